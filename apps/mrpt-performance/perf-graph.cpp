@@ -67,6 +67,24 @@ double graphs_test_populate_at_end(int nEdges, int _N)
 	return tictac.Tac() / N;
 }
 
+template <class EDGE_TYPE, class MAPIMPL>
+double graphs_test_iterate_edges(int nEdges, int _N)
+{
+	const long N = _N;
+
+	mrpt::graphs::CNetworkOfPoses<EDGE_TYPE, MAPIMPL> g;
+	for (int j = 0; j < nEdges; ++j)
+		g.insertEdge(j, j + 1, EDGE_TYPE());
+
+	CTicTac tictac;
+	TNodeID sum = 0;
+	for (long i = 0; i < N; i++)
+		for (const auto& e : g.edges) sum += e.first.second - e.first.first;
+	const double t = tictac.Tac() / N;
+	ASSERT_EQUAL_(sum, static_cast<TNodeID>(N * nEdges));
+	return t;
+}
+
 template <class EDGE_TYPE, class MAPS_IMPLEMENTATION>
 double graphs_dijkstra(int nNodes, int _N)
 {
@@ -258,6 +276,19 @@ void register_tests_graph()
 		graphs_test_populate_at_end<
 			CPose3DPDFGaussianInf, map_traits_map_as_vector>,
 		1e4, 250));
+	lstTests.push_back(TestData(
+		"graph(3d pdf,compact): insertEdgeAtEnd x 1e4",
+		graphs_test_populate_at_end<CPose3DPDFGaussianInf, map_traits_compact>,
+		1e4, 250));
+
+	lstTests.push_back(TestData(
+		"graph(3d pdf): iterate 1e5 edges",
+		graphs_test_iterate_edges<CPose3DPDFGaussianInf, map_traits_stdmap>,
+		1e5, 50));
+	lstTests.push_back(TestData(
+		"graph(3d pdf,compact): iterate 1e5 edges",
+		graphs_test_iterate_edges<CPose3DPDFGaussianInf, map_traits_compact>,
+		1e5, 50));
 
 	lstTests.push_back(TestData(
 		"graph(3d): dijkstra 1e2 nodes",
@@ -286,6 +317,9 @@ void register_tests_graph()
 	lstTests.push_back(TestData(
 		"graph(3d,vec): dijkstra 1e5 nodes",
 		graphs_dijkstra<CPose3D, map_traits_map_as_vector>, 1e5, 50));
+	lstTests.push_back(TestData(
+		"graph(3d,compact): dijkstra 1e5 nodes",
+		graphs_dijkstra<CPose3D, map_traits_compact>, 1e5, 50));
 
 	lstTests.push_back(TestData(
 		"graph(2d): dijkstra 1e5 nodes",
@@ -18,7 +18,7 @@
 
 #include <mrpt/hwdrivers/CGenericSensor.h>
 #include <mrpt/config/CConfigFile.h>
-#include <mrpt/io/CFileGZOutputStream.h>
+#include <mrpt/io/CFileGZParallelOutputStream.h>
 #include <mrpt/img/CImage.h>
 #include <mrpt/core/round.h>
 #include <mrpt/obs/CActionCollection.h>
@@ -107,6 +107,8 @@ int main(int argc, char** argv)
 		int GRABBER_PERIOD_MS = 1000;
 		int rawlog_GZ_compress_level =
 			1;  // 0: No compress, 1-9: compress level
+		// Number of compression threads (0: one per hardware thread)
+		int rawlog_GZ_compress_threads = 0;
 
 		MRPT_LOAD_CONFIG_VAR(
 			rawlog_prefix, string, iniFile, GLOBAL_SECTION_NAME);
@@ -121,6 +123,8 @@ int main(int argc, char** argv)
 
 		MRPT_LOAD_CONFIG_VAR(
 			rawlog_GZ_compress_level, int, iniFile, GLOBAL_SECTION_NAME);
+		MRPT_LOAD_CONFIG_VAR(
+			rawlog_GZ_compress_threads, int, iniFile, GLOBAL_SECTION_NAME);
 
 		// Build full rawlog file name:
 		string rawlog_postfix = "_";
@@ -182,10 +186,17 @@ int main(int argc, char** argv)
 		// ----------------------------------------------
 		// Run:
 		// ----------------------------------------------
-		mrpt::io::CFileGZOutputStream out_file;
+		// Observations are serialized here, compressed in parallel threads
+		// and written to disk in yet another thread:
+		mrpt::io::CFileGZParallelOutputStream out_file;
 		auto out_arch = archiveFrom(out_file);
 
-		out_file.open(rawlog_filename, rawlog_GZ_compress_level);
+		mrpt::io::CFileGZParallelOutputStream::TOptions out_opts;
+		out_opts.compress_level = rawlog_GZ_compress_level;
+		out_opts.num_threads = std::max(0, rawlog_GZ_compress_threads);
+		if (!out_file.open(rawlog_filename, out_opts))
+			THROW_EXCEPTION_FMT(
+				"Error opening output file: '%s'", rawlog_filename.c_str());
 
 		CSensoryFrame curSF;
 		CGenericSensor::TListObservations copy_of_global_list_obs;
@@ -435,6 +446,20 @@ int main(int argc, char** argv)
 						 << endl;
 				}
 			}
+
+			if (hwdrivers_verbose)
+			{
+				// Show whether the disk & compression keep up with sensors:
+				const auto st = out_file.getStats();
+				cout << format(
+							"  Rawlog: %.02f MB in, %.02f MB out, %u blocks "
+							"pending (max: %u), writer stalled %.03f s",
+							st.bytes_in * 1e-6, st.bytes_out * 1e-6,
+							static_cast<unsigned int>(st.pending_blocks),
+							static_cast<unsigned int>(st.max_pending_blocks),
+							st.producer_wait_time)
+					 << endl;
+			}
 			std::this_thread::sleep_for(
 				std::chrono::milliseconds(GRABBER_PERIOD_MS));
 		}
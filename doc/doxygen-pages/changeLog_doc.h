@@ -34,6 +34,11 @@ serialization with variants(To be replaced by std::variant eventually).
 			- The ICP module now supports Velodyne 3D scans.
 		- pf-localization:
 			- Odometry is now used also for observation-only rawlogs.
+		- rawlog-grabber:
+			- Rawlog files are compressed in parallel threads and written from
+a dedicated I/O thread, so heavy sensors no longer stall the main loop. New
+option `rawlog_GZ_compress_threads`. Pipeline statistics are shown if
+`MRPT_HWDRIVERS_VERBOSE` is set.
 	- Changes in libraries:
 		- \ref mrpt_base_grp => Refactored into several smaller libraries, one
 per namespace.
@@ -53,8 +58,73 @@ initializator
 			- Removed the include file: `<mrpt/math/jacobians.h>`. Replace by
 `<mrpt/math/num_jacobian.h>` or individual methods in \ref mrpt_poses_grp
 classes.
+		- \ref mrpt_io_grp
+			- New class mrpt::io::CFileGZParallelOutputStream: gzip output
+stream which compresses independent blocks in a thread pool and writes them
+from an I/O thread as a multi-member gzip file, with bounded memory and
+backpressure statistics.
+			- New class mrpt::io::CMemoryMappedFile to access a whole file as a
+read-only memory block.
+		- \ref mrpt_containers_grp
+			- New bounded lock-free queues mrpt::containers::spsc_queue and
+mrpt::containers::mpsc_queue. mrpt::containers::CThreadSafeQueue uses the
+latter, so push() no longer takes a lock unless the queue is full.
+		- \ref mrpt_poses_grp
+			- New batch methods mrpt::poses::CPose3D::composePoints(),
+mrpt::poses::CPose3D::inverseComposePoints() and
+mrpt::poses::CPose3D::composePoses(), with AVX2 kernels if enabled at build
+time. Used in mrpt::maps::CPointsMap::changeCoordinatesReference() and
+mrpt::poses::CPose3DPDFParticles::changeCoordinatesReference().
+			- mrpt::poses::CPose3DInterpolator, mrpt::poses::CPose2DInterpolator:
+The path is now stored in a sorted `std::vector` instead of a `std::map` (same
+serialization format). New batch `interpolate()` method for many query
+times, much faster for sorted times, which evaluates precomputed spline and
+line fit coefficients for each interval. Used in
+mrpt::obs::CObservationVelodyneScan::generatePointCloudAlongSE3Trajectory().
+[API change] `TPath` and the iterator types are now those of a
+`std::vector<std::pair<time_point, pose_t>>`: insert() and erase()
+invalidate all iterators past the modified position (and insert() may
+invalidate all of them), erasing is O(N), and `std::map`-only members of
+`TPath` are no longer available. The class methods (`begin()`, `find()`,
+`lower_bound()`, `upper_bound()`, `erase()`, `insert()`...) keep their
+signatures.
+		- \ref mrpt_expr_grp
+			- New mrpt::expr::CRuntimeCompiledExpression::eval_batch() to
+evaluate an expression for N values of its variables at once, with a compact
+bytecode interpreter for the usual arithmetic, comparison, logic and math
+functions, falling back to exprtk for anything else.
+		- \ref mrpt_graphs_grp
+			- mrpt::graphs::CDijkstra: Uses a binary heap and a compressed
+sparse row adjacency of the graph, so it runs in O((V+E) log V) instead of
+O(V^2). Same output trees.
+			- New container mrpt::graphs::compact_edges_map, selected with
+mrpt::graphs::map_traits_compact as MAPS_IMPLEMENTATION of
+mrpt::graphs::CNetworkOfPoses (or with the new EDGES_IMPLEMENTATION argument
+of mrpt::graphs::CDirectedGraph): all edges in one contiguous vector plus a
+per-node adjacency index, with the same iteration API and binary format than
+the default std::multimap.
+			- mrpt::graphs::ScalarFactorGraph: New solver
+mrpt::graphs::ScalarFactorGraph::solverSparseCholesky, a sparse LDL^T whose
+ordering and symbolic factorization are kept while the binary factors do not
+change. Variances are computed by selective inversion.
+			- mrpt::graphs::CGraphPartitioner: New overloads for sparse weights
+matrices (mrpt::graphs::sparse_adjacency_t), which find the Fiedler vector with
+a restarted Lanczos solver and can be warm-started from a previous solution.
 		- \ref mrpt_config_grp  [NEW IN MRPT 2.0.0]
 			- mrpt::config::CConfigFileBase::write() now supports enum types.
+		- \ref mrpt_bayes_grp
+			- mrpt::bayes::CKalmanFilterCapable: New method
+mrpt::bayes::kfEIF, a sparse extended information filter for large SLAM maps,
+with SEIF sparsification of the number of active landmarks. Landmark
+covariances are recovered on demand (see getLandmarkCov() and
+getFullCovariance()), and the symbolic analysis of the sparse Cholesky
+factorization is only redone when the information matrix structure changes.
+		- \ref mrpt_random_grp
+			- New class mrpt::random::CCounterBasedRandomGenerator (Philox4x32-10)
+for fast batch generation and reproducible, independent substreams in
+multithreaded code.
+			- New methods mrpt::random::CRandomGenerator::drawUniformBatch() and
+mrpt::random::CRandomGenerator::drawGaussian1DBatch().
 		- \ref mrpt_serialization_grp  [NEW IN MRPT 2.0.0]
 			- New method mrpt::serialization::CArchive::ReadPOD() and macro
 `MRPT_READ_POD()` for reading unaligned POD variables.-
@@ -63,6 +133,41 @@ classes.
 			- rbpf-slam: Add support for simplemap continuation.
 			- CICP: parameter `onlyClosestCorrespondences` deleted (always true
 now).
+			- mrpt::slam::data_association_full_covariance(): Faster JCBB, with
+incremental Cholesky updates of the joint innovation, a tighter pruning bound
+and parallel exploration of the top-level branches. With the Mahalanobis
+metric, hypotheses must now pass the joint compatibility (chi2) test, as in
+the original JCBB algorithm; the matching likelihood metric is not gated.
+			- mrpt::slam::CIncrementalMapPartitioner: The adjacency matrix is now
+sparse (only overlapping keyframes are stored) and partitions are computed
+with the sparse spectral bisection, warm-started from the previous update,
+so `map-partition` no longer needs O(N^2) memory nor O(N^3) time.
+[API change] The accessor `const CMatrixDouble& getAdjacencyMatrix() const`
+is removed, since there is no dense matrix to return a reference to anymore:
+use the new `getSparseAdjacency()` for direct access, or the template
+`getAdjacencyMatrix(MATRIX&)`, which still fills a dense copy. Serialization
+version bumped to 2.
+			- New mrpt::slam::CCorrelativeScanMatcher: a global 2D scan matcher
+doing branch-and-bound over a pyramid of max-pooled likelihood grids, in
+parallel over rotations. mrpt::graphslam::deciders::CLoopCloserERD can use it
+to find the initial ICP estimation of loop closure hypotheses (option
+`LC_use_correlative_matcher`).
+			- mrpt::slam::CMonteCarloLocalization2D,
+mrpt::slam::CMonteCarloLocalization3D: the standard proposal evaluates the
+likelihood of all particles with a single call per observation.
+		- \ref mrpt_graphslam_grp
+			- mrpt::graphslam::deciders::CLoopCloserERD: the ICP of the loop
+closure hypotheses runs in a pool of threads (option `LC_num_threads`), with
+results committed in the same order as before. The pair-wise consistency matrix
+computes each Dijkstra path once per node pair, instead of once per matrix
+element, and evaluates all elements in a single batch.
+			- mrpt::graphslam::optimizers::CLevMarqGSO: the optimizer keeps its
+own copy of the graph, brought up to date in place when an optimization starts.
+With `optimization_on_second_thread`, it is optimized in the background while
+the deciders keep on working on the live graph, and the optimized poses are
+applied in a single step once ready. The front-end never waits for a running
+optimization. The last optimized graph can be read from any thread with
+`getLastOptimizedGraph()`, and it is the one drawn in the graph visualization.
 		- \ref mrpt_system_grp
 			- functions to get timestamp as *local* time were removed, since
 they don't make sense. All timestamps in MRPT are UTC, and they can be formated
@@ -74,24 +179,76 @@ mrpt::nav::CRobot2NavInterface are now invoked *after* `navigationStep()` to
 avoid problems if user code invokes the navigator API to change its state.
 			- Added methods to load/save mrpt::nav::TWaypointSequence to
 configuration files.
+			- mrpt::nav::CMultiObjectiveMotionOptimizerBase: score and assert
+formulas are evaluated for all candidate movements in a single batch.
+mrpt::nav::CPTG_Holo_Blend evaluates its `expr_V`, `expr_W` and
+`expr_T_ramp` once per path index at initialization.
 		- \ref mrpt_comms_grp [NEW IN MRPT 2.0.0]
 			- This new module has been created to hold all serial devices &
 networking classes, with minimal dependencies.
+			- New typed nodelet topics mrpt::comms::TypedTopic: zero-copy
+`shared_ptr<const T>` messages, per-subscriber bounded queues with drop
+policies, delivery through a mrpt::comms::Executor thread pool, and
+throughput/latency statistics.
+			- New classes mrpt::comms::CSharedMemoryRingWriter and
+mrpt::comms::CSharedMemoryRingReader: a lock-free shared-memory ring buffer to
+publish serialized objects to other processes of the same machine, without
+sockets or extra copies.
 		- \ref mrpt_maps_grp
 			- Added optional "channel" attribute to CReflectivityGrdMap2D and
 CObservationReflectivity to support different colors of light.
+			- New native binary point cloud format, saved with
+mrpt::maps::CPointsMap::saveBinaryFile() and loaded with
+mrpt::maps::CPointsMap::loadBinaryFile() by memory-mapping it: coordinates,
+colour and weight arrays plus a chunked spatial index. Large maps can also be
+accessed in place, without copying, through mrpt::maps::CPointsMapBinaryFile.
+			- New mrpt::maps::CPointsMap::load_from_text_file_parallel(): loads
+XYZ text files by memory-mapping them and parsing blocks of lines in parallel,
+with optional voxel decimation. load2D_from_text_file() and
+load3D_from_text_file() now use it.
+			- New multithreaded point cloud filters:
+mrpt::maps::CPointCloudFilterVoxelGrid (centroid of each voxel),
+mrpt::maps::CPointCloudFilterRadiusOutliers,
+mrpt::maps::CPointCloudFilterStatisticalOutliers and
+mrpt::maps::CPointCloudFilterSubsample. They can be applied to each inserted
+observation via the new mrpt::maps::CPointsMap::TInsertionOptions::filters.
+			- mrpt::maps::COctoMap, mrpt::maps::CColouredOctoMap: Much faster
+insertion of dense point clouds and RGB-D observations: rays are traced in
+parallel once per distinct end voxel, and each voxel is updated only once.
+			- mrpt::maps::COccupancyGridMap2D: New insertion option
+`rasterizeFreeSpace` to insert the free space of 2D scans with a scanline fill
+of the scan polygon, updating each cell once. Serialization version bumped
+to 7.
+			- mrpt::maps::CBeaconMap, mrpt::maps::CLandmarksMap: batched
+likelihood of range-only and SIFT observations for many poses: beacons are
+looked up by ID and packed into contiguous arrays once, and SIFT features are
+extracted once. The SIFT likelihood skips pairs of landmarks too far apart to
+contribute, with a spatial hash of the map landmarks.
+			- mrpt::maps::CRandomFieldGridMap2D, mrpt::maps::CRandomFieldGridMap3D:
+New option `GMRF_use_sparse_cholesky` to update GMRF maps with the sparse
+Cholesky solver of mrpt::graphs::ScalarFactorGraph.
 		- \ref mrpt_hwdrivers_grp
 			- COpenNI2Generic: is safer in multithreading apps.
 			- CHokuyoURG:
 				- Rewrite driver to be safer and reduce mem allocs.
 				- New parameter `scan_interval` to decimate scans.
+			- mrpt::hwdrivers::CGenericSensor: observations are enqueued in a
+lock-free queue, so high-rate sensors no longer contend with the thread
+calling getObservations().
 		- \ref mrpt_opengl_grp
 			- Update Assimp lib version 4.0.1 -> 4.1.0 (when built as
 ExternalProject)
+			- New class mrpt::opengl::CBoundingVolumeHierarchy, used by
+mrpt::opengl::CSetOfTriangles and mrpt::opengl::CMesh for much faster
+traceRay() in large triangle sets.
+			- New method mrpt::opengl::COpenGLScene::traceRays() to trace a batch
+of rays in parallel.
 		- \ref mrpt_obs_grp
 			- mrpt::obs::T3DPointsProjectionParams and
 mrpt::obs::CObservation3DRangeScan::project3DPointsFromDepthImageInto now
 together support organized PCL point clouds.
+			- New mrpt::maps::CMetricMap::computeObservationLikelihoods() to
+evaluate an observation for a set of poses (e.g. all particles) at once.
 	- BUG FIXES:
 		- Fix reactive navigator inconsistent state if navigation API is called
 from within rnav callbacks.
@@ -53,6 +53,14 @@ etc.
 See: \ref comms_nodelets_example/NodeletsTest_impl.cpp
 \snippet comms_nodelets_example/NodeletsTest_impl.cpp example-nodelets
 
+For high-rate data, mrpt::comms::TopicDirectory::getTypedTopic() returns a
+mrpt::comms::TypedTopic, where messages are `std::shared_ptr<const T>` shared
+by all subscribers without copies. Each subscriber has its own bounded queue
+with a mrpt::comms::DropPolicy, and its callback runs in a
+mrpt::comms::Executor thread pool, so publish() does **not** block on slow
+subscribers. Per-topic counters and latencies are available via
+mrpt::comms::TypedTopic::getStats().
+
 ## HTTP request methods
 
 mrpt::comms::net::http_get() is an easy way to GET an HTTP resource from any C++
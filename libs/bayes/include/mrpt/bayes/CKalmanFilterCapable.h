@@ -19,12 +19,15 @@
 #include <mrpt/core/aligned_std_vector.h>
 #include <mrpt/config/CLoadableOptions.h>
 #include <mrpt/containers/stl_containers_utils.h>
+#include <mrpt/containers/deepcopy_ptr.h>
 #include <mrpt/system/COutputLogger.h>
 #include <mrpt/containers/stl_containers_utils.h>  // find_in_vector
 #include <mrpt/system/CTicTac.h>
 #include <mrpt/io/CFileOutputStream.h>
 #include <mrpt/typemeta/TEnumType.h>
 #include <mrpt/system/vector_loadsave.h>
+#include <map>
+#include <set>
 
 namespace mrpt
 {
@@ -41,7 +44,12 @@ enum TKFMethod
 	kfEKFNaive = 0,
 	kfEKFAlaDavison,
 	kfIKFFull,
-	kfIKF
+	kfIKF,
+	/** Sparse extended information filter: the filter keeps a block-sparse
+	 * information matrix instead of the dense covariance, and recovers
+	 * covariance blocks on demand (for data association) via a sparse
+	 * Cholesky factorization. See TKF_options::EIF_max_active_landmarks */
+	kfEIF
 };
 
 // Forward declaration:
@@ -78,6 +86,9 @@ struct TKF_options : public mrpt::config::CLoadableOptions
 		MRPT_LOAD_CONFIG_VAR(
 			debug_verify_analytic_jacobians_threshold, double, iniFile,
 			section);
+		MRPT_LOAD_CONFIG_VAR(EIF_max_active_landmarks, int, iniFile, section);
+		MRPT_LOAD_CONFIG_VAR(
+			EIF_recover_full_covariance, bool, iniFile, section);
 	}
 
 	/** This method must display clearly all the contents of the structure in
@@ -98,6 +109,12 @@ struct TKF_options : public mrpt::config::CLoadableOptions
 		out << mrpt::format(
 			"enable_profiler                         = %c\n",
 			enable_profiler ? 'Y' : 'N');
+		out << mrpt::format(
+			"EIF_max_active_landmarks                = %i\n",
+			EIF_max_active_landmarks);
+		out << mrpt::format(
+			"EIF_recover_full_covariance             = %c\n",
+			EIF_recover_full_covariance ? 'Y' : 'N');
 		out << mrpt::format("\n");
 	}
 
@@ -124,6 +141,19 @@ struct TKF_options : public mrpt::config::CLoadableOptions
 	/** (default-1e-2) Sets the threshold for the difference between the
 	 * analytic and the numerical jacobians */
 	double debug_verify_analytic_jacobians_threshold{1e-2};
+	/** Only for kfEIF: maximum number of "active" landmarks, i.e. those linked
+	 * to the vehicle in the information matrix (default=20). Beyond this
+	 * number, the weakest links are removed (SEIF sparsification), which keeps
+	 * the cost of each prediction independent of the map size. Set to 0 to
+	 * disable sparsification (exact EIF). */
+	int EIF_max_active_landmarks{20};
+	/** Only for kfEIF: if true, the full covariance matrix is recovered
+	 * into CKalmanFilterCapable::m_pkk at the end of each iteration, for
+	 * compatibility with code reading it directly. This costs O(N^2) per
+	 * iteration. By default (false), m_pkk only holds the vehicle marginal
+	 * covariance, and landmark covariances are recovered on demand by
+	 * CKalmanFilterCapable::getLandmarkCov() and getFullCovariance(). */
+	bool EIF_recover_full_covariance{false};
 };
 
 /** Auxiliary functions, for internal usage of MRPT classes */
@@ -285,23 +315,69 @@ class CKalmanFilterCapable : public mrpt::system::COutputLogger
 	}
 	/** Returns the covariance of the idx'th landmark (not applicable to
 	 * non-SLAM problems).
+	 * With kfEIF and TKF_options::EIF_recover_full_covariance=false, the
+	 * marginal is recovered on demand from the information matrix (or read
+	 * from m_pkk if it was not factorized yet, as in getFullCovariance()).
 	 * \exception std::exception On idx>= getNumberOfLandmarksInTheMap()
 	 */
 	inline void getLandmarkCov(size_t idx, KFMatrix_FxF& feat_cov) const
 	{
+		ASSERT_(idx < getNumberOfLandmarksInTheMap());
+		if (KF_options.method == kfEIF &&
+			!KF_options.EIF_recover_full_covariance && m_info_chol_uptodate)
+		{
+			feat_cov = EIF_marginalCovariance(std::vector<size_t>(1, 1 + idx));
+			return;
+		}
 		m_pkk.extractMatrix(
 			VEH_SIZE + idx * FEAT_SIZE, VEH_SIZE + idx * FEAT_SIZE, feat_cov);
 	}
 
+	/** Returns the full covariance matrix of the state vector. With kfEIF
+	 * and TKF_options::EIF_recover_full_covariance=false, it is recovered
+	 * from the information matrix, at O(N^2) cost. */
+	void getFullCovariance(KFMatrix& P) const
+	{
+		if (KF_options.method == kfEIF &&
+			!KF_options.EIF_recover_full_covariance && m_info_chol_uptodate)
+		{
+			std::vector<size_t> nodes;
+			for (size_t k = 0; k < m_info_blocks.size(); k++)
+				nodes.push_back(k);
+			P = EIF_marginalCovariance(nodes);
+			return;
+		}
+		P = m_pkk;
+	}
+
    protected:
 	/** @name Kalman filter state
 		@{ */
 
 	/** The system state vector. */
 	KFVector m_xkk;
-	/** The system full covariance matrix. */
+	/** The system full covariance matrix. With kfEIF, see
+	 * TKF_options::EIF_recover_full_covariance */
 	KFMatrix m_pkk;
 
+	/** Only for kfEIF: forces the information matrix to be rebuilt from the
+	 * current m_pkk in the next iteration. Must be called by derived classes
+	 * after resetting the filter state (m_xkk, m_pkk). */
+	void invalidateInformationForm()
+	{
+		m_info_blocks.clear();
+		m_info_chol_uptodate = false;
+	}
+
+	using KFMatrixDyn = Eigen::Matrix<KFTYPE, Eigen::Dynamic, Eigen::Dynamic>;
+	/** Only for kfEIF: the upper triangle of the information matrix, by
+	 * blocks (the (i,j) block, i<=j, is [j][i]; node 0 is the vehicle and
+	 * node k>0 the (k-1)'th landmark). Empty if not built yet. */
+	const std::vector<std::map<size_t, KFMatrixDyn>>& getInformationBlocks()
+		const
+	{
+		return m_info_blocks;
+	}
 	/** @} */
 
 	mrpt::system::CTimeLogger m_timLogger;
@@ -634,6 +710,61 @@ class CKalmanFilterCapable : public mrpt::system::COutputLogger
 	KFMatrix dh_dx_full_obs;
 	KFMatrix aux_K_dh_dx;
 
+	/** @name Extended information filter (kfEIF) state
+		@{ */
+	/** Sparse factorization of the information matrix. Defined in
+	 * CKalmanFilterCapable_impl.h, to keep Eigen's sparse modules out of
+	 * this header. */
+	struct TEIFFactorization;
+	/** Information matrix, stored as blocks: "node" 0 is the vehicle, node k>0
+	 * is the (k-1)'th landmark. Only the upper triangle is kept:
+	 * m_info_blocks[j][i] is the (i,j) block, with i<=j. */
+	std::vector<std::map<size_t, KFMatrixDyn>> m_info_blocks;
+	/** The nodes (landmarks) with a non-null link to the vehicle */
+	std::set<size_t> m_info_active;
+	/** Sparse Cholesky factorization of the last information matrix
+	 * (created on the first call to EIF_factorize()) */
+	mrpt::containers::copy_ptr<TEIFFactorization> m_info_chol;
+	/** False if blocks were added or removed since the last symbolic
+	 * analysis of m_info_chol (its ordering and elimination tree) */
+	bool m_info_pattern_uptodate{false};
+	/** False if the information matrix changed since the last (numeric)
+	 * factorization m_info_chol */
+	bool m_info_chol_uptodate{false};
+
+	static size_t EIF_nodeDim(size_t node)
+	{
+		return node == 0 ? VEH_SIZE : FEAT_SIZE;
+	}
+	static size_t EIF_nodeOffset(size_t node)
+	{
+		return node == 0 ? 0 : VEH_SIZE + (node - 1) * FEAT_SIZE;
+	}
+	/** Returns the (i,j) block, or zeros if it does not exist */
+	KFMatrixDyn EIF_getBlock(size_t i, size_t j) const;
+	/** Adds M to the (i,j) block (and its transpose to (j,i)) */
+	void EIF_addToBlock(size_t i, size_t j, const KFMatrixDyn& M);
+	/** Overwrites the (i,j) block (and (j,i)), removing it if null */
+	void EIF_setBlock(size_t i, size_t j, const KFMatrixDyn& M);
+	/** Builds m_info_blocks from m_xkk & m_pkk, if not done yet */
+	void EIF_initFromCovariance();
+	/** Prediction stage, for a transition Jacobian and noise of the vehicle */
+	void EIF_predict(const KFMatrix_VxV& dfv_dxv, const KFMatrix_VxV& Q);
+	/** SEIF sparsification: bounds the number of active landmarks */
+	void EIF_sparsify();
+	/** Computes the sparse factorization m_info_chol, if the information
+	 * matrix changed. The symbolic analysis is only redone if its sparsity
+	 * pattern changed, too. */
+	void EIF_factorize();
+	/** Returns the joint marginal covariance of the given nodes, stacked in
+	 * the given order. Requires a previous call to EIF_factorize(). */
+	KFMatrix EIF_marginalCovariance(const std::vector<size_t>& nodes) const;
+	/** Adds the links of a newly created landmark, with Jacobian dyn_dxv wrt
+	 * the vehicle and covariance of its inverse sensor model Ryn */
+	void EIF_addNewLandmark(
+		const KFMatrix_FxV& dyn_dxv, const KFMatrix_FxF& Ryn);
+	/** @} */
+
    protected:
 	/** The main entry point, executes one complete step: prediction + update.
 	 *  It is protected since derived classes must provide a problem-specific
@@ -681,6 +812,7 @@ MRPT_FILL_ENUM(kfEKFNaive);
 MRPT_FILL_ENUM(kfEKFAlaDavison);
 MRPT_FILL_ENUM(kfIKFFull);
 MRPT_FILL_ENUM(kfIKF);
+MRPT_FILL_ENUM(kfEIF);
 MRPT_ENUM_TYPE_END()
 
 // Template implementation:
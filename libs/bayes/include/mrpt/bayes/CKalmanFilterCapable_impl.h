@@ -13,11 +13,23 @@
 #endif
 
 #include <mrpt/containers/stl_containers_utils.h>
+#include <Eigen/SparseCore>
+#include <Eigen/SparseCholesky>
 
 namespace mrpt
 {
 namespace bayes
 {
+template <
+	size_t VEH_SIZE, size_t OBS_SIZE, size_t FEAT_SIZE, size_t ACT_SIZE,
+	typename KFTYPE>
+struct CKalmanFilterCapable<
+	VEH_SIZE, OBS_SIZE, FEAT_SIZE, ACT_SIZE, KFTYPE>::TEIFFactorization
+{
+	using sparse_matrix_t = Eigen::SparseMatrix<KFTYPE>;
+	Eigen::SimplicialLDLT<sparse_matrix_t> chol;
+};
+
 // The main entry point in the Kalman Filter class:
 template <
 	size_t VEH_SIZE, size_t OBS_SIZE, size_t FEAT_SIZE, size_t ACT_SIZE,
@@ -31,8 +43,11 @@ void CKalmanFilterCapable<
 	m_timLogger.enable(KF_options.enable_profiler);
 	m_timLogger.enter("KF:complete_step");
 
-	ASSERT_(int(m_xkk.size()) == m_pkk.cols());
 	ASSERT_(size_t(m_xkk.size()) >= VEH_SIZE);
+	if (KF_options.method == kfEIF)
+		EIF_initFromCovariance();
+	else
+		ASSERT_(int(m_xkk.size()) == m_pkk.cols());
 	// =============================================================
 	//  1. CREATE ACTION MATRIX u FROM ODOMETRY
 	// =============================================================
@@ -128,31 +143,40 @@ void CKalmanFilterCapable<
 		KFMatrix_VxV Q;
 		OnTransitionNoise(Q);
 
-		// ====================================
-		//  3.1:  Pxx submatrix
-		// ====================================
-		// Replace old covariance:
-		Eigen::Block<typename KFMatrix::Base, VEH_SIZE, VEH_SIZE>(m_pkk, 0, 0) =
-			Q + dfv_dxv *
-					Eigen::Block<typename KFMatrix::Base, VEH_SIZE, VEH_SIZE>(
-						m_pkk, 0, 0) *
-					dfv_dxv.transpose();
-
-		// ====================================
-		//  3.2:  All Pxy_i
-		// ====================================
-		// Now, update the cov. of landmarks, if any:
-		KFMatrix_VxF aux;
-		for (size_t i = 0; i < N_map; i++)
+		if (KF_options.method == kfEIF)
+		{
+			// Prediction in information form: only the vehicle row/column
+			// and the links between active landmarks are modified.
+			EIF_predict(dfv_dxv, Q);
+		}
+		else
 		{
-			aux = dfv_dxv *
-				  Eigen::Block<typename KFMatrix::Base, VEH_SIZE, FEAT_SIZE>(
-					  m_pkk, 0, VEH_SIZE + i * FEAT_SIZE);
-
-			Eigen::Block<typename KFMatrix::Base, VEH_SIZE, FEAT_SIZE>(
-				m_pkk, 0, VEH_SIZE + i * FEAT_SIZE) = aux;
-			Eigen::Block<typename KFMatrix::Base, FEAT_SIZE, VEH_SIZE>(
-				m_pkk, VEH_SIZE + i * FEAT_SIZE, 0) = aux.transpose();
+			// ====================================
+			//  3.1:  Pxx submatrix
+			// ====================================
+			// Replace old covariance:
+			Eigen::Block<typename KFMatrix::Base, VEH_SIZE, VEH_SIZE>(m_pkk, 0, 0) =
+				Q + dfv_dxv *
+						Eigen::Block<typename KFMatrix::Base, VEH_SIZE, VEH_SIZE>(
+							m_pkk, 0, 0) *
+						dfv_dxv.transpose();
+
+			// ====================================
+			//  3.2:  All Pxy_i
+			// ====================================
+			// Now, update the cov. of landmarks, if any:
+			KFMatrix_VxF aux;
+			for (size_t i = 0; i < N_map; i++)
+			{
+				aux = dfv_dxv *
+					  Eigen::Block<typename KFMatrix::Base, VEH_SIZE, FEAT_SIZE>(
+						  m_pkk, 0, VEH_SIZE + i * FEAT_SIZE);
+
+				Eigen::Block<typename KFMatrix::Base, VEH_SIZE, FEAT_SIZE>(
+					m_pkk, 0, VEH_SIZE + i * FEAT_SIZE) = aux;
+				Eigen::Block<typename KFMatrix::Base, FEAT_SIZE, VEH_SIZE>(
+					m_pkk, VEH_SIZE + i * FEAT_SIZE, 0) = aux.transpose();
+			}
 		}
 
 		// =============================================================
@@ -165,6 +189,18 @@ void CKalmanFilterCapable<
 
 	}  // end if (!skipPrediction)
 
+	if (KF_options.method == kfEIF)
+	{
+		// Recover the vehicle marginal, which user callbacks may need:
+		EIF_factorize();
+		const KFMatrix Pxx = EIF_marginalCovariance(std::vector<size_t>(1, 0));
+		if (KF_options.EIF_recover_full_covariance &&
+			m_pkk.cols() == int(m_xkk.size()))
+			m_pkk.insertMatrix(0, 0, Pxx);
+		else
+			m_pkk = Pxx;
+	}
+
 	const double tim_pred = m_timLogger.leave("KF:2.prediction stage");
 
 	// =============================================================
@@ -365,34 +401,46 @@ void CKalmanFilterCapable<
 
 		if (FEAT_SIZE > 0)
 		{  // SLAM-like problem:
+			// With kfEIF, only the covariance blocks of the vehicle and the
+			// predicted landmarks are recovered, in the order of
+			// predictLMidxs:
+			const bool use_subset = (KF_options.method == kfEIF);
+			if (use_subset)
+			{
+				std::vector<size_t> nodes(1, 0);
+				for (size_t lm_idx : predictLMidxs) nodes.push_back(1 + lm_idx);
+				Pkk_subset = EIF_marginalCovariance(nodes);
+			}
+			const KFMatrix& P = use_subset ? Pkk_subset : m_pkk;
+			auto P_lm_offset = [&](size_t pred_idx) {
+				return VEH_SIZE +
+					   (use_subset ? pred_idx : predictLMidxs[pred_idx]) *
+						   FEAT_SIZE;
+			};
+
 			const Eigen::Block<
 				const typename KFMatrix::Base, VEH_SIZE, VEH_SIZE>
-				Px(m_pkk, 0, 0);  // Covariance of the vehicle pose
+				Px(P, 0, 0);  // Covariance of the vehicle pose
 
 			for (size_t i = 0; i < N_pred; ++i)
 			{
-				const size_t lm_idx_i = predictLMidxs[i];
 				const Eigen::Block<
 					const typename KFMatrix::Base, FEAT_SIZE, VEH_SIZE>
-					Pxyi_t(
-						m_pkk, VEH_SIZE + lm_idx_i * FEAT_SIZE, 0);  // Pxyi^t
+					Pxyi_t(P, P_lm_offset(i), 0);  // Pxyi^t
 
 				// Only do j>=i (upper triangle), since S is symmetric:
 				for (size_t j = i; j < N_pred; ++j)
 				{
-					const size_t lm_idx_j = predictLMidxs[j];
 					// Sij block:
 					Eigen::Block<typename KFMatrix::Base, OBS_SIZE, OBS_SIZE>
 						Sij(S, OBS_SIZE * i, OBS_SIZE * j);
 
 					const Eigen::Block<
 						const typename KFMatrix::Base, VEH_SIZE, FEAT_SIZE>
-						Pxyj(m_pkk, 0, VEH_SIZE + lm_idx_j * FEAT_SIZE);
+						Pxyj(P, 0, P_lm_offset(j));
 					const Eigen::Block<
 						const typename KFMatrix::Base, FEAT_SIZE, FEAT_SIZE>
-						Pyiyj(
-							m_pkk, VEH_SIZE + lm_idx_i * FEAT_SIZE,
-							VEH_SIZE + lm_idx_j * FEAT_SIZE);
+						Pyiyj(P, P_lm_offset(i), P_lm_offset(j));
 
 					Sij = Hxs[i] * Px * Hxs[j].transpose() +
 						  Hys[i] * Pxyi_t * Hxs[j].transpose() +
@@ -1159,6 +1207,61 @@ void CKalmanFilterCapable<
 			}
 			break;
 
+			// --------------------------------------------------------------------
+			// - Extended information filter: Lambda += H^t R^-1 H
+			// --------------------------------------------------------------------
+			case kfEIF:
+			{
+				m_timLogger.enter("KF:8.update stage:1.EIF:update info");
+
+				const KFMatrix_OxO R_1 = R.inverse();
+				// The right hand side H^t R^-1 ytilde of the Gauss-Newton
+				// step for the mean:
+				KFVector rhs = KFVector::Zero(m_xkk.size());
+
+				for (size_t i = 0; i < Z.size(); ++i)
+				{
+					size_t pred_idx = 0, node = 0;
+					if (FEAT_SIZE != 0)
+					{
+						if (data_association[i] < 0) continue;
+						const size_t lm_idx =
+							static_cast<size_t>(data_association[i]);
+						pred_idx = mrpt::containers::find_in_vector(
+							lm_idx, predictLMidxs);
+						ASSERT_(pred_idx != string::npos);
+						node = 1 + lm_idx;
+					}
+
+					KFArray_OBS ytilde = Z[i];
+					OnSubstractObservationVectors(
+						ytilde, all_predictions[FEAT_SIZE == 0
+													? 0
+													: predictLMidxs[pred_idx]]);
+
+					const KFMatrixDyn HxtR_1 = Hxs[pred_idx].transpose() * R_1;
+					EIF_addToBlock(0, 0, HxtR_1 * Hxs[pred_idx]);
+					rhs.head(VEH_SIZE) += HxtR_1 * ytilde;
+
+					if (FEAT_SIZE != 0)
+					{
+						const KFMatrixDyn HytR_1 =
+							Hys[pred_idx].transpose() * R_1;
+						EIF_addToBlock(node, node, HytR_1 * Hys[pred_idx]);
+						EIF_addToBlock(0, node, HxtR_1 * Hys[pred_idx]);
+						rhs.segment(EIF_nodeOffset(node), FEAT_SIZE) +=
+							HytR_1 * ytilde;
+					}
+				}
+				m_timLogger.leave("KF:8.update stage:1.EIF:update info");
+
+				m_timLogger.enter("KF:8.update stage:2.EIF:update xkk");
+				EIF_factorize();
+				m_xkk += m_info_chol->chol.solve(rhs);
+				m_timLogger.leave("KF:8.update stage:2.EIF:update xkk");
+			}
+			break;
+
 			default:
 				THROW_EXCEPTION("Invalid value of options.KF_method");
 		}  // end switch method
@@ -1180,6 +1283,22 @@ void CKalmanFilterCapable<
 		m_timLogger.leave("KF:A.add new landmarks");
 	}  // end if data_association!=empty
 
+	// =============================================================
+	//  9. EIF: SPARSIFICATION AND COVARIANCE RECOVERY
+	// =============================================================
+	if (KF_options.method == kfEIF)
+	{
+		m_timLogger.enter("KF:A2.EIF recover cov");
+		EIF_sparsify();
+		EIF_factorize();
+		std::vector<size_t> nodes(1, 0);
+		if (KF_options.EIF_recover_full_covariance)
+			for (size_t k = 1; k < m_info_blocks.size(); k++)
+				nodes.push_back(k);
+		m_pkk = EIF_marginalCovariance(nodes);
+		m_timLogger.leave("KF:A2.EIF recover cov");
+	}
+
 	// Post iteration user code:
 	m_timLogger.enter("KF:B.OnPostIteration");
 	OnPostIteration();
@@ -1246,6 +1365,327 @@ void CKalmanFilterCapable<VEH_SIZE, OBS_SIZE, FEAT_SIZE, ACT_SIZE, KFTYPE>::
 	out_x = prediction[0];
 }
 
+// ---------------------------------------------------------------------
+//  Extended information filter (kfEIF) methods
+// ---------------------------------------------------------------------
+template <
+	size_t VEH_SIZE, size_t OBS_SIZE, size_t FEAT_SIZE, size_t ACT_SIZE,
+	typename KFTYPE>
+typename CKalmanFilterCapable<
+	VEH_SIZE, OBS_SIZE, FEAT_SIZE, ACT_SIZE, KFTYPE>::KFMatrixDyn
+	CKalmanFilterCapable<VEH_SIZE, OBS_SIZE, FEAT_SIZE, ACT_SIZE, KFTYPE>::
+		EIF_getBlock(size_t i, size_t j) const
+{
+	if (i > j) return EIF_getBlock(j, i).transpose();
+	const auto& col = m_info_blocks[j];
+	const auto it = col.find(i);
+	if (it == col.end())
+		return KFMatrixDyn::Zero(EIF_nodeDim(i), EIF_nodeDim(j));
+	return it->second;
+}
+
+template <
+	size_t VEH_SIZE, size_t OBS_SIZE, size_t FEAT_SIZE, size_t ACT_SIZE,
+	typename KFTYPE>
+void CKalmanFilterCapable<VEH_SIZE, OBS_SIZE, FEAT_SIZE, ACT_SIZE, KFTYPE>::
+	EIF_addToBlock(size_t i, size_t j, const KFMatrixDyn& M)
+{
+	if (i > j)
+	{
+		EIF_addToBlock(j, i, M.transpose());
+		return;
+	}
+	auto& col = m_info_blocks[j];
+	auto it = col.find(i);
+	if (it == col.end())
+	{
+		col[i] = M;
+		m_info_pattern_uptodate = false;
+	}
+	else
+		it->second += M;
+	m_info_chol_uptodate = false;
+	if (i == 0 && j != 0) m_info_active.insert(j);
+}
+
+template <
+	size_t VEH_SIZE, size_t OBS_SIZE, size_t FEAT_SIZE, size_t ACT_SIZE,
+	typename KFTYPE>
+void CKalmanFilterCapable<VEH_SIZE, OBS_SIZE, FEAT_SIZE, ACT_SIZE, KFTYPE>::
+	EIF_setBlock(size_t i, size_t j, const KFMatrixDyn& M)
+{
+	if (i > j)
+	{
+		EIF_setBlock(j, i, M.transpose());
+		return;
+	}
+	auto& col = m_info_blocks[j];
+	m_info_chol_uptodate = false;
+	if ((M.array() == 0).all())
+	{
+		if (col.erase(i)) m_info_pattern_uptodate = false;
+		if (i == 0) m_info_active.erase(j);
+	}
+	else
+	{
+		auto it = col.find(i);
+		if (it == col.end())
+		{
+			col[i] = M;
+			m_info_pattern_uptodate = false;
+		}
+		else
+			it->second = M;
+		if (i == 0 && j != 0) m_info_active.insert(j);
+	}
+}
+
+template <
+	size_t VEH_SIZE, size_t OBS_SIZE, size_t FEAT_SIZE, size_t ACT_SIZE,
+	typename KFTYPE>
+void CKalmanFilterCapable<VEH_SIZE, OBS_SIZE, FEAT_SIZE, ACT_SIZE, KFTYPE>::
+	EIF_initFromCovariance()
+{
+	const size_t nNodes = 1 + getNumberOfLandmarksInTheMap();
+	if (m_info_blocks.size() == nNodes) return;  // Already up to date
+
+	MRPT_START
+	ASSERT_(int(m_xkk.size()) == m_pkk.cols());
+
+	// Invert the (possibly dense) initial covariance once. Null variances
+	// (perfect knowledge) are replaced by a tiny value to keep it invertible:
+	KFMatrixDyn P = m_pkk;
+	for (int i = 0; i < P.rows(); i++) P(i, i) = std::max(P(i, i), KFTYPE(1e-6));
+	const KFMatrixDyn Lambda = P.inverse();
+
+	m_info_blocks.assign(nNodes, std::map<size_t, KFMatrixDyn>());
+	m_info_active.clear();
+	m_info_pattern_uptodate = false;
+	m_info_chol_uptodate = false;
+	for (size_t j = 0; j < nNodes; j++)
+		for (size_t i = 0; i <= j; i++)
+			EIF_setBlock(
+				i, j, Lambda.block(
+						  EIF_nodeOffset(i), EIF_nodeOffset(j), EIF_nodeDim(i),
+						  EIF_nodeDim(j)));
+	MRPT_END
+}
+
+template <
+	size_t VEH_SIZE, size_t OBS_SIZE, size_t FEAT_SIZE, size_t ACT_SIZE,
+	typename KFTYPE>
+void CKalmanFilterCapable<VEH_SIZE, OBS_SIZE, FEAT_SIZE, ACT_SIZE, KFTYPE>::
+	EIF_predict(const KFMatrix_VxV& dfv_dxv, const KFMatrix_VxV& Q)
+{
+	// The new vehicle pose x'=f(x)+w is appended and the old one marginalized
+	// out. Using W=Lxx^-1 and G=Q+F*W*F^t (which avoids inverting Q):
+	//  L'xx = G^-1
+	//  L'xm = G^-1 * F * W * Lxm
+	//  L'mm = Lmm - Lmx * (W - W * F^t * G^-1 * F * W) * Lxm
+	// Only the landmarks linked to the vehicle ("active") are affected.
+	const KFMatrixDyn F = dfv_dxv;
+	const KFMatrixDyn W = EIF_getBlock(0, 0).inverse();
+	const KFMatrixDyn G_1 = (KFMatrixDyn(Q) + F * W * F.transpose()).inverse();
+	const KFMatrixDyn T = G_1 * F * W;
+	const KFMatrixDyn A_1 = W - W * F.transpose() * T;
+
+	const std::vector<size_t> act(m_info_active.begin(), m_info_active.end());
+	std::vector<KFMatrixDyn> Lxm(act.size());
+	for (size_t k = 0; k < act.size(); k++) Lxm[k] = EIF_getBlock(0, act[k]);
+
+	for (size_t k = 0; k < act.size(); k++)
+	{
+		const KFMatrixDyn LmxA_1 = Lxm[k].transpose() * A_1;
+		for (size_t l = k; l < act.size(); l++)
+			EIF_addToBlock(act[k], act[l], -LmxA_1 * Lxm[l]);
+	}
+	for (size_t k = 0; k < act.size(); k++)
+		EIF_setBlock(0, act[k], T * Lxm[k]);
+	EIF_setBlock(0, 0, G_1);
+}
+
+template <
+	size_t VEH_SIZE, size_t OBS_SIZE, size_t FEAT_SIZE, size_t ACT_SIZE,
+	typename KFTYPE>
+void CKalmanFilterCapable<VEH_SIZE, OBS_SIZE, FEAT_SIZE, ACT_SIZE, KFTYPE>::
+	EIF_sparsify()
+{
+	const int max_active = KF_options.EIF_max_active_landmarks;
+	if (max_active <= 0 || m_info_active.size() <= size_t(max_active)) return;
+
+	// Keep the strongest links to the vehicle (m+), deactivate the rest (m0):
+	std::vector<std::pair<KFTYPE, size_t>> links;
+	for (size_t a : m_info_active)
+		links.emplace_back(EIF_getBlock(0, a).norm(), a);
+	std::sort(
+		links.begin(), links.end(),
+		[](const std::pair<KFTYPE, size_t>& a,
+		   const std::pair<KFTYPE, size_t>& b) { return a.first > b.first; });
+
+	// Nodes involved: I=[x, m+, m0]
+	std::vector<size_t> nodes(1, 0);
+	for (const auto& l : links) nodes.push_back(l.second);
+	std::vector<size_t> offs(nodes.size());
+	size_t dim = 0;
+	for (size_t k = 0; k < nodes.size(); k++)
+	{
+		offs[k] = dim;
+		dim += EIF_nodeDim(nodes[k]);
+	}
+	const size_t dim_m0_start = offs[1 + max_active];
+
+	KFMatrixDyn L0(dim, dim);
+	for (size_t a = 0; a < nodes.size(); a++)
+		for (size_t b = a; b < nodes.size(); b++)
+		{
+			const KFMatrixDyn B = EIF_getBlock(nodes[a], nodes[b]);
+			L0.block(offs[a], offs[b], B.rows(), B.cols()) = B;
+			L0.block(offs[b], offs[a], B.cols(), B.rows()) = B.transpose();
+		}
+
+	// Removes the variables in idxs by marginalization (Schur complement),
+	// keeping the size of the matrix: M - M(:,idxs) M(idxs,idxs)^-1 M(idxs,:)
+	auto marginalizeOut = [](const KFMatrixDyn& M,
+							 const std::vector<size_t>& idxs) {
+		KFMatrixDyn Mc(M.rows(), idxs.size()), Mii(idxs.size(), idxs.size());
+		for (size_t c = 0; c < idxs.size(); c++)
+		{
+			Mc.col(c) = M.col(idxs[c]);
+			for (size_t r = 0; r < idxs.size(); r++)
+				Mii(r, c) = M(idxs[r], idxs[c]);
+		}
+		return KFMatrixDyn(M - Mc * Mii.inverse() * Mc.transpose());
+	};
+	std::vector<size_t> idxs_x, idxs_m0, idxs_x_m0;
+	for (size_t i = 0; i < VEH_SIZE; i++) idxs_x.push_back(i);
+	for (size_t i = dim_m0_start; i < dim; i++) idxs_m0.push_back(i);
+	idxs_x_m0 = idxs_x;
+	idxs_x_m0.insert(idxs_x_m0.end(), idxs_m0.begin(), idxs_m0.end());
+
+	// SEIF sparsification (Thrun et al., IJRR 2004): the approximation
+	// conditions m0 on m+ (not on x), which removes the x-m0 links and
+	// preserves the mean.
+	const KFMatrixDyn Lt = marginalizeOut(L0, idxs_m0) -
+						   marginalizeOut(L0, idxs_x_m0) +
+						   marginalizeOut(L0, idxs_x);
+
+	for (size_t a = 0; a < nodes.size(); a++)
+		for (size_t b = a; b < nodes.size(); b++)
+		{
+			const bool is_removed_link = (a == 0 && b > size_t(max_active));
+			if (is_removed_link)
+				EIF_setBlock(
+					nodes[a], nodes[b],
+					KFMatrixDyn::Zero(
+						EIF_nodeDim(nodes[a]), EIF_nodeDim(nodes[b])));
+			else
+				EIF_setBlock(
+					nodes[a], nodes[b],
+					Lt.block(
+						offs[a], offs[b], EIF_nodeDim(nodes[a]),
+						EIF_nodeDim(nodes[b])));
+		}
+}
+
+template <
+	size_t VEH_SIZE, size_t OBS_SIZE, size_t FEAT_SIZE, size_t ACT_SIZE,
+	typename KFTYPE>
+void CKalmanFilterCapable<VEH_SIZE, OBS_SIZE, FEAT_SIZE, ACT_SIZE, KFTYPE>::
+	EIF_factorize()
+{
+	if (m_info_chol_uptodate) return;
+
+	MRPT_START
+	const size_t n = m_xkk.size();
+	ASSERT_EQUAL_(
+		EIF_nodeOffset(m_info_blocks.size() - 1) +
+			EIF_nodeDim(m_info_blocks.size() - 1),
+		n);
+
+	std::vector<Eigen::Triplet<KFTYPE>> triplets;
+	for (size_t j = 0; j < m_info_blocks.size(); j++)
+		for (const auto& ib : m_info_blocks[j])
+		{
+			const size_t i = ib.first, oi = EIF_nodeOffset(i),
+						 oj = EIF_nodeOffset(j);
+			const KFMatrixDyn& B = ib.second;
+			for (int c = 0; c < B.cols(); c++)
+				for (int r = 0; r < B.rows(); r++)
+				{
+					triplets.emplace_back(oi + r, oj + c, B(r, c));
+					if (i != j) triplets.emplace_back(oj + c, oi + r, B(r, c));
+				}
+		}
+	typename TEIFFactorization::sparse_matrix_t Lambda(n, n);
+	Lambda.setFromTriplets(triplets.begin(), triplets.end());
+
+	// The blocks are always written in the same order, so the matrix keeps
+	// the same structure (even if some entries become zero) as long as no
+	// block is added or removed:
+	if (!m_info_chol)
+	{
+		m_info_chol.resetDefaultCtor();
+		m_info_pattern_uptodate = false;
+	}
+	if (!m_info_pattern_uptodate)
+	{
+		m_info_chol->chol.analyzePattern(Lambda);
+		m_info_pattern_uptodate = true;
+	}
+	m_info_chol->chol.factorize(Lambda);
+	if (m_info_chol->chol.info() != Eigen::Success)
+		THROW_EXCEPTION(
+			"kfEIF: Factorization failed, information matrix is not "
+			"positive definite");
+	m_info_chol_uptodate = true;
+	MRPT_END
+}
+
+template <
+	size_t VEH_SIZE, size_t OBS_SIZE, size_t FEAT_SIZE, size_t ACT_SIZE,
+	typename KFTYPE>
+typename CKalmanFilterCapable<
+	VEH_SIZE, OBS_SIZE, FEAT_SIZE, ACT_SIZE, KFTYPE>::KFMatrix
+	CKalmanFilterCapable<VEH_SIZE, OBS_SIZE, FEAT_SIZE, ACT_SIZE, KFTYPE>::
+		EIF_marginalCovariance(const std::vector<size_t>& nodes) const
+{
+	// Solve Lambda * X = E, with E the columns of the identity for the
+	// requested variables, then keep the rows of those same variables:
+	std::vector<size_t> idxs;
+	for (size_t node : nodes)
+		for (size_t k = 0; k < EIF_nodeDim(node); k++)
+			idxs.push_back(EIF_nodeOffset(node) + k);
+
+	KFMatrixDyn E = KFMatrixDyn::Zero(m_xkk.size(), idxs.size());
+	for (size_t c = 0; c < idxs.size(); c++) E(idxs[c], c) = 1;
+	const KFMatrixDyn X = m_info_chol->chol.solve(E);
+
+	KFMatrix P(idxs.size(), idxs.size());
+	for (size_t r = 0; r < idxs.size(); r++)
+		for (size_t c = 0; c < idxs.size(); c++)
+			P(r, c) = X(idxs[r], c);
+	return P;
+}
+
+template <
+	size_t VEH_SIZE, size_t OBS_SIZE, size_t FEAT_SIZE, size_t ACT_SIZE,
+	typename KFTYPE>
+void CKalmanFilterCapable<VEH_SIZE, OBS_SIZE, FEAT_SIZE, ACT_SIZE, KFTYPE>::
+	EIF_addNewLandmark(const KFMatrix_FxV& dyn_dxv, const KFMatrix_FxF& Ryn)
+{
+	// y = g(x,z) linearized as y ~ dyn_dxv * x + N(0,Ryn):
+	const size_t node = m_info_blocks.size();
+	m_info_blocks.resize(node + 1);
+	m_info_pattern_uptodate = false;
+	m_info_chol_uptodate = false;
+
+	const KFMatrixDyn Ryn_1 = Ryn.inverse();
+	const KFMatrixDyn GtRyn_1 = dyn_dxv.transpose() * Ryn_1;
+	EIF_addToBlock(node, node, Ryn_1);
+	EIF_addToBlock(0, node, -GtRyn_1);
+	EIF_addToBlock(0, 0, GtRyn_1 * KFMatrixDyn(dyn_dxv));
+}
+
 namespace detail
 {
 // generic version for SLAM. There is a speciation below for NON-SLAM problems.
@@ -1307,59 +1747,72 @@ void addNewLandmarks(
 			for (q = 0; q < FEAT_SIZE; q++)
 				obj.internal_getXkk()[idx + q] = yn[q];
 
-			// --------------------
-			// Append to Pkk:
-			// --------------------
-			ASSERTDEB_(
-				obj.internal_getPkk().cols() == (int)idx &&
-				obj.internal_getPkk().rows() == (int)idx);
-
-			obj.internal_getPkk().setSize(idx + FEAT_SIZE, idx + FEAT_SIZE);
-
-			// Fill the Pxyn term:
-			// --------------------
-			typename KF::KFMatrix_VxV Pxx;
-			obj.internal_getPkk().extractMatrix(0, 0, Pxx);
-			typename KF::KFMatrix_FxV Pxyn;  // Pxyn = dyn_dxv * Pxx
-			Pxyn.multiply(dyn_dxv, Pxx);
-
-			obj.internal_getPkk().insertMatrix(idx, 0, Pxyn);
-			obj.internal_getPkk().insertMatrixTranspose(0, idx, Pxyn);
-
-			// Fill the Pyiyn terms:
-			// --------------------
-			const size_t nLMs =
-				(idx - VEH_SIZE) / FEAT_SIZE;  // Number of previous landmarks:
-			for (q = 0; q < nLMs; q++)
+			if (obj.KF_options.method == kfEIF)
 			{
-				typename KF::KFMatrix_VxF P_x_yq(
-					mrpt::math::UNINITIALIZED_MATRIX);
-				obj.internal_getPkk().extractMatrix(
-					0, VEH_SIZE + q * FEAT_SIZE, P_x_yq);
-
-				typename KF::KFMatrix_FxF P_cross(
-					mrpt::math::UNINITIALIZED_MATRIX);
-				P_cross.multiply(dyn_dxv, P_x_yq);
-
-				obj.internal_getPkk().insertMatrix(
-					idx, VEH_SIZE + q * FEAT_SIZE, P_cross);
-				obj.internal_getPkk().insertMatrixTranspose(
-					VEH_SIZE + q * FEAT_SIZE, idx, P_cross);
-			}  // end each previous LM(q)
-
-			// Fill the Pynyn term:
-			//  P_yn_yn =  (dyn_dxv * Pxx * ~dyn_dxv) + (dyn_dhn * R *
-			//  ~dyn_dhn);
-			// --------------------
-			typename KF::KFMatrix_FxF P_yn_yn(mrpt::math::UNINITIALIZED_MATRIX);
-			dyn_dxv.multiply_HCHt(Pxx, P_yn_yn);
-			if (use_dyn_dhn_jacobian)
-				dyn_dhn.multiply_HCHt(
-					R, P_yn_yn, true);  // Accumulate in P_yn_yn
+				// Information form: just add the links of the new landmark
+				typename KF::KFMatrix_FxF Ryn;
+				if (use_dyn_dhn_jacobian)
+					dyn_dhn.multiply_HCHt(R, Ryn);
+				else
+					Ryn = dyn_dhn_R_dyn_dhnT;
+				obj.EIF_addNewLandmark(dyn_dxv, Ryn);
+			}
 			else
-				P_yn_yn += dyn_dhn_R_dyn_dhnT;
-
-			obj.internal_getPkk().insertMatrix(idx, idx, P_yn_yn);
+			{
+				// --------------------
+				// Append to Pkk:
+				// --------------------
+				ASSERTDEB_(
+					obj.internal_getPkk().cols() == (int)idx &&
+					obj.internal_getPkk().rows() == (int)idx);
+
+				obj.internal_getPkk().setSize(idx + FEAT_SIZE, idx + FEAT_SIZE);
+
+				// Fill the Pxyn term:
+				// --------------------
+				typename KF::KFMatrix_VxV Pxx;
+				obj.internal_getPkk().extractMatrix(0, 0, Pxx);
+				typename KF::KFMatrix_FxV Pxyn;  // Pxyn = dyn_dxv * Pxx
+				Pxyn.multiply(dyn_dxv, Pxx);
+
+				obj.internal_getPkk().insertMatrix(idx, 0, Pxyn);
+				obj.internal_getPkk().insertMatrixTranspose(0, idx, Pxyn);
+
+				// Fill the Pyiyn terms:
+				// --------------------
+				const size_t nLMs =
+					(idx - VEH_SIZE) / FEAT_SIZE;  // Number of previous landmarks:
+				for (q = 0; q < nLMs; q++)
+				{
+					typename KF::KFMatrix_VxF P_x_yq(
+						mrpt::math::UNINITIALIZED_MATRIX);
+					obj.internal_getPkk().extractMatrix(
+						0, VEH_SIZE + q * FEAT_SIZE, P_x_yq);
+
+					typename KF::KFMatrix_FxF P_cross(
+						mrpt::math::UNINITIALIZED_MATRIX);
+					P_cross.multiply(dyn_dxv, P_x_yq);
+
+					obj.internal_getPkk().insertMatrix(
+						idx, VEH_SIZE + q * FEAT_SIZE, P_cross);
+					obj.internal_getPkk().insertMatrixTranspose(
+						VEH_SIZE + q * FEAT_SIZE, idx, P_cross);
+				}  // end each previous LM(q)
+
+				// Fill the Pynyn term:
+				//  P_yn_yn =  (dyn_dxv * Pxx * ~dyn_dxv) + (dyn_dhn * R *
+				//  ~dyn_dhn);
+				// --------------------
+				typename KF::KFMatrix_FxF P_yn_yn(mrpt::math::UNINITIALIZED_MATRIX);
+				dyn_dxv.multiply_HCHt(Pxx, P_yn_yn);
+				if (use_dyn_dhn_jacobian)
+					dyn_dhn.multiply_HCHt(
+						R, P_yn_yn, true);  // Accumulate in P_yn_yn
+				else
+					P_yn_yn += dyn_dhn_R_dyn_dhnT;
+
+				obj.internal_getPkk().insertMatrix(idx, idx, P_yn_yn);
+			}
 
 			obj.getProfiler().leave("KF:9.create new LMs");
 		}
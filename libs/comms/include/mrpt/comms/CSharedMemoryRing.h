@@ -0,0 +1,161 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+#pragma once
+
+#include <mrpt/io/CStream.h>
+#include <cstdint>
+#include <functional>
+#include <memory>  // unique_ptr
+#include <string>
+
+namespace mrpt::comms
+{
+namespace internal
+{
+struct SharedMemorySegment;
+}
+
+/** Publishes messages into a named shared-memory ring buffer, to be read by
+ * any number of CSharedMemoryRingReader, in the same or other processes of
+ * the same machine.
+ *
+ * Messages are written directly into the shared segment: serialize objects
+ * with beginMessage() + commitMessage(), e.g.:
+ * \code
+ * mrpt::comms::CSharedMemoryRingWriter shm("mrpt_obs");
+ * mrpt::serialization::archiveFrom(shm.beginMessage()) << obs;
+ * shm.commitMessage();
+ * \endcode
+ *
+ * The writer never waits for readers: readers which fall more than the ring
+ * capacity behind lose messages, which they detect by the sequence number of
+ * each message. There must be only one writer per ring.
+ *
+ * The segment is removed from the system when the writer is destroyed;
+ * readers which have it open can still read pending messages.
+ *
+ * \sa CSharedMemoryRingReader
+ * \ingroup mrpt_comms_grp
+ */
+class CSharedMemoryRingWriter
+{
+   public:
+	/** Creates the shared segment, replacing any existing one with the same
+	 * name.
+	 * \param name Name of the ring, shared with readers.
+	 * \param capacity Size in bytes of the ring buffer.
+	 * \param max_message_size Size limit of each message, in bytes. Values
+	 * of 0 or larger than capacity/4 mean capacity/4.
+	 * \exception std::exception On any error creating the segment.
+	 */
+	CSharedMemoryRingWriter(
+		const std::string& name, size_t capacity = 64 * 1024 * 1024,
+		size_t max_message_size = 0);
+	/** Dtor: unmaps and removes the segment */
+	~CSharedMemoryRingWriter();
+	CSharedMemoryRingWriter(const CSharedMemoryRingWriter&) = delete;
+	CSharedMemoryRingWriter& operator=(const CSharedMemoryRingWriter&) =
+		delete;
+
+	/** Starts a new message and returns a stream which writes it directly in
+	 * the shared segment. Any previous uncommitted message is discarded.
+	 * Writing more than getMaxMessageSize() bytes throws an exception.
+	 * \sa commitMessage */
+	mrpt::io::CStream& beginMessage();
+	/** Makes the message written since beginMessage() visible to readers.
+	 * \return The sequence number of the message. */
+	uint64_t commitMessage();
+	/** Writes and commits a message with the given bytes.
+	 * \return The sequence number of the message. */
+	uint64_t sendMessage(const void* data, size_t len);
+
+	/** The sequence number of the next message (0 for the first one) */
+	uint64_t getNextSequenceNumber() const { return m_next_seq; }
+	size_t getCapacity() const;
+	size_t getMaxMessageSize() const;
+
+   private:
+	std::unique_ptr<internal::SharedMemorySegment> m_shm;
+	/** The stream returned by beginMessage() */
+	std::unique_ptr<mrpt::io::CStream> m_stream;
+	/** Position of the next record (in bytes written since creation) */
+	uint64_t m_pos{0};
+	/** Position of the record being written, or ~0 if none */
+	uint64_t m_msg_pos;
+	uint64_t m_next_seq{0};
+};
+
+/** Reads messages from a CSharedMemoryRingWriter, possibly in another
+ * process, without copying them out of the shared segment.
+ *
+ * Readers don't block the writer: if the writer overwrites a message while
+ * it is being read, readMessage() returns ReadResult::Overwritten and its
+ * contents must be discarded. Lost messages are counted from gaps in the
+ * sequence numbers (see getLostMessages()).
+ *
+ * Example:
+ * \code
+ * mrpt::comms::CSharedMemoryRingReader shm("mrpt_obs");
+ * mrpt::serialization::CSerializable::Ptr obj;
+ * auto res = shm.readMessageStream([&](mrpt::io::CStream& s, uint64_t) {
+ *   obj = mrpt::serialization::archiveFrom(s).ReadObject();
+ * });
+ * if (res == mrpt::comms::CSharedMemoryRingReader::ReadResult::Ok) {...}
+ * \endcode
+ *
+ * \sa CSharedMemoryRingWriter
+ * \ingroup mrpt_comms_grp
+ */
+class CSharedMemoryRingReader
+{
+   public:
+	/** Opens an existing ring. Only messages committed after this call will
+	 * be read.
+	 * \exception std::exception If the ring does not exist.
+	 */
+	CSharedMemoryRingReader(const std::string& name);
+	~CSharedMemoryRingReader();
+	CSharedMemoryRingReader(const CSharedMemoryRingReader&) = delete;
+	CSharedMemoryRingReader& operator=(const CSharedMemoryRingReader&) =
+		delete;
+
+	enum class ReadResult : uint8_t
+	{
+		/** No new message (the function was not called) */
+		NoData = 0,
+		/** The function was called with a valid message */
+		Ok,
+		/** The message was overwritten by the writer while being read: discard
+		 * anything produced by the function */
+		Overwritten
+	};
+
+	/** Calls \a f with a pointer to the next message in the shared segment,
+	 * its length and its sequence number. The pointer is only valid during
+	 * the call. */
+	ReadResult readMessage(
+		const std::function<void(const uint8_t*, size_t, uint64_t)>& f);
+	/** Like readMessage(), but passing a stream which reads directly from the
+	 * shared segment, e.g. to deserialize objects. */
+	ReadResult readMessageStream(
+		const std::function<void(mrpt::io::CStream&, uint64_t)>& f);
+
+	/** Number of messages not read since this reader was created, due to
+	 * the writer overwriting them */
+	uint64_t getLostMessages() const { return m_lost; }
+
+   private:
+	std::unique_ptr<internal::SharedMemorySegment> m_shm;
+	/** Position of the next record to read */
+	uint64_t m_pos{0};
+	uint64_t m_expected_seq{0};
+	uint64_t m_lost{0};
+};
+
+}  // namespace mrpt::comms
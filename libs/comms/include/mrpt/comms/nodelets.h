@@ -11,10 +11,17 @@
 #include <memory>  // shared_ptr
 #include <unordered_map>
 #include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <vector>
 #include <list>
 #include <any>
 #include <iostream>
 #include <functional>
+#include <typeinfo>
+#include <mrpt/core/exceptions.h>
 #include <mrpt/typemeta/TTypeName.h>
 #include <mrpt/typemeta/TTypeName_stl.h>
 
@@ -104,6 +111,326 @@ class Topic : public std::enable_shared_from_this<Topic>
 	std::function<void()> m_cleanup;
 };
 
+/** A fixed-size pool of threads running posted tasks in FIFO order. Used to
+ * run the callbacks of TypedTopic subscribers. */
+class Executor
+{
+   public:
+	using Ptr = std::shared_ptr<Executor>;
+
+	/** Creates a pool of \a num_threads threads (0: one per hardware thread)
+	 */
+	static Ptr create(unsigned int num_threads = 0);
+	/** The shared executor used by subscribers which do not specify one,
+	 * created on first use */
+	static Ptr getDefault();
+
+	/** Waits for the running tasks and discards the pending ones */
+	~Executor();
+
+	/** Enqueues a task, to be run by one of the threads */
+	void post(std::function<void()>&& task);
+	unsigned int getNumThreads() const;
+
+	struct Impl;
+
+   private:
+	Executor(unsigned int num_threads);
+	std::shared_ptr<Impl> m_impl;
+};
+
+/** Policy of a queued subscriber of a TypedTopic when a new message arrives
+ * and its queue is full */
+enum class DropPolicy : uint8_t
+{
+	/** Discard the oldest queued message (typical for sensor data: process
+	 * the most recent one) */
+	DropOldest = 0,
+	/** Discard the new message */
+	DropNewest,
+	/** Block publish() until there is room in the queue */
+	Block
+};
+
+/** Options for TypedTopic::createSubscriber() */
+struct TSubscriberOptions
+{
+	/** Max. number of messages waiting for the subscriber. 0 means no queue:
+	 * the callback is invoked from the thread calling publish(), like in
+	 * Topic. */
+	size_t queue_length{10};
+	DropPolicy drop_policy{DropPolicy::DropOldest};
+	/** Where the callback runs (nullptr: Executor::getDefault()). Messages
+	 * to one subscriber are always delivered one at a time, in order. */
+	Executor::Ptr executor;
+};
+
+/** Statistics of a TypedTopic, see TypedTopic::getStats() */
+struct TTopicStats
+{
+	/** Number of calls to publish() */
+	uint64_t published{0};
+	/** Number of subscriber callbacks invoked */
+	uint64_t delivered{0};
+	/** Number of messages discarded due to full subscriber queues */
+	uint64_t dropped{0};
+	/** Time from publish() to the start of the callbacks (seconds) */
+	double latency_mean{0}, latency_max{0};
+	/** Current number of subscribers */
+	size_t subscribers{0};
+};
+
+namespace internal
+{
+using nodelets_clock = std::chrono::steady_clock;
+
+/** Lock-free accumulators behind TTopicStats */
+struct TopicStatsAccum
+{
+	std::atomic<uint64_t> published{0}, delivered{0}, dropped{0};
+	std::atomic<uint64_t> latency_sum_ns{0}, latency_max_ns{0};
+
+	void addDelivery(const nodelets_clock::time_point& t_pub)
+	{
+		const uint64_t ns =
+			std::chrono::duration_cast<std::chrono::nanoseconds>(
+				nodelets_clock::now() - t_pub)
+				.count();
+		delivered++;
+		latency_sum_ns += ns;
+		uint64_t prev = latency_max_ns.load();
+		while (prev < ns && !latency_max_ns.compare_exchange_weak(prev, ns))
+		{
+		}
+	}
+};
+
+/** The state of one subscriber of a TypedTopic<T>, shared with the tasks
+ * posted to its executor */
+template <typename T>
+struct TypedSubscriberState
+{
+	using msg_ptr_t = std::shared_ptr<const T>;
+	using Ptr = std::shared_ptr<TypedSubscriberState<T>>;
+
+	std::function<void(const msg_ptr_t&)> func;
+	TSubscriberOptions opts;
+	std::shared_ptr<TopicStatsAccum> stats;
+
+	std::mutex mtx;
+	std::condition_variable cv;
+	std::deque<std::pair<msg_ptr_t, nodelets_clock::time_point>> queue;
+	/** A drain() task is posted or running */
+	bool scheduled{false};
+	/** The subscriber was destroyed */
+	bool closed{false};
+
+	void invoke(const msg_ptr_t& msg, const nodelets_clock::time_point& t)
+	{
+		stats->addDelivery(t);
+		try
+		{
+			func(msg);
+		}
+		catch (std::exception& e)
+		{
+			std::cerr << "[TypedTopic] Exception in subscriber: " << e.what()
+					  << std::endl;
+		}
+	}
+
+	static void deliver(
+		const Ptr& self, const msg_ptr_t& msg,
+		const nodelets_clock::time_point& t)
+	{
+		if (self->opts.queue_length == 0)
+		{
+			self->invoke(msg, t);
+			return;
+		}
+		std::unique_lock<std::mutex> lck(self->mtx);
+		if (self->closed) return;
+		if (self->queue.size() >= self->opts.queue_length)
+		{
+			switch (self->opts.drop_policy)
+			{
+				case DropPolicy::DropOldest:
+					self->queue.pop_front();
+					self->stats->dropped++;
+					break;
+				case DropPolicy::DropNewest:
+					self->stats->dropped++;
+					return;
+				case DropPolicy::Block:
+					self->cv.wait(lck, [&]() {
+						return self->closed ||
+							   self->queue.size() < self->opts.queue_length;
+					});
+					if (self->closed) return;
+					break;
+			};
+		}
+		self->queue.emplace_back(msg, t);
+		if (!self->scheduled)
+		{
+			self->scheduled = true;
+			lck.unlock();
+			self->opts.executor->post([self]() { drain(self); });
+		}
+	}
+
+	/** Runs in the executor: delivers all queued messages */
+	static void drain(const Ptr& self)
+	{
+		for (;;)
+		{
+			std::pair<msg_ptr_t, nodelets_clock::time_point> m;
+			{
+				std::lock_guard<std::mutex> lck(self->mtx);
+				if (self->closed || self->queue.empty())
+				{
+					self->scheduled = false;
+					return;
+				}
+				m = std::move(self->queue.front());
+				self->queue.pop_front();
+			}
+			self->cv.notify_all();
+			self->invoke(m.first, m.second);
+		}
+	}
+
+	void close()
+	{
+		{
+			std::lock_guard<std::mutex> lck(mtx);
+			closed = true;
+			queue.clear();
+		}
+		cv.notify_all();
+	}
+};
+}  // namespace internal
+
+/** Base class of all TypedTopic<T>, used by TopicDirectory */
+class TypedTopicBase
+{
+   public:
+	virtual ~TypedTopicBase();
+	virtual TTopicStats getStats() const = 0;
+};
+
+/** A topic whose messages are of type T, passed to subscribers as
+ * `std::shared_ptr<const T>`: a published message is never copied, and all
+ * subscribers share it.
+ *
+ * Unlike Topic, each subscriber has, by default, its own bounded queue and
+ * its callback runs in an Executor, so slow subscribers never stall the
+ * publisher (see TSubscriberOptions and DropPolicy).
+ *
+ * Get instances with TopicDirectory::getTypedTopic().
+ */
+template <typename T>
+class TypedTopic : public TypedTopicBase,
+				   public std::enable_shared_from_this<TypedTopic<T>>
+{
+   private:
+	TypedTopic(std::function<void()>&& cleanup)
+		: m_subs(std::make_shared<const subs_list_t>()),
+		  m_stats(std::make_shared<internal::TopicStatsAccum>()),
+		  m_cleanup(std::move(cleanup))
+	{
+	}
+
+   public:
+	using Ptr = std::shared_ptr<TypedTopic<T>>;
+	using msg_ptr_t = std::shared_ptr<const T>;
+	using callback_t = std::function<void(const msg_ptr_t&)>;
+
+	~TypedTopic() override { m_cleanup(); }
+
+	/** Sends \a msg to all subscribers. Only blocks for subscribers with
+	 * zero-length queues or DropPolicy::Block. */
+	void publish(const msg_ptr_t& msg)
+	{
+		const auto t = internal::nodelets_clock::now();
+		m_stats->published++;
+		std::shared_ptr<const subs_list_t> subs;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			subs = m_subs;
+		}
+		for (const auto& s : *subs) state_t::deliver(s, msg, t);
+	}
+
+	/** Creates a subscriber, which remains active while the returned object
+	 * is alive. Callbacks already running when it is destroyed finish
+	 * normally. */
+	Subscriber::Ptr createSubscriber(
+		callback_t func, const TSubscriberOptions& opts = TSubscriberOptions())
+	{
+		auto st = std::make_shared<state_t>();
+		st->func = std::move(func);
+		st->opts = opts;
+		if (!st->opts.executor) st->opts.executor = Executor::getDefault();
+		st->stats = m_stats;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto newList = std::make_shared<subs_list_t>(*m_subs);
+			newList->push_back(st);
+			m_subs = newList;
+		}
+		auto capturedShared = this->shared_from_this();
+		return Subscriber::create(
+			[](const std::any&) {},
+			// cleanup function
+			[capturedShared, st] {
+				st->close();
+				capturedShared->removeSubscriber(st.get());
+			});
+	}
+
+	TTopicStats getStats() const override
+	{
+		TTopicStats s;
+		s.published = m_stats->published;
+		s.delivered = m_stats->delivered;
+		s.dropped = m_stats->dropped;
+		if (s.delivered)
+			s.latency_mean = 1e-9 * m_stats->latency_sum_ns / s.delivered;
+		s.latency_max = 1e-9 * m_stats->latency_max_ns;
+		std::lock_guard<std::mutex> lock(m_mutex);
+		s.subscribers = m_subs->size();
+		return s;
+	}
+
+	template <typename CLEANUP>
+	static Ptr create(CLEANUP&& cleanup)
+	{
+		return Ptr(new TypedTopic<T>(std::forward<CLEANUP>(cleanup)));
+	}
+
+   private:
+	using state_t = internal::TypedSubscriberState<T>;
+	using subs_list_t = std::vector<typename state_t::Ptr>;
+
+	void removeSubscriber(const state_t* st)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto newList = std::make_shared<subs_list_t>();
+		for (const auto& s : *m_subs)
+			if (s.get() != st) newList->push_back(s);
+		m_subs = newList;
+	}
+
+	mutable std::mutex m_mutex;
+	/** Copy-on-write list of subscribers, so publish() only holds m_mutex to
+	 * copy a pointer */
+	std::shared_ptr<const subs_list_t> m_subs;
+	std::shared_ptr<internal::TopicStatsAccum> m_stats;
+	std::function<void()> m_cleanup;
+};
+
 /** The central directory of existing topics for pub/sub */
 class TopicDirectory : public std::enable_shared_from_this<TopicDirectory>
 {
@@ -131,12 +458,44 @@ class TopicDirectory : public std::enable_shared_from_this<TopicDirectory>
 		return newNode;
 	}
 
+	/** Gets or creates the TypedTopic with the given name.
+	 * \exception std::exception If the topic exists with a different type.
+	 */
+	template <typename T>
+	typename TypedTopic<T>::Ptr getTypedTopic(const std::string& path)
+	{
+		// Declared out of the lock scope: if this becomes the last reference
+		// to the topic, ~TypedTopic() locks m_mutex in cleanupTypedTopic().
+		std::shared_ptr<TypedTopicBase> existing;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto it = m_mapTyped.find(path);
+			if (it != m_mapTyped.end()) existing = it->second.lock();
+			if (!existing)
+			{
+				auto capturedShared = shared_from_this();
+				auto newNode = TypedTopic<T>::create(
+					[=]() { capturedShared->cleanupTypedTopic(path); });
+				m_mapTyped[path] = newNode;
+				return newNode;
+			}
+			auto typed = std::dynamic_pointer_cast<TypedTopic<T>>(existing);
+			if (typed) return typed;
+		}
+		existing.reset();
+		THROW_EXCEPTION_FMT(
+			"Topic '%s' exists with another type than '%s'", path.c_str(),
+			typeid(T).name());
+	}
+
 	void cleanupTopic(const std::string& key);
+	void cleanupTypedTopic(const std::string& key);
 	static Ptr create();
 
    private:
 	std::mutex m_mutex;
 	std::unordered_map<std::string, std::weak_ptr<Topic>> m_mapService;
+	std::unordered_map<std::string, std::weak_ptr<TypedTopicBase>> m_mapTyped;
 };
 
 /** @} */  // end grouping
@@ -0,0 +1,391 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include "comms-precomp.h"  // Precompiled headers
+
+#include <mrpt/comms/CSharedMemoryRing.h>
+#include <mrpt/io/CMemoryStream.h>
+#include <mrpt/core/exceptions.h>
+
+#include <atomic>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace mrpt::comms;
+
+namespace
+{
+/** "MRPTSHM1" */
+constexpr uint64_t SHM_MAGIC = 0x314d48535450524dULL;
+
+/** At the beginning of the segment, followed by the ring buffer */
+struct ShmHeader
+{
+	/** Set by the writer once all other fields are initialized */
+	std::atomic<uint64_t> magic;
+	/** Size of the ring buffer, in bytes */
+	uint64_t capacity;
+	/** Max size of one record, including its RecordHeader */
+	uint64_t max_record;
+	/** End of the last committed record (bytes written since creation) */
+	alignas(64) std::atomic<uint64_t> write_pos;
+	/** Sequence number of the next message */
+	std::atomic<uint64_t> next_seq;
+	/** The writer may be modifying ring bytes up to this position: bytes at
+	 * positions < reserve_pos - capacity are no longer valid */
+	alignas(64) std::atomic<uint64_t> reserve_pos;
+};
+static_assert(
+	std::atomic<uint64_t>::is_always_lock_free,
+	"Shared-memory atomics must be lock-free");
+constexpr size_t DATA_OFFSET = (sizeof(ShmHeader) + 63) / 64 * 64;
+
+/** Before each message in the ring. Records start at multiples of 16 */
+struct RecordHeader
+{
+	uint64_t seq;
+	/** Length of the message, or PAD_FLAG|length for padding until the end
+	 * of the ring */
+	uint64_t len;
+};
+constexpr uint64_t PAD_FLAG = 1ULL << 63;
+constexpr size_t REC_ALIGN = 16;
+static_assert(sizeof(RecordHeader) == REC_ALIGN, "Unexpected size");
+
+inline uint64_t alignRecord(uint64_t n)
+{
+	return (n + REC_ALIGN - 1) / REC_ALIGN * REC_ALIGN;
+}
+
+/** A stream writing into a fixed-size memory block */
+class CFixedBufferWriteStream : public mrpt::io::CStream
+{
+   public:
+	uint8_t* m_buf{nullptr};
+	size_t m_max{0}, m_len{0};
+
+	size_t Read(void*, size_t) override
+	{
+		THROW_EXCEPTION("Trying to read from an output stream.");
+	}
+	size_t Write(const void* Buffer, size_t Count) override
+	{
+		if (m_len + Count > m_max)
+			THROW_EXCEPTION_FMT(
+				"Message exceeds the max_message_size of the shared-memory "
+				"ring (%u bytes)",
+				static_cast<unsigned int>(m_max));
+		std::memcpy(m_buf + m_len, Buffer, Count);
+		m_len += Count;
+		return Count;
+	}
+	uint64_t Seek(int64_t, CStream::TSeekOrigin) override
+	{
+		THROW_EXCEPTION("Method not available in this class.");
+	}
+	uint64_t getTotalBytesCount() const override { return m_len; }
+	uint64_t getPosition() const override { return m_len; }
+};
+}  // namespace
+
+namespace mrpt::comms::internal
+{
+/** A mapped shared-memory segment */
+struct SharedMemorySegment
+{
+	std::string name;
+	uint8_t* base{nullptr};
+	size_t size{0};
+	/** Created by us (vs. opened) */
+	bool owner{false};
+#ifdef _WIN32
+	HANDLE hMap{nullptr};
+#endif
+
+	SharedMemorySegment(const std::string& segName, size_t createSize)
+		: owner(createSize != 0)
+	{
+#ifdef _WIN32
+		name = segName;
+		if (owner)
+		{
+			hMap = CreateFileMappingA(
+				INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+				static_cast<DWORD>(uint64_t(createSize) >> 32),
+				static_cast<DWORD>(createSize & 0xFFFFFFFF), name.c_str());
+			if (hMap)
+				base = static_cast<uint8_t*>(
+					MapViewOfFile(hMap, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+			size = createSize;
+		}
+		else
+		{
+			hMap = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+			if (hMap)
+				base = static_cast<uint8_t*>(
+					MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0));
+			MEMORY_BASIC_INFORMATION mbi;
+			if (base && VirtualQuery(base, &mbi, sizeof(mbi)))
+				size = mbi.RegionSize;
+		}
+		if (!base)
+		{
+			if (hMap) CloseHandle(hMap);
+			THROW_EXCEPTION_FMT(
+				"Error mapping shared memory '%s' (error code: %u)",
+				name.c_str(), static_cast<unsigned int>(GetLastError()));
+		}
+#else
+		// POSIX names must start with a single slash:
+		name = (!segName.empty() && segName[0] == '/') ? segName
+														: "/" + segName;
+		int fd;
+		if (owner)
+		{
+			shm_unlink(name.c_str());  // Remove any stale ring
+			fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+			if (fd >= 0 && ftruncate(fd, createSize) != 0)
+			{
+				::close(fd);
+				shm_unlink(name.c_str());
+				fd = -1;
+			}
+			size = createSize;
+		}
+		else
+		{
+			fd = shm_open(name.c_str(), O_RDONLY, 0);
+			struct stat st;
+			if (fd >= 0 && fstat(fd, &st) == 0) size = st.st_size;
+		}
+		if (fd < 0 || size == 0)
+		{
+			const int err = errno;
+			if (fd >= 0) ::close(fd);
+			THROW_EXCEPTION_FMT(
+				"Error opening shared memory '%s': %s", name.c_str(),
+				strerror(err));
+		}
+		void* p = mmap(
+			nullptr, size, owner ? (PROT_READ | PROT_WRITE) : PROT_READ,
+			MAP_SHARED, fd, 0);
+		const int err = errno;
+		::close(fd);
+		if (p == MAP_FAILED)
+		{
+			if (owner) shm_unlink(name.c_str());
+			THROW_EXCEPTION_FMT(
+				"Error mapping shared memory '%s': %s", name.c_str(),
+				strerror(err));
+		}
+		base = static_cast<uint8_t*>(p);
+#endif
+	}
+
+	~SharedMemorySegment()
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(base);
+		CloseHandle(hMap);
+#else
+		munmap(base, size);
+		if (owner) shm_unlink(name.c_str());
+#endif
+	}
+
+	ShmHeader& header() { return *reinterpret_cast<ShmHeader*>(base); }
+	uint8_t* data() { return base + DATA_OFFSET; }
+};
+}  // namespace mrpt::comms::internal
+
+// ------- CSharedMemoryRingWriter --------------
+CSharedMemoryRingWriter::CSharedMemoryRingWriter(
+	const std::string& name, size_t capacity, size_t max_message_size)
+	: m_stream(std::make_unique<CFixedBufferWriteStream>()), m_msg_pos(~0ULL)
+{
+	MRPT_START
+	capacity = alignRecord(std::max<size_t>(capacity, 4 * REC_ALIGN));
+	if (max_message_size == 0) max_message_size = capacity / 4;
+	// So readers one message behind the writer never get overwritten:
+	max_message_size = std::min(max_message_size, capacity / 4);
+
+	m_shm = std::make_unique<internal::SharedMemorySegment>(
+		name, DATA_OFFSET + capacity);
+
+	auto* h = new (m_shm->base) ShmHeader;
+	h->capacity = capacity;
+	h->max_record = sizeof(RecordHeader) + alignRecord(max_message_size);
+	h->write_pos.store(0, std::memory_order_relaxed);
+	h->next_seq.store(0, std::memory_order_relaxed);
+	h->reserve_pos.store(0, std::memory_order_relaxed);
+	h->magic.store(SHM_MAGIC, std::memory_order_release);
+	MRPT_END
+}
+
+CSharedMemoryRingWriter::~CSharedMemoryRingWriter() = default;
+
+size_t CSharedMemoryRingWriter::getCapacity() const
+{
+	return m_shm->header().capacity;
+}
+size_t CSharedMemoryRingWriter::getMaxMessageSize() const
+{
+	return m_shm->header().max_record - sizeof(RecordHeader);
+}
+
+mrpt::io::CStream& CSharedMemoryRingWriter::beginMessage()
+{
+	auto& h = m_shm->header();
+	const uint64_t cap = h.capacity;
+	uint64_t off = m_pos % cap;
+	// Each message must be contiguous: skip the end of the ring if needed.
+	const uint64_t pad = (cap - off < h.max_record) ? cap - off : 0;
+
+	// Tell readers which old bytes are about to be overwritten, before
+	// touching them:
+	h.reserve_pos.store(m_pos + pad + h.max_record, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	if (pad)
+	{
+		RecordHeader rh{0, PAD_FLAG | (pad - sizeof(RecordHeader))};
+		std::memcpy(m_shm->data() + off, &rh, sizeof(rh));
+		m_pos += pad;
+		off = 0;
+	}
+	m_msg_pos = m_pos;
+
+	auto& s = static_cast<CFixedBufferWriteStream&>(*m_stream);
+	s.m_buf = m_shm->data() + off + sizeof(RecordHeader);
+	s.m_max = h.max_record - sizeof(RecordHeader);
+	s.m_len = 0;
+	return s;
+}
+
+uint64_t CSharedMemoryRingWriter::commitMessage()
+{
+	if (m_msg_pos == ~0ULL)
+		THROW_EXCEPTION("commitMessage() called without beginMessage()");
+	auto& h = m_shm->header();
+	const auto& s = static_cast<CFixedBufferWriteStream&>(*m_stream);
+
+	const RecordHeader rh{m_next_seq, s.m_len};
+	std::memcpy(m_shm->data() + m_msg_pos % h.capacity, &rh, sizeof(rh));
+	m_pos = m_msg_pos + sizeof(RecordHeader) + alignRecord(s.m_len);
+	m_msg_pos = ~0ULL;
+	h.next_seq.store(m_next_seq + 1, std::memory_order_relaxed);
+	h.write_pos.store(m_pos, std::memory_order_release);
+	return m_next_seq++;
+}
+
+uint64_t CSharedMemoryRingWriter::sendMessage(const void* data, size_t len)
+{
+	beginMessage().Write(data, len);
+	return commitMessage();
+}
+
+// ------- CSharedMemoryRingReader --------------
+CSharedMemoryRingReader::CSharedMemoryRingReader(const std::string& name)
+{
+	MRPT_START
+	m_shm = std::make_unique<internal::SharedMemorySegment>(name, 0);
+	auto& h = m_shm->header();
+	if (m_shm->size < DATA_OFFSET ||
+		h.magic.load(std::memory_order_acquire) != SHM_MAGIC ||
+		m_shm->size < DATA_OFFSET + h.capacity)
+		THROW_EXCEPTION_FMT(
+			"Shared memory '%s' is not a valid ring", name.c_str());
+	m_pos = h.write_pos.load(std::memory_order_acquire);
+	m_expected_seq = h.next_seq.load(std::memory_order_relaxed);
+	MRPT_END
+}
+
+CSharedMemoryRingReader::~CSharedMemoryRingReader() = default;
+
+CSharedMemoryRingReader::ReadResult CSharedMemoryRingReader::readMessage(
+	const std::function<void(const uint8_t*, size_t, uint64_t)>& f)
+{
+	auto& h = m_shm->header();
+	const uint64_t cap = h.capacity;
+	const uint8_t* data = m_shm->data();
+
+	// True if the writer may have overwritten anything from m_pos on. Call
+	// after reading from the ring.
+	auto overwritten = [&]() {
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (h.reserve_pos.load(std::memory_order_relaxed) <= m_pos + cap)
+			return false;
+		// Jump to the newest data. Lost messages will be detected from the
+		// next sequence number.
+		m_pos = h.write_pos.load(std::memory_order_acquire);
+		return true;
+	};
+
+	for (;;)
+	{
+		const uint64_t w = h.write_pos.load(std::memory_order_acquire);
+		if (m_pos == w) return ReadResult::NoData;
+
+		const uint64_t off = m_pos % cap;
+		RecordHeader rh;
+		std::memcpy(&rh, data + off, sizeof(rh));
+		if (overwritten()) return ReadResult::Overwritten;
+
+		if (rh.len & PAD_FLAG)
+		{
+			m_pos += cap - off;
+			continue;
+		}
+		ASSERTMSG_(
+			off + sizeof(rh) + rh.len <= cap, "Corrupted shared-memory ring");
+
+		auto advance = [&]() {
+			if (rh.seq > m_expected_seq) m_lost += rh.seq - m_expected_seq;
+			m_expected_seq = rh.seq + 1;
+			m_pos += sizeof(rh) + alignRecord(rh.len);
+		};
+		try
+		{
+			f(data + off + sizeof(rh), rh.len, rh.seq);
+		}
+		catch (...)
+		{
+			// Probably due to parsing data being overwritten:
+			if (overwritten()) return ReadResult::Overwritten;
+			advance();  // Don't get stuck in an invalid message
+			throw;
+		}
+		if (overwritten()) return ReadResult::Overwritten;
+		advance();
+		return ReadResult::Ok;
+	}
+}
+
+CSharedMemoryRingReader::ReadResult CSharedMemoryRingReader::readMessageStream(
+	const std::function<void(mrpt::io::CStream&, uint64_t)>& f)
+{
+	return readMessage([&](const uint8_t* d, size_t len, uint64_t seq) {
+		mrpt::io::CMemoryStream s;
+		s.assignMemoryNotOwn(d, len);
+		f(s, seq);
+	});
+}
@@ -0,0 +1,150 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include <mrpt/comms/CSharedMemoryRing.h>
+#include <mrpt/poses/CPose3D.h>
+#include <mrpt/serialization/CArchive.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace mrpt::comms;
+using ReadResult = CSharedMemoryRingReader::ReadResult;
+
+// A ring name unique to this test run:
+static std::string ringName(const char* test)
+{
+	static const auto id = std::random_device()();
+	return std::string("mrpt_unittest_") + test + "_" + std::to_string(id);
+}
+
+static std::vector<uint8_t> message(size_t len, uint8_t seed)
+{
+	std::vector<uint8_t> m(len);
+	for (size_t i = 0; i < len; i++) m[i] = static_cast<uint8_t>(seed + i);
+	return m;
+}
+
+TEST(CSharedMemoryRing, sendReceiveWithWrapAround)
+{
+	CSharedMemoryRingWriter wr(ringName("wrap"), 4096);
+	EXPECT_EQ(wr.getMaxMessageSize(), 1024U);
+	CSharedMemoryRingReader rd(ringName("wrap"));
+
+	const auto noop = [](const uint8_t*, size_t, uint64_t) {};
+	EXPECT_EQ(rd.readMessage(noop), ReadResult::NoData);
+
+	// Many times the ring capacity, with all kinds of sizes:
+	for (size_t i = 0; i < 500; i++)
+	{
+		const auto m = message((i * 37) % 1025, uint8_t(i));
+		EXPECT_EQ(wr.sendMessage(m.data(), m.size()), i);
+		const auto res = rd.readMessage(
+			[&](const uint8_t* d, size_t len, uint64_t seq) {
+				EXPECT_EQ(seq, i);
+				ASSERT_EQ(len, m.size());
+				EXPECT_TRUE(std::equal(m.begin(), m.end(), d));
+			});
+		EXPECT_EQ(res, ReadResult::Ok);
+	}
+	EXPECT_EQ(rd.readMessage(noop), ReadResult::NoData);
+	EXPECT_EQ(rd.getLostMessages(), 0U);
+
+	// Too large:
+	const auto big = message(1025, 0);
+	EXPECT_THROW(wr.sendMessage(big.data(), big.size()), std::exception);
+	EXPECT_EQ(rd.readMessage(noop), ReadResult::NoData);
+}
+
+TEST(CSharedMemoryRing, slowReaderLosesMessages)
+{
+	CSharedMemoryRingWriter wr(ringName("slow"), 4096);
+	CSharedMemoryRingReader rd(ringName("slow"));
+
+	const auto m = message(200, 1);
+	for (int i = 0; i < 100; i++) wr.sendMessage(m.data(), m.size());
+
+	size_t nCalls = 0;
+	const auto count = [&](const uint8_t*, size_t, uint64_t) { nCalls++; };
+	EXPECT_EQ(rd.readMessage(count), ReadResult::Overwritten);
+	EXPECT_EQ(rd.readMessage(count), ReadResult::NoData);
+	EXPECT_EQ(nCalls, 0U);
+
+	wr.sendMessage(m.data(), m.size());
+	EXPECT_EQ(rd.readMessage(count), ReadResult::Ok);
+	EXPECT_EQ(rd.getLostMessages(), 100U);
+}
+
+TEST(CSharedMemoryRing, serializeObjects)
+{
+	CSharedMemoryRingWriter wr(ringName("obj"), 1 << 16);
+	CSharedMemoryRingReader rd(ringName("obj"));
+
+	const mrpt::poses::CPose3D p(1.0, 2.0, 3.0, 0.1, 0.2, 0.3);
+	mrpt::serialization::archiveFrom(wr.beginMessage()) << p;
+	wr.commitMessage();
+
+	mrpt::serialization::CSerializable::Ptr obj;
+	const auto res = rd.readMessageStream([&](mrpt::io::CStream& s, uint64_t) {
+		obj = mrpt::serialization::archiveFrom(s).ReadObject();
+	});
+	EXPECT_EQ(res, ReadResult::Ok);
+	auto p_rx = std::dynamic_pointer_cast<mrpt::poses::CPose3D>(obj);
+	ASSERT_TRUE(p_rx);
+	EXPECT_EQ(*p_rx, p);
+}
+
+TEST(CSharedMemoryRing, concurrentWriter)
+{
+	CSharedMemoryRingWriter wr(ringName("mt"), 8192);
+	CSharedMemoryRingReader rd(ringName("mt"));
+
+	const size_t N = 20000;
+	std::atomic_bool done{false};
+	std::thread writer([&]() {
+		for (size_t i = 0; i < N; i++)
+		{
+			const auto m = message(64 + i % 500, uint8_t(i));
+			wr.sendMessage(m.data(), m.size());
+			if (i % 8 == 0) std::this_thread::yield();
+		}
+		done = true;
+	});
+	// Whatever is not lost must arrive intact and in order:
+	size_t nOk = 0, nBad = 0;
+	uint64_t last_seq = 0;
+	for (bool finished = false; !finished;)
+	{
+		finished = done;
+		std::vector<uint8_t> rx;
+		uint64_t rx_seq = 0;
+		const auto res =
+			rd.readMessage([&](const uint8_t* d, size_t len, uint64_t seq) {
+				rx.assign(d, d + len);
+				rx_seq = seq;
+			});
+		if (res == ReadResult::NoData) std::this_thread::yield();
+		if (res != ReadResult::Ok) continue;
+		if (nOk) EXPECT_GT(rx_seq, last_seq);
+		last_seq = rx_seq;
+		if (rx != message(64 + rx_seq % 500, uint8_t(rx_seq))) nBad++;
+		nOk++;
+	}
+	writer.join();
+	EXPECT_EQ(nBad, 0U);
+	EXPECT_GT(nOk, 0U);
+	EXPECT_LE(nOk + rd.getLostMessages(), N);
+}
+
+TEST(CSharedMemoryRing, missingRing)
+{
+	EXPECT_THROW(CSharedMemoryRingReader rd(ringName("none")), std::exception);
+}
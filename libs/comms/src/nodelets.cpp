@@ -10,6 +10,8 @@
 #include "comms-precomp.h"  // Precompiled headers
 
 #include <mrpt/comms/nodelets.h>
+#include <algorithm>
+#include <thread>
 
 using namespace mrpt::comms;
 
@@ -61,3 +63,93 @@ void TopicDirectory::cleanupTopic(const std::string& key)
 }
 
 TopicDirectory::Ptr TopicDirectory::create() { return Ptr(new TopicDirectory); }
+
+void TopicDirectory::cleanupTypedTopic(const std::string& key)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	// It might have been already replaced by a new topic with the same name:
+	auto it = m_mapTyped.find(key);
+	if (it != m_mapTyped.end() && it->second.expired()) m_mapTyped.erase(it);
+}
+
+// -------------- TypedTopic ---------------------
+TypedTopicBase::~TypedTopicBase() = default;
+
+// -------------- Executor ---------------------
+struct Executor::Impl
+{
+	std::mutex mtx;
+	std::condition_variable cv;
+	std::deque<std::function<void()>> tasks;
+	bool quit{false};
+	std::vector<std::thread> threads;
+
+	static void run(std::shared_ptr<Impl> self)
+	{
+		for (;;)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lck(self->mtx);
+				self->cv.wait(
+					lck, [&]() { return self->quit || !self->tasks.empty(); });
+				if (self->quit) return;
+				task = std::move(self->tasks.front());
+				self->tasks.pop_front();
+			}
+			task();
+		}
+	}
+};
+
+Executor::Executor(unsigned int num_threads) : m_impl(std::make_shared<Impl>())
+{
+	if (num_threads == 0)
+		num_threads = std::max(1U, std::thread::hardware_concurrency());
+	for (unsigned int i = 0; i < num_threads; i++)
+		m_impl->threads.emplace_back(&Impl::run, m_impl);
+}
+
+Executor::~Executor()
+{
+	{
+		std::lock_guard<std::mutex> lck(m_impl->mtx);
+		m_impl->quit = true;
+		m_impl->tasks.clear();
+	}
+	m_impl->cv.notify_all();
+	for (auto& t : m_impl->threads)
+	{
+		// The last reference may be released by a task in this executor:
+		if (t.get_id() == std::this_thread::get_id())
+			t.detach();
+		else
+			t.join();
+	}
+}
+
+Executor::Ptr Executor::create(unsigned int num_threads)
+{
+	return Ptr(new Executor(num_threads));
+}
+
+Executor::Ptr Executor::getDefault()
+{
+	static Ptr def = create();
+	return def;
+}
+
+void Executor::post(std::function<void()>&& task)
+{
+	{
+		std::lock_guard<std::mutex> lck(m_impl->mtx);
+		if (m_impl->quit) return;
+		m_impl->tasks.push_back(std::move(task));
+	}
+	m_impl->cv.notify_one();
+}
+
+unsigned int Executor::getNumThreads() const
+{
+	return static_cast<unsigned int>(m_impl->threads.size());
+}
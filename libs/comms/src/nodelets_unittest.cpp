@@ -18,3 +18,175 @@ TEST(NodeletsTests, pub_sub_multithread_test)
 	NodeletsTest();
 	EXPECT_TRUE(nodelets_test_passed_ok);
 }
+
+#include <atomic>
+#include <future>
+
+using namespace mrpt::comms;
+using namespace std::chrono_literals;
+
+// Waits up to 5 seconds for a condition:
+template <class COND>
+static bool waitFor(COND cond)
+{
+	for (int i = 0; i < 500 && !cond(); i++)
+		std::this_thread::sleep_for(10ms);
+	return cond();
+}
+
+TEST(NodeletsTests, typed_topic_fanout)
+{
+	auto tdir = TopicDirectory::create();
+	auto topic = tdir->getTypedTopic<std::vector<double>>("/lidar");
+	EXPECT_EQ(topic, tdir->getTypedTopic<std::vector<double>>("/lidar"));
+	EXPECT_THROW(tdir->getTypedTopic<int>("/lidar"), std::exception);
+
+	// Subscribers must get the very same object (no copies):
+	auto msg = std::make_shared<const std::vector<double>>(1000, 1.0);
+	std::atomic<int> nSync{0}, nAsync{0};
+	TSubscriberOptions syncOpts;
+	syncOpts.queue_length = 0;
+	auto sub1 = topic->createSubscriber(
+		[&](const std::shared_ptr<const std::vector<double>>& m) {
+			if (m == msg) nSync++;
+		},
+		syncOpts);
+	std::vector<Subscriber::Ptr> subs;
+	for (int i = 0; i < 2; i++)
+		subs.push_back(topic->createSubscriber(
+			[&](const std::shared_ptr<const std::vector<double>>& m) {
+				if (m == msg) nAsync++;
+			}));
+
+	for (int i = 0; i < 5; i++) topic->publish(msg);
+	EXPECT_EQ(nSync, 5);
+	EXPECT_TRUE(waitFor([&]() { return nAsync == 10; }));
+
+	auto stats = topic->getStats();
+	EXPECT_EQ(stats.published, 5U);
+	EXPECT_EQ(stats.delivered, 15U);
+	EXPECT_EQ(stats.dropped, 0U);
+	EXPECT_EQ(stats.subscribers, 3U);
+	EXPECT_GE(stats.latency_max, stats.latency_mean);
+
+	// Unsubscribe:
+	sub1.reset();
+	subs.clear();
+	EXPECT_EQ(topic->getStats().subscribers, 0U);
+	topic->publish(msg);
+	EXPECT_EQ(nSync, 5);
+}
+
+// A subscriber blocked in its first message, while 9 more are published:
+static std::vector<int> slowSubscriber(DropPolicy policy, TTopicStats& stats)
+{
+	auto tdir = TopicDirectory::create();
+	auto topic = tdir->getTypedTopic<int>("/data");
+
+	std::promise<void> started, release;
+	auto releaseFut = release.get_future().share();
+	std::mutex mtx;
+	std::vector<int> rx;
+
+	TSubscriberOptions opts;
+	opts.queue_length = 2;
+	opts.drop_policy = policy;
+	opts.executor = Executor::create(1);
+	auto sub = topic->createSubscriber(
+		[&](const std::shared_ptr<const int>& m) {
+			if (*m == 0)
+			{
+				started.set_value();
+				releaseFut.wait();
+			}
+			std::lock_guard<std::mutex> lck(mtx);
+			rx.push_back(*m);
+		},
+		opts);
+
+	topic->publish(std::make_shared<const int>(0));
+	started.get_future().wait();
+	for (int i = 1; i < 10; i++) topic->publish(std::make_shared<const int>(i));
+	release.set_value();
+	waitFor([&]() {
+		std::lock_guard<std::mutex> lck(mtx);
+		return rx.size() == 3;
+	});
+	stats = topic->getStats();
+	std::lock_guard<std::mutex> lck(mtx);
+	return rx;
+}
+
+TEST(NodeletsTests, typed_topic_drop_policies)
+{
+	TTopicStats stats;
+	EXPECT_EQ(
+		slowSubscriber(DropPolicy::DropOldest, stats),
+		std::vector<int>({0, 8, 9}));
+	EXPECT_EQ(stats.dropped, 7U);
+
+	EXPECT_EQ(
+		slowSubscriber(DropPolicy::DropNewest, stats),
+		std::vector<int>({0, 1, 2}));
+	EXPECT_EQ(stats.dropped, 7U);
+	EXPECT_EQ(stats.published, 10U);
+	EXPECT_EQ(stats.delivered, 3U);
+}
+
+TEST(NodeletsTests, typed_topic_block_policy)
+{
+	auto tdir = TopicDirectory::create();
+	auto topic = tdir->getTypedTopic<int>("/data");
+
+	std::promise<void> started, release;
+	auto releaseFut = release.get_future().share();
+	std::mutex mtx;
+	std::vector<int> rx;
+
+	TSubscriberOptions opts;
+	opts.queue_length = 2;
+	opts.drop_policy = DropPolicy::Block;
+	opts.executor = Executor::create(1);
+	auto sub = topic->createSubscriber(
+		[&](const std::shared_ptr<const int>& m) {
+			if (*m == 0)
+			{
+				started.set_value();
+				releaseFut.wait();
+			}
+			std::lock_guard<std::mutex> lck(mtx);
+			rx.push_back(*m);
+		},
+		opts);
+
+	topic->publish(std::make_shared<const int>(0));
+	started.get_future().wait();
+
+	// Messages 1 and 2 fill the queue, then publish() blocks:
+	std::atomic<int> nPublished{0};
+	auto publisher = std::async(std::launch::async, [&]() {
+		for (int i = 1; i < 10; i++)
+		{
+			topic->publish(std::make_shared<const int>(i));
+			nPublished++;
+		}
+	});
+	EXPECT_TRUE(waitFor([&]() { return nPublished == 2; }));
+	std::this_thread::sleep_for(50ms);
+	EXPECT_EQ(nPublished, 2);
+
+	release.set_value();
+	publisher.wait();
+	EXPECT_EQ(nPublished, 9);
+	EXPECT_TRUE(waitFor([&]() {
+		std::lock_guard<std::mutex> lck(mtx);
+		return rx.size() == 10;
+	}));
+	{
+		std::lock_guard<std::mutex> lck(mtx);
+		EXPECT_EQ(rx, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+	}
+	const auto stats = topic->getStats();
+	EXPECT_EQ(stats.dropped, 0U);
+	EXPECT_EQ(stats.delivered, 10U);
+}
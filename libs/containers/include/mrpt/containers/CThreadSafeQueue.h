@@ -8,6 +8,8 @@
    +------------------------------------------------------------------------+ */
 #pragma once
 
+#include <mrpt/containers/lockfree_queue.h>
+#include <atomic>
 #include <mutex>
 #include <queue>
 
@@ -47,31 +49,67 @@ namespace mrpt::containers
  * with \a get(). However, elements
   *   still in the queue upon destruction will be deleted automatically.
   *
+  *  push() is lock-free as long as the number of queued messages is below
+  * the capacity given to the constructor: messages are kept in a
+  * mrpt::containers::mpsc_queue. Beyond that, they are kept in a
+  * mutex-protected std::queue, so messages are never lost nor reordered.
+  *
  * \ingroup mrpt_containers_grp
   */
 template <class T>
 class CThreadSafeQueue
 {
    protected:
-	/** The queue of messages. Memory is freed at destructor or by clients
-	 * gathering messages. */
-	std::queue<T*> m_msgs;
-	/** The critical section */
+	/** The lock-free queue of messages. Memory is freed at destructor or by
+	 * clients gathering messages. */
+	mpsc_queue<T*> m_msgs;
+	/** Messages pushed while m_msgs was full, or while this one was not empty
+	 * (to keep the FIFO order). */
+	std::queue<T*> m_overflow;
+	/** True while m_overflow may not be empty */
+	std::atomic<bool> m_overflowing{false};
+	/** The critical section for m_overflow */
+	mutable std::mutex m_csOverflow;
+	/** Messages taken from m_overflow, to be returned before new ones */
+	std::queue<T*> m_pending;
+	/** The critical section for consumers */
 	mutable std::mutex m_csQueue;
 
+	/** Retrieve the next message, or nullptr. Call with m_csQueue locked. */
+	T* get_nolock()
+	{
+		T* ret = nullptr;
+		if (!m_pending.empty())
+		{
+			ret = m_pending.front();
+			m_pending.pop();
+		}
+		else if (!m_msgs.pop(ret) && m_overflowing.load())
+		{
+			// All messages in m_msgs are older than those in m_overflow:
+			std::lock_guard<std::mutex> lock(m_csOverflow);
+			m_pending.swap(m_overflow);
+			m_overflowing = false;
+			if (!m_pending.empty())
+			{
+				ret = m_pending.front();
+				m_pending.pop();
+			}
+		}
+		return ret;
+	}
+
    public:
-	/** Default ctor. */
-	CThreadSafeQueue() {}
+	/** Default ctor.
+	 * \param capacity Number of messages that can be queued with lock-free
+	 * operations. */
+	CThreadSafeQueue(size_t capacity = 1024) : m_msgs(capacity) {}
 	virtual ~CThreadSafeQueue() { clear(); }
 	/** Clear the queue of messages, freeing memory as required. */
 	void clear()
 	{
 		std::lock_guard<std::mutex> lock(m_csQueue);
-		while (!m_msgs.empty())
-		{
-			delete m_msgs.front();
-			m_msgs.pop();
-		}
+		while (T* msg = get_nolock()) delete msg;
 	}
 
 	/** Insert a new message in the queue - The object must be created with
@@ -79,8 +117,10 @@ class CThreadSafeQueue
 	  */
 	inline void push(T* msg)
 	{
-		std::lock_guard<std::mutex> lock(m_csQueue);
-		m_msgs.push(msg);
+		if (!m_overflowing.load() && m_msgs.push(msg)) return;
+		std::lock_guard<std::mutex> lock(m_csOverflow);
+		m_overflow.push(msg);
+		m_overflowing = true;
 	}
 
 	/** Retrieve the next message in the queue, or nullptr if there is no
@@ -90,14 +130,7 @@ class CThreadSafeQueue
 	inline T* get()
 	{
 		std::lock_guard<std::mutex> lock(m_csQueue);
-		if (m_msgs.empty())
-			return nullptr;
-		else
-		{
-			T* ret = m_msgs.front();
-			m_msgs.pop();
-			return ret;
-		}
+		return get_nolock();
 	}
 
 	/** Skip all old messages in the queue and directly return the last one (the
@@ -109,36 +142,25 @@ class CThreadSafeQueue
 	inline T* get_lastest_purge_old()
 	{
 		std::lock_guard<std::mutex> lock(m_csQueue);
-		if (m_msgs.empty())
-			return nullptr;
-		else
+		T* ret = nullptr;
+		while (T* msg = get_nolock())
 		{
-			for (;;)
-			{
-				T* ret = m_msgs.front();
-				m_msgs.pop();
-				if (m_msgs.empty())
-					return ret;
-				else
-					delete ret;
-			}
+			delete ret;
+			ret = msg;
 		}
+		return ret;
 	}
 
 	/** Return true if there are no messages. */
-	bool empty() const
-	{
-		std::lock_guard<std::mutex> lock(m_csQueue);
-		return m_msgs.empty();
-	}
+	bool empty() const { return size() == 0; }
 
 	/** Return the number of queued messages. */
 	size_t size() const
 	{
 		std::lock_guard<std::mutex> lock(m_csQueue);
-		return m_msgs.size();
+		std::lock_guard<std::mutex> lock2(m_csOverflow);
+		return m_msgs.size() + m_overflow.size() + m_pending.size();
 	}
 
 };  // End of class def.
 }
-
@@ -0,0 +1,219 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace mrpt::containers
+{
+namespace internal
+{
+/** Smallest power of two >= n (and >= 2) */
+inline size_t lockfree_queue_capacity(size_t n)
+{
+	if (n == 0) throw std::invalid_argument("capacity must be >0");
+	size_t c = 2;
+	while (c < n) c <<= 1;
+	return c;
+}
+/** Typical size of a cache line, to keep producer and consumer indices apart
+ */
+constexpr size_t LOCKFREE_CACHE_LINE = 64;
+}  // namespace internal
+
+/** A bounded, lock-free, single-producer single-consumer FIFO queue, stored in
+ * a ring buffer of fixed capacity (rounded up to a power of two).
+ *
+ * push() may be called from one thread while pop() is called from another
+ * one, with no locks and no memory allocation. A full queue makes push()
+ * return false instead of blocking or growing.
+ *
+ * \tparam T Any default-constructible, movable type. Popped slots are reset
+ * to T(), so smart pointers release their objects immediately.
+ * \sa mpsc_queue
+ * \note Defined in #include <mrpt/containers/lockfree_queue.h>
+ * \ingroup mrpt_containers_grp
+ */
+template <typename T>
+class spsc_queue
+{
+   public:
+	spsc_queue(const size_t capacity)
+		: m_capacity(internal::lockfree_queue_capacity(capacity)),
+		  m_mask(m_capacity - 1),
+		  m_data(new T[m_capacity])
+	{
+	}
+	spsc_queue(const spsc_queue&) = delete;
+	spsc_queue& operator=(const spsc_queue&) = delete;
+
+	/** Inserts an element. Call only from the producer thread.
+	 * \return false (and \a d is not moved from) if the queue is full. */
+	bool push(T&& d)
+	{
+		const size_t tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_head.load(std::memory_order_acquire) == m_capacity)
+			return false;
+		m_data[tail & m_mask] = std::move(d);
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+	/** \overload */
+	bool push(const T& d)
+	{
+		T copy(d);
+		return push(std::move(copy));
+	}
+
+	/** Retrieves the oldest element. Call only from the consumer thread.
+	 * \return false if the queue is empty. */
+	bool pop(T& out)
+	{
+		const size_t head = m_head.load(std::memory_order_relaxed);
+		if (head == m_tail.load(std::memory_order_acquire)) return false;
+		T& slot = m_data[head & m_mask];
+		out = std::move(slot);
+		slot = T();
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/** Number of elements, exact only if no other thread is accessing the
+	 * queue */
+	size_t size() const
+	{
+		return m_tail.load(std::memory_order_acquire) -
+			   m_head.load(std::memory_order_acquire);
+	}
+	bool empty() const { return size() == 0; }
+	/** Maximum number of elements in the queue */
+	size_t capacity() const { return m_capacity; }
+
+   private:
+	const size_t m_capacity, m_mask;
+	std::unique_ptr<T[]> m_data;
+	/** Next slot to read, only written by the consumer */
+	alignas(internal::LOCKFREE_CACHE_LINE) std::atomic<size_t> m_head{0};
+	/** Next slot to write, only written by the producer */
+	alignas(internal::LOCKFREE_CACHE_LINE) std::atomic<size_t> m_tail{0};
+};
+
+/** A bounded, lock-free, multiple-producer single-consumer FIFO queue, stored
+ * in a ring buffer of fixed capacity (rounded up to a power of two).
+ *
+ * push() may be called from any number of threads at once, and pop() from
+ * one consumer thread at a time (e.g. protected by a mutex if there are
+ * several consumers). Each slot holds a sequence number telling producers and
+ * the consumer whether it is free or ready, so no locks are needed (D.
+ * Vyukov's bounded queue). Elements pushed by one thread are popped in the
+ * same order. A full queue makes push() return false instead of blocking.
+ *
+ * \tparam T Any default-constructible, movable type. Popped slots are reset
+ * to T(), so smart pointers release their objects immediately.
+ * \sa spsc_queue
+ * \note Defined in #include <mrpt/containers/lockfree_queue.h>
+ * \ingroup mrpt_containers_grp
+ */
+template <typename T>
+class mpsc_queue
+{
+   public:
+	mpsc_queue(const size_t capacity)
+		: m_capacity(internal::lockfree_queue_capacity(capacity)),
+		  m_mask(m_capacity - 1),
+		  m_slots(new Slot[m_capacity])
+	{
+		for (size_t i = 0; i < m_capacity; i++)
+			m_slots[i].seq.store(i, std::memory_order_relaxed);
+	}
+	mpsc_queue(const mpsc_queue&) = delete;
+	mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+	/** Inserts an element. Thread-safe with respect to other producers and
+	 * the consumer.
+	 * \return false (and \a d is not moved from) if the queue is full. */
+	bool push(T&& d)
+	{
+		size_t pos = m_tail.load(std::memory_order_relaxed);
+		Slot* s;
+		for (;;)
+		{
+			s = &m_slots[pos & m_mask];
+			const size_t seq = s->seq.load(std::memory_order_acquire);
+			const auto dif =
+				static_cast<std::ptrdiff_t>(seq) -
+				static_cast<std::ptrdiff_t>(pos);
+			if (dif == 0)
+			{
+				// The slot is free: try to claim it.
+				if (m_tail.compare_exchange_weak(
+						pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (dif < 0)
+				return false;  // Full
+			else
+				pos = m_tail.load(std::memory_order_relaxed);
+		}
+		s->data = std::move(d);
+		s->seq.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+	/** \overload */
+	bool push(const T& d)
+	{
+		T copy(d);
+		return push(std::move(copy));
+	}
+
+	/** Retrieves the oldest element. Call from one thread at a time.
+	 * \return false if the queue is empty. */
+	bool pop(T& out)
+	{
+		const size_t pos = m_head.load(std::memory_order_relaxed);
+		Slot& s = m_slots[pos & m_mask];
+		if (s.seq.load(std::memory_order_acquire) != pos + 1) return false;
+		out = std::move(s.data);
+		s.data = T();
+		s.seq.store(pos + m_capacity, std::memory_order_release);
+		m_head.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	/** Number of elements, exact only if no other thread is accessing the
+	 * queue. It may include elements still being pushed. */
+	size_t size() const
+	{
+		const size_t head = m_head.load(std::memory_order_acquire);
+		const size_t tail = m_tail.load(std::memory_order_acquire);
+		return tail > head ? tail - head : 0;
+	}
+	bool empty() const { return size() == 0; }
+	/** Maximum number of elements in the queue */
+	size_t capacity() const { return m_capacity; }
+
+   private:
+	struct Slot
+	{
+		std::atomic<size_t> seq;
+		T data;
+	};
+	const size_t m_capacity, m_mask;
+	std::unique_ptr<Slot[]> m_slots;
+	/** Next slot to read, only written by the consumer */
+	alignas(internal::LOCKFREE_CACHE_LINE) std::atomic<size_t> m_head{0};
+	/** Next slot to claim by producers */
+	alignas(internal::LOCKFREE_CACHE_LINE) std::atomic<size_t> m_tail{0};
+};
+
+}  // namespace mrpt::containers
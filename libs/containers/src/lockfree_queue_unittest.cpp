@@ -0,0 +1,134 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include <mrpt/containers/lockfree_queue.h>
+#include <mrpt/containers/CThreadSafeQueue.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace mrpt::containers;
+
+template <class QUEUE>
+static void fillAndEmpty()
+{
+	QUEUE q(5);
+	EXPECT_EQ(q.capacity(), 8U);
+	for (int round = 0; round < 3; round++)
+	{
+		EXPECT_TRUE(q.empty());
+		for (int i = 0; i < 8; i++) EXPECT_TRUE(q.push(i));
+		EXPECT_FALSE(q.push(8));
+		EXPECT_EQ(q.size(), 8U);
+		int v;
+		for (int i = 0; i < 8; i++)
+		{
+			EXPECT_TRUE(q.pop(v));
+			EXPECT_EQ(v, i);
+		}
+		EXPECT_FALSE(q.pop(v));
+	}
+}
+
+TEST(lockfree_queue, spsc_FillAndEmpty) { fillAndEmpty<spsc_queue<int>>(); }
+TEST(lockfree_queue, mpsc_FillAndEmpty) { fillAndEmpty<mpsc_queue<int>>(); }
+TEST(lockfree_queue, ReleasesPoppedObjects)
+{
+	mpsc_queue<std::shared_ptr<int>> q(4);
+	auto p = std::make_shared<int>(1);
+	EXPECT_TRUE(q.push(p));
+	EXPECT_EQ(p.use_count(), 2);
+	std::shared_ptr<int> out;
+	EXPECT_TRUE(q.pop(out));
+	out.reset();
+	EXPECT_EQ(p.use_count(), 1);
+}
+
+TEST(lockfree_queue, spsc_Threads)
+{
+	const size_t N = 100000;
+	spsc_queue<size_t> q(64);
+	std::thread producer([&]() {
+		for (size_t i = 0; i < N; i++)
+			while (!q.push(i)) std::this_thread::yield();
+	});
+	size_t expected = 0, v;
+	while (expected < N)
+	{
+		if (!q.pop(v))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		ASSERT_EQ(v, expected);
+		expected++;
+	}
+	producer.join();
+	EXPECT_TRUE(q.empty());
+}
+
+TEST(lockfree_queue, mpsc_Threads)
+{
+	const size_t N = 20000, nProducers = 4;
+	mpsc_queue<std::pair<size_t, size_t>> q(64);
+	std::vector<std::thread> producers;
+	for (size_t p = 0; p < nProducers; p++)
+		producers.emplace_back([&q, p]() {
+			for (size_t i = 0; i < N; i++)
+				while (!q.push({p, i})) std::this_thread::yield();
+		});
+	// Each producer's elements must arrive in order:
+	std::vector<size_t> next(nProducers, 0);
+	std::pair<size_t, size_t> v;
+	for (size_t count = 0; count < N * nProducers;)
+	{
+		if (!q.pop(v))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		ASSERT_LT(v.first, nProducers);
+		ASSERT_EQ(v.second, next[v.first]);
+		next[v.first]++;
+		count++;
+	}
+	for (auto& t : producers) t.join();
+	EXPECT_TRUE(q.empty());
+}
+
+TEST(CThreadSafeQueue, OverflowKeepsOrder)
+{
+	CThreadSafeQueue<int> q(4);
+	int i = 0;
+	for (; i < 10; i++) q.push(new int(i));
+	EXPECT_EQ(q.size(), 10U);
+	int expected = 0;
+	for (; expected < 6; expected++)
+	{
+		std::unique_ptr<int> v(q.get());
+		ASSERT_TRUE(v);
+		EXPECT_EQ(*v, expected);
+	}
+	for (; i < 20; i++) q.push(new int(i));
+	for (; expected < 20; expected++)
+	{
+		std::unique_ptr<int> v(q.get());
+		ASSERT_TRUE(v);
+		EXPECT_EQ(*v, expected);
+	}
+	EXPECT_EQ(q.get(), nullptr);
+	EXPECT_TRUE(q.empty());
+
+	for (i = 0; i < 10; i++) q.push(new int(i));
+	std::unique_ptr<int> last(q.get_lastest_purge_old());
+	ASSERT_TRUE(last);
+	EXPECT_EQ(*last, 9);
+	EXPECT_TRUE(q.empty());
+}
@@ -13,6 +13,7 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
 #include "mrpt-expr_export.h"
 
 namespace exprtk {
@@ -87,6 +88,31 @@ class MRPT_EXPR_EXPORT CRuntimeCompiledExpression
 	*/
 	double eval() const;
 
+	/** Evaluates the formula for N different values of some of its
+	 * variables in one call, e.g. to score many candidates. Variables not in
+	 * \a batch_variables keep their current values, and no variable is
+	 * modified.
+	 *
+	 * Formulas made of arithmetic, comparison and logical operators, `if()`,
+	 * the `?:` operator and the usual math functions are translated by
+	 * compile() into a bytecode which runs each operation over a block of
+	 * values at once, in tight loops the compiler can vectorize. Other
+	 * formulas are evaluated by exprtk once per value.
+	 * \sa has_batch_bytecode()
+	 */
+	void eval_batch(
+		/** [in] Map of variables by `name` -> pointer to their N values.
+		   Names which are not variables of the formula are ignored. */
+		const std::map<std::string, const double*>& batch_variables,
+		/** [in] Number of values of each batch variable */
+		const size_t N,
+		/** [out] The N values of the formula */
+		std::vector<double>& out) const;
+
+	/** Returns true if eval_batch() uses a vectorized bytecode for this
+	 * formula, false if it falls back to exprtk. */
+	bool has_batch_bytecode() const;
+
 	/** Returns true if compile() was called and ended without errors. */
 	bool is_compiled() const;
 	/** Returns the original formula passed to compile(), or an empty string if
@@ -11,7 +11,12 @@
 
 #include <mrpt/expr/CRuntimeCompiledExpression.h>
 #include <mrpt/core/exceptions.h>
+#include <algorithm>
+#include <cctype>
 #include <cmath>  // M_PI
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
 
 #define exprtk_disable_string_capabilities  // Workaround a bug in Ubuntu
 // precise's GCC+libstdc++
@@ -31,10 +36,588 @@
 using namespace mrpt;
 using namespace mrpt::expr;
 
+namespace
+{
+/** Operations of the bytecode used by eval_batch(). They work on a stack of
+ * blocks of values, one value per element of the batch. */
+enum class Op : uint8_t
+{
+	Var,
+	Const,
+	Neg,
+	Not,
+	Func1,
+	Add,
+	Sub,
+	Mul,
+	Div,
+	Mod,
+	Pow,
+	Func2,
+	Lt,
+	Le,
+	Gt,
+	Ge,
+	Eq,
+	Ne,
+	And,
+	Or,
+	Select
+};
+
+struct Instr
+{
+	Op op;
+	double value{0};  // Op::Const
+	double* var{nullptr};  // Op::Var
+	double (*func1)(double){nullptr};  // Op::Func1
+	double (*func2)(double, double){nullptr};  // Op::Func2
+};
+
+struct BatchProgram
+{
+	std::vector<Instr> code;
+	/** Maximum number of blocks in the stack */
+	size_t stack_size{0};
+};
+
+/** Translates the subset of the exprtk grammar supported by the bytecode,
+ * with its same precedence rules, from lowest to highest:
+ * `?:`, `or`, `and`, comparisons (all with the same precedence), `+ -`,
+ * `* / %`, unary `+ -`, and `^` (right associative).
+ * Throws std::runtime_error on anything else. */
+class BatchCompiler
+{
+   public:
+	BatchCompiler(
+		const std::string& str, const std::map<std::string, double*>& vars,
+		BatchProgram& prog)
+		: m_str(str), m_vars(vars), m_prog(prog)
+	{
+	}
+
+	void run()
+	{
+		next();
+		parseTernary();
+		if (isOp(";")) next();
+		if (m_tok != Tok::End) fail();
+	}
+
+   private:
+	enum class Tok
+	{
+		End,
+		Number,
+		Ident,
+		Op
+	};
+	const std::string& m_str;
+	const std::map<std::string, double*>& m_vars;
+	BatchProgram& m_prog;
+	size_t m_pos{0}, m_depth{0};
+	Tok m_tok{Tok::End};
+	/** Current operator, or identifier in lower case */
+	std::string m_text;
+	double m_number{0};
+
+	[[noreturn]] static void fail()
+	{
+		throw std::runtime_error("Unsupported by batch bytecode");
+	}
+
+	void next()
+	{
+		while (m_pos < m_str.size() && std::isspace(m_str[m_pos])) m_pos++;
+		m_text.clear();
+		if (m_pos >= m_str.size())
+		{
+			m_tok = Tok::End;
+			return;
+		}
+		const size_t start = m_pos;
+		const auto isDigit = [this](size_t i) {
+			return i < m_str.size() && std::isdigit(m_str[i]);
+		};
+		const char c = m_str[m_pos];
+		if (isDigit(m_pos) || (c == '.' && isDigit(m_pos + 1)))
+		{
+			while (isDigit(m_pos)) m_pos++;
+			if (m_pos < m_str.size() && m_str[m_pos] == '.') m_pos++;
+			while (isDigit(m_pos)) m_pos++;
+			if (m_pos < m_str.size() &&
+				(m_str[m_pos] == 'e' || m_str[m_pos] == 'E'))
+			{
+				m_pos++;
+				if (m_pos < m_str.size() &&
+					(m_str[m_pos] == '+' || m_str[m_pos] == '-'))
+					m_pos++;
+				if (!isDigit(m_pos)) fail();
+				while (isDigit(m_pos)) m_pos++;
+			}
+			m_tok = Tok::Number;
+			m_number = std::strtod(
+				m_str.substr(start, m_pos - start).c_str(), nullptr);
+		}
+		else if (std::isalpha(c) || c == '_')
+		{
+			while (m_pos < m_str.size() &&
+				   (std::isalnum(m_str[m_pos]) || m_str[m_pos] == '_'))
+				m_pos++;
+			m_tok = Tok::Ident;
+			m_text = m_str.substr(start, m_pos - start);
+		}
+		else
+		{
+			static const char* ops2[] = {"<=", ">=", "==", "!=", "<>", ":="};
+			m_tok = Tok::Op;
+			for (const char* op : ops2)
+				if (m_str.compare(m_pos, 2, op) == 0) m_text = op;
+			if (m_text.empty()) m_text = std::string(1, c);
+			m_pos += m_text.size();
+		}
+	}
+
+	bool isOp(const char* op) const
+	{
+		return m_tok == Tok::Op && m_text == op;
+	}
+	bool isKeyword(const char* kw) const
+	{
+		return m_tok == Tok::Ident && lowerCase(m_text) == kw;
+	}
+	void expect(const char* op)
+	{
+		if (!isOp(op)) fail();
+		next();
+	}
+	static std::string lowerCase(std::string s)
+	{
+		for (auto& c : s) c = std::tolower(c);
+		return s;
+	}
+
+	/** Appends an instruction which pops `pops` blocks and pushes one */
+	void emit(const Instr& ins, size_t pops)
+	{
+		m_prog.code.push_back(ins);
+		m_depth = m_depth - pops + 1;
+		m_prog.stack_size = std::max(m_prog.stack_size, m_depth);
+	}
+	void emit(Op op, size_t pops) { emit(Instr{op}, pops); }
+
+	void parseTernary()
+	{
+		parseOr();
+		if (!isOp("?")) return;
+		next();
+		parseTernary();
+		expect(":");
+		parseTernary();
+		emit(Op::Select, 3);
+	}
+	void parseOr()
+	{
+		parseAnd();
+		while (isOp("|") || isKeyword("or"))
+		{
+			next();
+			parseAnd();
+			emit(Op::Or, 2);
+		}
+	}
+	void parseAnd()
+	{
+		parseComparison();
+		while (isOp("&") || isKeyword("and"))
+		{
+			next();
+			parseComparison();
+			emit(Op::And, 2);
+		}
+	}
+	void parseComparison()
+	{
+		parseAdditive();
+		for (;;)
+		{
+			Op op;
+			if (isOp("<"))
+				op = Op::Lt;
+			else if (isOp("<="))
+				op = Op::Le;
+			else if (isOp(">"))
+				op = Op::Gt;
+			else if (isOp(">="))
+				op = Op::Ge;
+			else if (isOp("==") || isOp("="))
+				op = Op::Eq;
+			else if (isOp("!=") || isOp("<>"))
+				op = Op::Ne;
+			else
+				return;
+			next();
+			parseAdditive();
+			emit(op, 2);
+		}
+	}
+	void parseAdditive()
+	{
+		parseMultiplicative();
+		while (isOp("+") || isOp("-"))
+		{
+			const Op op = isOp("+") ? Op::Add : Op::Sub;
+			next();
+			parseMultiplicative();
+			emit(op, 2);
+		}
+	}
+	void parseMultiplicative()
+	{
+		parseUnary();
+		while (isOp("*") || isOp("/") || isOp("%"))
+		{
+			const Op op = isOp("*") ? Op::Mul : isOp("/") ? Op::Div : Op::Mod;
+			next();
+			parseUnary();
+			emit(op, 2);
+		}
+	}
+	void parseUnary()
+	{
+		if (isOp("-"))
+		{
+			next();
+			parseUnary();
+			emit(Op::Neg, 1);
+		}
+		else if (isOp("+"))
+		{
+			next();
+			parseUnary();
+		}
+		else
+			parsePower();
+	}
+	void parsePower()
+	{
+		parsePrimary();
+		if (!isOp("^")) return;
+		next();
+		parseUnary();
+		emit(Op::Pow, 2);
+	}
+	void parsePrimary()
+	{
+		if (m_tok == Tok::Number)
+		{
+			Instr ins{Op::Const};
+			ins.value = m_number;
+			emit(ins, 0);
+			next();
+			return;
+		}
+		for (const auto& br : {"()", "[]", "{}"})
+		{
+			if (!isOp(std::string(1, br[0]).c_str())) continue;
+			next();
+			parseTernary();
+			expect(std::string(1, br[1]).c_str());
+			return;
+		}
+		if (m_tok != Tok::Ident) fail();
+
+		const std::string name = m_text;
+		next();
+		if (isOp("("))
+			parseFunction(lowerCase(name));
+		else
+			parseSymbol(name);
+	}
+
+	void parseFunction(const std::string& name)
+	{
+		// Arguments:
+		next();
+		size_t nArgs = 0;
+		if (!isOp(")"))
+		{
+			for (;;)
+			{
+				parseTernary();
+				nArgs++;
+				if (!isOp(",")) break;
+				next();
+			}
+		}
+		expect(")");
+
+		using F1 = double (*)(double);
+		using F2 = double (*)(double, double);
+		static const std::map<std::string, F1> funcs1 = {
+			{"abs", [](double x) { return std::abs(x); }},
+			{"acos", [](double x) { return std::acos(x); }},
+			{"asin", [](double x) { return std::asin(x); }},
+			{"atan", [](double x) { return std::atan(x); }},
+			{"ceil", [](double x) { return std::ceil(x); }},
+			{"cos", [](double x) { return std::cos(x); }},
+			{"cosh", [](double x) { return std::cosh(x); }},
+			{"exp", [](double x) { return std::exp(x); }},
+			{"floor", [](double x) { return std::floor(x); }},
+			{"log", [](double x) { return std::log(x); }},
+			{"log10", [](double x) { return std::log10(x); }},
+			{"sgn",
+			 [](double x) { return x > 0 ? 1.0 : (x < 0 ? -1.0 : 0.0); }},
+			{"sin", [](double x) { return std::sin(x); }},
+			{"sinh", [](double x) { return std::sinh(x); }},
+			{"sqrt", [](double x) { return std::sqrt(x); }},
+			{"tan", [](double x) { return std::tan(x); }},
+			{"tanh", [](double x) { return std::tanh(x); }},
+			{"trunc", [](double x) { return std::trunc(x); }}};
+		static const std::map<std::string, F2> funcs2 = {
+			{"atan2", [](double y, double x) { return std::atan2(y, x); }},
+			{"hypot", [](double x, double y) { return std::hypot(x, y); }},
+			{"pow", [](double x, double y) { return std::pow(x, y); }}};
+
+		if (name == "if" && nArgs == 3)
+			emit(Op::Select, 3);
+		else if (name == "not" && nArgs == 1)
+			emit(Op::Not, 1);
+		else if ((name == "min" || name == "max") && nArgs >= 1)
+		{
+			// Same semantics than std::min(), std::max() wrt NaN:
+			Instr ins{Op::Func2};
+			if (name == "min")
+				ins.func2 = [](double a, double b) { return std::min(a, b); };
+			else
+				ins.func2 = [](double a, double b) { return std::max(a, b); };
+			for (size_t i = 1; i < nArgs; i++) emit(ins, 2);
+		}
+		else if (funcs1.count(name) && nArgs == 1)
+		{
+			Instr ins{Op::Func1};
+			ins.func1 = funcs1.at(name);
+			emit(ins, 1);
+		}
+		else if (funcs2.count(name) && nArgs == 2)
+		{
+			Instr ins{Op::Func2};
+			ins.func2 = funcs2.at(name);
+			emit(ins, 2);
+		}
+		else
+			fail();
+	}
+
+	void parseSymbol(const std::string& name)
+	{
+		// Variables (case insensitive in exprtk):
+		auto it = m_vars.find(name);
+		if (it == m_vars.end())
+			it = std::find_if(m_vars.begin(), m_vars.end(), [&](const auto& v) {
+				return lowerCase(v.first) == lowerCase(name);
+			});
+		if (it != m_vars.end())
+		{
+			Instr ins{Op::Var};
+			ins.var = it->second;
+			emit(ins, 0);
+			return;
+		}
+		// Constants defined by exprtk and compile():
+		static const std::map<std::string, double> consts = {
+			{"pi", M_PI},
+			{"m_pi", M_PI},
+			{"epsilon", 0.0000000001},
+			{"inf", std::numeric_limits<double>::infinity()},
+			{"true", 1.0},
+			{"false", 0.0}};
+		const auto itc = consts.find(lowerCase(name));
+		if (itc == consts.end()) fail();
+		Instr ins{Op::Const};
+		ins.value = itc->second;
+		emit(ins, 0);
+	}
+};
+
+template <class F>
+inline void batchBinaryOp(double* a, const double* b, const size_t n, F f)
+{
+	for (size_t i = 0; i < n; i++) a[i] = f(a[i], b[i]);
+}
+
+/** Runs the bytecode in blocks of values, with the given batch variables
+ * (pairs of variable address -> array of values) */
+void runBatchProgram(
+	const BatchProgram& prog,
+	const std::vector<std::pair<double*, const double*>>& batch,
+	const size_t N, double* out)
+{
+	constexpr size_t BLOCK = 128;
+	const auto& code = prog.code;
+
+	// The array of values bound to each Op::Var, or nullptr:
+	std::vector<const double*> var_values(code.size(), nullptr);
+	for (size_t pc = 0; pc < code.size(); pc++)
+		for (const auto& b : batch)
+			if (code[pc].op == Op::Var && code[pc].var == b.first)
+				var_values[pc] = b.second;
+
+	std::vector<double> stack(prog.stack_size * BLOCK);
+	for (size_t i0 = 0; i0 < N; i0 += BLOCK)
+	{
+		const size_t n = std::min(BLOCK, N - i0);
+		// Top of the stack and the block below it:
+		double* top = nullptr;
+		double* below = nullptr;
+		size_t sp = 0;
+		const auto push = [&]() {
+			top = &stack[BLOCK * sp++];
+			return top;
+		};
+		const auto pop = [&]() {
+			top = &stack[BLOCK * (--sp - 1)];
+			below = sp > 1 ? top - BLOCK : nullptr;
+		};
+
+		for (size_t pc = 0; pc < code.size(); pc++)
+		{
+			const Instr& ins = code[pc];
+			below = sp > 1 ? top - BLOCK : nullptr;
+			switch (ins.op)
+			{
+				case Op::Var:
+					if (var_values[pc])
+						std::copy_n(var_values[pc] + i0, n, push());
+					else
+						std::fill_n(push(), n, *ins.var);
+					break;
+				case Op::Const:
+					std::fill_n(push(), n, ins.value);
+					break;
+				case Op::Neg:
+					for (size_t i = 0; i < n; i++) top[i] = -top[i];
+					break;
+				case Op::Not:
+					for (size_t i = 0; i < n; i++)
+						top[i] = (top[i] == 0) ? 1.0 : 0.0;
+					break;
+				case Op::Func1:
+					for (size_t i = 0; i < n; i++) top[i] = ins.func1(top[i]);
+					break;
+				case Op::Func2:
+					batchBinaryOp(below, top, n, ins.func2);
+					pop();
+					break;
+				case Op::Add:
+					batchBinaryOp(below, top, n, [](double a, double b) {
+						return a + b;
+					});
+					pop();
+					break;
+				case Op::Sub:
+					batchBinaryOp(below, top, n, [](double a, double b) {
+						return a - b;
+					});
+					pop();
+					break;
+				case Op::Mul:
+					batchBinaryOp(below, top, n, [](double a, double b) {
+						return a * b;
+					});
+					pop();
+					break;
+				case Op::Div:
+					batchBinaryOp(below, top, n, [](double a, double b) {
+						return a / b;
+					});
+					pop();
+					break;
+				case Op::Mod:
+					batchBinaryOp(below, top, n, [](double a, double b) {
+						return std::fmod(a, b);
+					});
+					pop();
+					break;
+				case Op::Pow:
+					batchBinaryOp(below, top, n, [](double a, double b) {
+						return std::pow(a, b);
+					});
+					pop();
+					break;
+				case Op::Lt:
+					batchBinaryOp(below, top, n, [](double a, double b) {
+						return a < b ? 1.0 : 0.0;
+					});
+					pop();
+					break;
+				case Op::Le:
+					batchBinaryOp(below, top, n, [](double a, double b) {
+						return a <= b ? 1.0 : 0.0;
+					});
+					pop();
+					break;
+				case Op::Gt:
+					batchBinaryOp(below, top, n, [](double a, double b) {
+						return a > b ? 1.0 : 0.0;
+					});
+					pop();
+					break;
+				case Op::Ge:
+					batchBinaryOp(below, top, n, [](double a, double b) {
+						return a >= b ? 1.0 : 0.0;
+					});
+					pop();
+					break;
+				case Op::Eq:
+					batchBinaryOp(below, top, n, [](double a, double b) {
+						return a == b ? 1.0 : 0.0;
+					});
+					pop();
+					break;
+				case Op::Ne:
+					batchBinaryOp(below, top, n, [](double a, double b) {
+						return a != b ? 1.0 : 0.0;
+					});
+					pop();
+					break;
+				case Op::And:
+					batchBinaryOp(below, top, n, [](double a, double b) {
+						return (a != 0 && b != 0) ? 1.0 : 0.0;
+					});
+					pop();
+					break;
+				case Op::Or:
+					batchBinaryOp(below, top, n, [](double a, double b) {
+						return (a != 0 || b != 0) ? 1.0 : 0.0;
+					});
+					pop();
+					break;
+				case Op::Select:
+				{
+					// Stack: condition, value if true, value if false
+					double* cond = below - BLOCK;
+					for (size_t i = 0; i < n; i++)
+						cond[i] = (cond[i] != 0) ? below[i] : top[i];
+					pop();
+					pop();
+				}
+				break;
+			};
+		}
+		std::copy_n(top, n, out + i0);
+	}
+}
+}  // namespace
+
 struct CRuntimeCompiledExpression::Impl
 {
 	exprtk::expression<double> m_compiled_formula;
 	std::string m_original_expr_str;
+	/** Addresses of all the variables, by name */
+	std::map<std::string, double*> m_variables;
+	/** The formula translated for eval_batch(), or empty if not supported */
+	BatchProgram m_batch_program;
 };
 
 CRuntimeCompiledExpression::CRuntimeCompiledExpression():
@@ -62,6 +645,7 @@ void CRuntimeCompiledExpression::compile(
 	{
 		double& var = const_cast<double&>(v.second);
 		symbol_table.add_variable(v.first, var);
+		m_impl->m_variables.emplace(v.first, &var);
 	}
 	symbol_table.add_constant("M_PI", M_PI);
 	symbol_table.add_constants();
@@ -77,6 +661,18 @@ void CRuntimeCompiledExpression::compile(
 			"Error compiling expression (name=`%s`): `%s`. Error: `%s`",
 			expr_name_for_error_reporting.c_str(), expression.c_str(),
 			parser.error().c_str());
+
+	// Translate it for eval_batch(), if possible:
+	m_impl->m_batch_program = BatchProgram();
+	try
+	{
+		BatchCompiler(expression, m_impl->m_variables, m_impl->m_batch_program)
+			.run();
+	}
+	catch (const std::exception&)
+	{
+		m_impl->m_batch_program = BatchProgram();
+	}
 }
 
 double CRuntimeCompiledExpression::eval() const
@@ -85,6 +681,46 @@ double CRuntimeCompiledExpression::eval() const
 	return m_impl->m_compiled_formula.value();
 }
 
+void CRuntimeCompiledExpression::eval_batch(
+	const std::map<std::string, const double*>& batch_variables,
+	const size_t N, std::vector<double>& out) const
+{
+	ASSERT_(m_impl);
+	out.resize(N);
+	if (!N) return;
+
+	// Variable address -> batch values:
+	std::vector<std::pair<double*, const double*>> batch;
+	for (const auto& bv : batch_variables)
+	{
+		const auto it = m_impl->m_variables.find(bv.first);
+		if (it != m_impl->m_variables.end())
+			batch.emplace_back(it->second, bv.second);
+	}
+
+	if (!m_impl->m_batch_program.code.empty())
+	{
+		runBatchProgram(m_impl->m_batch_program, batch, N, &out[0]);
+		return;
+	}
+
+	// Not supported by the bytecode: evaluate one by one
+	std::vector<double> old_values;
+	for (const auto& b : batch) old_values.push_back(*b.first);
+	for (size_t i = 0; i < N; i++)
+	{
+		for (const auto& b : batch) *b.first = b.second[i];
+		out[i] = m_impl->m_compiled_formula.value();
+	}
+	for (size_t k = 0; k < batch.size(); k++) *batch[k].first = old_values[k];
+}
+
+bool CRuntimeCompiledExpression::has_batch_bytecode() const
+{
+	ASSERT_(m_impl);
+	return !m_impl->m_batch_program.code.empty();
+}
+
 void CRuntimeCompiledExpression::register_symbol_table(
 	/** [in] Map of variables/constants by `name` ->  `value`. The
 	   references to the values in this map **must** be ensured to be valid
@@ -96,6 +732,7 @@ void CRuntimeCompiledExpression::register_symbol_table(
 	{
 		double* var = const_cast<double*>(v.second);
 		symbol_table.add_variable(v.first, *var);
+		m_impl->m_variables.emplace(v.first, var);
 	}
 	m_impl->m_compiled_formula.register_symbol_table(symbol_table);
 }
@@ -10,6 +10,7 @@
 #include <mrpt/expr/CRuntimeCompiledExpression.h>
 #include <CTraitsTest.h>
 #include <gtest/gtest.h>
+#include <cmath>
 
 template class mrpt::CTraitsTest<mrpt::expr::CRuntimeCompiledExpression>;
 
@@ -25,3 +26,98 @@ TEST(RuntimeCompiledExpression, SimpleTest)
 	EXPECT_NEAR(
 		expr.eval(), vars["x"] * vars["x"] + vars["x"] * vars["y"] + 1.0, 1e-9);
 }
+
+// Evaluates the expression with eval(), one value at a time:
+static std::vector<double> evalOneByOne(
+	const mrpt::expr::CRuntimeCompiledExpression& expr,
+	std::map<std::string, double>& vars, const std::vector<double>& xs,
+	const std::vector<double>& ys)
+{
+	std::vector<double> ret;
+	for (size_t i = 0; i < xs.size(); i++)
+	{
+		vars["x"] = xs[i];
+		vars["y"] = ys[i];
+		ret.push_back(expr.eval());
+	}
+	return ret;
+}
+
+TEST(RuntimeCompiledExpression, BatchSameAsEval)
+{
+	// Values of "x" and "y" for each candidate, in more than one block:
+	std::vector<double> xs, ys;
+	for (int i = 0; i < 300; i++)
+	{
+		xs.push_back(0.1 * (i % 41) - 2.0);
+		ys.push_back(i % 7 == 0 ? 0.0 : std::cos(0.3 * i) * 3.0);
+	}
+
+	const char* formulas[] = {
+		"x^2+x*y+1", "-x^2", "2^x^2", "x^-y", "2*-x+z", "x - y - z",
+		"x / y / z", "x % 2 + y % -1.5", "x < y and y < 0 or z > 2",
+		"x == y = 0", "x <> 2 != y", "1 or x and 0", "x & y | 0",
+		"0 == x < y", "if(x > 0, sqrt(x), -y)", "x > y ? x : y > 0 ? 1 : 2",
+		"min(x, y, z) + max(x, 1)", "not(x) + not(y)", "sgn(y) * abs(x)",
+		"atan2(y, x) + hypot(x, y) + pow(abs(x), y)",
+		"sin(x) * cos(y) + tan(x / 10) + exp(-x) + log(abs(y) + 1)",
+		"floor(x) + ceil(y) + trunc(-x) + log10(z) + tanh(y)",
+		"[x + {y * (z - 1)}]", "X + Y", "pi * M_PI + epsilon + inf",
+		"true + false", "1.5e-1 * x + .5 * y;"};
+
+	std::map<std::string, double> vars;
+	vars["x"] = vars["y"] = 0;
+	vars["z"] = 2.5;
+	for (const char* f : formulas)
+	{
+		mrpt::expr::CRuntimeCompiledExpression expr;
+		expr.compile(f, vars);
+		EXPECT_TRUE(expr.has_batch_bytecode()) << f;
+
+		vars["x"] = vars["y"] = 1234.0;
+		std::vector<double> vals;
+		expr.eval_batch({{"x", &xs[0]}, {"y", &ys[0]}}, xs.size(), vals);
+		// Variables are not modified:
+		EXPECT_EQ(vars["x"], 1234.0);
+		EXPECT_EQ(vars["y"], 1234.0);
+
+		const auto expected = evalOneByOne(expr, vars, xs, ys);
+		ASSERT_EQ(vals.size(), expected.size());
+		for (size_t i = 0; i < vals.size(); i++)
+		{
+			if (std::isnan(expected[i]))
+				EXPECT_TRUE(std::isnan(vals[i])) << f << " i=" << i;
+			else if (std::isinf(expected[i]))
+				EXPECT_EQ(vals[i], expected[i]) << f << " i=" << i;
+			else
+				EXPECT_NEAR(vals[i], expected[i], 1e-12 * std::abs(expected[i]))
+					<< f << " i=" << i;
+		}
+	}
+}
+
+TEST(RuntimeCompiledExpression, BatchFallbackAndSymbolTable)
+{
+	double x = 0, y = 7.0;
+	mrpt::expr::CRuntimeCompiledExpression expr;
+	expr.register_symbol_table({{"x", &x}, {"y", &y}});
+	// Implicit multiplication is not supported by the bytecode:
+	expr.compile("2x + y");
+	EXPECT_FALSE(expr.has_batch_bytecode());
+
+	const std::vector<double> xs = {1.0, 2.0, 3.0};
+	std::vector<double> vals;
+	expr.eval_batch({{"x", &xs[0]}, {"unused", nullptr}}, xs.size(), vals);
+	ASSERT_EQ(vals.size(), 3U);
+	EXPECT_DOUBLE_EQ(vals[0], 9.0);
+	EXPECT_DOUBLE_EQ(vals[1], 11.0);
+	EXPECT_DOUBLE_EQ(vals[2], 13.0);
+	EXPECT_EQ(x, 0.0);
+
+	mrpt::expr::CRuntimeCompiledExpression expr2;
+	expr2.register_symbol_table({{"x", &x}, {"y", &y}});
+	expr2.compile("2*x + y");
+	EXPECT_TRUE(expr2.has_batch_bytecode());
+	expr2.eval_batch({{"x", &xs[0]}}, xs.size(), vals);
+	EXPECT_DOUBLE_EQ(vals[2], 13.0);
+}
@@ -16,6 +16,7 @@
 #include <set>
 #include <map>
 #include <fstream>
+#include <type_traits>
 
 namespace mrpt
 {
@@ -50,20 +51,49 @@ struct edge_annotations_empty
 };
 }  // namespace detail
 
+/** Traits for using a std::multimap<> as the container of edges in
+ * mrpt::graphs::CDirectedGraph (the default) \sa edges_traits_compact */
+struct edges_traits_multimap
+{
+	template <class EDGE>
+	using edges_map = mrpt::aligned_std_multimap<TPairNodeIDs, EDGE>;
+};
+
+namespace detail
+{
+/** The edges traits to use for a given MAPS_IMPLEMENTATION: its nested type
+ * \a edges_traits if it has one, edges_traits_multimap otherwise. */
+template <class MAPS_IMPLEMENTATION, class = void>
+struct edges_traits_of
+{
+	using type = edges_traits_multimap;
+};
+template <class MAPS_IMPLEMENTATION>
+struct edges_traits_of<
+	MAPS_IMPLEMENTATION,
+	std::void_t<typename MAPS_IMPLEMENTATION::edges_traits>>
+{
+	using type = typename MAPS_IMPLEMENTATION::edges_traits;
+};
+}  // namespace detail
+
 /** A directed graph with the argument of the template specifying the type of
  * the annotations in the edges.
  *  This class only keeps a list of edges (in the member \a edges), so there is
  * no information stored for each node but its existence referred by a node_ID.
  *
  *  Note that edges are stored as a std::multimap<> to allow <b>multiple
- * edges</b> between the same pair of nodes.
+ * edges</b> between the same pair of nodes. The container can be changed with
+ * the template argument \a EDGES_IMPLEMENTATION, e.g. to
+ * mrpt::graphs::edges_traits_compact to store all edges contiguously.
  *
  * \sa mrpt::graphs::CDijkstra, mrpt::graphs::CNetworkOfPoses,
  * mrpt::graphs::CDirectedTree
  * \ingroup mrpt_graphs_grp
  */
 template <class TYPE_EDGES,
-		  class EDGE_ANNOTATIONS = detail::edge_annotations_empty>
+		  class EDGE_ANNOTATIONS = detail::edge_annotations_empty,
+		  class EDGES_IMPLEMENTATION = edges_traits_multimap>
 class CDirectedGraph
 {
    public:
@@ -88,18 +118,21 @@ class CDirectedGraph
 	/** Underlying type for edge_t = TYPE_EDGES + annotations */
 	using edge_underlying_t = TYPE_EDGES;
 	/** The type of the member \a edges */
-	using edges_map_t = mrpt::aligned_std_multimap<TPairNodeIDs, edge_t>;
+	using edges_map_t =
+		typename EDGES_IMPLEMENTATION::template edges_map<edge_t>;
 	using iterator = typename edges_map_t::iterator;
 	using reverse_iterator = typename edges_map_t::reverse_iterator;
 	using const_iterator = typename edges_map_t::const_iterator;
 	using const_reverse_iterator = typename edges_map_t::const_reverse_iterator;
 	/**\brief Handy self type */
-	using self_t = CDirectedGraph<TYPE_EDGES, EDGE_ANNOTATIONS>;
+	using self_t =
+		CDirectedGraph<TYPE_EDGES, EDGE_ANNOTATIONS, EDGES_IMPLEMENTATION>;
 
 	/** The public member with the directed edges in the graph */
 	edges_map_t edges;
 
-	/** Copy constructor from a multimap<pair< >, > */
+	/** Copy constructor from a multimap<pair< >, > (or the container set by
+	 * \a EDGES_IMPLEMENTATION) */
 	inline CDirectedGraph(const edges_map_t& obj) : edges(obj) {}
 	/** Default constructor */
 	inline CDirectedGraph() : edges() {}
@@ -11,6 +11,8 @@
 #include <mrpt/system/COutputLogger.h>
 #include <mrpt/math/CMatrix.h>
 #include <mrpt/math/ops_matrices.h>
+#include <utility>
+#include <vector>
 
 namespace mrpt
 {
@@ -19,6 +21,15 @@ namespace mrpt
  */
 namespace graphs
 {
+/** A sparse, symmetric weights matrix of an undirected graph: element "i"
+ * holds the pairs (j, W<sub>ij</sub>) for all nonzero W<sub>ij</sub>, with
+ * j != i and sorted by "j". Symmetry (W<sub>ij</sub>=W<sub>ji</sub>) must be
+ * kept by the user. \sa CGraphPartitioner
+ */
+template <typename num_t>
+using sparse_adjacency_t =
+	std::vector<std::vector<std::pair<uint32_t, num_t>>>;
+
 /** Algorithms for finding the min-normalized-cut of a weighted undirected
  * graph.
  *    Two methods are provided, one for bisection and the other for
@@ -33,6 +44,11 @@ namespace graphs
  * \tparam num_t The type of matrix elements, thresholds, etc. (typ: float or
  * double). Defaults to the type of matrix elements.
  *
+ * Overloads taking a mrpt::graphs::sparse_adjacency_t instead of a dense
+ * matrix are also provided: they never build dense matrices, and find the
+ * Fiedler vector of the Laplacian with an iterative Lanczos solver, so they
+ * scale to graphs with many thousands of nodes.
+ *
  * \note Prior to MRPT 1.0.0 this class wasn't a template and provided static
  * variables for debugging, which were removed since that version.
  */
@@ -142,6 +158,48 @@ class CGraphPartitioner : public mrpt::system::COutputLogger
 		const GRAPH_MATRIX& in_A, const std::vector<uint32_t>& in_part1,
 		const std::vector<uint32_t>& in_part2);
 
+	/** @name Sparse graphs
+		@{ */
+
+	/** Like the dense RecursiveSpectralPartition(), for a sparse symmetric
+	 * weights matrix (it always uses spectral bisection).
+	 * \param in_out_fiedler [IN/OUT] Optional. If given, its contents (e.g.
+	 * the result of a previous call for a slightly different graph) are used
+	 * as the initial guess for the first bisection, and it is set to its
+	 * final Fiedler vector.
+	 */
+	static void RecursiveSpectralPartition(
+		const sparse_adjacency_t<num_t>& in_A,
+		std::vector<std::vector<uint32_t>>& out_parts,
+		num_t threshold_Ncut = 1, bool recursive = true,
+		unsigned minSizeClusters = 1, const bool verbose = false,
+		std::vector<num_t>* in_out_fiedler = nullptr);
+
+	/** Like the dense SpectralBisection(), for a sparse symmetric weights
+	 * matrix. \sa FiedlerVector */
+	static void SpectralBisection(
+		const sparse_adjacency_t<num_t>& in_A,
+		std::vector<uint32_t>& out_part1, std::vector<uint32_t>& out_part2,
+		num_t& out_cut_value, std::vector<num_t>* in_out_fiedler = nullptr);
+
+	/** Computes the eigenvector of the second smallest eigenvalue of the
+	 * Laplacian L=D-W of a sparse graph, with a restarted Lanczos method
+	 * with full reorthogonalization over (at most) 40-dimensional Krylov
+	 * subspaces, so each iteration costs O(E+40N).
+	 * \param in_out_v [IN/OUT] If it has one entry per node, it is used as
+	 * initial guess. On output, the unit-norm Fiedler vector.
+	 * \return The number of (sparse) matrix-vector products done.
+	 */
+	static size_t FiedlerVector(
+		const sparse_adjacency_t<num_t>& in_A, std::vector<num_t>& in_out_v);
+
+	/** The normalized cut of a sparse graph, given a bisection */
+	static num_t nCut(
+		const sparse_adjacency_t<num_t>& in_A,
+		const std::vector<uint32_t>& in_part1,
+		const std::vector<uint32_t>& in_part2);
+	/** @} */
+
 };  // End of class def.
 
 }  // namespace graphs
@@ -13,6 +13,10 @@
 #error "This file can't be included from outside of CGraphPartitioner.h"
 #endif
 
+#include <Eigen/Dense>
+#include <cmath>
+#include <iostream>
+
 namespace mrpt::graphs
 {
 /*---------------------------------------------------------------
@@ -351,4 +355,268 @@ void CGraphPartitioner<GRAPH_MATRIX, num_t>::exactBisection(
 	}
 }
 
+/*---------------------------------------------------------------
+					FiedlerVector (sparse)
+  ---------------------------------------------------------------*/
+template <class GRAPH_MATRIX, typename num_t>
+size_t CGraphPartitioner<GRAPH_MATRIX, num_t>::FiedlerVector(
+	const sparse_adjacency_t<num_t>& in_A, std::vector<num_t>& in_out_v)
+{
+	MRPT_START
+	using vec_t = Eigen::VectorXd;
+	const size_t n = in_A.size();
+	ASSERT_(n >= 2);
+
+	// Lanczos finds extreme eigenvalues first, so work with M = s*I - L,
+	// with s >= the largest eigenvalue of L, whose largest eigenvalue in the
+	// subspace orthogonal to the constant vector (the eigenvector of L for
+	// lambda=0) is the one we look for:
+	vec_t deg(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		double d = 0;
+		for (const auto& e : in_A[i]) d += e.second;
+		deg[i] = d;
+	}
+	const double s = 2 * deg.maxCoeff() + 1e-12;
+	size_t nProducts = 0;
+	auto mult_M = [&](const vec_t& x, vec_t& y) {
+		for (size_t i = 0; i < n; i++)
+		{
+			double Wx = 0;
+			for (const auto& e : in_A[i]) Wx += e.second * x[e.first];
+			y[i] = (s - deg[i]) * x[i] + Wx;
+		}
+		y.array() -= y.mean();  // Keep it orthogonal to (1,...,1)
+		nProducts++;
+	};
+
+	// Initial guess: the given vector, plus a bit of an arbitrary
+	// non-symmetric one. A previous solution may be exactly orthogonal to
+	// the new Fiedler vector (e.g. if it is zero for all the nodes added
+	// since then), and the Krylov subspace would never reach it.
+	vec_t x(n), x0(n);
+	for (size_t i = 0; i < n; i++) x0[i] = i + 0.5 * std::cos(double(i));
+	x0.array() -= x0.mean();
+	x0.normalize();
+	if (in_out_v.size() == n)
+		for (size_t i = 0; i < n; i++) x[i] = in_out_v[i];
+	else
+		x.setZero();
+	x.array() -= x.mean();
+	if (x.norm() < 1e-9)
+		x = x0;
+	else
+		x = x.normalized() + 1e-2 * x0;
+	x.normalize();
+
+	const size_t m = std::min<size_t>(n - 1, 40);  // Krylov subspace size
+	const size_t max_restarts = 100;
+	const double tol = 1e-7 * s;  // Max. residual norm ||M*x-lambda*x||
+	Eigen::MatrixXd Q(n, m);
+	vec_t w(n), alpha(m), beta(m);
+	for (size_t restart = 0; restart < max_restarts; restart++)
+	{
+		// Lanczos iterations, with full reorthogonalization, until the Ritz
+		// pair for the largest eigenvalue converges:
+		Q.col(0) = x;
+		bool converged = false;
+		for (size_t k = 0; k < m; k++)
+		{
+			mult_M(Q.col(k), w);
+			alpha[k] = Q.col(k).dot(w);
+			for (int pass = 0; pass < 2; pass++)
+			{
+				const vec_t h = Q.leftCols(k + 1).transpose() * w;
+				w -= Q.leftCols(k + 1) * h;
+			}
+			beta[k] = w.norm();
+
+			Eigen::MatrixXd T = Eigen::MatrixXd::Zero(k + 1, k + 1);
+			for (size_t i = 0; i <= k; i++)
+			{
+				T(i, i) = alpha[i];
+				if (i < k) T(i, i + 1) = T(i + 1, i) = beta[i];
+			}
+			Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(T);
+			const vec_t y = es.eigenvectors().col(k);
+			// Residual norm of the Ritz pair, ||M*x-lambda*x||:
+			converged = std::abs(beta[k] * y[k]) < tol;
+			if (converged || k + 1 == m)
+			{
+				x = Q.leftCols(k + 1) * y;
+				break;
+			}
+			Q.col(k + 1) = w / beta[k];
+		}
+		x.array() -= x.mean();
+		x.normalize();
+		if (converged) break;
+	}
+
+	in_out_v.resize(n);
+	for (size_t i = 0; i < n; i++) in_out_v[i] = static_cast<num_t>(x[i]);
+	return nProducts;
+	MRPT_END
+}
+
+/*---------------------------------------------------------------
+					SpectralBisection (sparse)
+  ---------------------------------------------------------------*/
+template <class GRAPH_MATRIX, typename num_t>
+void CGraphPartitioner<GRAPH_MATRIX, num_t>::SpectralBisection(
+	const sparse_adjacency_t<num_t>& in_A, std::vector<uint32_t>& out_part1,
+	std::vector<uint32_t>& out_part2, num_t& out_cut_value,
+	std::vector<num_t>* in_out_fiedler)
+{
+	const size_t nodeCount = in_A.size();
+	ASSERT_(nodeCount >= 2);
+
+	std::vector<num_t> v;
+	if (in_out_fiedler) v = *in_out_fiedler;
+	FiedlerVector(in_A, v);
+	if (in_out_fiedler) *in_out_fiedler = v;
+
+	double mean = 0;
+	for (size_t i = 0; i < nodeCount; i++) mean += v[i];
+	mean /= nodeCount;
+
+	out_part1.clear();
+	out_part2.clear();
+	for (size_t i = 0; i < nodeCount; i++)
+	{
+		if (v[i] >= mean)
+			out_part1.push_back(i);
+		else
+			out_part2.push_back(i);
+	}
+
+	// Constant eigenvector: Split nodes in two equally sized parts:
+	if (!out_part1.size() || !out_part2.size())
+	{
+		out_part1.clear();
+		out_part2.clear();
+		for (size_t i = 0; i < nodeCount; i++)
+			if (i <= nodeCount / 2)
+				out_part1.push_back(i);
+			else
+				out_part2.push_back(i);
+	}
+
+	out_cut_value = nCut(in_A, out_part1, out_part2);
+}
+
+/*---------------------------------------------------------------
+					RecursiveSpectralPartition (sparse)
+  ---------------------------------------------------------------*/
+template <class GRAPH_MATRIX, typename num_t>
+void CGraphPartitioner<GRAPH_MATRIX, num_t>::RecursiveSpectralPartition(
+	const sparse_adjacency_t<num_t>& in_A,
+	std::vector<std::vector<uint32_t>>& out_parts, num_t threshold_Ncut,
+	bool recursive, unsigned minSizeClusters, const bool verbose,
+	std::vector<num_t>* in_out_fiedler)
+{
+	MRPT_START
+
+	const size_t nodeCount = in_A.size();
+	out_parts.clear();
+	if (!nodeCount) return;
+
+	std::vector<uint32_t> p1, p2;
+	if (nodeCount == 1)
+	{
+		// Don't split, there is just a node!
+		p1.push_back(0);
+		out_parts.push_back(p1);
+		return;
+	}
+
+	num_t cut_value;
+	SpectralBisection(in_A, p1, p2, cut_value, in_out_fiedler);
+
+	if (verbose)
+		std::cout << format(
+			"Cut:%u=%u+%u,nCut=%.02f->", (unsigned int)nodeCount,
+			(unsigned int)p1.size(), (unsigned int)p2.size(), cut_value);
+
+	// Is it a useful partition?
+	if (cut_value > threshold_Ncut || p1.size() < minSizeClusters ||
+		p2.size() < minSizeClusters)
+	{
+		if (verbose) std::cout << "->NO!" << std::endl;
+
+		p1.clear();
+		for (size_t i = 0; i < nodeCount; i++) p1.push_back(i);
+		out_parts.push_back(p1);
+		return;
+	}
+	if (verbose) std::cout << "->YES!" << std::endl;
+
+	if (!recursive)
+	{
+		out_parts.push_back(p1);
+		out_parts.push_back(p2);
+		return;
+	}
+
+	// Split each part, taking care of the indices mapping:
+	std::vector<int64_t> new_idx(nodeCount);
+	for (const auto* p : {&p1, &p2})
+	{
+		std::fill(new_idx.begin(), new_idx.end(), -1);
+		for (size_t i = 0; i < p->size(); i++) new_idx[(*p)[i]] = i;
+
+		sparse_adjacency_t<num_t> A_sub(p->size());
+		for (size_t i = 0; i < p->size(); i++)
+			for (const auto& e : in_A[(*p)[i]])
+				if (new_idx[e.first] >= 0)
+					A_sub[i].emplace_back(new_idx[e.first], e.second);
+
+		std::vector<std::vector<uint32_t>> sub_parts;
+		RecursiveSpectralPartition(
+			A_sub, sub_parts, threshold_Ncut, recursive, minSizeClusters);
+		for (auto& sp : sub_parts)
+		{
+			for (auto& idx : sp) idx = (*p)[idx];
+			out_parts.push_back(sp);
+		}
+	}
+
+	MRPT_END
+}
+
+/*---------------------------------------------------------------
+						nCut (sparse)
+  ---------------------------------------------------------------*/
+template <class GRAPH_MATRIX, typename num_t>
+num_t CGraphPartitioner<GRAPH_MATRIX, num_t>::nCut(
+	const sparse_adjacency_t<num_t>& in_A,
+	const std::vector<uint32_t>& in_part1,
+	const std::vector<uint32_t>& in_part2)
+{
+	std::vector<uint8_t> in_1(in_A.size(), 0), in_2(in_A.size(), 0);
+	for (auto i : in_part1) in_1[i] = 1;
+	for (auto i : in_part2) in_2[i] = 1;
+
+	num_t cut_AB = 0, assoc_AA = 0, assoc_BB = 0;
+	for (auto i : in_part1)
+		for (const auto& e : in_A[i])
+		{
+			if (in_2[e.first]) cut_AB += e.second;
+			// Each pair is visited twice:
+			if (in_1[e.first]) assoc_AA += 0.5 * e.second;
+		}
+	for (auto i : in_part2)
+		for (const auto& e : in_A[i])
+			if (in_2[e.first]) assoc_BB += 0.5 * e.second;
+
+	const num_t assoc_AV = assoc_AA + cut_AB;
+	const num_t assoc_BV = assoc_BB + cut_AB;
+
+	if (!cut_AB)
+		return 0;
+	else
+		return cut_AB / assoc_AV + cut_AB / assoc_BV;
+}
+
 }  // namespace mrpt::graphs
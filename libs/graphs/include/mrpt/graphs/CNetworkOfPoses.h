@@ -16,6 +16,7 @@
 #include <iostream>
 
 #include <mrpt/graphs/CDirectedGraph.h>
+#include <mrpt/graphs/compact_edges_map.h>
 #include <mrpt/graphs/CDirectedTree.h>
 #include <mrpt/serialization/CSerializable.h>
 #include <mrpt/io/CFileGZInputStream.h>
@@ -106,7 +107,9 @@ class CMRVisualizer;
  *value or a Gaussian, etc.)
  *		- MAPS_IMPLEMENTATION: Can be either mrpt::containers::map_traits_stdmap
  *or mrpt::containers::map_traits_map_as_vector. Determines the type of the list
- *of global poses (member \a nodes).
+ *of global poses (member \a nodes). Use mrpt::graphs::map_traits_compact to,
+ *in addition, store all the \a edges contiguously in a
+ *mrpt::graphs::compact_edges_map<> instead of a std::multimap<>.
  *
  * \sa mrpt::graphslam
  * \ingroup mrpt_graphs_grp
@@ -119,13 +122,17 @@ template <
 	class NODE_ANNOTATIONS = mrpt::graphs::detail::TNodeAnnotationsEmpty,
 	class EDGE_ANNOTATIONS = mrpt::graphs::detail::edge_annotations_empty>
 class CNetworkOfPoses
-	: public mrpt::graphs::CDirectedGraph<CPOSE, EDGE_ANNOTATIONS>
+	: public mrpt::graphs::CDirectedGraph<
+		  CPOSE, EDGE_ANNOTATIONS,
+		  typename detail::edges_traits_of<MAPS_IMPLEMENTATION>::type>
 {
    public:
 	/** @name Typedef's
 		@{ */
-	/** The base class "CDirectedGraph<CPOSE,EDGE_ANNOTATIONS>" */
-	using BASE = mrpt::graphs::CDirectedGraph<CPOSE, EDGE_ANNOTATIONS>;
+	/** The base class "CDirectedGraph<CPOSE,EDGE_ANNOTATIONS,...>" */
+	using BASE = mrpt::graphs::CDirectedGraph<
+		CPOSE, EDGE_ANNOTATIONS,
+		typename detail::edges_traits_of<MAPS_IMPLEMENTATION>::type>;
 	/** My own type */
 	using self_t = CNetworkOfPoses<
 		CPOSE, MAPS_IMPLEMENTATION, NODE_ANNOTATIONS, EDGE_ANNOTATIONS>;
@@ -1031,6 +1038,7 @@ namespace typemeta
 {
 MRPT_DECLARE_TTYPENAME(mrpt::containers::map_traits_stdmap)
 MRPT_DECLARE_TTYPENAME(mrpt::containers::map_traits_map_as_vector)
+MRPT_DECLARE_TTYPENAME(mrpt::graphs::map_traits_compact)
 }  // namespace typemeta
 
 }  // namespace mrpt
@@ -720,41 +720,25 @@ struct graph_ops
 	static size_t graph_of_poses_collapse_dup_edges(graph_t* g)
 	{
 		MRPT_START
-		using TEdgeIterator = typename graph_t::edges_map_t::iterator;
-
-		// Data structure: (id1,id2) -> all edges between them
-		//  (with id1 < id2)
-		using TListAllEdges =
-			map<pair<TNodeID, TNodeID>,
-				vector<TEdgeIterator>>;  // For god's sake... when will ALL
-										 // compilers support
-		// auto!! :'-(
-		TListAllEdges lstAllEdges;
-
-		// Clasify all edges to identify duplicated ones:
-		for (TEdgeIterator itEd = g->edges.begin(); itEd != g->edges.end();
-			 ++itEd)
+		// Pairs <id1,id2> (with id1 < id2) already seen: all later edges
+		// between them are removed in the same pass, so no iterators have to
+		// be kept across erasures (which a compact_edges_map invalidates).
+		std::set<pair<TNodeID, TNodeID>> seenArcs;
+
+		size_t nRemoved = 0;
+		for (auto itEd = g->edges.begin(); itEd != g->edges.end();)
 		{
 			// Build a pair <id1,id2> with id1 < id2:
 			const pair<TNodeID, TNodeID> arc_id = make_pair(
 				std::min(itEd->first.first, itEd->first.second),
 				std::max(itEd->first.first, itEd->first.second));
-			// get (or create the first time) the list of edges between them:
-			vector<TEdgeIterator>& lstEdges = lstAllEdges[arc_id];
-			// And add this one:
-			lstEdges.push_back(itEd);
-		}
-
-		// Now, remove all but the first edge:
-		size_t nRemoved = 0;
-		for (typename TListAllEdges::const_iterator it = lstAllEdges.begin();
-			 it != lstAllEdges.end(); ++it)
-		{
-			const size_t N = it->second.size();
-			for (size_t i = 1; i < N; i++)  // i=0 is NOT removed
-				g->edges.erase(it->second[i]);
-
-			if (N >= 2) nRemoved += N - 1;
+			if (seenArcs.insert(arc_id).second)
+				++itEd;  // The first one is NOT removed
+			else
+			{
+				itEd = g->edges.erase(itEd);
+				nRemoved++;
+			}
 		}
 
 		return nRemoved;
@@ -956,9 +940,7 @@ struct graph_ops
 	// --------------------------------------------------------------------------------
 	static double graph_edge_sqerror(
 		const graph_t* g,
-		const typename mrpt::graphs::CDirectedGraph<
-			typename graph_t::constraint_t>::edges_map_t::const_iterator&
-			itEdge,
+		const typename graph_t::edges_map_t::const_iterator& itEdge,
 		bool ignoreCovariances)
 	{
 		MRPT_START
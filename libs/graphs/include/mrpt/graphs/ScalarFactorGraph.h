@@ -12,6 +12,7 @@
 #include <mrpt/system/COutputLogger.h>
 #include <mrpt/system/CTimeLogger.h>
 #include <deque>
+#include <memory>
 
 namespace mrpt::graphs
 {
@@ -27,13 +28,14 @@ namespace mrpt::graphs
  *   - Linear error functions (for now).
  *   - Scalar (1-dim) error functions.
  *   - Gaussian factors.
- *   - Solver: Eigen SparseQR.
+ *   - Solver: Eigen SparseQR, or a sparse Cholesky factorization (see
+ * TSolverType).
  *
  *  Usage:
  *   - Call initialize() to set the number of nodes.
  *   - Call addConstraints() to insert constraints. This may be called more than
  * once.
- *   - Call updateEstimation() to run one step of the linear SparseQR solver.
+ *   - Call updateEstimation() to run one step of the linear solver.
  *
  * \ingroup mrpt_graph_grp
  * \note [New in MRPT 1.5.0] Requires Eigen>=3.1
@@ -42,6 +44,26 @@ class ScalarFactorGraph : public mrpt::system::COutputLogger
 {
    public:
 	ScalarFactorGraph();
+	ScalarFactorGraph(const ScalarFactorGraph& o);
+	ScalarFactorGraph& operator=(const ScalarFactorGraph& o);
+	~ScalarFactorGraph();
+
+	/** Linear solvers for updateEstimation() \sa setSolver() */
+	enum TSolverType
+	{
+		/** Eigen SparseQR of the weighted Jacobian, computed from scratch in
+		   each call (Default) */
+		solverSparseQR = 0,
+		/** Sparse LDL^T of the information matrix. Its fill-reducing ordering
+		 * and symbolic factorization are kept between calls while the
+		 * number of nodes and the binary factors do not change, so adding or
+		 * removing unary factors (e.g. new readings in a GMRF map) only
+		 * requires a numeric refactorization. Variances are recovered by
+		 * selective inversion, only over the nonzero pattern of the factor.
+		 * Falls back to SparseQR if the information matrix is singular, e.g.
+		 * before any unary factor is added. */
+		solverSparseCholesky
+	};
 
 	struct FactorBase
 	{
@@ -90,7 +112,11 @@ class ScalarFactorGraph : public mrpt::system::COutputLogger
 	bool eraseConstraint(const FactorBase& c);
 
 	void clearAllConstraintsByType_Unary() { m_factors_unary.clear(); }
-	void clearAllConstraintsByType_Binary() { m_factors_binary.clear(); }
+	void clearAllConstraintsByType_Binary()
+	{
+		m_factors_binary.clear();
+		m_cholesky_needs_analysis = true;
+	}
 	void updateEstimation(
 		/** Output increment of the current estimate. Caller must add this
 		   vector to current state vector to obtain the optimal estimation. */
@@ -98,6 +124,11 @@ class ScalarFactorGraph : public mrpt::system::COutputLogger
 		/** If !=nullptr, the variances of each estimate will be stored here. */
 		Eigen::VectorXd* solved_variances = nullptr);
 
+	/** Selects the linear solver of updateEstimation() (Default:
+	 * solverSparseQR) */
+	void setSolver(TSolverType solver) { m_solver = solver; }
+	TSolverType getSolver() const { return m_solver; }
+
 	bool isProfilerEnabled() const { return m_enable_profiler; }
 	void enableProfiler(bool enable = true) { m_enable_profiler = enable; }
    private:
@@ -110,6 +141,18 @@ class ScalarFactorGraph : public mrpt::system::COutputLogger
 	mrpt::system::CTimeLogger m_timelogger;
 	bool m_enable_profiler;
 
+	TSolverType m_solver{solverSparseQR};
+	/** Cached state of the sparse Cholesky solver */
+	struct CholeskyState;
+	std::unique_ptr<CholeskyState> m_cholesky;
+	/** Whether the sparsity pattern of the information matrix changed */
+	bool m_cholesky_needs_analysis{true};
+
+	/** Solves the system with solverSparseCholesky. Returns false if the
+	 * information matrix is singular. */
+	bool updateEstimationCholesky(
+		Eigen::VectorXd& solved_x_inc, Eigen::VectorXd* solved_variances);
+
 };  // End of class def.
 
 }
@@ -0,0 +1,435 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+#pragma once
+
+#include <mrpt/core/aligned_std_vector.h>
+#include <mrpt/core/exceptions.h>
+#include <mrpt/containers/traits_map.h>
+#include <mrpt/graphs/TNodeID.h>
+#include <mrpt/serialization/stl_serialization.h>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mrpt::graphs
+{
+/** \addtogroup mrpt_graphs_grp
+	@{ */
+
+/** A STL-like container which looks and behaves like the
+ * std::multimap<TPairNodeIDs,EDGE> used by default for
+ * mrpt::graphs::CDirectedGraph::edges, but stores all edges in one contiguous
+ * (memory-aligned) std::vector<>, plus a dense per-node adjacency index.
+ *
+ * Edges are appended to the vector in insertion order and never moved while
+ * they exist (but for erasures, which move the last edge into the gap). For
+ * each "from" node ID, the index keeps the list of its out-edges sorted by the
+ * "to" node ID, so find() is a binary search among the out-edges of one node
+ * and iterators visit edges in the same order than the std::multimap (with
+ * edges between the same pair of nodes kept in insertion order). Algorithms
+ * which do not care about the order may also walk over getVector() directly.
+ *
+ * Differences wrt std::multimap<>:
+ *  - Elements are <code>std::pair<TPairNodeIDs,EDGE></code> (the key is NOT
+ *    const), but keys must never be modified through an iterator.
+ *  - Iterators are bidirectional, and any insertion or erasure invalidates
+ *    all of them (but the one returned by erase()).
+ *  - The size of the per-node index is the largest "from" node ID, so node
+ *    IDs should be dense (e.g. 0,1,...,N-1), as in any typical SLAM graph.
+ *
+ * \note Defined in #include <mrpt/graphs/compact_edges_map.h>
+ * \sa edges_traits_compact, map_traits_compact
+ */
+template <class EDGE>
+class compact_edges_map
+{
+   public:
+	using key_type = TPairNodeIDs;
+	using mapped_type = EDGE;
+	using value_type = std::pair<TPairNodeIDs, EDGE>;
+	using vec_t = mrpt::aligned_std_vector<value_type>;
+	using size_type = typename vec_t::size_type;
+
+   private:
+	/** An entry in the per-node index: the "to" node of an out-edge and its
+	 * position in m_edges */
+	struct TOutEdge
+	{
+		TNodeID to;
+		size_t idx;
+	};
+	using row_t = std::vector<TOutEdge>;
+
+	/** All edges, in insertion order */
+	vec_t m_edges;
+	/** m_rows[i]: out-edges of node "i", sorted by "to" */
+	std::vector<row_t> m_rows;
+
+	/** Iterates in (from,to) order, as a (node,position in its row) pair */
+	template <bool IS_CONST>
+	class iterator_t
+	{
+		using owner_t = std::conditional_t<
+			IS_CONST, const compact_edges_map, compact_edges_map>;
+
+	   public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = typename compact_edges_map<EDGE>::value_type;
+		using difference_type = std::ptrdiff_t;
+		using reference =
+			std::conditional_t<IS_CONST, const value_type&, value_type&>;
+		using pointer =
+			std::conditional_t<IS_CONST, const value_type*, value_type*>;
+
+		iterator_t() = default;
+		iterator_t(owner_t* owner, size_t node, size_t pos)
+			: m_owner(owner), m_node(node), m_pos(pos)
+		{
+			skipEmptyRows();
+		}
+		/** Conversion iterator -> const_iterator */
+		template <bool C = IS_CONST, typename = std::enable_if_t<C>>
+		iterator_t(const iterator_t<false>& o)
+			: m_owner(o.m_owner), m_node(o.m_node), m_pos(o.m_pos)
+		{
+		}
+
+		reference operator*() const
+		{
+			return m_owner->m_edges[m_owner->m_rows[m_node][m_pos].idx];
+		}
+		pointer operator->() const { return &**this; }
+		iterator_t& operator++()
+		{
+			++m_pos;
+			skipEmptyRows();
+			return *this;
+		}
+		iterator_t operator++(int)
+		{
+			iterator_t old = *this;
+			++*this;
+			return old;
+		}
+		iterator_t& operator--()
+		{
+			while (m_pos == 0) m_pos = m_owner->m_rows[--m_node].size();
+			--m_pos;
+			return *this;
+		}
+		iterator_t operator--(int)
+		{
+			iterator_t old = *this;
+			--*this;
+			return old;
+		}
+		friend bool operator==(const iterator_t& a, const iterator_t& b)
+		{
+			return a.m_node == b.m_node && a.m_pos == b.m_pos;
+		}
+		friend bool operator!=(const iterator_t& a, const iterator_t& b)
+		{
+			return !(a == b);
+		}
+
+	   private:
+		friend class compact_edges_map<EDGE>;
+		template <bool>
+		friend class iterator_t;
+
+		owner_t* m_owner = nullptr;
+		size_t m_node = 0, m_pos = 0;
+
+		void skipEmptyRows()
+		{
+			const auto& rows = m_owner->m_rows;
+			while (m_node < rows.size() && m_pos >= rows[m_node].size())
+			{
+				++m_node;
+				m_pos = 0;
+			}
+		}
+	};
+
+	/** Position of the first out-edge of \a from with "to" >= \a to (or >,
+	 * if \a upper) */
+	size_t rowBound(const row_t& row, const TNodeID to, bool upper) const
+	{
+		if (upper)
+			return std::upper_bound(
+					   row.begin(), row.end(), to,
+					   [](const TNodeID t, const TOutEdge& e) {
+						   return t < e.to;
+					   }) -
+				   row.begin();
+		else
+			return std::lower_bound(
+					   row.begin(), row.end(), to,
+					   [](const TOutEdge& e, const TNodeID t) {
+						   return e.to < t;
+					   }) -
+				   row.begin();
+	}
+
+   public:
+	/** @name Iterators stuff
+		@{ */
+	using iterator = iterator_t<false>;
+	using const_iterator = iterator_t<true>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	inline iterator begin() { return iterator(this, 0, 0); }
+	inline iterator end() { return iterator(this, m_rows.size(), 0); }
+	inline const_iterator begin() const { return const_iterator(this, 0, 0); }
+	inline const_iterator end() const
+	{
+		return const_iterator(this, m_rows.size(), 0);
+	}
+	inline const_iterator cbegin() const { return begin(); }
+	inline const_iterator cend() const { return end(); }
+	inline reverse_iterator rbegin() { return reverse_iterator(end()); }
+	inline const_reverse_iterator rbegin() const
+	{
+		return const_reverse_iterator(end());
+	}
+	inline reverse_iterator rend() { return reverse_iterator(begin()); }
+	inline const_reverse_iterator rend() const
+	{
+		return const_reverse_iterator(begin());
+	}
+	/** @} */
+
+	/** @name Read/write access and other operations
+		@{ */
+	inline size_type size() const { return m_edges.size(); }
+	inline bool empty() const { return m_edges.empty(); }
+	inline size_type max_size() const { return m_edges.max_size(); }
+	/** Reserve memory for \a n edges */
+	inline void reserve(size_type n) { m_edges.reserve(n); }
+	/** Read-only access to the contiguous vector of all edges, in an
+	 * unspecified order (insertion order, if there were no erasures) */
+	inline const vec_t& getVector() const { return m_edges; }
+	inline void clear()
+	{
+		m_edges.clear();
+		m_rows.clear();
+	}
+	inline void swap(compact_edges_map<EDGE>& o)
+	{
+		m_edges.swap(o.m_edges);
+		m_rows.swap(o.m_rows);
+	}
+
+	/** Insert an edge after all existing edges with the same pair of node
+	 * IDs: O(1) (amortized) plus a shift in the out-edges of its node. */
+	iterator insert(value_type v)
+	{
+		const TNodeID from = v.first.first, to = v.first.second;
+		ASSERT_(from != INVALID_NODEID);
+		if (m_rows.size() <= from) m_rows.resize(from + 1);
+		row_t& row = m_rows[from];
+		const size_t pos = rowBound(row, to, true);
+		row.insert(row.begin() + pos, TOutEdge{to, m_edges.size()});
+		m_edges.push_back(std::move(v));
+		return iterator(this, from, pos);
+	}
+	/** \overload (the hint is ignored) */
+	inline iterator insert(const_iterator hint, value_type v)
+	{
+		(void)hint;
+		return insert(std::move(v));
+	}
+	template <typename... Args>
+	inline iterator emplace(Args&&... args)
+	{
+		return insert(value_type(std::forward<Args>(args)...));
+	}
+
+	/** Erase one edge, returning an iterator to the next one */
+	iterator erase(const_iterator it)
+	{
+		row_t& row = m_rows[it.m_node];
+		const size_t idx = row[it.m_pos].idx, last = m_edges.size() - 1;
+		row.erase(row.begin() + it.m_pos);
+		if (idx != last)
+		{
+			// Move the last edge into the gap, and update its index entry:
+			m_edges[idx] = std::move(m_edges[last]);
+			const auto& k = m_edges[idx].first;
+			for (auto& e : m_rows[k.first])
+				if (e.idx == last)
+				{
+					e.idx = idx;
+					break;
+				}
+		}
+		m_edges.pop_back();
+		return iterator(this, it.m_node, it.m_pos);
+	}
+	/** Erase a range of edges, returning an iterator to the next one */
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		for (auto n = std::distance(first, last); n > 0; n--)
+			first = erase(first);
+		return iterator(this, first.m_node, first.m_pos);
+	}
+	/** Erase all edges between the given pair of nodes, returning how many
+	 * were removed */
+	size_type erase(const key_type& k)
+	{
+		const auto r = equal_range(k);
+		const size_type n = std::distance(r.first, r.second);
+		erase(r.first, r.second);
+		return n;
+	}
+
+	/** Return the first edge between the given pair of nodes, or end() */
+	inline iterator find(const key_type& k)
+	{
+		const auto it = std::as_const(*this).find(k);
+		return iterator(this, it.m_node, it.m_pos);
+	}
+	const_iterator find(const key_type& k) const
+	{
+		if (k.first >= m_rows.size()) return end();
+		const row_t& row = m_rows[k.first];
+		const size_t pos = rowBound(row, k.second, false);
+		if (pos == row.size() || row[pos].to != k.second) return end();
+		return const_iterator(this, k.first, pos);
+	}
+	inline size_type count(const key_type& k) const
+	{
+		if (k.first >= m_rows.size()) return 0;
+		const row_t& row = m_rows[k.first];
+		return rowBound(row, k.second, true) - rowBound(row, k.second, false);
+	}
+	inline iterator lower_bound(const key_type& k)
+	{
+		const auto it = std::as_const(*this).lower_bound(k);
+		return iterator(this, it.m_node, it.m_pos);
+	}
+	const_iterator lower_bound(const key_type& k) const
+	{
+		if (k.first >= m_rows.size()) return end();
+		return const_iterator(
+			this, k.first, rowBound(m_rows[k.first], k.second, false));
+	}
+	inline iterator upper_bound(const key_type& k)
+	{
+		const auto it = std::as_const(*this).upper_bound(k);
+		return iterator(this, it.m_node, it.m_pos);
+	}
+	const_iterator upper_bound(const key_type& k) const
+	{
+		if (k.first >= m_rows.size()) return end();
+		return const_iterator(
+			this, k.first, rowBound(m_rows[k.first], k.second, true));
+	}
+	inline std::pair<iterator, iterator> equal_range(const key_type& k)
+	{
+		return std::make_pair(lower_bound(k), upper_bound(k));
+	}
+	inline std::pair<const_iterator, const_iterator> equal_range(
+		const key_type& k) const
+	{
+		return std::make_pair(lower_bound(k), upper_bound(k));
+	}
+
+	/** Range of all the edges leaving node \a from, in O(1) */
+	std::pair<const_iterator, const_iterator> outEdges(
+		const TNodeID from) const
+	{
+		if (from >= m_rows.size()) return {end(), end()};
+		return {const_iterator(this, from, 0),
+				const_iterator(this, from + 1, 0)};
+	}
+	/** Number of edges leaving node \a from, in O(1) */
+	inline size_type outDegree(const TNodeID from) const
+	{
+		return from < m_rows.size() ? m_rows[from].size() : 0;
+	}
+
+	inline bool operator==(const compact_edges_map<EDGE>& o) const
+	{
+		return size() == o.size() && std::equal(begin(), end(), o.begin());
+	}
+	inline bool operator!=(const compact_edges_map<EDGE>& o) const
+	{
+		return !(*this == o);
+	}
+	/** @} */
+};
+
+/** Serializes a compact_edges_map<> with the same format than the equivalent
+ * std::multimap<>, so both containers can read each other's data. */
+template <class EDGE>
+mrpt::serialization::CArchive& operator<<(
+	mrpt::serialization::CArchive& out, const compact_edges_map<EDGE>& obj)
+{
+	using mrpt::typemeta::TTypeName;
+	out << std::string("std::multimap") << TTypeName<TPairNodeIDs>::get()
+		<< TTypeName<EDGE>::get();
+	out << static_cast<uint32_t>(obj.size());
+	for (const auto& e : obj) out << e.first << e.second;
+	return out;
+}
+
+/** Deserializes a compact_edges_map<> \sa operator<< */
+template <class EDGE>
+mrpt::serialization::CArchive& operator>>(
+	mrpt::serialization::CArchive& in, compact_edges_map<EDGE>& obj)
+{
+	using mrpt::typemeta::TTypeName;
+	obj.clear();
+	std::string pref, stored_K, stored_V;
+	in >> pref >> stored_K >> stored_V;
+	if (pref != "std::multimap" ||
+		stored_K != std::string(TTypeName<TPairNodeIDs>::get().c_str()) ||
+		stored_V != std::string(TTypeName<EDGE>::get().c_str()))
+		THROW_EXCEPTION_FMT(
+			"Error: serialized container %s<%s,%s> does not match "
+			"compact_edges_map<%s>",
+			pref.c_str(), stored_K.c_str(), stored_V.c_str(),
+			TTypeName<EDGE>::get().c_str());
+	uint32_t n;
+	in >> n;
+	obj.reserve(n);
+	for (uint32_t i = 0; i < n; i++)
+	{
+		TPairNodeIDs key;
+		in >> key;
+		// Read directly into the new ".second" (stored data is sorted, so
+		// this is always an O(1) insertion at the end):
+		auto it = obj.insert(std::make_pair(key, EDGE()));
+		in >> it->second;
+	}
+	return in;
+}
+
+/** Traits for using a mrpt::graphs::compact_edges_map<> as the container of
+ * edges in mrpt::graphs::CDirectedGraph \sa edges_traits_multimap */
+struct edges_traits_compact
+{
+	template <class EDGE>
+	using edges_map = mrpt::graphs::compact_edges_map<EDGE>;
+};
+
+/** Implementation of maps for mrpt::graphs::CNetworkOfPoses which keeps
+ * \a nodes in a std::map<> (as mrpt::containers::map_traits_stdmap) but
+ * stores \a edges in a contiguous mrpt::graphs::compact_edges_map<>. */
+struct map_traits_compact : public mrpt::containers::map_traits_stdmap
+{
+	using edges_traits = edges_traits_compact;
+};
+
+/** @} */
+}  // namespace mrpt::graphs
@@ -13,8 +13,9 @@
 #include <mrpt/containers/traits_map.h>
 #include <mrpt/math/utils.h>
 
+#include <algorithm>
 #include <limits>
-#include <iostream>  // TODO - remove me
+#include <queue>
 #include <vector>
 #include <utility>
 #include <exception>
@@ -70,6 +71,10 @@ class NotConnectedGraph : public std::exception
  *  computes all the needed data, then successive calls to \a
  *  getShortestPathTo return the paths efficiently from the root.
  *
+ *  The search uses a binary heap over a compressed sparse row (CSR)
+ *  adjacency of the graph, built once from its edges, so it runs in
+ *  O((V+E) log V) time.
+ *
  *  The entire generated tree can be also retrieved with \a getTreeGraph.
  *
  *  Input graphs are represented by instances of (or classes derived from)
@@ -118,7 +123,6 @@ class CDijkstra
 	};
 
 	// Cached input data:
-	const TYPE_GRAPH& m_cached_graph;
 	const TNodeID m_source_node_ID;
 
 	// Private typedefs:
@@ -133,16 +137,115 @@ class CDijkstra
 	using id2id_map_t =
 		typename MAPS_IMPLEMENTATION::template map<TNodeID, TPrevious>;
 
+	/** One entry in the adjacency list of a node */
+	struct TAdjacency
+	{
+		/** Dense index of the neighbor node */
+		size_t neighbor;
+		/** The edge connecting both nodes (in either direction) */
+		const typename TYPE_GRAPH::edges_map_t::value_type* edge;
+		/** false: edge from this node to the neighbor; true: the opposite */
+		bool reverse;
+	};
+
 	// Intermediary and final results:
 	/** All the distances */
 	id2dist_map_t m_distances;
-	std::map<TNodeID, TDistance>
-		m_distances_non_visited;  // Use a std::map here in all cases.
 	id2id_map_t m_prev_node;
 	id2pairIDs_map_t m_prev_arc;
 	std::set<TNodeID> m_lstNode_IDs;
+	/** All the neighbors of every node, built along the CSR adjacency */
 	list_all_neighbors_t m_allNeighbors;
 
+	/** Node IDs in ascending order, so node with ID `m_node_IDs[i]` has the
+	 * dense index `i` */
+	std::vector<TNodeID> m_node_IDs;
+	/** CSR adjacency: the neighbors of the node with dense index `i` are
+	 * `m_adj[m_adj_offsets[i]]` to `m_adj[m_adj_offsets[i+1]-1]`, sorted by
+	 * neighbor, each of them only once. */
+	std::vector<size_t> m_adj_offsets;
+	std::vector<TAdjacency> m_adj;
+	/** The graph edge of m_prev_arc for each dense node index (nullptr for
+	 * the root and unreachable nodes) */
+	std::vector<const typename TYPE_GRAPH::edges_map_t::value_type*>
+		m_prev_edge;
+
+	/** Dense index of a node ID, or the number of nodes if not found */
+	size_t nodeIndex(const TNodeID id) const
+	{
+		const auto it =
+			std::lower_bound(m_node_IDs.begin(), m_node_IDs.end(), id);
+		return (it != m_node_IDs.end() && *it == id)
+				   ? static_cast<size_t>(it - m_node_IDs.begin())
+				   : m_node_IDs.size();
+	}
+
+	/** Builds the CSR adjacency from the graph edges, regardless of their
+	 * direction. For nodes connected by several edges, only the one that
+	 * `edges.find()` would return is kept: the first u->i edge, or the
+	 * first i->u if there is none. Self-loops are ignored. */
+	void buildAdjacency(const TYPE_GRAPH& graph)
+	{
+		const size_t nNodes = m_node_IDs.size();
+
+		// Count the neighbors of each node, then fill in place:
+		m_adj_offsets.assign(nNodes + 1, 0);
+		for (const auto& e : graph.edges)
+		{
+			if (e.first.first == e.first.second) continue;
+			m_adj_offsets[nodeIndex(e.first.first) + 1]++;
+			m_adj_offsets[nodeIndex(e.first.second) + 1]++;
+		}
+		for (size_t i = 0; i < nNodes; i++)
+			m_adj_offsets[i + 1] += m_adj_offsets[i];
+
+		m_adj.resize(m_adj_offsets[nNodes]);
+		std::vector<size_t> next(m_adj_offsets.begin(), m_adj_offsets.end());
+		for (const auto& e : graph.edges)
+		{
+			if (e.first.first == e.first.second) continue;
+			const size_t a = nodeIndex(e.first.first),
+						 b = nodeIndex(e.first.second);
+			m_adj[next[a]++] = TAdjacency{b, &e, false};
+			m_adj[next[b]++] = TAdjacency{a, &e, true};
+		}
+
+		// Sort by neighbor and remove duplicates, compacting the arrays:
+		size_t nOut = 0;
+		for (size_t i = 0; i < nNodes; i++)
+		{
+			const auto first = m_adj.begin() + m_adj_offsets[i],
+					   last = m_adj.begin() + m_adj_offsets[i + 1];
+			std::stable_sort(
+				first, last, [](const TAdjacency& x, const TAdjacency& y) {
+					return x.neighbor < y.neighbor ||
+						   (x.neighbor == y.neighbor && !x.reverse &&
+							y.reverse);
+				});
+			m_adj_offsets[i] = nOut;
+			for (auto it = first; it != last; ++it)
+				if (it == first || it->neighbor != (it - 1)->neighbor)
+					m_adj[nOut++] = *it;
+		}
+		m_adj_offsets[nNodes] = nOut;
+		m_adj.resize(nOut);
+
+		// The same neighbors, by node ID (plus self-loops, as in
+		// CDirectedGraph::getAdjacencyMatrix()):
+		m_allNeighbors.clear();
+		for (size_t i = 0; i < nNodes; i++)
+		{
+			if (m_adj_offsets[i] == m_adj_offsets[i + 1]) continue;
+			auto& neighbors = m_allNeighbors[m_node_IDs[i]];
+			for (size_t k = m_adj_offsets[i]; k < m_adj_offsets[i + 1]; k++)
+				neighbors.insert(
+					neighbors.end(), m_node_IDs[m_adj[k].neighbor]);
+		}
+		for (const auto& e : graph.edges)
+			if (e.first.first == e.first.second)
+				m_allNeighbors[e.first.first].insert(e.first.first);
+	}
+
    public:
 	/** @name Useful typedefs
 		@{ */
@@ -185,7 +288,7 @@ class CDijkstra
 		const graph_t& graph, const TNodeID source_node_ID,
 		functor_edge_weight_t functor_edge_weight = functor_edge_weight_t(),
 		functor_on_progress_t functor_on_progress = functor_on_progress_t())
-		: m_cached_graph(graph), m_source_node_ID(source_node_ID)
+		: m_source_node_ID(source_node_ID)
 	{
 		/*
 		1  function Dijkstra(G, w, s)
@@ -218,79 +321,52 @@ class CDijkstra
 				static_cast<unsigned long>(source_node_ID));
 		}
 
+		// Precompute all neighbors of all the nodes in the given graph:
+		m_node_IDs.assign(m_lstNode_IDs.begin(), m_lstNode_IDs.end());
+		buildAdjacency(graph);
+
 		// Init:
-		// m_distances: already initialized to infinity by default.
-		// m_prev_node: idem
-		// m_prev_arc: idem
-		// m_visited: idem
+		const double INF = std::numeric_limits<double>::max();
+		std::vector<double> dist(nNodes, INF);
+		std::vector<size_t> prev_node(nNodes, nNodes);
+		std::vector<const TAdjacency*> prev_arc(nNodes, nullptr);
+		std::vector<bool> visited(nNodes, false);
 		size_t visitedCount = 0;
-		m_distances[source_node_ID] = 0;
-		m_distances_non_visited[source_node_ID] = 0;
-
-		// Precompute all neighbors of all the nodes in the given graph:
-		graph.getAdjacencyMatrix(m_allNeighbors);
 
-		using namespace std;
+		// Min-heap of non-visited nodes with their known distances so far,
+		// which may have stale entries for nodes whose distance was later
+		// improved. Ties are broken by the lowest node ID.
+		using heap_entry_t = std::pair<double, size_t>;
+		std::priority_queue<
+			heap_entry_t, std::vector<heap_entry_t>,
+			std::greater<heap_entry_t>>
+			non_visited;
+		const size_t src = nodeIndex(source_node_ID);
+		dist[src] = 0;
+		non_visited.emplace(0, src);
 
-		TNodeID u;
 		// as long as there are nodes not yet visited.
-		do
-		{  // The algorithm:
-			// Find the nodeID with the minimum known distance so far
-			// considered:
-			double min_d = std::numeric_limits<double>::max();
-			u = INVALID_NODEID;
-
-			// No need to check if the min. distance node is not visited yet,
-			// since we
-			// keep two lists: m_distances_non_visited & m_distances
-			for (typename std::map<TNodeID, TDistance>::const_iterator itDist =
-					 m_distances_non_visited.begin();
-				 itDist != m_distances_non_visited.end(); ++itDist)
-			{
-				// TODO - remove these
-				// cout << "Current min distance: " << min_d << endl;
-				// cout << "itDist->first: " << itDist->first << endl;
-				// cout << "itDist->second (distance to this node): " <<
-				// itDist->second.dist << endl;
-
-				if (itDist->second.dist < min_d)
-				{
-					u = itDist->first;
-					min_d = itDist->second.dist;
-					// cout << "updating u, min_d... " << endl;
-				}
-				// cout << "finished for." << endl;
-			}
+		while (visitedCount < nNodes)
+		{
+			// Find the node with the minimum known distance so far:
+			while (!non_visited.empty() &&
+				   (visited[non_visited.top().second] ||
+					non_visited.top().first > dist[non_visited.top().second]))
+				non_visited.pop();
 
-			// make sure we have found the next nodeID from the available
+			// make sure we have found the next node from the available
 			// non-visited distances
-			if (u == INVALID_NODEID)
+			if (non_visited.empty())
 			{
 				std::set<TNodeID> nodeIDs_unconnected;
 
 				// for all the nodes in the graph
-				for (typename TYPE_GRAPH::global_poses_t::const_iterator n_it =
-						 graph.nodes.begin();
-					 n_it != graph.nodes.end(); ++n_it)
+				for (const auto& n : graph.nodes)
 				{
 					// have I already visited this node in Dijkstra?
-					bool have_traversed = false;
-					for (typename id2dist_map_t::const_iterator d_it =
-							 m_distances.begin();
-						 d_it != m_distances.end(); ++d_it)
-					{
-						if (n_it->first == d_it->first)
-						{
-							have_traversed = true;
-							break;
-						}
-					}
-
-					if (!have_traversed)
-					{
-						nodeIDs_unconnected.insert(n_it->first);
-					}
+					const size_t idx = nodeIndex(n.first);
+					if (idx == nNodes || dist[idx] == INF)
+						nodeIDs_unconnected.insert(n.first);
 				}
 
 				std::string err_str =
@@ -299,76 +375,51 @@ class CDijkstra
 					nodeIDs_unconnected, err_str);
 			}
 
-			// Update distance (for possible future reference...) and remove
-			// this node from "non-visited":
-			m_distances[u] = m_distances_non_visited[u];
-			m_distances_non_visited.erase(u);
-
+			const size_t u = non_visited.top().second;
+			const double min_d = non_visited.top().first;
+			non_visited.pop();
+			visited[u] = true;
 			visitedCount++;
 
 			// Let the user know about our progress...
 			if (functor_on_progress) functor_on_progress(graph, visitedCount);
 
 			// For each arc from "u":
-			const std::set<TNodeID>& neighborsOfU =
-				m_allNeighbors[u];  // graph.getNeighborsOf(u,neighborsOfU);
-			for (unsigned long i : neighborsOfU)
+			for (size_t k = m_adj_offsets[u]; k < m_adj_offsets[u + 1]; k++)
 			{
-					if (i == u) continue;  // ignore self-loops...
-
-				// the "edge_ui" may be searched here or a bit later, so the
-				// "bool" var will tell us.
-				typename graph_t::const_iterator edge_ui;
-				bool edge_ui_reverse = false;
-				bool edge_ui_found = false;
+				const TAdjacency& adj = m_adj[k];
+				const size_t i = adj.neighbor;
 
 				// Get weight of edge u<->i
-				double edge_ui_weight;
-				if (!functor_edge_weight)
-					edge_ui_weight = 1.;
-				else
-				{  // edge may be i->u or u->i:
-					edge_ui = graph.edges.find(std::make_pair(u, i));
-					if (edge_ui == graph.edges.end())
-					{
-						edge_ui = graph.edges.find(std::make_pair(i, u));
-						edge_ui_reverse = true;
-					}
-					ASSERT_(edge_ui != graph.edges.end());
-					edge_ui_weight = functor_edge_weight(
-						graph, edge_ui->first.first, edge_ui->first.second,
-						edge_ui->second);
-					edge_ui_found = true;
-				}
-
-				if ((min_d + edge_ui_weight) < m_distances[i].dist)
-				{  // the [] creates the entry if needed
-					// update m_distances, m_distances_non_visited
-					m_distances_non_visited[i].dist = min_d + edge_ui_weight;
-					m_distances[i].dist = min_d + edge_ui_weight;
-
-					m_prev_node[i].id = u;
-					// If still not done above, detect the direction of the arc
-					// now:
-					if (!edge_ui_found)
-					{
-						edge_ui = graph.edges.find(std::make_pair(u, i));
-						if (edge_ui == graph.edges.end())
-						{
-							edge_ui = graph.edges.find(std::make_pair(i, u));
-							edge_ui_reverse = true;
-						}
-						ASSERT_(edge_ui != graph.edges.end());
-					}
-
-					if (!edge_ui_reverse)
-						m_prev_arc[i] = std::make_pair(u, i);  // *u -> *i
-					else
-						m_prev_arc[i] = std::make_pair(i, u);  // *i -> *u
+				const double edge_ui_weight =
+					!functor_edge_weight
+						? 1.
+						: functor_edge_weight(
+							  graph, adj.edge->first.first,
+							  adj.edge->first.second, adj.edge->second);
+
+				if ((min_d + edge_ui_weight) < dist[i])
+				{
+					dist[i] = min_d + edge_ui_weight;
+					prev_node[i] = u;
+					prev_arc[i] = &adj;
+					non_visited.emplace(dist[i], i);
 				}
 			}
-		} while (visitedCount < nNodes);
+		}
 
+		// Save the results:
+		m_prev_edge.assign(nNodes, nullptr);
+		for (size_t i = 0; i < nNodes; i++)
+		{
+			if (dist[i] == INF) continue;
+			const TNodeID id = m_node_IDs[i];
+			m_distances[id] = dist[i];
+			if (!prev_arc[i]) continue;
+			m_prev_node[id].id = m_node_IDs[prev_node[i]];
+			m_prev_arc[id] = prev_arc[i]->edge->first;  // *u -> *i or *i -> *u
+			m_prev_edge[i] = prev_arc[i]->edge;
+		}
 	}  // end Dijkstra
 
 	/** @name Query Dijkstra results
@@ -397,9 +448,9 @@ class CDijkstra
 
 	/** Return the node ID of the tree root, as passed in the constructor */
 	inline TNodeID getRootNodeID() const { return m_source_node_ID; }
-	/** Return the adjacency matrix of the input graph, which is cached at
-	 * construction so if needed later just use this copy to avoid
-	 * recomputing it
+	/** Return the adjacency matrix of the input graph, which is computed
+	 * along the search in the constructor, so if needed later just use this
+	 * copy to avoid recomputing it
 	 *
 	 * \sa  mrpt::graphs::CDirectedGraph::getAdjacencyMatrix
 	 * */
@@ -470,16 +521,17 @@ class CDijkstra
 				out_tree.edges_to_children[id == id_from ? id_to : id_from];
 			TreeEdgeInfo newEdge(id);
 			newEdge.reverse = (id == id_from);  // true: root towards leafs.
-			typename graph_t::edges_map_t::const_iterator itEdgeData =
-				m_cached_graph.edges.find(std::make_pair(id_from, id_to));
+			const size_t i = nodeIndex(id);
+			const auto* edgeData =
+				i < m_prev_edge.size() ? m_prev_edge[i] : nullptr;
 			ASSERTMSG_(
-				itEdgeData != m_cached_graph.edges.end(),
+				edgeData != nullptr,
 				format(
 					"Edge %u->%u is in Dijkstra paths but not in original "
 					"graph!",
 					static_cast<unsigned int>(id_from),
 					static_cast<unsigned int>(id_to)));
-			newEdge.data = &itEdgeData->second;
+			newEdge.data = &edgeData->second;
 			edges.push_back(newEdge);
 		}
 
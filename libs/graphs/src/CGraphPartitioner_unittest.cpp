@@ -0,0 +1,136 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include <mrpt/graphs/CGraphPartitioner.h>
+#include <mrpt/math/CMatrixD.h>
+#include <mrpt/random.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+
+using namespace mrpt;
+using namespace mrpt::graphs;
+using namespace mrpt::math;
+using namespace std;
+
+using partitioner_t = CGraphPartitioner<CMatrixD, double>;
+
+// A few clusters of nodes, strongly connected among them and weakly
+// connected to the next cluster:
+static void buildClusteredGraph(
+	const size_t nClusters, const size_t clusterSize,
+	sparse_adjacency_t<double>& A_sparse, CMatrixD& A_dense)
+{
+	auto& rng = mrpt::random::getRandomGenerator();
+	const size_t N = nClusters * clusterSize;
+	A_dense.setZero(N, N);
+	for (size_t i = 0; i < N; i++)
+		for (size_t j = i + 1; j < N; j++)
+		{
+			const size_t ci = i / clusterSize, cj = j / clusterSize;
+			double w = 0;
+			if (ci == cj)
+				w = (rng.drawUniform(0, 1) < 0.5) ? rng.drawUniform(0.5, 1) : 0;
+			else if (cj == ci + 1 && rng.drawUniform(0, 1) < 0.05)
+				w = rng.drawUniform(0.01, 0.05);
+			A_dense(i, j) = A_dense(j, i) = w;
+		}
+	A_sparse.assign(N, {});
+	for (size_t i = 0; i < N; i++)
+		for (size_t j = 0; j < N; j++)
+			if (A_dense(i, j) != 0) A_sparse[i].emplace_back(j, A_dense(i, j));
+}
+
+static std::vector<std::vector<uint32_t>> sorted(
+	std::vector<std::vector<uint32_t>> parts)
+{
+	for (auto& p : parts) std::sort(p.begin(), p.end());
+	std::sort(parts.begin(), parts.end());
+	return parts;
+}
+
+TEST(CGraphPartitioner, sparseFiedlerVector)
+{
+	mrpt::random::getRandomGenerator().randomize(1234);
+	sparse_adjacency_t<double> As;
+	CMatrixD Ad;
+	buildClusteredGraph(2, 40, As, Ad);
+
+	// Dense reference: eigenvector of 2nd smallest eigenvalue of L=D-W:
+	const size_t N = As.size();
+	CMatrixD L(N, N);
+	L.setZero();
+	for (size_t i = 0; i < N; i++)
+		for (size_t j = 0; j < N; j++)
+			if (i != j)
+			{
+				L(i, j) = -Ad(i, j);
+				L(i, i) += Ad(i, j);
+			}
+	CMatrixD eigVecs, eigVals;
+	L.eigenVectors(eigVecs, eigVals);
+
+	std::vector<double> v;
+	const size_t nProducts = partitioner_t::FiedlerVector(As, v);
+	ASSERT_EQ(v.size(), N);
+	EXPECT_GT(nProducts, 0u);
+	double dot = 0;
+	for (size_t i = 0; i < N; i++) dot += v[i] * eigVecs(i, 1);
+	EXPECT_NEAR(std::abs(dot), 1.0, 1e-4);
+
+	// Warm start from the solution converges right away:
+	const size_t nProducts2 = partitioner_t::FiedlerVector(As, v);
+	EXPECT_LT(nProducts2, nProducts);
+}
+
+// A warm start orthogonal to the solution: the previous Fiedler vector of
+// the first cluster, before the second one was added.
+TEST(CGraphPartitioner, sparseFiedlerVectorOrthogonalWarmStart)
+{
+	const size_t N = 30;
+	sparse_adjacency_t<double> A(N);
+	for (size_t i = 0; i < N; i++)
+		for (size_t j = 0; j < N; j++)
+			if (i != j && (i < N / 2) == (j < N / 2)) A[i].emplace_back(j, 1.0);
+
+	std::vector<double> v(N, 0.0);
+	for (size_t i = 0; i < N / 2; i++) v[i] = (i % 2) ? 1.0 : -1.0;
+	v[N / 2 - 1] = 0;
+	partitioner_t::FiedlerVector(A, v);
+	for (size_t i = 0; i < N; i++)
+		EXPECT_NEAR(v[i], (v[0] > 0 ? 1 : -1) * (i < N / 2 ? 1 : -1) *
+							  std::sqrt(1.0 / N),
+					1e-4);
+}
+
+TEST(CGraphPartitioner, sparseVsDense)
+{
+	mrpt::random::getRandomGenerator().randomize(4321);
+	for (size_t nClusters = 1; nClusters <= 4; nClusters++)
+	{
+		sparse_adjacency_t<double> As;
+		CMatrixD Ad;
+		buildClusteredGraph(nClusters, 25, As, Ad);
+
+		// Bisection, and its N-cut:
+		std::vector<uint32_t> p1, p2;
+		double cut;
+		partitioner_t::SpectralBisection(As, p1, p2, cut);
+		EXPECT_EQ(p1.size() + p2.size(), As.size());
+		EXPECT_NEAR(cut, partitioner_t::nCut(Ad, p1, p2), 1e-9);
+		EXPECT_NEAR(cut, partitioner_t::nCut(As, p1, p2), 1e-9);
+
+		// Recursive partition must find the clusters:
+		std::vector<std::vector<uint32_t>> parts_s, parts_d;
+		partitioner_t::RecursiveSpectralPartition(As, parts_s, 0.2);
+		partitioner_t::RecursiveSpectralPartition(
+			Ad, parts_d, 0.2, false, true, true);
+		EXPECT_EQ(parts_s.size(), nClusters);
+		EXPECT_EQ(sorted(parts_s), sorted(parts_d));
+	}
+}
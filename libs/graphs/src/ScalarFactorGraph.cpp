@@ -11,6 +11,8 @@
 
 #include <mrpt/graphs/ScalarFactorGraph.h>
 #include <mrpt/system/CTicTac.h>
+#include <algorithm>
+#include <array>
 
 using namespace mrpt;
 using namespace mrpt::graphs;
@@ -19,13 +21,53 @@ using namespace std;
 #if EIGEN_VERSION_AT_LEAST(3, 1, 0)  // Requires Eigen>=3.1
 #include <Eigen/SparseCore>
 #include <Eigen/SparseQR>
+#include <Eigen/SparseCholesky>
 #endif
 
+struct ScalarFactorGraph::CholeskyState
+{
+#if EIGEN_VERSION_AT_LEAST(3, 1, 0)
+	/** Information matrix (lower triangle) */
+	Eigen::SparseMatrix<double> H;
+	/** Indices in H.valuePtr() of the diagonal entries */
+	std::vector<int> diag_slots;
+	/** Indices in H.valuePtr() of the (i,i), (j,j) and (i,j) entries of each
+	 * binary factor, in the order of m_factors_binary */
+	std::vector<std::array<int, 3>> binary_slots;
+	Eigen::SimplicialLDLT<
+		Eigen::SparseMatrix<double>, Eigen::Lower, Eigen::AMDOrdering<int>>
+		ldlt;
+#endif
+};
+
 ScalarFactorGraph::FactorBase::~FactorBase() {}
 ScalarFactorGraph::ScalarFactorGraph()
 	: COutputLogger("GMRF"), m_enable_profiler(false)
 {
 }
+ScalarFactorGraph::~ScalarFactorGraph() {}
+ScalarFactorGraph::ScalarFactorGraph(const ScalarFactorGraph& o)
+	: COutputLogger(o),
+	  m_numNodes(o.m_numNodes),
+	  m_factors_unary(o.m_factors_unary),
+	  m_factors_binary(o.m_factors_binary),
+	  m_enable_profiler(o.m_enable_profiler),
+	  m_solver(o.m_solver)
+{
+}
+ScalarFactorGraph& ScalarFactorGraph::operator=(const ScalarFactorGraph& o)
+{
+	if (this == &o) return *this;
+	COutputLogger::operator=(o);
+	m_numNodes = o.m_numNodes;
+	m_factors_unary = o.m_factors_unary;
+	m_factors_binary = o.m_factors_binary;
+	m_enable_profiler = o.m_enable_profiler;
+	m_solver = o.m_solver;
+	// The cached factorization is rebuilt on demand:
+	m_cholesky_needs_analysis = true;
+	return *this;
+}
 
 void ScalarFactorGraph::clear()
 {
@@ -34,6 +76,7 @@ void ScalarFactorGraph::clear()
 	m_numNodes = 0;
 	m_factors_unary.clear();
 	m_factors_binary.clear();
+	m_cholesky_needs_analysis = true;
 }
 
 void ScalarFactorGraph::initialize(const size_t nodeCount)
@@ -41,6 +84,7 @@ void ScalarFactorGraph::initialize(const size_t nodeCount)
 	MRPT_LOG_DEBUG_STREAM("initialize() called, nodeCount=" << nodeCount);
 
 	m_numNodes = nodeCount;
+	m_cholesky_needs_analysis = true;
 }
 
 void ScalarFactorGraph::addConstraint(const UnaryFactorVirtualBase& c)
@@ -50,6 +94,7 @@ void ScalarFactorGraph::addConstraint(const UnaryFactorVirtualBase& c)
 void ScalarFactorGraph::addConstraint(const BinaryFactorVirtualBase& c)
 {
 	m_factors_binary.push_back(&c);
+	m_cholesky_needs_analysis = true;
 }
 
 bool ScalarFactorGraph::eraseConstraint(const FactorBase& c)
@@ -68,6 +113,7 @@ bool ScalarFactorGraph::eraseConstraint(const FactorBase& c)
 		if (it != m_factors_binary.end())
 		{
 			m_factors_binary.erase(it);
+			m_cholesky_needs_analysis = true;
 			return true;
 		}
 	}
@@ -94,6 +140,13 @@ void ScalarFactorGraph::updateEstimation(
 
 #if EIGEN_VERSION_AT_LEAST(3, 1, 0)
 
+	if (m_solver == solverSparseCholesky)
+	{
+		if (updateEstimationCholesky(solved_x_inc, solved_variances)) return;
+		MRPT_LOG_DEBUG(
+			"Singular information matrix, falling back to SparseQR solver");
+	}
+
 	// Number of vertices:
 	const size_t n = m_numNodes;
 	solved_x_inc.setZero(n);
@@ -248,3 +301,158 @@ void ScalarFactorGraph::updateEstimation(
 	THROW_EXCEPTION("This method requires Eigen 3.1.0 or above");
 #endif
 }
+
+/* Method:
+  H = J^t * Lambda * J  ,  g = - J^t * Lambda * r(x)
+  H * x_incr = g         --> P*H*P^t = L*D*L^t
+
+  The symbolic part (ordering P and pattern of L) only depends on the graph
+  connectivity, i.e. on the binary factors, and it is reused between calls.
+*/
+bool ScalarFactorGraph::updateEstimationCholesky(
+	Eigen::VectorXd& solved_x_inc, Eigen::VectorXd* solved_variances)
+{
+#if EIGEN_VERSION_AT_LEAST(3, 1, 0)
+	const size_t n = m_numNodes;
+	if (!m_cholesky) m_cholesky.reset(new CholeskyState);
+	CholeskyState& st = *m_cholesky;
+
+	// Sparsity pattern and symbolic factorization
+	// ---------------------------------------------
+	if (m_cholesky_needs_analysis)
+	{
+		mrpt::system::CTimeLoggerEntry tle(m_timelogger, "GMRF.chol_analyze");
+
+		std::vector<Eigen::Triplet<double>> H_tri;
+		H_tri.reserve(n + m_factors_binary.size());
+		for (size_t i = 0; i < n; i++) H_tri.emplace_back(i, i, .0);
+		for (const auto& e : m_factors_binary)
+		{
+			ASSERT_(e != nullptr);
+			H_tri.emplace_back(
+				std::max(e->node_id_i, e->node_id_j),
+				std::min(e->node_id_i, e->node_id_j), .0);
+		}
+		st.H.resize(n, n);
+		st.H.setFromTriplets(H_tri.begin(), H_tri.end());
+		st.H.makeCompressed();
+
+		const auto slot = [&st](size_t r, size_t c) {
+			return int(&st.H.coeffRef(r, c) - st.H.valuePtr());
+		};
+		st.diag_slots.resize(n);
+		for (size_t i = 0; i < n; i++) st.diag_slots[i] = slot(i, i);
+		st.binary_slots.clear();
+		st.binary_slots.reserve(m_factors_binary.size());
+		for (const auto& e : m_factors_binary)
+			st.binary_slots.push_back(
+				{{st.diag_slots[e->node_id_i], st.diag_slots[e->node_id_j],
+				  slot(
+					  std::max(e->node_id_i, e->node_id_j),
+					  std::min(e->node_id_i, e->node_id_j))}});
+
+		st.ldlt.analyzePattern(st.H);
+		m_cholesky_needs_analysis = false;
+	}
+
+	// Numeric values of H and g
+	// ---------------------------------------------
+	Eigen::VectorXd g;
+	g.setZero(n);
+	{
+		mrpt::system::CTimeLoggerEntry tle(m_timelogger, "GMRF.chol_build_H");
+
+		double* H = st.H.valuePtr();
+		std::fill(H, H + st.H.nonZeros(), .0);
+		for (const auto& e : m_factors_unary)
+		{
+			ASSERT_(e != nullptr);
+			const double lambda = e->getInformation();
+			double dr_dx;
+			e->evalJacobian(dr_dx);
+			H[st.diag_slots[e->node_id]] += lambda * dr_dx * dr_dx;
+			g[e->node_id] -= lambda * dr_dx * e->evaluateResidual();
+		}
+		size_t k = 0;
+		for (const auto& e : m_factors_binary)
+		{
+			const auto& s = st.binary_slots[k++];
+			const double lambda = e->getInformation();
+			double dr_dxi, dr_dxj;
+			e->evalJacobian(dr_dxi, dr_dxj);
+			const double r = e->evaluateResidual();
+			H[s[0]] += lambda * dr_dxi * dr_dxi;
+			H[s[1]] += lambda * dr_dxj * dr_dxj;
+			H[s[2]] += (e->node_id_i == e->node_id_j ? 2 : 1) * lambda *
+					   dr_dxi * dr_dxj;
+			g[e->node_id_i] -= lambda * dr_dxi * r;
+			g[e->node_id_j] -= lambda * dr_dxj * r;
+		}
+	}
+
+	// Numeric factorization and solve
+	// ---------------------------------------------
+	{
+		mrpt::system::CTimeLoggerEntry tle(m_timelogger, "GMRF.chol_solve");
+
+		st.ldlt.factorize(st.H);
+		if (st.ldlt.info() != Eigen::Success) return false;
+		// Nodes not constrained by any unary factor leave (numerically) null
+		// pivots, instead of a failed factorization:
+		const auto& D = st.ldlt.vectorD();
+		if (D.minCoeff() <= 1e-12 * D.cwiseAbs().maxCoeff()) return false;
+
+		solved_x_inc = st.ldlt.solve(g);
+	}
+
+	// Recover variances
+	// ---------------------------------------------
+	if (solved_variances)
+	{
+		mrpt::system::CTimeLoggerEntry tle(m_timelogger, "GMRF.variance");
+
+		// Selective inversion (Takahashi equations): computes the entries of
+		// Z=inv(P*H*P^t) within the pattern of L only, from the last column
+		// backwards:
+		//  Z(j,i) = - sum_{k>i} L(k,i) * Z(j,k)      , j>i, L(j,i)!=0
+		//  Z(i,i) = 1/D(i) - sum_{k>i} L(k,i) * Z(k,i)
+		// All the Z(j,k) required are also within the pattern of L.
+		const auto& L = st.ldlt.matrixL().nestedExpression();
+		const int* Lp = L.outerIndexPtr();
+		const int* Li = L.innerIndexPtr();
+		const double* Lx = L.valuePtr();
+		const auto& D = st.ldlt.vectorD();
+
+		std::vector<double> Z(L.nonZeros()), Z_diag(n);
+		// Row indices within each column of L are sorted:
+		const auto Z_at = [&](int r, int c) {
+			if (r == c) return Z_diag[r];
+			if (r < c) std::swap(r, c);
+			const int* it = std::lower_bound(Li + Lp[c], Li + Lp[c + 1], r);
+			return (it != Li + Lp[c + 1] && *it == r) ? Z[it - Li] : .0;
+		};
+		for (int i = int(n) - 1; i >= 0; i--)
+		{
+			double z_ii = 1.0 / D[i];
+			for (int p = Lp[i]; p < Lp[i + 1]; p++)
+			{
+				double z_ji = .0;
+				for (int q = Lp[i]; q < Lp[i + 1]; q++)
+					z_ji -= Lx[q] * Z_at(Li[p], Li[q]);
+				Z[p] = z_ji;
+				z_ii -= Lx[p] * z_ji;
+			}
+			Z_diag[i] = z_ii;
+		}
+
+		// Undo the fill-reducing permutation:
+		const auto& perm = st.ldlt.permutationP().indices();
+		solved_variances->resize(n);
+		for (size_t i = 0; i < n; i++)
+			(*solved_variances)[i] = Z_diag[perm[i]];
+	}
+	return true;
+#else
+	return false;
+#endif
+}
@@ -174,4 +174,109 @@ TEST(ScalarFactorGraph, MiniMRF_BinaryEdges)
 	}
 }
 
+// A grid MRF solved with both solvers, adding readings (unary factors)
+// between updates. Variances are compared to those from a dense inverse.
+TEST(ScalarFactorGraph, GridMRF_CholeskySameAsQR)
+{
+	const size_t NX = 13, NY = 9, N = NX * NY;
+	vector<double> my_map(N, .0);
+
+	ScalarFactorGraph gmrf_qr, gmrf_chol;
+	gmrf_chol.setSolver(ScalarFactorGraph::solverSparseCholesky);
+	gmrf_qr.initialize(N);
+	gmrf_chol.initialize(N);
+
+	std::deque<MySimpleBinaryEdge> priors;
+	for (size_t cy = 0; cy < NY; cy++)
+		for (size_t cx = 0; cx < NX; cx++)
+		{
+			const size_t i = cx + cy * NX;
+			if (cx + 1 < NX) priors.emplace_back(my_map, i, i + 1, 0.5);
+			if (cy + 1 < NY) priors.emplace_back(my_map, i, i + NX, 0.5);
+		}
+	std::deque<MySimpleUnaryEdge> readings;
+	const auto denseVariances = [&]() {
+		Eigen::MatrixXd H;
+		H.setZero(N, N);
+		for (const auto& e : priors)
+		{
+			const size_t i = e.node_id_i, j = e.node_id_j;
+			H(i, i) += e.getInformation();
+			H(j, j) += e.getInformation();
+			H(i, j) -= e.getInformation();
+			H(j, i) -= e.getInformation();
+		}
+		for (const auto& e : readings)
+			H(e.node_id, e.node_id) += e.getInformation();
+		return Eigen::VectorXd(H.inverse().diagonal());
+	};
+	for (const auto& e : priors)
+	{
+		gmrf_qr.addConstraint(e);
+		gmrf_chol.addConstraint(e);
+	}
+
+	for (size_t k = 0; k < 5; k++)
+	{
+		// New readings:
+		for (size_t r = 0; r < 7; r++)
+		{
+			const size_t i = (k * 31 + r * 17) % N;
+			readings.emplace_back(my_map, i, 0.1 * i, 1.0 + r);
+			gmrf_qr.addConstraint(readings.back());
+			gmrf_chol.addConstraint(readings.back());
+		}
+
+		Eigen::VectorXd x_qr, x_chol, var_chol;
+		gmrf_qr.updateEstimation(x_qr);
+		gmrf_chol.updateEstimation(x_chol, &var_chol);
+
+		ASSERT_EQ(x_chol.size(), int(N));
+		ASSERT_EQ(var_chol.size(), int(N));
+		const Eigen::VectorXd var = denseVariances();
+		for (size_t i = 0; i < N; i++)
+		{
+			EXPECT_NEAR(x_qr[i], x_chol[i], 1e-6) << "k=" << k;
+			EXPECT_NEAR(var[i], var_chol[i], 1e-9) << "k=" << k;
+		}
+		for (size_t i = 0; i < N; i++) my_map[i] += x_chol[i];
+	}
+
+	// Decaying readings, as in a GMRF map:
+	gmrf_qr.eraseConstraint(readings.front());
+	gmrf_chol.eraseConstraint(readings.front());
+	readings.pop_front();
+	Eigen::VectorXd x_qr, x_chol, var_chol;
+	gmrf_qr.updateEstimation(x_qr);
+	gmrf_chol.updateEstimation(x_chol, &var_chol);
+	const Eigen::VectorXd var = denseVariances();
+	for (size_t i = 0; i < N; i++)
+	{
+		EXPECT_NEAR(x_qr[i], x_chol[i], 1e-6);
+		EXPECT_NEAR(var[i], var_chol[i], 1e-9);
+	}
+}
+
+TEST(ScalarFactorGraph, MiniMRF_CholeskySingular)
+{
+	// Without unary factors the system is singular: must fall back to QR
+	const size_t N = 3;
+	vector<double> my_map{1.0, 2.0, 4.0};
+
+	ScalarFactorGraph gmrf;
+	gmrf.setSolver(ScalarFactorGraph::solverSparseCholesky);
+	gmrf.initialize(N);
+	MySimpleBinaryEdge edge_01(my_map, 0, 1, 1.0);
+	gmrf.addConstraint(edge_01);
+	MySimpleBinaryEdge edge_12(my_map, 1, 2, 1.0);
+	gmrf.addConstraint(edge_12);
+
+	Eigen::VectorXd x_incr;
+	gmrf.updateEstimation(x_incr);
+	ASSERT_EQ(x_incr.size(), int(N));
+	for (size_t i = 0; i < N; i++) my_map[i] += x_incr[i];
+	EXPECT_NEAR(my_map[0], my_map[1], 1e-6);
+	EXPECT_NEAR(my_map[1], my_map[2], 1e-6);
+}
+
 #endif  // Eigen>=3.1
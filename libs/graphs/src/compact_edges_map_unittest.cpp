@@ -0,0 +1,180 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include <mrpt/graphs/CNetworkOfPoses.h>
+#include <mrpt/graphs/compact_edges_map.h>
+#include <mrpt/random.h>
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace mrpt;
+using namespace mrpt::graphs;
+using namespace mrpt::poses;
+using namespace std;
+
+using ref_map_t = mrpt::aligned_std_multimap<TPairNodeIDs, int>;
+using compact_map_t = compact_edges_map<int>;
+
+static void expectSameContents(const ref_map_t& r, const compact_map_t& c)
+{
+	ASSERT_EQ(r.size(), c.size());
+	auto itc = c.begin();
+	for (const auto& e : r)
+	{
+		EXPECT_EQ(e.first, itc->first);
+		EXPECT_EQ(e.second, itc->second);
+		++itc;
+	}
+}
+
+TEST(compact_edges_map, randomOps)
+{
+	auto& rng = mrpt::random::getRandomGenerator();
+	rng.randomize(4321);
+
+	ref_map_t r;
+	compact_map_t c;
+	const unsigned int N = 30;
+	for (int i = 0; i < 5000; i++)
+	{
+		const TPairNodeIDs k(
+			rng.drawUniform32bit() % N, rng.drawUniform32bit() % N);
+		switch (rng.drawUniform32bit() % 5)
+		{
+			case 0:
+			case 1:
+			{
+				const auto itr = r.insert(std::make_pair(k, i));
+				const auto itc = c.insert(std::make_pair(k, i));
+				EXPECT_EQ(
+					std::distance(r.begin(), itr),
+					std::distance(c.begin(), itc));
+			}
+			break;
+			case 2:
+				EXPECT_EQ(r.erase(k), c.erase(k));
+				break;
+			case 3:
+				if (!r.empty())
+				{
+					const size_t idx = rng.drawUniform32bit() % r.size();
+					const auto itr = r.erase(std::next(r.begin(), idx));
+					const auto itc = c.erase(std::next(c.begin(), idx));
+					EXPECT_EQ(
+						std::distance(r.begin(), itr),
+						std::distance(c.begin(), itc));
+				}
+				break;
+			case 4:
+			{
+				const auto itr = r.find(k);
+				const auto itc = c.find(k);
+				ASSERT_EQ(itr == r.end(), itc == c.end());
+				if (itr != r.end()) EXPECT_EQ(itr->second, itc->second);
+				EXPECT_EQ(r.count(k), c.count(k));
+				const auto rr = r.equal_range(k);
+				const auto rc = c.equal_range(k);
+				EXPECT_EQ(
+					std::distance(r.begin(), rr.first),
+					std::distance(c.begin(), rc.first));
+				EXPECT_EQ(
+					std::distance(r.begin(), rr.second),
+					std::distance(c.begin(), rc.second));
+			}
+			break;
+		};
+		expectSameContents(r, c);
+	}
+
+	// Per-node ranges:
+	for (TNodeID from = 0; from < N + 2; from++)
+	{
+		const auto row = c.outEdges(from);
+		size_t n = 0;
+		for (auto it = row.first; it != row.second; ++it, ++n)
+			EXPECT_EQ(it->first.first, from);
+		EXPECT_EQ(n, c.outDegree(from));
+		EXPECT_EQ(
+			n, static_cast<size_t>(std::count_if(
+				   r.begin(), r.end(), [from](const ref_map_t::value_type& e) {
+					   return e.first.first == from;
+				   })));
+	}
+
+	// Backwards iteration, and raw access to all edges:
+	EXPECT_TRUE(std::equal(
+		r.rbegin(), r.rend(), c.rbegin(),
+		[](const ref_map_t::value_type& a, const compact_map_t::value_type& b) {
+			return a.first == b.first && a.second == b.second;
+		}));
+	EXPECT_EQ(c.getVector().size(), r.size());
+
+	// Erase a range:
+	r.erase(std::next(r.begin(), 3), std::next(r.begin(), r.size() / 2));
+	c.erase(std::next(c.begin(), 3), std::next(c.begin(), c.size() / 2));
+	expectSameContents(r, c);
+	const TPairNodeIDs k(N / 2, 1);
+	EXPECT_EQ(r.count(k), c.count(k));
+}
+
+TEST(compact_edges_map, CNetworkOfPoses)
+{
+	using graph_t = CNetworkOfPoses<CPosePDFGaussianInf>;
+	using compact_graph_t =
+		CNetworkOfPoses<CPosePDFGaussianInf, map_traits_compact>;
+
+	auto& rng = mrpt::random::getRandomGenerator();
+	rng.randomize(1234);
+
+	// A random graph, with duplicated edges:
+	graph_t g;
+	compact_graph_t gc;
+	const size_t N = 50;
+	for (size_t i = 1; i < 3 * N; i++)
+	{
+		const TNodeID from = (i < N) ? i - 1 : rng.drawUniform32bit() % N;
+		const TNodeID to =
+			(i < N) ? i : (from + 1 + rng.drawUniform32bit() % (N - 1)) % N;
+		CPosePDFGaussianInf p;
+		p.mean = CPose2D(
+			rng.drawUniform(-1.0, 1.0), rng.drawUniform(-1.0, 1.0),
+			rng.drawUniform(-0.5, 0.5));
+		p.cov_inv.setIdentity();
+		g.insertEdge(from, to, p);
+		gc.insertEdge(from, to, p);
+	}
+	ASSERT_EQ(g.edgeCount(), gc.edgeCount());
+	for (TNodeID i = 0; i < N; i++) g.nodes[i] = gc.nodes[i] = CPose2D();
+
+	g.dijkstra_nodes_estimate();
+	gc.dijkstra_nodes_estimate();
+	ASSERT_EQ(g.nodeCount(), gc.nodeCount());
+	for (const auto& n : g.nodes)
+		EXPECT_EQ(n.second, gc.nodes.at(n.first));
+	EXPECT_DOUBLE_EQ(g.getGlobalSquareError(), gc.getGlobalSquareError());
+
+	EXPECT_EQ(g.collapseDuplicatedEdges(), gc.collapseDuplicatedEdges());
+	ASSERT_EQ(g.edgeCount(), gc.edgeCount());
+	auto it = g.edges.begin();
+	for (const auto& e : gc.edges)
+	{
+		EXPECT_EQ(it->first, e.first);
+		EXPECT_EQ(it->second.mean, e.second.mean);
+		++it;
+	}
+
+	// Text I/O:
+	std::stringstream ss;
+	gc.writeAsText(ss);
+	compact_graph_t gc2;
+	ss.seekg(0);
+	gc2.readAsText(ss);
+	EXPECT_EQ(gc.edgeCount(), gc2.edgeCount());
+	EXPECT_NEAR(gc.chi2(), gc2.chi2(), 1e-2);
+}
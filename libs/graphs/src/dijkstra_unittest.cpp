@@ -0,0 +1,134 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include <mrpt/graphs/CNetworkOfPoses.h>
+#include <mrpt/graphs/dijkstra.h>
+#include <mrpt/random.h>
+#include <gtest/gtest.h>
+
+using namespace mrpt;
+using namespace mrpt::graphs;
+using namespace mrpt::poses;
+using namespace std;
+
+using my_dijkstra_t = CDijkstra<CNetworkOfPoses2D>;
+
+static double edgeLength(
+	const CNetworkOfPoses2D&, const TNodeID, const TNodeID,
+	const CNetworkOfPoses2D::edge_t& edge)
+{
+	return edge.norm();
+}
+
+TEST(CDijkstra, randomGraphs)
+{
+	auto& rng = mrpt::random::getRandomGenerator();
+	rng.randomize(1234);
+
+	for (int trial = 0; trial < 20; trial++)
+	{
+		// A random spanning tree plus random extra edges (including
+		// duplicated, reversed and self-loop edges):
+		CNetworkOfPoses2D g;
+		const size_t N = 10 + 10 * trial;
+		for (size_t i = 1; i < N; i++)
+			g.insertEdge(
+				rng.drawUniform32bit() % i, i,
+				CPose2D(rng.drawUniform(0.1, 3.0), 0, 0));
+		for (size_t k = 0; k < N; k++)
+			g.insertEdge(
+				rng.drawUniform32bit() % N, rng.drawUniform32bit() % N,
+				CPose2D(rng.drawUniform(0.1, 3.0), 0, 0));
+		for (size_t i = 0; i < N; i++) g.nodes[i] = CPose2D();
+
+		const my_dijkstra_t dij(g, 0, &edgeLength);
+
+		// Reference distances (Bellman-Ford), with each pair of nodes
+		// weighted as the edge that edges.find() returns:
+		std::vector<double> ref(N, std::numeric_limits<double>::max());
+		ref[0] = 0;
+		for (size_t it = 0; it < N; it++)
+			for (const auto& e : g.edges)
+			{
+				const TNodeID a = e.first.first, b = e.first.second;
+				auto e_ab = g.edges.find(make_pair(a, b));
+				auto e_ba = g.edges.find(make_pair(b, a));
+				const double w_from_a = edgeLength(g, a, b, e_ab->second);
+				if (e_ba == g.edges.end()) e_ba = e_ab;
+				const double w_from_b = edgeLength(g, b, a, e_ba->second);
+				if (ref[a] + w_from_a < ref[b]) ref[b] = ref[a] + w_from_a;
+				if (ref[b] + w_from_b < ref[a]) ref[a] = ref[b] + w_from_b;
+			}
+
+		for (size_t i = 0; i < N; i++)
+		{
+			EXPECT_NEAR(ref[i], dij.getNodeDistanceToRoot(i), 1e-9);
+
+			// The path must exist and add up to the distance:
+			my_dijkstra_t::edge_list_t path;
+			dij.getShortestPathTo(i, path);
+			double d = 0;
+			TNodeID cur = 0;
+			for (const auto& arc : path)
+			{
+				auto e = g.edges.find(arc);
+				ASSERT_TRUE(e != g.edges.end());
+				ASSERT_TRUE(arc.first == cur || arc.second == cur);
+				cur = (arc.first == cur) ? arc.second : arc.first;
+				d += edgeLength(g, arc.first, arc.second, e->second);
+			}
+			EXPECT_EQ(cur, i);
+			EXPECT_NEAR(d, dij.getNodeDistanceToRoot(i), 1e-9);
+		}
+
+		my_dijkstra_t::tree_graph_t tree;
+		dij.getTreeGraph(tree);
+		size_t nTreeEdges = 0;
+		for (const auto& e : tree.edges_to_children)
+			nTreeEdges += e.second.size();
+		EXPECT_EQ(nTreeEdges, N - 1);
+
+		// The tree edges point to the graph edges, which may outlive the
+		// Dijkstra object:
+		for (const auto& e : tree.edges_to_children)
+			for (const auto& child : e.second)
+			{
+				const auto arc = child.reverse
+									 ? make_pair(child.id, e.first)
+									 : make_pair(e.first, child.id);
+				EXPECT_EQ(child.data, &g.edges.find(arc)->second);
+			}
+
+		std::decay_t<decltype(dij.getCachedAdjacencyMatrix())> adj;
+		g.getAdjacencyMatrix(adj);
+		EXPECT_TRUE(dij.getCachedAdjacencyMatrix() == adj);
+	}
+}
+
+TEST(CDijkstra, notConnected)
+{
+	CNetworkOfPoses2D g;
+	for (TNodeID i : {0, 1, 2, 3, 7}) g.nodes[i] = CPose2D();
+	g.insertEdge(0, 1, CPose2D());
+	g.insertEdge(2, 3, CPose2D());
+
+	bool thrown = false;
+	try
+	{
+		my_dijkstra_t dij(g, 0);
+	}
+	catch (mrpt::graphs::detail::NotConnectedGraph& e)
+	{
+		thrown = true;
+		std::set<TNodeID> unconnected;
+		e.getUnconnectedNodeIDs(&unconnected);
+		EXPECT_EQ(unconnected, std::set<TNodeID>({2, 3, 7}));
+	}
+	EXPECT_TRUE(thrown);
+}
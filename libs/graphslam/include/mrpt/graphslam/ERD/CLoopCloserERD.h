@@ -18,6 +18,8 @@
 #include <mrpt/obs/CSensoryFrame.h>
 #include <mrpt/slam/CIncrementalMapPartitioner.h>
 #include <mrpt/slam/CICP.h>
+#include <mrpt/slam/CCorrelativeScanMatcher.h>
+#include <mrpt/poses/CPosePDFGaussian.h>
 
 #include <mrpt/graphslam/interfaces/CRangeScanEdgeRegistrationDecider.h>
 #include <mrpt/graphslam/misc/TSlidingWindow.h>
@@ -327,6 +329,11 @@ public:
 	 * \param[out] generated_hypots Pool of generated hypothesis. Hypotheses
 	 * are generated in the heap, so the caller is responsible of afterwards
 	 * calling \a delete.
+	 *
+	 * The scan matching of the node pairs is distributed among
+	 * TLoopClosureParams::LC_num_threads threads, while the hypotheses are
+	 * stored in the same order, and with the same IDs, as if done
+	 * sequentially.
 	 */
 	void generateHypotsPool(
 		const std::vector<uint32_t>& groupA,
@@ -347,6 +354,10 @@ public:
 	 * method
 	 * \param[in] groupB_opt_paths
 	 *
+	 * The optimal path between each pair of nodes of a group is computed (or
+	 * looked up) only once, and all the matrix elements are then evaluated in
+	 * a single batch.
+	 *
 	 * \sa generatePWConsistencyElement
 	 * \sa evalPWConsistenciesMatrix
 	 */
@@ -483,6 +494,21 @@ public:
 		 * registered
 		 */
 		int full_partition_per_nodes;
+		/**\brief Find the initial ICP estimation of each loop closure
+		 * hypothesis with a global, branch-and-bound correlative scan
+		 * matcher instead of the difference of the current node poses, which
+		 * may be far off before closing the loop [off by default].
+		 *
+		 * Its options are read from the section
+		 * "EdgeRegistrationDeciderParameters.correlative_matcher".
+		 */
+		bool LC_use_correlative_matcher{false};
+		mrpt::slam::CCorrelativeScanMatcher correlative_matcher;
+		/**\brief Number of threads for scan matching the loop closure
+		 * hypotheses of a partition (0: as many as hardware threads, 1: run
+		 * sequentially). Results do not depend on it.
+		 */
+		unsigned int LC_num_threads{0};
 		bool visualize_map_partitions;
 		std::string keystroke_map_partitions;
 
@@ -698,6 +724,30 @@ public:
 		const mrpt::graphs::TNodeID& from, const mrpt::graphs::TNodeID& to,
 		constraint_t* rel_edge, mrpt::slam::CICP::TReturnInfo* icp_info = nullptr,
 		const TGetICPEdgeAdParams* ad_params = nullptr);
+	/**\brief Search the relative pose of two nodes with the correlative scan
+	 * matcher (see TLoopClosureParams::LC_use_correlative_matcher), around
+	 * the difference of their current poses, and store it in
+	 * ad_params->init_estim as the initial estimation for getICPEdge().
+	 *
+	 * \return True if a match was found; otherwise the difference of the
+	 * current poses is stored as initial estimation.
+	 */
+	bool getCorrelativeMatcherEstimate(
+		const mrpt::graphs::TNodeID& from, const mrpt::graphs::TNodeID& to,
+		TGetICPEdgeAdParams* ad_params);
+	/**\brief Align two laser scans with the correlative scan matcher,
+	 * starting from *estim, which is replaced by the result if one is found.
+	 *
+	 * Unlike getCorrelativeMatcherEstimate() it neither accesses the graph
+	 * nor logs, so it can be called from several threads at once (with a
+	 * different matcher each).
+	 *
+	 * \return The goodness of the match, 0 if not found.
+	 */
+	static float alignWithCorrelativeMatcher(
+		mrpt::slam::CCorrelativeScanMatcher& matcher,
+		const mrpt::obs::CObservation2DRangeScan& from_scan,
+		const mrpt::obs::CObservation2DRangeScan& to_scan, pose_t* estim);
 	/**\brief compute the minimum uncertainty of each node position with
 	 * regards to the graph root.
 	 *
@@ -13,6 +13,10 @@
 #include <mrpt/opengl/CEllipsoid.h>
 #include <mrpt/opengl/CSphere.h>
 #include <mrpt/math/data_utils.h>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 namespace mrpt::graphslam::deciders
 {
@@ -302,6 +306,57 @@ bool CLoopCloserERD<GRAPH_T>::getICPEdge(
 	MRPT_END;
 }  // end of getICPEdge
 
+template <class GRAPH_T>
+bool CLoopCloserERD<GRAPH_T>::getCorrelativeMatcherEstimate(
+	const mrpt::graphs::TNodeID& from, const mrpt::graphs::TNodeID& to,
+	TGetICPEdgeAdParams* ad_params)
+{
+	MRPT_START;
+	ASSERTDEB_(ad_params);
+	using namespace mrpt::obs;
+
+	CObservation2DRangeScan::Ptr from_scan, to_scan;
+	global_pose_t from_pose, to_pose;
+	const bool from_success = this->getPropsOfNodeID(
+		from, &from_pose, from_scan, &ad_params->from_params);
+	const bool to_success = this->getPropsOfNodeID(
+		to, &to_pose, to_scan, &ad_params->to_params);
+	ad_params->init_estim = to_pose - from_pose;
+	if (!from_success || !to_success) return false;
+
+	this->m_time_logger.enter("getCorrelativeMatcherEstimate");
+	const float goodness = alignWithCorrelativeMatcher(
+		m_lc_params.correlative_matcher, *from_scan, *to_scan,
+		&ad_params->init_estim);
+
+	MRPT_LOG_DEBUG_STREAM(
+		"Correlative matcher: " << from << " => " << to
+								<< "| goodness: " << goodness
+								<< "| init_estim: " << ad_params->init_estim);
+
+	this->m_time_logger.leave("getCorrelativeMatcherEstimate");
+	return goodness > 0;
+	MRPT_END;
+}
+
+template <class GRAPH_T>
+float CLoopCloserERD<GRAPH_T>::alignWithCorrelativeMatcher(
+	mrpt::slam::CCorrelativeScanMatcher& matcher,
+	const mrpt::obs::CObservation2DRangeScan& from_scan,
+	const mrpt::obs::CObservation2DRangeScan& to_scan, pose_t* estim)
+{
+	mrpt::maps::CSimplePointsMap m1, m2;
+	m1.insertObservation(&from_scan);
+	m2.insertObservation(&to_scan);
+
+	mrpt::poses::CPosePDFGaussian init;
+	init.mean = *estim;
+	mrpt::slam::CCorrelativeScanMatcher::TReturnInfo info;
+	const auto pdf = matcher.AlignPDF(&m1, &m2, init, nullptr, &info);
+	if (info.goodness > 0) *estim = pdf->getMeanVal();
+	return info.goodness;
+}
+
 template <class GRAPH_T>
 bool CLoopCloserERD<GRAPH_T>::fillNodePropsFromGroupParams(
 	const mrpt::graphs::TNodeID& nodeID,
@@ -773,100 +828,152 @@ void CLoopCloserERD<GRAPH_T>::generateHypotsPool(
 
 	// use a hypothesis ID with which the consistency matrix will then be
 	// formed
-	int hypot_counter = 0;
-	int invalid_hypots = 0;  // just for keeping track of them.
-	{
-		// iterate over all the nodes in both groups
-		for (unsigned int b_it : groupB)
+	//
+	// 1st pass: create the hypotheses and fetch the poses and LaserScans of
+	// their nodeIDs, so that the scan matching below does not need to access
+	// the graph.
+	const size_t nHypots = groupA.size() * groupB.size();
+	std::vector<TGetICPEdgeAdParams> icp_ad_params(nHypots);
+	std::vector<bool> has_scans(nHypots, false);
+	generated_hypots->reserve(nHypots);
+	for (unsigned int b_it : groupB)
+	{
+		for (unsigned int a_it : groupA)
 		{
-			for (unsigned int a_it : groupA)
+			// by default hypotheses will direct bi => ai; If the hypothesis is
+			// traversed the opposite way, take the opposite of the constraint
+			// [from] *b_it ====[edge]===> [to]  *a_it
+			const size_t id = generated_hypots->size();
+			hypot_t* hypot = new hypot_t;
+			hypot->from = b_it;
+			hypot->to = a_it;
+			hypot->id = id;
+			generated_hypots->push_back(hypot);
+
+			TGetICPEdgeAdParams& params = icp_ad_params[id];
+			if (ad_params)
 			{
-				// by default hypotheses will direct bi => ai; If the hypothesis
-				// is
-				// traversed the opposite way, take the opposite of the
-				// constraint
-				hypot_t* hypot = new hypot_t;
-				hypot->from = b_it;
-				hypot->to = a_it;
-				hypot->id = hypot_counter++;
-
-				// [from] *b_it ====[edge]===> [to]  *a_it
-
-				// Fetch and set the pose and LaserScan of from, to nodeIDs
-				//
-				// even if icp_ad_params NULL, it will be handled appropriately
-				// by the
-				// getICPEdge fun.
-				// bool from_success, to_success;
-				TGetICPEdgeAdParams* icp_ad_params = NULL;
-				if (ad_params)
-				{
-					icp_ad_params = new TGetICPEdgeAdParams;
-					// from_success = fillNodePropsFromGroupParams(
-					fillNodePropsFromGroupParams(
-						b_it, ad_params->groupB_params,
-						&icp_ad_params->from_params);
-					// to_success = fillNodePropsFromGroupParams(
-					fillNodePropsFromGroupParams(
-						a_it, ad_params->groupA_params,
-						&icp_ad_params->to_params);
-
-					// MRPT_LOG_DEBUG_STREAM(">>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>");
-					// MRPT_LOG_DEBUG_STREAM("From nodeID (other): " << *b_it);
-					// MRPT_LOG_DEBUG_STREAM("From params (other): "
-					//<< icp_ad_params->from_params.getAsString());
-					// MRPT_LOG_DEBUG_STREAM("from_success: " << (from_success?
-					// "TRUE" : "FALSE"));
-					// MRPT_LOG_DEBUG_STREAM("**********");
-					// MRPT_LOG_DEBUG_STREAM("To nodeID (own)   : " << *a_it);
-					// MRPT_LOG_DEBUG_STREAM("To params (own)   : "
-					//<< icp_ad_params->to_params.getAsString());
-					// MRPT_LOG_DEBUG_STREAM("to_success: " << (to_success?
-					// "TRUE" : "FALSE"));
-					// MRPT_LOG_DEBUG_STREAM("<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<");
-				}
+				fillNodePropsFromGroupParams(
+					b_it, ad_params->groupB_params, &params.from_params);
+				fillNodePropsFromGroupParams(
+					a_it, ad_params->groupA_params, &params.to_params);
+			}
+			node_props_t& from = params.from_params;
+			node_props_t& to = params.to_params;
+			has_scans[id] =
+				this->getPropsOfNodeID(b_it, &from.pose, from.scan, &from) &&
+				this->getPropsOfNodeID(a_it, &to.pose, to.scan, &to);
+
+			// same initial ICP estimation as getICPEdge()
+			if (!ad_params) params.init_estim = to.pose - from.pose;
+		}
+	}
 
-				// fetch the ICP constraint bi => ai
-				mrpt::slam::CICP::TReturnInfo icp_info;
-				constraint_t edge;
-				bool found_edge = this->getICPEdge(
-					b_it, a_it, &edge, &icp_info, icp_ad_params);
-
-				hypot->setEdge(edge);
-				hypot->goodness =
-					icp_info.goodness;  // goodness related to the edge
-
-				// Check if invalid
-				//
-				// Goodness Threshold
-				double goodness_thresh =
-					m_laser_params.goodness_threshold_win.getMedian() *
-					m_lc_icp_constraint_factor;
-				bool accept_goodness = icp_info.goodness > goodness_thresh;
-				MRPT_LOG_DEBUG_STREAM(
-					"generateHypotsPool:\nCurr. Goodness: "
-					<< icp_info.goodness << "|\t Threshold: " << goodness_thresh
-					<< " => " << (accept_goodness ? "ACCEPT" : "REJECT")
-					<< endl);
-
-				if (!found_edge || !accept_goodness)
+	// 2nd pass: fetch the ICP constraints bi => ai, in parallel.
+	this->m_time_logger.enter("LoopClosureScanMatching");
+	std::vector<constraint_t> edges(nHypots);
+	std::vector<mrpt::slam::CICP::TReturnInfo> icp_infos(nHypots);
+	std::vector<float> correlative_goodness(nHypots, 0);
+	const size_t nThreads = std::min<size_t>(
+		nHypots, m_lc_params.LC_num_threads
+					 ? m_lc_params.LC_num_threads
+					 : std::max(1U, std::thread::hardware_concurrency()));
+
+	std::atomic<size_t> next_hypot{0};
+	std::exception_ptr worker_error;
+	std::mutex worker_error_mtx;
+	auto worker = [&]() {
+		// Each thread uses its own matcher. The parallelism is already given
+		// by the hypotheses:
+		mrpt::slam::CCorrelativeScanMatcher matcher =
+			m_lc_params.correlative_matcher;
+		if (nThreads > 1) matcher.options.num_threads = 1;
+		try
+		{
+			for (size_t id; (id = next_hypot++) < nHypots;)
+			{
+				if (!has_scans[id]) continue;
+				TGetICPEdgeAdParams& params = icp_ad_params[id];
+				const auto& from_scan = *params.from_params.scan;
+				const auto& to_scan = *params.to_params.scan;
+
+				// find the initial ICP estimation by global search:
+				if (m_lc_params.LC_use_correlative_matcher)
 				{
-					hypot->is_valid = false;
-					invalid_hypots++;
+					params.init_estim = params.to_params.pose -
+										params.from_params.pose;
+					correlative_goodness[id] = alignWithCorrelativeMatcher(
+						matcher, from_scan, to_scan, &params.init_estim);
 				}
-				generated_hypots->push_back(hypot);
-				MRPT_LOG_DEBUG_STREAM(hypot->getAsString());
-
-				// delete pointer to getICPEdge additional parameters if they
-				// were initialized
-				delete icp_ad_params;
+				range_ops_t::getICPEdge(
+					from_scan, to_scan, &edges[id], &params.init_estim,
+					&icp_infos[id]);
 			}
 		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(worker_error_mtx);
+			if (!worker_error) worker_error = std::current_exception();
+			next_hypot = nHypots;  // stop the other threads too
+		}
+	};
+	if (nThreads <= 1)
+		worker();
+	else
+	{
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < nThreads; t++) threads.emplace_back(worker);
+		for (auto& t : threads) t.join();
+	}
+	this->m_time_logger.leave("LoopClosureScanMatching");
+	if (worker_error)
+	{
+		for (auto hypot : *generated_hypots) delete hypot;
+		generated_hypots->clear();
+		std::rethrow_exception(worker_error);
+	}
+
+	// 3rd pass: commit the results, in the order of the hypotheses IDs.
+	const double goodness_thresh =
+		m_laser_params.goodness_threshold_win.getMedian() *
+		m_lc_icp_constraint_factor;
+	int invalid_hypots = 0;  // just for keeping track of them.
+	for (size_t id = 0; id < nHypots; id++)
+	{
+		hypot_t* hypot = (*generated_hypots)[id];
+		const mrpt::slam::CICP::TReturnInfo& icp_info = icp_infos[id];
+		if (m_lc_params.LC_use_correlative_matcher)
+		{
+			MRPT_LOG_DEBUG_STREAM(
+				"Correlative matcher: "
+				<< hypot->from << " => " << hypot->to
+				<< "| goodness: " << correlative_goodness[id]
+				<< "| init_estim: " << icp_ad_params[id].init_estim);
+		}
+
+		hypot->setEdge(edges[id]);
+		hypot->goodness = icp_info.goodness;  // goodness related to the edge
+
+		// Check if invalid
+		//
+		// Goodness Threshold
+		bool accept_goodness = icp_info.goodness > goodness_thresh;
 		MRPT_LOG_DEBUG_STREAM(
-			"Generated pool of hypotheses...\tsize = "
-			<< generated_hypots->size()
-			<< "\tinvalid hypotheses: " << invalid_hypots);
+			"generateHypotsPool:\nCurr. Goodness: "
+			<< icp_info.goodness << "|\t Threshold: " << goodness_thresh
+			<< " => " << (accept_goodness ? "ACCEPT" : "REJECT") << endl);
+
+		if (!has_scans[id] || !accept_goodness)
+		{
+			hypot->is_valid = false;
+			invalid_hypots++;
+		}
+		MRPT_LOG_DEBUG_STREAM(hypot->getAsString());
 	}
+	MRPT_LOG_DEBUG_STREAM(
+		"Generated pool of hypotheses...\tsize = "
+		<< generated_hypots->size() << "\tinvalid hypotheses: "
+		<< invalid_hypots);
 
 	MRPT_END;
 }  // end of generateHypotsPool
@@ -978,117 +1085,103 @@ void CLoopCloserERD<GRAPH_T>::generatePWConsistenciesMatrix(
 		<< "\tgroupB: " << getSTLContainerAsString(groupB) << endl
 		<< "\tHypots pool Size: " << hypots_pool.size());
 
-	// b1
-	for (std::vector<uint32_t>::const_iterator b1_it = groupB.begin();
-		 b1_it != groupB.end(); ++b1_it)
-	{
-		TNodeID b1 = *b1_it;
-
-		// b2
-		for (std::vector<uint32_t>::const_iterator b2_it = b1_it + 1;
-			 b2_it != groupB.end(); ++b2_it)
+	// hypotheses between the i-th node of groupB and the j-th of groupA
+	const size_t nA = groupA.size(), nB = groupB.size();
+	std::vector<hypot_t*> hypots(nA * nB);
+	for (size_t i = 0; i < nB; i++)
+		for (size_t j = 0; j < nA; j++)
+			hypots[i * nA + j] =
+				this->findHypotByEnds(hypots_pool, groupB[i], groupA[j]);
+
+	// The uncertainty of the optimal path between the i-th and j-th (i<j)
+	// nodes of a group. Each one is only computed (or looked up in the given
+	// paths) once, the first time it is needed.
+	struct TGroupPaths
+	{
+		const std::vector<uint32_t>& group;
+		const paths_t* opt_paths;
+		std::vector<constraint_t> pdfs;
+		std::vector<bool> done;
+	};
+	TGroupPaths paths_A{groupA, groupA_opt_paths, {}, {}},
+		paths_B{groupB, groupB_opt_paths, {}, {}};
+	for (TGroupPaths* g : {&paths_A, &paths_B})
+	{
+		g->pdfs.resize(g->group.size() * g->group.size());
+		g->done.assign(g->pdfs.size(), false);
+	}
+	auto pathPDF =
+		[this](TGroupPaths& g, size_t i, size_t j) -> const constraint_t& {
+		const size_t k = i * g.group.size() + j;
+		if (!g.done[k])
 		{
-			TNodeID b2 = *b2_it;
-
-			// a1
-			for (std::vector<uint32_t>::const_iterator a1_it = groupA.begin();
-				 a1_it != groupA.end(); ++a1_it)
+			const TNodeID src = g.group[i], dst = g.group[j];
+			const path_t* p = nullptr;
+			if (g.opt_paths)
+				p = this->findPathByEnds(*g.opt_paths, src, dst, true);
+			if (!p || p->isEmpty())
 			{
-				TNodeID a1 = *a1_it;
-				hypot_t* hypot_b2_a1 =
-					this->findHypotByEnds(hypots_pool, b2, a1);
-				// MRPT_LOG_DEBUG_STREAM("hypot_b2_a1: " <<
-				// hypot_b2_a1->getAsString());
-
-				// a2
-				for (std::vector<uint32_t>::const_iterator a2_it = a1_it + 1;
-					 a2_it != groupA.end(); ++a2_it)
+				execDijkstraProjection(src, dst);
+				p = this->queryOptimalPath(dst);
+				ASSERT_(p);
+			}
+			p->assertIsBetweenNodeIDs(src, dst);
+			g.pdfs[k] = p->curr_pose_pdf;
+			g.done[k] = true;
+		}
+		return g.pdfs[k];
+	};
+
+	// Gather the loops a1 ==> a2 ==> b1 ==> b2 ==> a1 of all the pairs of
+	// valid hypotheses, the same as in generatePWConsistencyElement():
+	std::vector<std::pair<size_t, size_t>> elem_ids;
+	std::vector<dynamic_vector<double>> elem_T;
+	std::vector<CMatrixDouble33> elem_cov;
+	consist_matrix->setZero();
+	for (size_t b1 = 0; b1 < nB; b1++)
+	{
+		for (size_t b2 = b1 + 1; b2 < nB; b2++)
+		{
+			for (size_t a1 = 0; a1 < nA; a1++)
+			{
+				const hypot_t* hypot_b2_a1 = hypots[b2 * nA + a1];
+				if (!hypot_b2_a1->is_valid) continue;
+				for (size_t a2 = a1 + 1; a2 < nA; a2++)
 				{
-					TNodeID a2 = *a2_it;
-					hypot_t* hypot_b1_a2 =
-						this->findHypotByEnds(hypots_pool, b1, a2);
-					// MRPT_LOG_DEBUG_STREAM("hypot_b1_a2: " <<
-					// hypot_b1_a2->getAsString());
-
-					double consistency;
-
-					// compute consistency element
-					if (hypot_b2_a1->is_valid && hypot_b1_a2->is_valid)
-					{
-						// extract vector of hypotheses that connect the given
-						// nodes,
-						// instead of passing the whole hypothesis pool.
-						hypotsp_t extracted_hypots;
-						extracted_hypots.push_back(hypot_b2_a1);
-						extracted_hypots.push_back(hypot_b1_a2);
-
-						paths_t* curr_opt_paths = NULL;
-						if (groupA_opt_paths || groupB_opt_paths)
-						{  // fill curr_opt_paths
-							curr_opt_paths = new paths_t();
-						}
-
-						// decide on additional optimal paths
-						if (curr_opt_paths)
-						{
-							// groupA
-							if (groupA_opt_paths)
-							{  // a1 -> a2 optimal path
-								const path_t* p = this->findPathByEnds(
-									*groupA_opt_paths, a1, a2,
-									true);
-								curr_opt_paths->push_back(*p);
-							}
-							else
-							{  // empty
-								curr_opt_paths->push_back(path_t());
-							}
-
-							if (groupB_opt_paths)
-							{  // b1 -> b2 optimal path
-								const path_t* p = this->findPathByEnds(
-									*groupB_opt_paths, b1, b2,
-									true);
-								curr_opt_paths->push_back(*p);
-							}
-							else
-							{  // empty
-								curr_opt_paths->push_back(path_t());
-							}
-						}
-
-						consistency = this->generatePWConsistencyElement(
-							a1, a2, b1, b2, extracted_hypots, curr_opt_paths);
-
-						delete curr_opt_paths;
-					}
-					else
-					{  //  null those that don't look good
-						consistency = 0;
-					}
-
-					// MRPT_LOG_DEBUG_STREAM(
-					//"Adding hypothesis consistency for nodeIDs: "
-					//<< "[b1] " << b1 << ", [b2] -> " << b2
-					//<< ", [a1] -> " << a1 << ", [a2] -> " << a2
-					//<< " ==> " << consistency << endl);
-
-					// fill the PW consistency matrix corresponding element -
-					// symmetrical
-					int id1 = hypot_b2_a1->id;
-					int id2 = hypot_b1_a2->id;
-
-					(*consist_matrix)(id1, id2) = consistency;
-					(*consist_matrix)(id2, id1) = consistency;
-
-					// MRPT_LOG_DEBUG_STREAM("id1 = " << id1 << "\t|"
-					//<< "id2 = " << id2 << "\t|"
-					//<< "consistency = " << consistency);
+					const hypot_t* hypot_b1_a2 = hypots[b1 * nA + a2];
+					if (!hypot_b1_a2->is_valid) continue;
+
+					constraint_t res_transform(pathPDF(paths_A, a1, a2));
+					res_transform += hypot_b1_a2->getInverseEdge();
+					res_transform += pathPDF(paths_B, b1, b2);
+					res_transform += hypot_b2_a1->getEdge();
+
+					elem_ids.emplace_back(hypot_b2_a1->id, hypot_b1_a2->id);
+					elem_T.emplace_back();
+					res_transform.getMeanVal().getAsVector(elem_T.back());
+					elem_cov.emplace_back();
+					res_transform.getCovariance(elem_cov.back());
 				}
 			}
 		}
 	}
 
+	// ...and evaluate them in a single batch: exp(-T^t * C * T). Elements of
+	// pairs with any invalid hypothesis are left to zero.
+	const size_t nElems = elem_ids.size();
+	Eigen::ArrayXd consistency(nElems);
+	for (size_t k = 0; k < nElems; k++)
+		consistency[k] = -elem_T[k].dot(elem_cov[k] * elem_T[k]);
+	consistency = consistency.exp();
+	for (size_t k = 0; k < nElems; k++)
+	{
+		// fill the PW consistency matrix corresponding element - symmetrical
+		(*consist_matrix)(elem_ids[k].first, elem_ids[k].second) =
+			consistency[k];
+		(*consist_matrix)(elem_ids[k].second, elem_ids[k].first) =
+			consistency[k];
+	}
+
 	// MRPT_LOG_WARN_STREAM("Consistency matrix:" << endl
 	//<< this->header_sep << endl
 	//<< *consist_matrix << endl);
@@ -1150,7 +1243,7 @@ double CLoopCloserERD<GRAPH_T>::generatePWConsistencyElement(
 
 	// b1 ==> b2
 	const path_t* path_b1_b2;
-	if (!opt_paths || opt_paths->rend()->isEmpty())
+	if (!opt_paths || opt_paths->rbegin()->isEmpty())
 	{
 		MRPT_LOG_DEBUG_STREAM(
 			"Running djkstra [b1] " << b1 << " => [b2] " << b2);
@@ -2601,6 +2694,10 @@ void CLoopCloserERD<GRAPH_T>::TLoopClosureParams::dumpToTextStream(
 	   << (LC_check_curr_partition_only ? "TRUE" : "FALSE") << endl;
 	ss << "New registered nodes required for full partitioning   = "
 	   << full_partition_per_nodes << endl;
+	ss << "Use correlative matcher for the initial ICP estimation = "
+	   << (LC_use_correlative_matcher ? "TRUE" : "FALSE") << endl;
+	ss << "Threads for scan matching the hypotheses (0: auto)    = "
+	   << LC_num_threads << endl;
 	ss << "Visualize map partitions                              = "
 	   << (visualize_map_partitions ? "TRUE" : "FALSE") << endl;
 
@@ -2623,6 +2720,11 @@ void CLoopCloserERD<GRAPH_T>::TLoopClosureParams::loadFromConfigFile(
 		source.read_bool(section, "LC_check_curr_partition_only", true, false);
 	full_partition_per_nodes =
 		source.read_int(section, "full_partition_per_nodes", 50, false);
+	LC_use_correlative_matcher =
+		source.read_bool(section, "LC_use_correlative_matcher", false, false);
+	correlative_matcher.options.loadFromConfigFile(
+		source, section + std::string(".correlative_matcher"));
+	LC_num_threads = source.read_int(section, "LC_num_threads", 0, false);
 	visualize_map_partitions = source.read_bool(
 		"VisualizationParameters", "visualize_map_partitions", true, false);
 
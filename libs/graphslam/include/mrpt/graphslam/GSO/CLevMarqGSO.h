@@ -20,10 +20,14 @@
 #include <mrpt/graphslam/levmarq.h>
 #include <mrpt/graphslam/interfaces/CGraphSlamOptimizer.h>
 
+#include <future>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <map>
 #include <cmath>
+#include <set>
+#include <thread>
 
 namespace mrpt::graphslam::optimizers
 {
@@ -49,7 +53,10 @@ namespace mrpt::graphslam::optimizers
  *   + \a Default value :  FALSE
  *   + \a Required      : FALSE
  *   + \a Description   : Specify whether to use a second thread to optimize
- *   the graph.
+ *   the graph. If set, the optimizer's own copy of the graph is optimized in
+ *   the background while the registration deciders keep on working on the
+ *   live graph, and the result is applied to the latter once ready. See
+ *   getLastOptimizedGraph().
  *
  * - \b LC_min_nodeid_diff
  *  + \a Section       : GeneralConfiguration
@@ -132,7 +139,7 @@ class CLevMarqGSO
 	/**\}*/
 
 	CLevMarqGSO();
-	~CLevMarqGSO() override = default;
+	~CLevMarqGSO() override;
 
 	bool updateState(
 		mrpt::obs::CActionCollection::Ptr action,
@@ -213,6 +220,18 @@ class CLevMarqGSO
 
 	bool justFullyOptimizedGraph() const override;
 
+	/**\brief The last optimized graph, or nullptr if no optimization has
+	 * finished yet.
+	 *
+	 * The returned graph is never modified afterwards, so it can be read
+	 * (e.g. visualized) from any thread without locking nor copying the live
+	 * graph. Nodes registered while it was being optimized are not in it.
+	 */
+	std::shared_ptr<const GRAPH_T> getLastOptimizedGraph() const
+	{
+		return std::atomic_load(&m_last_optimized_graph);
+	}
+
 	/** Parameters relevant to the optimizatio nfo the graph. */
 	OptimizationParams opt_params;
 	/** Parameters relevant to the visualization of the graph. */
@@ -227,19 +246,21 @@ class CLevMarqGSO
 		const GRAPH_T& graph, const size_t iter, const size_t max_iter,
 		const double cur_sq_error);
 
-	/**\brief Optimize the given graph.
+	/**\brief Optimize the graph, and wait for the result. The caller must
+	 * hold the graph section.
 	 *
-	 * Wrapper around the graphslam::optimize_spa_levmarq method
+	 * Wrapper around the graphslam::optimize_spa_levmarq method, see
+	 * startOptimization() and publishOptimization().
 	 * \sa optimize_spa_levmarq, optimizeGraph
 	 *
 	 * \param[in] full_update Impose that method optimizes the whole graph
 	 *
 	 */
 	void _optimizeGraph(bool is_full_update = false);
-	/** \brief Wrapper around _optimizeGraph which first locks the section and
-	 * then calls the _optimizeGraph method.
+	/** \brief Thread-safe version of _optimizeGraph.
 	 *
-	 * Used in multithreaded optimization
+	 * The graph section is only locked to start the optimization and to apply
+	 * its result, so nodes and edges can be registered while it runs.
 	 * \sa _optimizeGraph()
 	 */
 	void optimizeGraph() override;
@@ -332,8 +353,59 @@ class CLevMarqGSO
 	// added (when m_graph->nodeCount() > m_last_total_num_of_nodes)
 	size_t m_last_total_num_of_nodes;
 
-	// Use second thread for graph optimization
-	std::thread m_thread_optimize;
+	/**\name Optimization on the optimizer's own graph
+	 *
+	 * LevMarq never runs on the live graph, but on m_opt_graph, which is only
+	 * brought up to date with the live graph (see syncOptimizerGraph()) when
+	 * an optimization starts. With \b optimization_on_second_thread it runs in
+	 * the background, so the graph section needs not be locked meanwhile, and
+	 * the optimized poses are applied to the live graph, in a single step, by
+	 * the next updateState() call after it finished.
+	 */
+	/**\{*/
+	/**\brief Sync m_opt_graph with the live graph and start optimizing it,
+	 * unless an optimization is already pending. The caller must hold the
+	 * graph section.
+	 *
+	 * \param[in] in_background Run it on a new thread. Otherwise, it's run
+	 * by the publishOptimization() call that waits for it.
+	 * \return False if there was nothing to start.
+	 */
+	bool startOptimization(bool is_full_update, bool in_background);
+	/**\brief If the pending optimization has finished, apply its result to
+	 * the live graph. The caller must hold the graph section.
+	 *
+	 * \param[in] wait Wait for the optimization to finish, if running.
+	 * \return True if a result was applied.
+	 * \sa applyOptimizedGraph()
+	 */
+	bool publishOptimization(bool wait = false);
+	/**\brief Nodes to optimize: nullptr means all but the root node. */
+	std::unique_ptr<std::set<mrpt::graphs::TNodeID>> getNodesToOptimize(
+		bool is_full_update);
+	/**\brief Bring m_opt_graph up to date with the live graph, in place:
+	 * poses are overwritten and new nodes and edges are inserted, so the
+	 * graph is not reallocated. */
+	void syncOptimizerGraph();
+	/**\brief Overwrite the poses of the live graph with those of an
+	 * optimized copy of it. The caller must hold the graph section.
+	 *
+	 * Poses of the nodes registered since the copy was taken are moved along
+	 * with the newest node of the copy, so their relative poses are kept.
+	 */
+	void applyOptimizedGraph(const GRAPH_T& optimized);
+
+	/** The graph optimized by LevMarq. While an optimization is pending, it's
+	 * only accessed by the latter. */
+	GRAPH_T m_opt_graph;
+	/** The pending optimization, if valid(). It returns a copy of the
+	 * optimized m_opt_graph, to be published. */
+	std::shared_future<std::shared_ptr<const GRAPH_T>> m_opt_result;
+	bool m_opt_is_full_update = false;
+	std::shared_ptr<const GRAPH_T> m_last_optimized_graph;
+	/** The graph drawn by updateGraphVisualization() */
+	std::shared_ptr<const GRAPH_T> m_visualized_graph;
+	/**\}*/
 
 	/**\brief Enumeration that defines the behaviors towards using or ignoring a
 	 * newly added loop closure to fully optimize the graph
@@ -9,6 +9,10 @@
 
 #pragma once
 
+#include <mrpt/config/CConfigFile.h>
+#include <mrpt/opengl/CDisk.h>
+#include <mrpt/opengl/CSphere.h>
+
 namespace mrpt::graphslam::optimizers
 {
 
@@ -27,6 +31,12 @@ CLevMarqGSO<GRAPH_T>::CLevMarqGSO()
 	this->initializeLoggers("CLevMarqGSO");
 }
 
+template <class GRAPH_T>
+CLevMarqGSO<GRAPH_T>::~CLevMarqGSO()
+{
+	if (m_opt_result.valid()) m_opt_result.wait();
+}
+
 template <class GRAPH_T>
 bool CLevMarqGSO<GRAPH_T>::updateState(
 	mrpt::obs::CActionCollection::Ptr action,
@@ -34,6 +44,9 @@ bool CLevMarqGSO<GRAPH_T>::updateState(
 	mrpt::obs::CObservation::Ptr observation)
 {
 	MRPT_START;
+	// apply the result of the background optimization as soon as it's ready
+	this->publishOptimization();
+
 	if (this->m_graph->nodeCount() > m_last_total_num_of_nodes)
 	{
 		m_last_total_num_of_nodes = this->m_graph->nodeCount();
@@ -45,18 +58,19 @@ bool CLevMarqGSO<GRAPH_T>::updateState(
 			m_first_time_call = true;
 		}
 
-		if (opt_params.optimization_on_second_thread)
+		// on a seperate thread, skip this optimization if the previous one
+		// is still running: never wait for it here.
+		if (!m_opt_result.valid())
 		{
-			// join the previous optimization thread
-			m_thread_optimize.join();
-
-			// optimize the graph - run on a seperate thread
-			m_thread_optimize = std::thread(&CLevMarqGSO::optimizeGraph, this);
-		}
-		else
-		{  // single threaded implementation
 			bool is_full_update = this->checkForFullOptimization();
-			this->_optimizeGraph(is_full_update);
+			if (opt_params.optimization_on_second_thread)
+			{
+				this->startOptimization(is_full_update, /*in_background=*/true);
+			}
+			else
+			{  // single threaded implementation
+				this->_optimizeGraph(is_full_update);
+			}
 		}
 	}
 
@@ -114,6 +128,8 @@ void CLevMarqGSO<GRAPH_T>::notifyOfWindowEvents(
 
 		if (events_occurred.find(opt_params.keystroke_optimize_graph)->second)
 		{
+			// don't race with the background optimization, if any
+			this->publishOptimization(/*wait=*/true);
 			this->_optimizeGraph(/*is_full_update=*/true);
 		}
 	}
@@ -171,6 +187,16 @@ inline void CLevMarqGSO<GRAPH_T>::updateGraphVisualization()
 	this->logFmt(
 		mrpt::system::LVL_DEBUG, "In the updateGraphVisualization function");
 
+	// Draw the last optimized graph, which is never modified: the objects are
+	// only rebuilt when a new one is published. Until then, draw the live one.
+	const auto optimized = this->getLastOptimizedGraph();
+	if (optimized && optimized == m_visualized_graph)
+	{
+		return;
+	}
+	m_visualized_graph = optimized;
+	const GRAPH_T& graph = optimized ? *optimized : *this->m_graph;
+
 	// update the graph (clear and rewrite..)
 	COpenGLScene::Ptr& scene = this->m_win->get3DSceneAndLock();
 
@@ -187,7 +213,7 @@ inline void CLevMarqGSO<GRAPH_T>::updateGraphVisualization()
 	// CSetOfObjects::Ptr graph_obj =
 	// graph_tools::graph_visualize(*this->m_graph, viz_params.cfg);
 	CSetOfObjects::Ptr graph_obj = mrpt::make_aligned_shared<CSetOfObjects>();
-	this->m_graph->getAs3DObject(graph_obj, viz_params.cfg);
+	graph.getAs3DObject(graph_obj, viz_params.cfg);
 
 	graph_obj->setName("optimized_graph");
 	graph_obj->setVisibility(prev_visibility);
@@ -198,7 +224,7 @@ inline void CLevMarqGSO<GRAPH_T>::updateGraphVisualization()
 		5, -viz_params.offset_y_graph,
 		format(
 			"Optimized Graph: #nodes %d",
-			static_cast<int>(this->m_graph->nodeCount())),
+			static_cast<int>(graph.nodeCount())),
 		mrpt::img::TColorf(0.0, 0.0, 0.0),
 		/* unique_index = */ viz_params.text_index_graph);
 
@@ -391,10 +417,29 @@ void CLevMarqGSO<GRAPH_T>::optimizeGraph()
 									<< "\t"
 									<< "Trying to grab lock... ");
 
-	std::lock_guard<std::mutex> graph_lock(*this->m_graph_section);
-	this->_optimizeGraph();
+	// Only hold the graph section to start the optimization, and later on to
+	// apply its result: the graph can be extended meanwhile.
+	std::shared_future<std::shared_ptr<const GRAPH_T>> result;
+	{
+		std::lock_guard<std::mutex> graph_lock(*this->m_graph_section);
+		this->logFmt(mrpt::system::LVL_DEBUG, "2nd thread grabbed the lock..");
+
+		this->publishOptimization(/*wait=*/true);
+		if (!this->startOptimization(
+				/*is_full_update=*/false, /*in_background=*/true))
+		{
+			return;
+		}
+		result = m_opt_result;
+	}
 
-	this->logFmt(mrpt::system::LVL_DEBUG, "2nd thread grabbed the lock..");
+	result.wait();
+
+	{
+		// unless updateState() has already applied it
+		std::lock_guard<std::mutex> graph_lock(*this->m_graph_section);
+		this->publishOptimization();
+	}
 
 	MRPT_END;
 }
@@ -405,70 +450,179 @@ void CLevMarqGSO<GRAPH_T>::_optimizeGraph(bool is_full_update /*=false*/)
 	MRPT_START;
 	this->m_time_logger.enter("CLevMarqGSO::_optimizeGraph");
 
+	// runs the optimization right away, on this thread
+	if (this->startOptimization(is_full_update, /*in_background=*/false))
+	{
+		this->publishOptimization(/*wait=*/true);
+	}
+
+	this->m_time_logger.leave("CLevMarqGSO::_optimizeGraph");
+	MRPT_END;
+}  // end of _optimizeGraph
+
+template <class GRAPH_T>
+bool CLevMarqGSO<GRAPH_T>::startOptimization(
+	bool is_full_update, bool in_background)
+{
+	MRPT_START;
 	// if less than X nodes exist overall, do not try optimizing
-	if (m_min_nodes_for_optimization > this->m_graph->nodes.size())
+	if (m_opt_result.valid() ||
+		m_min_nodes_for_optimization > this->m_graph->nodes.size())
 	{
-		return;
+		return false;
 	}
+	this->m_time_logger.enter("CLevMarqGSO::startOptimization");
 
-	mrpt::system::CTicTac optimization_timer;
-	optimization_timer.Tic();
+	auto nodes_to_optimize = this->getNodesToOptimize(is_full_update);
+	this->syncOptimizerGraph();
+	m_opt_is_full_update = is_full_update;
 
-	// set of nodes for which the optimization procedure will take place
-	std::set<mrpt::graphs::TNodeID>* nodes_to_optimize;
+	m_opt_result =
+		std::async(
+			in_background ? std::launch::async : std::launch::deferred,
+			[this, cfg = opt_params.cfg,
+			 nodes_to_optimize = std::move(nodes_to_optimize)]() {
+				mrpt::system::CTicTac optimization_timer;
+				optimization_timer.Tic();
 
-	// fill in the nodes in certain distance to the current node, only if
-	// is_full_update is not instructed
-	if (is_full_update)
+				graphslam::TResultInfoSpaLevMarq levmarq_info;
+				mrpt::graphslam::optimize_graph_spa_levmarq(
+					m_opt_graph, levmarq_info, nodes_to_optimize.get(), cfg,
+					&CLevMarqGSO<GRAPH_T>::levMarqFeedback);
+
+				this->logFmt(
+					mrpt::system::LVL_DEBUG, "Optimization of graph took: %fs",
+					optimization_timer.Tac());
+				return std::make_shared<const GRAPH_T>(m_opt_graph);
+			})
+			.share();
+
+	this->m_time_logger.leave("CLevMarqGSO::startOptimization");
+	return true;
+	MRPT_END;
+}
+
+template <class GRAPH_T>
+bool CLevMarqGSO<GRAPH_T>::publishOptimization(bool wait)
+{
+	MRPT_START;
+	if (!m_opt_result.valid() ||
+		(!wait && m_opt_result.wait_for(std::chrono::seconds(0)) !=
+					  std::future_status::ready))
 	{
-		// nodes_to_optimize: List of nodes to optimize. nullptr -> all but the
-		// root
-		// node.
-		nodes_to_optimize = nullptr;
+		return false;
 	}
-	else
-	{
-		nodes_to_optimize = new std::set<mrpt::graphs::TNodeID>;
+	// (get() rethrows the exception of the optimization, if any)
+	const auto result = std::move(m_opt_result);
+	const std::shared_ptr<const GRAPH_T> optimized = result.get();
+
+	this->m_time_logger.enter("CLevMarqGSO::publishOptimization");
+
+	this->applyOptimizedGraph(*optimized);
+	m_just_fully_optimized_graph = m_opt_is_full_update;
+
+	MRPT_LOG_DEBUG_STREAM(
+		"Applied optimization of " << optimized->nodes.size() << " nodes");
+	std::atomic_store(&m_last_optimized_graph, optimized);
+
+	this->m_time_logger.leave("CLevMarqGSO::publishOptimization");
+	return true;
+	MRPT_END;
+}
 
-		// I am certain that this shall not be called when nodeCount = 0, since
-		// the
-		// optimization procedure starts only after certain number of nodes has
-		// been added
+template <class GRAPH_T>
+std::unique_ptr<std::set<mrpt::graphs::TNodeID>>
+	CLevMarqGSO<GRAPH_T>::getNodesToOptimize(bool is_full_update)
+{
+	// nullptr -> all but the root node.
+	std::unique_ptr<std::set<mrpt::graphs::TNodeID>> nodes_to_optimize;
+	if (!is_full_update)
+	{
+		nodes_to_optimize.reset(new std::set<mrpt::graphs::TNodeID>);
 		this->getNearbyNodesOf(
-			nodes_to_optimize, this->m_graph->nodeCount() - 1,
+			nodes_to_optimize.get(), this->m_graph->nodeCount() - 1,
 			opt_params.optimization_distance);
 		nodes_to_optimize->insert(this->m_graph->nodeCount() - 1);
 	}
+	return nodes_to_optimize;
+}
 
-	graphslam::TResultInfoSpaLevMarq levmarq_info;
-
-	// Execute the optimization
-	mrpt::graphslam::optimize_graph_spa_levmarq(
-		*(this->m_graph), levmarq_info, nodes_to_optimize, opt_params.cfg,
-		&CLevMarqGSO<GRAPH_T>::levMarqFeedback);  // functor feedback
-
-	if (is_full_update)
+template <class GRAPH_T>
+void CLevMarqGSO<GRAPH_T>::syncOptimizerGraph()
+{
+	MRPT_START;
+	const GRAPH_T& live = *this->m_graph;
+	m_opt_graph.root = live.root;
+
+	// Both are sorted by ID: walk them side by side. The poses are always
+	// overwritten, since they may have been changed (e.g. re-estimated by
+	// CGraphSlamEngine after each new node).
+	auto& opt_nodes = m_opt_graph.nodes;
+	auto it_node = opt_nodes.begin();
+	for (const auto& node : live.nodes)
 	{
-		m_just_fully_optimized_graph = true;
+		while (it_node != opt_nodes.end() && it_node->first < node.first)
+		{
+			it_node = opt_nodes.erase(it_node);
+		}
+		if (it_node != opt_nodes.end() && it_node->first == node.first)
+		{
+			(it_node++)->second = node.second;
+		}
+		else
+		{
+			opt_nodes.insert(it_node, node);
+		}
 	}
-	else
+	opt_nodes.erase(it_node, opt_nodes.end());
+
+	// Edges are never modified once inserted: only insert the new ones.
+	auto& opt_edges = m_opt_graph.edges;
+	auto it_edge = opt_edges.begin();
+	for (const auto& edge : live.edges)
 	{
-		m_just_fully_optimized_graph = false;
+		while (it_edge != opt_edges.end() && it_edge->first < edge.first)
+		{
+			it_edge = opt_edges.erase(it_edge);
+		}
+		if (it_edge != opt_edges.end() && it_edge->first == edge.first)
+		{
+			++it_edge;
+		}
+		else
+		{
+			opt_edges.insert(it_edge, edge);
+		}
 	}
+	opt_edges.erase(it_edge, opt_edges.end());
+	MRPT_END;
+}
 
-	double elapsed_time = optimization_timer.Tac();
-	this->logFmt(
-		mrpt::system::LVL_DEBUG, "Optimization of graph took: %fs",
-		elapsed_time);
+template <class GRAPH_T>
+void CLevMarqGSO<GRAPH_T>::applyOptimizedGraph(const GRAPH_T& optimized)
+{
+	MRPT_START;
+	auto& live_nodes = this->m_graph->nodes;
+	const auto& opt_nodes = optimized.nodes;
+	ASSERT_(!opt_nodes.empty());
 
-	// deleting the nodes_to_optimize set
-	delete nodes_to_optimize;
-	nodes_to_optimize = nullptr;
+	// Nodes registered in the meantime follow the newest optimized node:
+	const mrpt::graphs::TNodeID last_id = opt_nodes.rbegin()->first;
+	const pose_t last_before = live_nodes.at(last_id);
+	const pose_t last_after = opt_nodes.at(last_id);
 
-	this->m_time_logger.leave("CLevMarqGSO::_optimizeGraph");
-	MRPT_UNUSED_PARAM(elapsed_time);
+	for (auto& node : live_nodes)
+	{
+		// only overwrite the pose, not the node annotations (if any)
+		pose_t& pose = node.second;
+		auto it = opt_nodes.find(node.first);
+		if (it != opt_nodes.end())
+			pose = it->second;
+		else
+			pose = last_after + (pose - last_before);
+	}
 	MRPT_END;
-}  // end of _optimizeGraph
+}
 
 template <class GRAPH_T>
 bool CLevMarqGSO<GRAPH_T>::checkForLoopClosures()
@@ -0,0 +1,135 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include <gtest/gtest.h>
+#include <mrpt/graphs/CNetworkOfPoses.h>
+#include <mrpt/graphslam/GSO/CLevMarqGSO.h>
+#include <mrpt/random.h>
+
+#include <mutex>
+#include <thread>
+
+using namespace mrpt;
+using namespace mrpt::graphs;
+using namespace mrpt::poses;
+
+using graph_t = CNetworkOfPoses2DInf;
+
+namespace
+{
+// Gives access to the protected optimization entry points
+struct TestGSO : public mrpt::graphslam::optimizers::CLevMarqGSO<graph_t>
+{
+	using CLevMarqGSO<graph_t>::publishOptimization;
+};
+
+void appendNode(graph_t& g, const CPose2D& odo, double cov_inv)
+{
+	const TNodeID last = g.nodes.rbegin()->first;
+	graph_t::constraint_t e;
+	e.mean = odo;
+	e.cov_inv.setIdentity();
+	e.cov_inv *= cov_inv;
+	g.insertEdge(last, last + 1, e);
+	g.nodes[last + 1] = g.nodes[last] + odo;
+}
+}  // namespace
+
+// Nodes registered while the background optimization runs must not get lost,
+// and must keep their poses relative to the optimized ones.
+TEST(CLevMarqGSO, appendNodesWhileOptimizing)
+{
+	auto& rng = mrpt::random::getRandomGenerator();
+	rng.randomize(123);
+
+	// A noisy circular path, with loop closures:
+	graph_t g;
+	g.root = 0;
+	g.nodes[0] = CPose2D();
+	const CPose2D odo(0.5, 0, DEG2RAD(360.0 / 100));
+	const size_t N = 1000;
+	for (TNodeID i = 1; i < N; i++)
+	{
+		appendNode(
+			g,
+			odo + CPose2D(
+					  rng.drawGaussian1D(0, 0.02), rng.drawGaussian1D(0, 0.02),
+					  rng.drawGaussian1D(0, 0.01)),
+			100);
+		if (i >= 100)
+		{
+			graph_t::constraint_t lc;
+			lc.cov_inv.setIdentity();
+			lc.cov_inv *= 100;
+			g.insertEdge(i - 100, i, lc);
+		}
+	}
+	const double chi2_init = g.chi2();
+
+	std::mutex graph_section;
+	TestGSO gso;
+	gso.setMinLoggingLevel(mrpt::system::LVL_ERROR);
+	gso.setGraphPtr(&g);
+	gso.setCriticalSectionPtr(&graph_section);
+	gso.opt_params.optimization_on_second_thread = true;
+	gso.opt_params.optimization_distance = -1;  // all the nodes
+	gso.opt_params.cfg["max_iterations"] = 20;
+
+	// Starts optimizing the N nodes in the background:
+	{
+		std::lock_guard<std::mutex> lock(graph_section);
+		gso.updateState(nullptr, nullptr, nullptr);
+	}
+	EXPECT_FALSE(gso.getLastOptimizedGraph());
+
+	// Registered after the optimization started, hence not optimized by it:
+	const size_t num_appended = 50;
+	for (size_t i = 0; i < num_appended; i++)
+	{
+		std::lock_guard<std::mutex> lock(graph_section);
+		appendNode(g, odo, 1e6);
+	}
+
+	// The next updateState() calls apply the result, once ready:
+	while (!gso.getLastOptimizedGraph())
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		std::lock_guard<std::mutex> lock(graph_section);
+		gso.updateState(nullptr, nullptr, nullptr);
+	}
+
+	// Nothing lost, and the optimized result was applied:
+	ASSERT_EQ(g.nodes.size(), N + num_appended);
+	EXPECT_LT(g.chi2(), chi2_init);
+	const auto last_optimized = gso.getLastOptimizedGraph();
+	ASSERT_EQ(last_optimized->nodes.size(), N);
+	for (const auto& node : last_optimized->nodes)
+	{
+		const auto d = g.nodes.at(node.first) - node.second;
+		EXPECT_NEAR(d.norm(), 0, 1e-9);
+	}
+
+	// The new nodes kept their poses relative to their predecessors:
+	for (TNodeID id = N; id < g.nodes.size(); id++)
+	{
+		const CPose2D d = g.nodes.at(id) - g.nodes.at(id - 1);
+		EXPECT_NEAR(d.x(), odo.x(), 1e-3) << "node: " << id;
+		EXPECT_NEAR(d.y(), odo.y(), 1e-3) << "node: " << id;
+		EXPECT_NEAR(d.phi(), odo.phi(), 1e-3) << "node: " << id;
+	}
+
+	// A new node triggers the optimization of all of them:
+	{
+		std::lock_guard<std::mutex> lock(graph_section);
+		appendNode(g, odo, 1e6);
+		gso.updateState(nullptr, nullptr, nullptr);
+		EXPECT_TRUE(gso.publishOptimization(/*wait=*/true));
+	}
+	EXPECT_EQ(gso.getLastOptimizedGraph()->nodes.size(), g.nodes.size());
+}
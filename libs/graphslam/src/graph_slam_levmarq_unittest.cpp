@@ -33,6 +33,8 @@ const std::map<std::string, in_out_filenames> inout_graph_files{
 	 {{"graphslam_SE2_in.graph", "graphslam_SE2_out_good.graph"},
 	  {"graphslam_SE2_in2.graph", "graphslam_SE2_out_good2.graph"},
 	  {"graphslam_SE2_in3.graph", "graphslam_SE2_out_good3.graph"}}},
+	{"GraphTester2DCompact",
+	 {{"graphslam_SE2_in.graph", "graphslam_SE2_out_good.graph"}}},
 	{"GraphTester2DInf",
 	 {{"graphslam_SE2_in.graph", "graphslam_SE2_out_good.graph"},
 	  {"graphslam_SE2pdf_in.graph", "graphslam_SE2pdf_out_good.graph"}}}};
@@ -217,6 +219,8 @@ class GraphTester : public GraphSlamLevMarqTest<my_graph_t>,
 using GraphTester2D = GraphTester<CNetworkOfPoses2D>;
 using GraphTester3D = GraphTester<CNetworkOfPoses3D>;
 using GraphTester2DInf = GraphTester<CNetworkOfPoses2DInf>;
+using GraphTester2DCompact =
+	GraphTester<CNetworkOfPoses<CPose2D, map_traits_compact>>;
 using GraphTester3DInf = GraphTester<CNetworkOfPoses3DInf>;
 
 #define GRAPHS_TESTS(_TYPE)                           \
@@ -248,4 +252,5 @@ MRPT_TODO("Re-enable tests after https://github.com/MRPT/mrpt/issues/770");
 GRAPHS_TESTS(GraphTester2D)
 //GRAPHS_TESTS(GraphTester3D)
 GRAPHS_TESTS(GraphTester2DInf)
+GRAPHS_TESTS(GraphTester2DCompact)
 //GRAPHS_TESTS(GraphTester3DInf)
@@ -11,6 +11,7 @@
 
 #include <mrpt/config/CConfigFileBase.h>
 #include <mrpt/obs/CObservation.h>
+#include <mrpt/containers/lockfree_queue.h>
 #include <map>
 #include <mutex>
 
@@ -113,9 +114,12 @@ class CGenericSensor
 	static void registerClass(const TSensorClassId* pNewClass);
 
    private:
-	/** The critical section for m_objList */
+	/** The lock-free queue of objects to be returned by getObservations, so
+	 * high-rate sensors never block in appendObservations() */
+	mrpt::containers::mpsc_queue<TListObsPair> m_objQueue;
+	/** The critical section for m_objList and for popping from m_objQueue */
 	std::mutex m_csObjList;
-	/** The queue of objects to be returned by getObservations */
+	/** Objects appended while m_objQueue was full */
 	TListObservations m_objList;
 
 	/** Used in registerClass */
@@ -23,7 +23,8 @@ using namespace std;
 						Constructor
 -------------------------------------------------------------*/
 CGenericSensor::CGenericSensor()
-	: m_process_rate(0),
+	: m_objQueue(1024),
+	  m_process_rate(0),
 	  m_max_queue_len(200),
 	  m_grab_decimation(0),
 	  m_sensorLabel("UNNAMED_SENSOR"),
@@ -57,8 +58,6 @@ void CGenericSensor::appendObservations(
 	{
 		m_grab_decimation_counter = 0;
 
-		std::lock_guard<std::mutex> lock(m_csObjList);
-
 		for (const auto & obj : objs)
 		{
 				if (!obj) continue;
@@ -78,8 +77,13 @@ void CGenericSensor::appendObservations(
 			else
 				THROW_EXCEPTION("Passed object must be CObservation.");
 
-			// Add it:
-			m_objList.insert(TListObsPair(timestamp, obj));
+			// Add it (without locks, unless the queue is full):
+			TListObsPair p(timestamp, obj);
+			if (!m_objQueue.push(std::move(p)))
+			{
+				std::lock_guard<std::mutex> lock(m_csObjList);
+				m_objList.insert(std::move(p));
+			}
 		}
 	}
 }
@@ -90,8 +94,13 @@ void CGenericSensor::appendObservations(
 void CGenericSensor::getObservations(TListObservations& lstObjects)
 {
 	std::lock_guard<std::mutex> lock(m_csObjList);
-	lstObjects = m_objList;
-	m_objList.clear();  // Memory of objects will be freed by invoker.
+	lstObjects.clear();
+	lstObjects.swap(m_objList);  // Memory of objects will be freed by invoker.
+	// Merge by timestamp; objects usually come already sorted, so inserting
+	// at the end is O(1) most of the times:
+	TListObsPair p;
+	while (m_objQueue.pop(p))
+		lstObjects.emplace_hint(lstObjects.end(), std::move(p));
 }
 
 /*-------------------------------------------------------------
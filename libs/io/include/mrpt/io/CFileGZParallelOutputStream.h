@@ -0,0 +1,130 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+#pragma once
+
+#include <mrpt/io/CStream.h>
+#include <memory>
+
+namespace mrpt::io
+{
+/** Saves data to a gzip file like CFileGZOutputStream, but compressing in
+ * parallel threads, so the thread calling Write() only has to copy data.
+ *
+ * Written data is split into blocks of TOptions::block_size bytes, each one
+ * compressed by a pool of worker threads into an independent gzip member.
+ * A dedicated I/O thread writes the members to disk in order. The resulting
+ * multi-member ("concatenated") gzip file can be read back with
+ * CFileGZInputStream, gunzip, etc. Compression ratio is very close to that
+ * of a single gzip stream for blocks of 1 MiB or larger.
+ *
+ * Backpressure: if the disk or the compressors cannot keep up, at most
+ * TOptions::max_pending_blocks blocks are kept in memory and Write() blocks
+ * until one is written. The time spent blocked and the queue length are
+ * reported by getStats().
+ *
+ * Errors writing to disk are reported as an exception in the next call to
+ * Write(), flush() or close().
+ *
+ * \sa CFileGZOutputStream
+ * \ingroup mrpt_io_grp
+ */
+class CFileGZParallelOutputStream : public CStream
+{
+   public:
+	/** Parameters of open() */
+	struct TOptions
+	{
+		/** 0:no compression, 1:fastest, 9:best */
+		int compress_level{1};
+		/** Number of compression threads (0: one per hardware thread) */
+		unsigned int num_threads{0};
+		/** Size in bytes of uncompressed data in each gzip member */
+		size_t block_size{1 << 20};
+		/** Maximum number of blocks waiting to be compressed or written
+		 * before Write() blocks (0: 4 per compression thread) */
+		size_t max_pending_blocks{0};
+	};
+
+	/** Statistics of the pipeline, see getStats() */
+	struct TStats
+	{
+		/** Uncompressed bytes passed to Write() */
+		uint64_t bytes_in{0};
+		/** Compressed bytes already written to disk */
+		uint64_t bytes_out{0};
+		/** Number of gzip members already written to disk */
+		uint64_t blocks_written{0};
+		/** Blocks currently being compressed or waiting to be written */
+		size_t pending_blocks{0};
+		/** Maximum value of pending_blocks since open() */
+		size_t max_pending_blocks{0};
+		/** Total time (seconds) Write() was blocked due to backpressure */
+		double producer_wait_time{0};
+	};
+
+	/** Constructor: opens an output file with default TOptions.
+	 * \param fileName The file to be open in this stream
+	 * \sa open
+	 */
+	CFileGZParallelOutputStream(const std::string& fileName);
+
+	/** Constructor, without opening the file.
+	 * \sa open
+	 */
+	CFileGZParallelOutputStream();
+
+	CFileGZParallelOutputStream(const CFileGZParallelOutputStream&) = delete;
+	CFileGZParallelOutputStream& operator=(
+		const CFileGZParallelOutputStream&) = delete;
+
+	/** Destructor: calls close(), ignoring any error */
+	~CFileGZParallelOutputStream() override;
+
+	/** Open a file for write, choosing the compression level
+	 * \param fileName The file to be open in this stream
+	 * \param compress_level 0:no compression, 1:fastest, 9:best
+	 * \return true on success, false on any error.
+	 */
+	bool open(const std::string& fileName, int compress_level = 1);
+	/** \overload */
+	bool open(const std::string& fileName, const TOptions& options);
+	/** Compresses and writes all pending data, then closes the file.
+	 * \exception std::exception On any error writing to the file. */
+	void close();
+	/** Sends the data written so far to compression, without waiting for it
+	 * to reach the disk. Note that small blocks hurt the compression ratio.
+	 * \exception std::exception On any previous error writing to the file.
+	 */
+	void flush();
+	/** Returns true if the file was open without errors. */
+	bool fileOpenCorrectly() const;
+	/** Returns true if the file was open without errors. */
+	bool is_open() { return fileOpenCorrectly(); }
+	/** Returns a snapshot of the statistics of the pipeline */
+	TStats getStats() const;
+	/** Method for getting the current cursor position, in uncompressed
+	 * bytes, where 0 is the first byte and TotalBytesCount-1 the last one. */
+	uint64_t getPosition() const override;
+
+	/** This method is not implemented in this class */
+	uint64_t Seek(int64_t, CStream::TSeekOrigin = sFromBeginning) override;
+	/** This method is not implemented in this class */
+	uint64_t getTotalBytesCount() const override;
+	size_t Read(void* Buffer, size_t Count) override;
+	size_t Write(const void* Buffer, size_t Count) override;
+
+   private:
+	struct Impl;
+	std::unique_ptr<Impl> m_impl;
+};  // End of class def.
+static_assert(
+	!std::is_copy_constructible_v<CFileGZParallelOutputStream> &&
+		!std::is_copy_assignable_v<CFileGZParallelOutputStream>,
+	"Copy Check");
+}
@@ -0,0 +1,63 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace mrpt::io
+{
+/** Maps a whole file into memory, read-only, so its contents can be accessed
+ * as a plain byte array without reading or copying it: pages are loaded by
+ * the OS on demand, and shared with other processes mapping the same file.
+ *
+ * \sa CFileInputStream
+ * \ingroup mrpt_io_grp
+ */
+class CMemoryMappedFile
+{
+   public:
+	/** Constructor
+	 * \param fileName The file to be mapped
+	 * \exception std::exception On error opening or mapping the file.
+	 */
+	CMemoryMappedFile(const std::string& fileName);
+	/** Default constructor */
+	CMemoryMappedFile() = default;
+
+	CMemoryMappedFile(const CMemoryMappedFile&) = delete;
+	CMemoryMappedFile& operator=(const CMemoryMappedFile&) = delete;
+
+	~CMemoryMappedFile();
+
+	/** Maps a file, closing any previous one.
+	 * \return true on success.
+	 */
+	bool open(const std::string& fileName);
+	/** Unmaps the file. Pointers returned by data() become invalid. */
+	void close();
+	/** Returns true if a file is mapped (possibly an empty one) */
+	bool is_open() const { return m_is_open; }
+
+	/** The file contents, or nullptr for empty or closed files */
+	const uint8_t* data() const { return m_data; }
+	/** The file size, in bytes */
+	size_t size() const { return m_size; }
+
+   private:
+	const uint8_t* m_data{nullptr};
+	size_t m_size{0};
+	bool m_is_open{false};
+#ifdef _WIN32
+	void* m_hFile{nullptr};
+	void* m_hMap{nullptr};
+#endif
+};  // End of class def.
+}  // namespace mrpt::io
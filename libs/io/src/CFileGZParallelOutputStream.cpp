@@ -0,0 +1,345 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include "io-precomp.h"  // Precompiled headers
+
+#include <mrpt/io/CFileGZParallelOutputStream.h>
+#include <mrpt/core/exceptions.h>
+
+#include <zlib.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace mrpt::io;
+using namespace std;
+
+namespace
+{
+/** One block of data, from the producer to the disk */
+struct Block
+{
+	std::vector<uint8_t> raw, gz;
+	bool taken{false}, compressed{false};
+};
+
+/** Compresses \a in as one complete gzip member */
+bool gzipMember(
+	const std::vector<uint8_t>& in, int level, std::vector<uint8_t>& out)
+{
+	z_stream zs;
+	std::memset(&zs, 0, sizeof(zs));
+	// windowBits+16: gzip header and trailer instead of zlib ones
+	if (deflateInit2(&zs, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) !=
+		Z_OK)
+		return false;
+	// +32: room for the gzip header, not accounted for by old zlib versions
+	out.resize(deflateBound(&zs, in.size()) + 32);
+	zs.next_in = const_cast<Bytef*>(in.data());
+	zs.avail_in = static_cast<uInt>(in.size());
+	int ret;
+	do
+	{
+		if (zs.total_out == out.size()) out.resize(2 * out.size());
+		zs.next_out = out.data() + zs.total_out;
+		zs.avail_out = static_cast<uInt>(out.size() - zs.total_out);
+		ret = deflate(&zs, Z_FINISH);
+	} while (ret == Z_OK || ret == Z_BUF_ERROR);
+	out.resize(zs.total_out);
+	deflateEnd(&zs);
+	return ret == Z_STREAM_END;
+}
+}  // namespace
+
+struct CFileGZParallelOutputStream::Impl
+{
+	FILE* f{nullptr};
+	TOptions opts;
+	/** The block being filled by Write() */
+	std::vector<uint8_t> current;
+	uint64_t position{0};
+
+	// Everything below is protected by "mtx":
+	mutable std::mutex mtx;
+	std::condition_variable cv;
+	/** Blocks being compressed or waiting to be written, in file order */
+	std::deque<std::shared_ptr<Block>> pending;
+	bool quit{false};
+	bool error{false};
+	TStats stats;
+
+	std::vector<std::thread> workers;
+	std::thread writer;
+
+	void compressThread()
+	{
+		for (;;)
+		{
+			std::shared_ptr<Block> b;
+			{
+				std::unique_lock<std::mutex> lck(mtx);
+				cv.wait(lck, [&]() {
+					if (quit) return true;
+					for (const auto& p : pending)
+						if (!p->taken) return true;
+					return false;
+				});
+				for (const auto& p : pending)
+					if (!p->taken)
+					{
+						b = p;
+						break;
+					}
+				if (!b) return;  // quit, and nothing else to do
+				b->taken = true;
+			}
+			const bool ok = gzipMember(b->raw, opts.compress_level, b->gz);
+			b->raw = std::vector<uint8_t>();
+			{
+				std::lock_guard<std::mutex> lck(mtx);
+				b->compressed = true;
+				if (!ok) error = true;
+			}
+			cv.notify_all();
+		}
+	}
+
+	void writeThread()
+	{
+		for (;;)
+		{
+			std::shared_ptr<Block> b;
+			bool skip;
+			{
+				std::unique_lock<std::mutex> lck(mtx);
+				cv.wait(lck, [&]() {
+					return (!pending.empty() && pending.front()->compressed) ||
+						   (quit && pending.empty());
+				});
+				if (pending.empty()) return;
+				b = pending.front();
+				skip = error;  // Don't write anything after an error
+			}
+			const bool ok =
+				!skip && std::fwrite(b->gz.data(), 1, b->gz.size(), f) ==
+							 b->gz.size();
+			{
+				std::lock_guard<std::mutex> lck(mtx);
+				pending.pop_front();
+				if (!ok) error = true;
+				stats.bytes_out += b->gz.size();
+				stats.blocks_written++;
+				stats.pending_blocks = pending.size();
+			}
+			cv.notify_all();
+		}
+	}
+
+	/** Sends "current" to the compression threads, waiting if there are too
+	 * many pending blocks */
+	void submit()
+	{
+		auto b = std::make_shared<Block>();
+		b->raw.swap(current);
+		current.reserve(opts.block_size);
+
+		std::unique_lock<std::mutex> lck(mtx);
+		if (pending.size() >= opts.max_pending_blocks)
+		{
+			const auto t0 = std::chrono::steady_clock::now();
+			cv.wait(lck, [&]() {
+				return pending.size() < opts.max_pending_blocks;
+			});
+			stats.producer_wait_time +=
+				std::chrono::duration<double>(
+					std::chrono::steady_clock::now() - t0)
+					.count();
+		}
+		pending.push_back(b);
+		stats.pending_blocks = pending.size();
+		stats.max_pending_blocks =
+			std::max(stats.max_pending_blocks, stats.pending_blocks);
+		lck.unlock();
+		cv.notify_all();
+	}
+
+	void checkError() const
+	{
+		std::lock_guard<std::mutex> lck(mtx);
+		if (error) THROW_EXCEPTION("Error compressing or writing to file.");
+	}
+
+	/** Waits for all blocks to be written and closes the file.
+	 * \return false on any error. */
+	bool finish()
+	{
+		{
+			std::lock_guard<std::mutex> lck(mtx);
+			quit = true;
+		}
+		cv.notify_all();
+		for (auto& t : workers) t.join();
+		writer.join();
+		workers.clear();
+		const bool ok = !error && std::fclose(f) == 0;
+		f = nullptr;
+		return ok;
+	}
+};
+
+CFileGZParallelOutputStream::CFileGZParallelOutputStream(
+	const string& fileName)
+	: CFileGZParallelOutputStream()
+{
+	MRPT_START
+	if (!open(fileName))
+		THROW_EXCEPTION_FMT(
+			"Error trying to open file: '%s'", fileName.c_str());
+	MRPT_END
+}
+
+CFileGZParallelOutputStream::CFileGZParallelOutputStream()
+	: m_impl(std::make_unique<Impl>())
+{
+}
+
+bool CFileGZParallelOutputStream::open(
+	const string& fileName, int compress_level)
+{
+	TOptions opts;
+	opts.compress_level = compress_level;
+	return open(fileName, opts);
+}
+
+bool CFileGZParallelOutputStream::open(
+	const string& fileName, const TOptions& options)
+{
+	MRPT_START
+
+	if (m_impl->f)
+	{
+		try
+		{
+			close();
+		}
+		catch (std::exception&)
+		{
+		}
+	}
+	m_impl = std::make_unique<Impl>();
+	auto& d = *m_impl;
+
+	d.f = std::fopen(fileName.c_str(), "wb");
+	if (!d.f) return false;
+
+	d.opts = options;
+	d.opts.block_size = std::max<size_t>(d.opts.block_size, 1);
+	if (d.opts.num_threads == 0)
+		d.opts.num_threads = std::max(1U, std::thread::hardware_concurrency());
+	if (d.opts.max_pending_blocks == 0)
+		d.opts.max_pending_blocks = 4 * d.opts.num_threads;
+	d.current.reserve(d.opts.block_size);
+
+	for (unsigned int i = 0; i < d.opts.num_threads; i++)
+		d.workers.emplace_back(&Impl::compressThread, &d);
+	d.writer = std::thread(&Impl::writeThread, &d);
+	return true;
+
+	MRPT_END
+}
+
+CFileGZParallelOutputStream::~CFileGZParallelOutputStream()
+{
+	try
+	{
+		close();
+	}
+	catch (std::exception&)
+	{
+	}
+}
+
+void CFileGZParallelOutputStream::close()
+{
+	if (!m_impl->f) return;
+	// An empty file must still be a valid gzip file:
+	if (!m_impl->current.empty() || m_impl->position == 0) m_impl->submit();
+	if (!m_impl->finish())
+		THROW_EXCEPTION("Error compressing or writing to file.");
+}
+
+void CFileGZParallelOutputStream::flush()
+{
+	if (!m_impl->f) THROW_EXCEPTION("File is not open.");
+	m_impl->checkError();
+	if (!m_impl->current.empty()) m_impl->submit();
+}
+
+size_t CFileGZParallelOutputStream::Read(void*, size_t)
+{
+	THROW_EXCEPTION("Trying to read from an output file stream.");
+}
+
+size_t CFileGZParallelOutputStream::Write(const void* Buffer, size_t Count)
+{
+	auto& d = *m_impl;
+	if (!d.f) THROW_EXCEPTION("File is not open.");
+	d.checkError();
+
+	const auto* in = static_cast<const uint8_t*>(Buffer);
+	for (size_t left = Count; left > 0;)
+	{
+		const size_t n =
+			std::min(left, d.opts.block_size - d.current.size());
+		d.current.insert(d.current.end(), in, in + n);
+		in += n;
+		left -= n;
+		if (d.current.size() == d.opts.block_size) d.submit();
+	}
+	d.position += Count;
+	{
+		std::lock_guard<std::mutex> lck(d.mtx);
+		d.stats.bytes_in = d.position;
+	}
+	return Count;
+}
+
+uint64_t CFileGZParallelOutputStream::getPosition() const
+{
+	if (!m_impl->f) THROW_EXCEPTION("File is not open.");
+	return m_impl->position;
+}
+
+bool CFileGZParallelOutputStream::fileOpenCorrectly() const
+{
+	return m_impl->f != nullptr;
+}
+
+CFileGZParallelOutputStream::TStats CFileGZParallelOutputStream::getStats()
+	const
+{
+	std::lock_guard<std::mutex> lck(m_impl->mtx);
+	return m_impl->stats;
+}
+
+uint64_t CFileGZParallelOutputStream::Seek(int64_t, CStream::TSeekOrigin)
+{
+	THROW_EXCEPTION("Method not available in this class.");
+}
+
+uint64_t CFileGZParallelOutputStream::getTotalBytesCount() const
+{
+	THROW_EXCEPTION("Method not available in this class.");
+}
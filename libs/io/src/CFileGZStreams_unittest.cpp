@@ -9,6 +9,7 @@
 
 #include <mrpt/io/CFileGZOutputStream.h>
 #include <mrpt/io/CFileGZInputStream.h>
+#include <mrpt/io/CFileGZParallelOutputStream.h>
 #include <mrpt/system/filesystem.h>
 #include <mrpt/core/format.h>
 #include <gtest/gtest.h>
@@ -101,3 +102,68 @@ TEST(CFileGZStreams, compareWithTestGZFiles)
 			<< " compress_level:" << compress_level;
 	}
 }
+
+TEST(CFileGZStreams, readwriteTmpFileParallel)
+{
+	// Many small blocks, written in chunks of several sizes:
+	std::vector<uint8_t> tst_data;
+	std::mt19937 mersenne_engine{321};
+	std::uniform_int_distribution<uint8_t> dist{0, 7};
+	tst_data.resize(100000);
+	for (auto& v : tst_data) v = dist(mersenne_engine);
+
+	for (unsigned int num_threads : {1, 3})
+	{
+		const std::string fil = mrpt::system::getTempFileName() +
+								std::string("_par") +
+								std::to_string(num_threads);
+		// Write:
+		mrpt::io::CFileGZParallelOutputStream::TOptions opts;
+		opts.num_threads = num_threads;
+		opts.block_size = 4096;
+		opts.max_pending_blocks = 2;
+		{
+			mrpt::io::CFileGZParallelOutputStream fil_out;
+			EXPECT_TRUE(fil_out.open(fil, opts));
+			for (size_t i = 0, n = 1; i < tst_data.size(); i += n, n += 17)
+			{
+				n = std::min(n, tst_data.size() - i);
+				EXPECT_EQ(fil_out.Write(&tst_data[i], n), n);
+			}
+			EXPECT_EQ(fil_out.getPosition(), tst_data.size());
+			fil_out.close();
+			const auto stats = fil_out.getStats();
+			EXPECT_EQ(stats.bytes_in, tst_data.size());
+			EXPECT_EQ(
+				stats.blocks_written,
+				(tst_data.size() + opts.block_size - 1) / opts.block_size);
+			EXPECT_EQ(stats.pending_blocks, 0U);
+			EXPECT_LE(stats.max_pending_blocks, opts.max_pending_blocks);
+			EXPECT_EQ(stats.bytes_out, mrpt::system::getFileSize(fil));
+		}
+		// Read:
+		{
+			mrpt::io::CFileGZInputStream fil_in;
+			EXPECT_TRUE(fil_in.open(fil));
+
+			std::vector<uint8_t> rd_buf(tst_data.size() + 5);
+			const size_t rd_count = fil_in.Read(&rd_buf[0], rd_buf.size());
+			EXPECT_EQ(rd_count, tst_data.size());
+			EXPECT_TRUE(std::equal(
+				std::begin(tst_data), std::end(tst_data), std::begin(rd_buf)))
+				<< " num_threads:" << num_threads;
+		}
+	}
+}
+
+TEST(CFileGZStreams, emptyFileParallel)
+{
+	const std::string fil = mrpt::system::getTempFileName();
+	{
+		mrpt::io::CFileGZParallelOutputStream fil_out(fil);
+	}
+	mrpt::io::CFileGZInputStream fil_in;
+	EXPECT_TRUE(fil_in.open(fil));
+	uint8_t rd_buf[5];
+	EXPECT_EQ(fil_in.Read(rd_buf, sizeof(rd_buf)), 0U);
+}
@@ -0,0 +1,104 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include "io-precomp.h"  // Precompiled headers
+
+#include <mrpt/io/CMemoryMappedFile.h>
+#include <mrpt/core/exceptions.h>
+
+#ifdef _WIN32
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace mrpt::io;
+
+CMemoryMappedFile::CMemoryMappedFile(const std::string& fileName)
+{
+	MRPT_START
+	if (!open(fileName))
+		THROW_EXCEPTION_FMT(
+			"Error trying to map file: '%s'", fileName.c_str());
+	MRPT_END
+}
+
+CMemoryMappedFile::~CMemoryMappedFile() { close(); }
+
+bool CMemoryMappedFile::open(const std::string& fileName)
+{
+	close();
+#ifdef _WIN32
+	HANDLE hFile = CreateFileA(
+		fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER len;
+	if (!GetFileSizeEx(hFile, &len))
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+	m_hFile = hFile;
+	m_size = static_cast<size_t>(len.QuadPart);
+	m_is_open = true;
+	// Empty files can't be mapped, but are valid:
+	if (m_size == 0) return true;
+	m_hMap = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_hMap)
+		m_data = static_cast<const uint8_t*>(
+			MapViewOfFile(m_hMap, FILE_MAP_READ, 0, 0, 0));
+#else
+	const int fd = ::open(fileName.c_str(), O_RDONLY);
+	if (fd < 0) return false;
+	struct stat st;
+	if (fstat(fd, &st) != 0)
+	{
+		::close(fd);
+		return false;
+	}
+	m_size = static_cast<size_t>(st.st_size);
+	m_is_open = true;
+	if (m_size != 0)
+	{
+		void* p = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+		if (p != MAP_FAILED) m_data = static_cast<const uint8_t*>(p);
+	}
+	// The mapping stays valid after closing the descriptor:
+	::close(fd);
+	if (m_size == 0) return true;
+#endif
+	if (!m_data)
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+void CMemoryMappedFile::close()
+{
+#ifdef _WIN32
+	if (m_data) UnmapViewOfFile(m_data);
+	if (m_hMap) CloseHandle(m_hMap);
+	if (m_hFile) CloseHandle(m_hFile);
+	m_hMap = m_hFile = nullptr;
+#else
+	if (m_data) munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+	m_data = nullptr;
+	m_size = 0;
+	m_is_open = false;
+}
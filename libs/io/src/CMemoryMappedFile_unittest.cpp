@@ -0,0 +1,53 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include <mrpt/io/CMemoryMappedFile.h>
+#include <mrpt/io/CFileOutputStream.h>
+#include <mrpt/system/filesystem.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(CMemoryMappedFile, mapFile)
+{
+	std::vector<uint8_t> tst_data(100000);
+	for (size_t i = 0; i < tst_data.size(); i++)
+		tst_data[i] = static_cast<uint8_t>(i * 7);
+
+	const std::string fil = mrpt::system::getTempFileName();
+	{
+		mrpt::io::CFileOutputStream f(fil);
+		f.Write(tst_data.data(), tst_data.size());
+	}
+	mrpt::io::CMemoryMappedFile m(fil);
+	EXPECT_TRUE(m.is_open());
+	ASSERT_EQ(m.size(), tst_data.size());
+	EXPECT_TRUE(std::equal(tst_data.begin(), tst_data.end(), m.data()));
+
+	m.close();
+	EXPECT_FALSE(m.is_open());
+	EXPECT_EQ(m.data(), nullptr);
+	mrpt::system::deleteFile(fil);
+}
+
+TEST(CMemoryMappedFile, emptyAndMissingFiles)
+{
+	const std::string fil = mrpt::system::getTempFileName();
+	{
+		mrpt::io::CFileOutputStream f(fil);
+	}
+	mrpt::io::CMemoryMappedFile m;
+	EXPECT_TRUE(m.open(fil));
+	EXPECT_EQ(m.size(), 0U);
+	EXPECT_EQ(m.data(), nullptr);
+	mrpt::system::deleteFile(fil);
+
+	EXPECT_FALSE(m.open(fil));
+	EXPECT_FALSE(m.is_open());
+	EXPECT_THROW(mrpt::io::CMemoryMappedFile m2(fil), std::exception);
+}
@@ -61,6 +61,13 @@ class CBeaconMap : public mrpt::maps::CMetricMap
 	double internal_computeObservationLikelihood(
 		const mrpt::obs::CObservation* obs,
 		const mrpt::poses::CPose3D& takenFrom) override;
+	/** For mrpt::obs::CObservationBeaconRanges, beacons are looked up by ID
+	 * and packed into contiguous arrays once, then all the poses are
+	 * evaluated at once for each measurement. */
+	void internal_computeObservationLikelihoods(
+		const mrpt::obs::CObservation* obs,
+		const std::vector<mrpt::poses::CPose3D>& takenFrom,
+		double* out_log_liks) override;
 
    public:
 	/** Constructor */
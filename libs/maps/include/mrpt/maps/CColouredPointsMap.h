@@ -91,6 +91,9 @@ class CColouredPointsMap : public CPointsMap
 		m_color_B[index] = point_data[5];
 	}
 
+	/** See CPointsMap::loadFromBinaryFile() */
+	void loadFromBinaryFile(const CPointsMapBinaryFile& f) override;
+
 	/** See CPointsMap::loadFromRangeScan() */
 	void loadFromRangeScan(
 		const mrpt::obs::CObservation2DRangeScan& rangeScan,
@@ -105,6 +108,9 @@ class CColouredPointsMap : public CPointsMap
 	 * finish the copying of class-specific data  */
 	void addFrom_classSpecific(
 		const CPointsMap& anotherMap, const size_t nPreviousPoints) override;
+	// See base class docs
+	void getBinaryFileChannels(
+		CPointsMapBinaryFile::TChannels& ch) const override;
 
 	// Friend methods:
 	template <class Derived>
@@ -545,6 +545,14 @@ class COccupancyGridMap2D : public CMetricMap,
 		/** Enabled: Rays widen with distance to approximate the real behavior
 		 * of lasers, disabled: insert rays as simple lines (Default=false) */
 		bool wideningBeamsWithDistance;
+		/** Only when wideningBeamsWithDistance=false. Enabled: the free space
+		 * of a 2D scan is inserted by filling, row by row, the polygon
+		 * formed by the sensor and the scan end points, so each cell gets
+		 * at most one "free" update per scan. Much faster for dense scans
+		 * than tracing each ray, which updates cells close to the sensor
+		 * many times. Disabled: insert rays as simple lines
+		 * (Default=false) */
+		bool rasterizeFreeSpace;
 	};
 
 	/** With this struct options are provided to the observation insertion
@@ -377,6 +377,20 @@ class COctoMapBase : public mrpt::maps::CMetricMap
 		const mrpt::poses::CPose3D* robotPose, octomap_point3d& sensorPt,
 		octomap_pointcloud& scan) const;
 
+	/** Inserts a point cloud (in global coordinates) whose rays start at
+	 * sensorPt, in batch: rays are traced only once for each distinct end
+	 * voxel (in parallel for large clouds), and the log-odds of each
+	 * distinct voxel are updated only once, with "occupied" taking
+	 * precedence over "free".
+	 * Takes into account insertionOptions.maxrange and
+	 * insertionOptions.pruning.
+	 * \param[in] sensorPt Is in fact an "octomap::point3d".
+	 * \param[in] scan Is in fact an "octomap::Pointcloud".
+	 */
+	template <class octomap_point3d, class octomap_pointcloud>
+	void internal_insertPointCloudBatch(
+		const octomap_point3d& sensorPt, const octomap_pointcloud& scan);
+
 	struct Impl;
 
 	mrpt::pimpl<Impl> m_impl;
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <mrpt/system/datetime.h>
+#include <functional>
 #include <vector>
 #include <memory>
 
@@ -62,6 +63,22 @@ class CPointCloudFilterBase
 		const mrpt::poses::CPose3D& pc_reference_pose,
 		/** [in,out] additional in/out parameters */
 		TExtraFilterParams* params = nullptr) = 0;
+
+   protected:
+	/** Number of threads worth using for processing `N` points, given the
+	 * user-requested `num_threads` (0: one per CPU core). */
+	static size_t suggestedThreadCount(size_t N, unsigned int num_threads);
+	/** Calls `f(i0, i1)` for `nThreads` contiguous ranges [i0,i1) covering
+	 * [0,N), each one in its own thread. */
+	static void parallel_for_ranges(
+		size_t N, size_t nThreads,
+		const std::function<void(size_t, size_t)>& f);
+	/** Removes the points marked in `deletion_mask` unless
+	 * `params->do_not_delete`, and copies the mask to
+	 * `params->out_deletion_mask` if given. */
+	static void applyDeletionMask(
+		mrpt::maps::CPointsMap* pc, const std::vector<bool>& deletion_mask,
+		TExtraFilterParams* params);
 };
 }
 }  // End of namespace
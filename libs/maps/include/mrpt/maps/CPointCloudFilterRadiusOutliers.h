@@ -0,0 +1,55 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+#pragma once
+
+#include <mrpt/maps/CPointCloudFilterBase.h>
+#include <mrpt/config/CLoadableOptions.h>
+
+namespace mrpt::maps
+{
+/** Radius outlier removal: deletes points with less than `min_neighbors`
+ * other points within a distance `radius`. Neighbors are searched in
+ * parallel, using the point cloud KD-tree.
+ *
+ * \sa CPointCloudFilterStatisticalOutliers,
+ * CPointsMap::TInsertionOptions::filters
+ * \ingroup mrpt_maps_grp
+ */
+class CPointCloudFilterRadiusOutliers
+	: public mrpt::maps::CPointCloudFilterBase
+{
+   public:
+	// See base docs
+	void filter(
+		mrpt::maps::CPointsMap* inout_pointcloud,
+		const mrpt::system::TTimeStamp pc_timestamp,
+		const mrpt::poses::CPose3D& pc_reference_pose,
+		TExtraFilterParams* params = nullptr) override;
+
+	struct TOptions : public mrpt::config::CLoadableOptions
+	{
+		/** (Default: 0.2 m) Search radius */
+		double radius;
+		/** (Default: 2) Min. number of neighbors to keep a point */
+		unsigned int min_neighbors;
+		/** (Default: 0) Number of threads (0: one per CPU core) */
+		unsigned int num_threads;
+
+		TOptions();
+		void loadFromConfigFile(
+			const mrpt::config::CConfigFileBase& source,
+			const std::string& section) override;  // See base docs
+		void saveToConfigFile(
+			mrpt::config::CConfigFileBase& c,
+			const std::string& section) const override;
+	};
+
+	TOptions options;
+};
+}  // namespace mrpt::maps
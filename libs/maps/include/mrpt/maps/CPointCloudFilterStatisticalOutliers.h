@@ -0,0 +1,58 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+#pragma once
+
+#include <mrpt/maps/CPointCloudFilterBase.h>
+#include <mrpt/config/CLoadableOptions.h>
+
+namespace mrpt::maps
+{
+/** Statistical outlier removal: computes the mean distance of each point to
+ * its `mean_k` nearest neighbors, and deletes points whose mean distance is
+ * above \f$ \mu + m \sigma \f$, with \f$ \mu \f$ and \f$ \sigma \f$ the mean
+ * and standard deviation of those distances over the whole cloud and \f$ m
+ * \f$ = `std_dev_mul`. Neighbors are searched in parallel, using the point
+ * cloud KD-tree.
+ *
+ * \sa CPointCloudFilterRadiusOutliers,
+ * CPointsMap::TInsertionOptions::filters
+ * \ingroup mrpt_maps_grp
+ */
+class CPointCloudFilterStatisticalOutliers
+	: public mrpt::maps::CPointCloudFilterBase
+{
+   public:
+	// See base docs
+	void filter(
+		mrpt::maps::CPointsMap* inout_pointcloud,
+		const mrpt::system::TTimeStamp pc_timestamp,
+		const mrpt::poses::CPose3D& pc_reference_pose,
+		TExtraFilterParams* params = nullptr) override;
+
+	struct TOptions : public mrpt::config::CLoadableOptions
+	{
+		/** (Default: 8) Number of neighbors of each point to average */
+		unsigned int mean_k;
+		/** (Default: 1.0) Threshold, in standard deviations */
+		double std_dev_mul;
+		/** (Default: 0) Number of threads (0: one per CPU core) */
+		unsigned int num_threads;
+
+		TOptions();
+		void loadFromConfigFile(
+			const mrpt::config::CConfigFileBase& source,
+			const std::string& section) override;  // See base docs
+		void saveToConfigFile(
+			mrpt::config::CConfigFileBase& c,
+			const std::string& section) const override;
+	};
+
+	TOptions options;
+};
+}  // namespace mrpt::maps
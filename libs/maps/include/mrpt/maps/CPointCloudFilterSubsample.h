@@ -0,0 +1,53 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+#pragma once
+
+#include <mrpt/maps/CPointCloudFilterBase.h>
+#include <mrpt/config/CLoadableOptions.h>
+
+namespace mrpt::maps
+{
+/** Keeps a fraction `ratio` of the points, either evenly spaced in the point
+ * sequence or randomly chosen. The order of the remaining points is kept.
+ *
+ * \sa CPointCloudFilterVoxelGrid, CPointsMap::TInsertionOptions::filters
+ * \ingroup mrpt_maps_grp
+ */
+class CPointCloudFilterSubsample : public mrpt::maps::CPointCloudFilterBase
+{
+   public:
+	// See base docs
+	void filter(
+		mrpt::maps::CPointsMap* inout_pointcloud,
+		const mrpt::system::TTimeStamp pc_timestamp,
+		const mrpt::poses::CPose3D& pc_reference_pose,
+		TExtraFilterParams* params = nullptr) override;
+
+	struct TOptions : public mrpt::config::CLoadableOptions
+	{
+		/** (Default: 0.1) Fraction [0,1] of points to keep */
+		double ratio;
+		/** (Default: false) Pick points randomly instead of evenly */
+		bool random;
+		/** (Default: 0) Seed for `random` subsampling, so the output is
+		 * repeatable */
+		unsigned int random_seed;
+
+		TOptions();
+		void loadFromConfigFile(
+			const mrpt::config::CConfigFileBase& source,
+			const std::string& section) override;  // See base docs
+		void saveToConfigFile(
+			mrpt::config::CConfigFileBase& c,
+			const std::string& section) const override;
+	};
+
+	TOptions options;
+};
+}  // namespace mrpt::maps
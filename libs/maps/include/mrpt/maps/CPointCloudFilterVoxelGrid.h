@@ -0,0 +1,60 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+#pragma once
+
+#include <mrpt/maps/CPointCloudFilterBase.h>
+#include <mrpt/config/CLoadableOptions.h>
+
+namespace mrpt::maps
+{
+/** Voxel-grid downsampling: all points falling into the same cubic voxel are
+ * replaced by a single point at their centroid. The remaining point keeps the
+ * other fields (colour, weight,...) of the first point of its voxel.
+ * Points with NaN or infinite coordinates are removed.
+ *
+ * Voxels are distributed among threads by their hash, so each thread
+ * accumulates its own voxels with no locking.
+ *
+ * If `params->do_not_delete` is set, the point cloud is left untouched and
+ * only the deletion mask is reported.
+ *
+ * \sa CPointsMap::TInsertionOptions::filters
+ * \ingroup mrpt_maps_grp
+ */
+class CPointCloudFilterVoxelGrid : public mrpt::maps::CPointCloudFilterBase
+{
+   public:
+	// See base docs
+	void filter(
+		mrpt::maps::CPointsMap* inout_pointcloud,
+		const mrpt::system::TTimeStamp pc_timestamp,
+		const mrpt::poses::CPose3D& pc_reference_pose,
+		TExtraFilterParams* params = nullptr) override;
+
+	struct TOptions : public mrpt::config::CLoadableOptions
+	{
+		/** (Default: 0.1 m) Voxel side length */
+		double voxel_size;
+		/** (Default: 1) Voxels with less points than this are removed */
+		unsigned int min_points_per_voxel;
+		/** (Default: 0) Number of threads (0: one per CPU core) */
+		unsigned int num_threads;
+
+		TOptions();
+		void loadFromConfigFile(
+			const mrpt::config::CConfigFileBase& source,
+			const std::string& section) override;  // See base docs
+		void saveToConfigFile(
+			mrpt::config::CConfigFileBase& c,
+			const std::string& section) const override;
+	};
+
+	TOptions options;
+};
+}  // namespace mrpt::maps
@@ -9,6 +9,8 @@
 #pragma once
 
 #include <mrpt/maps/CMetricMap.h>
+#include <mrpt/maps/CPointsMapBinaryFile.h>
+#include <mrpt/maps/CPointCloudFilterBase.h>
 #include <mrpt/serialization/CSerializable.h>
 #include <mrpt/config/CLoadableOptions.h>
 #include <mrpt/core/safe_pointers.h>
@@ -180,6 +182,10 @@ class CPointsMap : public CMetricMap,
 	 * finish the copying of class-specific data  */
 	virtual void addFrom_classSpecific(
 		const CPointsMap& anotherMap, const size_t nPreviousPoints) = 0;
+	/** Fills in the channels to be saved by saveBinaryFile(). Derived classes
+	 * with extra channels must call the base implementation. */
+	virtual void getBinaryFileChannels(
+		CPointsMapBinaryFile::TChannels& ch) const;
 
    public:
 	/** @} */
@@ -244,6 +250,16 @@ class CPointsMap : public CMetricMap,
 		float maxDistForInterpolatePoints;
 		/** Points with x,y,z coordinates set to zero will also be inserted */
 		bool insertInvalidPoints;
+		/** Filters applied, in this order, to the points of each inserted
+		 * observation (2D/3D range scans and Velodyne scans) before adding
+		 * them to the map. Filters get the new points only, already in the
+		 * map frame, along with the observation timestamp and the robot
+		 * pose. Empty by default.
+		 * Filters are shared by copies of these options, and are neither
+		 * serialized nor loaded from config files.
+		 * \sa CPointCloudFilterVoxelGrid, CPointCloudFilterRadiusOutliers,
+		 * CPointCloudFilterStatisticalOutliers, CPointCloudFilterSubsample */
+		std::vector<mrpt::maps::CPointCloudFilterBase::Ptr> filters;
 
 		/** Binary dump to stream - for usage in derived classes' serialization
 		 */
@@ -367,9 +383,41 @@ class CPointsMap : public CMetricMap,
 	}
 
 	/** 2D or 3D generic implementation of \a load2D_from_text_file and
-	 * load3D_from_text_file */
+	 * load3D_from_text_file. Uses load_from_text_file_parallel() with default
+	 * options. */
 	bool load2Dor3D_from_text_file(const std::string& file, const bool is_3D);
 
+	/** Options for load_from_text_file_parallel() */
+	struct TTextFileLoadOptions
+	{
+		TTextFileLoadOptions()
+			: is_3D(true), num_threads(0), block_size(4 * 1024 * 1024),
+			  voxel_size(0)
+		{
+		}
+		/** Whether lines have "X Y Z" (true) or "X Y" (false) coordinates */
+		bool is_3D;
+		/** Number of parsing threads (0: one per CPU core) */
+		unsigned int num_threads;
+		/** Size of the blocks of the file parsed by each thread, in bytes */
+		size_t block_size;
+		/** If >0, only the first point of each cubic voxel of this size
+		 * (meters) is loaded, and points with NaN or infinite coordinates
+		 * are discarded */
+		float voxel_size;
+	};
+
+	/** Loads a text file with one point per line, like
+	 * load3D_from_text_file(), but memory-mapping the file and parsing blocks
+	 * of lines in parallel, with an optional voxel decimation of the points.
+	 * Lines which don't start with the coordinates (e.g. comments) are
+	 * skipped, and extra columns are ignored. The map is cleared first.
+	 * \return false if the file cannot be read.
+	 */
+	bool load_from_text_file_parallel(
+		const std::string& file,
+		const TTextFileLoadOptions& options = TTextFileLoadOptions());
+
 	/**  Save to a text file. Each line will contain "X Y" point coordinates.
 	 *		Returns false if any error occured, true elsewere.
 	 */
@@ -400,6 +448,26 @@ class CPointsMap : public CMetricMap,
 	 * PCL) \return false on any error */
 	virtual bool loadPCDFile(const std::string& filename);
 
+	/** Save the point cloud in MRPT's binary format (see
+	 * mrpt::maps::CPointsMapBinaryFile), with the colour and weight channels
+	 * of classes which store them. Loading it is much faster than loading
+	 * text files.
+	 * \param spatial_sort If true, points are saved spatially sorted (hence,
+	 * in a different order), so the file has a useful spatial index.
+	 * \return false on any error \sa loadBinaryFile */
+	bool saveBinaryFile(
+		const std::string& filename, bool spatial_sort = true) const;
+
+	/** Load a file saved with saveBinaryFile(), by memory-mapping it.
+	 * Channels not stored in this class are ignored, and channels missing in
+	 * the file get default values.
+	 * \return false on any error \sa saveBinaryFile, loadFromBinaryFile */
+	bool loadBinaryFile(const std::string& filename);
+
+	/** Replaces the contents of this map with the points of an open binary
+	 * point cloud file. \sa loadBinaryFile */
+	virtual void loadFromBinaryFile(const CPointsMapBinaryFile& f);
+
 	/** @} */  // End of: File input/output methods
 	// --------------------------------------------------
 
@@ -0,0 +1,127 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+#pragma once
+
+#include <mrpt/io/CMemoryMappedFile.h>
+#include <mrpt/math/lightweight_geom_data.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mrpt::maps
+{
+/** Read-only view of a point cloud file in MRPT's native binary format, as
+ * written by CPointsMap::saveBinaryFile().
+ *
+ * The file is a fixed header followed by one contiguous array per channel
+ * (X, Y, Z and, optionally, R, G, B as floats in [0,1] and weights as
+ * uint32_t), each aligned to 64 bytes, and a table of chunks. Chunks are runs
+ * of consecutive points with their bounding box: points are usually stored
+ * sorted along a space-filling curve, so this table works as a precomputed
+ * spatial index (see getPointsInBox()). Data is stored in the native
+ * (little-endian) byte order.
+ *
+ * Opening a file just memory-maps it: the arrays are accessed directly from
+ * the OS page cache, so even multi-GB maps are opened instantly, with no
+ * copy, and shared among processes. Use CPointsMap::loadBinaryFile() to load
+ * the points into a map instead.
+ *
+ * \sa CPointsMap::saveBinaryFile(), CPointsMap::loadBinaryFile()
+ * \ingroup mrpt_maps_grp
+ */
+class CPointsMapBinaryFile
+{
+   public:
+	/** One entry of the spatial index: points [first, first+count) */
+	struct TChunk
+	{
+		uint64_t first{0};
+		uint32_t count{0};
+		uint32_t reserved{0};
+		float bb_min[3]{0, 0, 0}, bb_max[3]{0, 0, 0};
+	};
+
+	/** Input data for save(). Optional channels are nullptr if missing */
+	struct TChannels
+	{
+		size_t count{0};
+		const float *x{nullptr}, *y{nullptr}, *z{nullptr};
+		const float *R{nullptr}, *G{nullptr}, *B{nullptr};
+		const uint32_t* weight{nullptr};
+	};
+
+	/** Writes a point cloud file.
+	 * \param spatial_sort If true, points are reordered along a Z-order
+	 * (Morton) curve, so chunks are spatially compact.
+	 * \param chunk_size Max number of points of each chunk.
+	 * \return false on any error.
+	 */
+	static bool save(
+		const std::string& filename, const TChannels& data,
+		bool spatial_sort = true, size_t chunk_size = 4096);
+
+	/** Default constructor */
+	CPointsMapBinaryFile() = default;
+	/** Constructor which opens a file
+	 * \exception std::exception On error opening it, or if it is not a valid
+	 * point cloud file.
+	 */
+	CPointsMapBinaryFile(const std::string& filename);
+
+	/** Maps a file, closing any previous one.
+	 * \return false on error opening it, or if it is not a valid point cloud
+	 * file. */
+	bool open(const std::string& filename);
+	/** Unmaps the file. All returned pointers become invalid. */
+	void close();
+	bool is_open() const { return m_file.is_open(); }
+
+	/** Number of points */
+	size_t size() const { return m_count; }
+	bool hasColor() const { return m_R != nullptr; }
+	bool hasWeights() const { return m_weight != nullptr; }
+
+	/** @name Direct access to the mapped arrays, valid while open.
+		@{ */
+	const float* getPointsBuffer_x() const { return m_x; }
+	const float* getPointsBuffer_y() const { return m_y; }
+	const float* getPointsBuffer_z() const { return m_z; }
+	/** nullptr if the file has no colour channel */
+	const float* getPointsBuffer_R() const { return m_R; }
+	const float* getPointsBuffer_G() const { return m_G; }
+	const float* getPointsBuffer_B() const { return m_B; }
+	/** nullptr if the file has no weight channel */
+	const uint32_t* getPointsBuffer_weight() const { return m_weight; }
+	/** The chunks of the spatial index (see getChunkCount()) */
+	const TChunk* getChunks() const { return m_chunks; }
+	size_t getChunkCount() const { return m_chunk_count; }
+	/** @} */
+
+	/** Bounding box of all points (all zeros for empty clouds) */
+	void boundingBox(
+		mrpt::math::TPoint3Df& bb_min, mrpt::math::TPoint3Df& bb_max) const;
+
+	/** Gets the indices of all points inside the given box (limits
+	 * included), only looking into chunks which intersect it. */
+	void getPointsInBox(
+		const mrpt::math::TPoint3Df& bb_min,
+		const mrpt::math::TPoint3Df& bb_max,
+		std::vector<size_t>& out_indices) const;
+
+   private:
+	mrpt::io::CMemoryMappedFile m_file;
+	size_t m_count{0}, m_chunk_count{0};
+	const float *m_x{nullptr}, *m_y{nullptr}, *m_z{nullptr};
+	const float *m_R{nullptr}, *m_G{nullptr}, *m_B{nullptr};
+	const uint32_t* m_weight{nullptr};
+	const TChunk* m_chunks{nullptr};
+	mrpt::math::TPoint3Df m_bb_min{0, 0, 0}, m_bb_max{0, 0, 0};
+};
+
+}  // namespace mrpt::maps
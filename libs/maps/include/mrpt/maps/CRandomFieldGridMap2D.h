@@ -308,6 +308,11 @@ class CRandomFieldGridMap2D
 		/** (Default:false) Skip the computation of the variance, just compute
 		 * the mean */
 		bool GMRF_skip_variance;
+		/** (Default:false) Solve the GMRF with a sparse Cholesky
+		 * factorization whose symbolic analysis is kept between updates, much
+		 * faster for online mapping than the default SparseQR. \sa
+		 * mrpt::graphs::ScalarFactorGraph::solverSparseCholesky */
+		bool GMRF_use_sparse_cholesky{false};
 		/** @} */
 	};
 
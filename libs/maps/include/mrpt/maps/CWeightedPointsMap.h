@@ -86,6 +86,9 @@ class CWeightedPointsMap : public CPointsMap
 		pointWeight[index] = point_data[3];
 	}
 
+	/** See CPointsMap::loadFromBinaryFile() */
+	void loadFromBinaryFile(const CPointsMapBinaryFile& f) override;
+
 	/** See CPointsMap::loadFromRangeScan() */
 	void loadFromRangeScan(
 		const mrpt::obs::CObservation2DRangeScan& rangeScan,
@@ -101,6 +104,9 @@ class CWeightedPointsMap : public CPointsMap
 	 * finish the copying of class-specific data  */
 	void addFrom_classSpecific(
 		const CPointsMap& anotherMap, const size_t nPreviousPoints) override;
+	// See base class docs
+	void getBinaryFileChannels(
+		CPointsMapBinaryFile::TChannels& ch) const override;
 
 	// Friend methods:
 	template <class Derived>
@@ -27,6 +27,7 @@
 #include <mrpt/opengl/CSetOfObjects.h>
 #include <mrpt/opengl/CGridPlaneXY.h>
 #include <mrpt/opengl/stock_objects.h>
+#include <unordered_map>
 
 using namespace mrpt;
 using namespace mrpt::maps;
@@ -348,6 +349,185 @@ double CBeaconMap::internal_computeObservationLikelihood(
 	MRPT_END
 }
 
+/*---------------------------------------------------------------
+					computeObservationLikelihoods
+  ---------------------------------------------------------------*/
+void CBeaconMap::internal_computeObservationLikelihoods(
+	const CObservation* obs, const std::vector<CPose3D>& takenFrom,
+	double* out_log_liks)
+{
+	MRPT_START
+
+	if (CLASS_ID(CObservationBeaconRanges) != obs->GetRuntimeClass())
+	{
+		CMetricMap::internal_computeObservationLikelihoods(
+			obs, takenFrom, out_log_liks);
+		return;
+	}
+
+	// Same likelihood model than internal_computeObservationLikelihood(),
+	// but each beacon PDF is packed into contiguous arrays only once per
+	// measurement, and all the poses are evaluated in tight loops over those
+	// arrays, which the compiler can vectorize.
+	const auto* o = static_cast<const CObservationBeaconRanges*>(obs);
+	const size_t nPoses = takenFrom.size();
+	std::fill(out_log_liks, out_log_liks + nPoses, 0.0);
+
+	// Beacons by ID (the first one, as in getBeaconByID()):
+	std::unordered_map<CBeacon::TBeaconID, const CBeacon*> beaconsByID;
+	for (const auto& b : m_beacons) beaconsByID.emplace(b.m_ID, &b);
+
+	const double varR = square(likelihoodOptions.rangeStd);
+	// Sensor positions, for all the poses:
+	std::vector<double> sx(nPoses), sy(nPoses), sz(nPoses);
+	// Packed PDF modes (particles or Gaussians) of one beacon:
+	std::vector<double> mx, my, mz, mlogw, logLiks;
+	std::vector<double> c00, c11, c22, c01, c02, c12;
+
+	for (const auto& m : o->sensedData)
+	{
+		const auto itB = beaconsByID.find(m.beaconID);
+		if (itB == beaconsByID.end() || !(m.sensedDistance > 0))
+		{
+			// If not found, a uniform distribution:
+			if (o->maxSensorDistance != o->minSensorDistance)
+			{
+				const double l =
+					log(1.0 / (o->maxSensorDistance - o->minSensorDistance));
+				for (size_t i = 0; i < nPoses; i++) out_log_liks[i] += l;
+			}
+			continue;
+		}
+		const CBeacon& beac = *itB->second;
+		const double sensedRange = m.sensedDistance;
+
+		for (size_t i = 0; i < nPoses; i++)
+			takenFrom[i].composePoint(
+				m.sensorLocationOnRobot.x(), m.sensorLocationOnRobot.y(),
+				m.sensorLocationOnRobot.z(), sx[i], sy[i], sz[i]);
+
+		// Pack the modes of the beacon PDF:
+		size_t nModes = 0;
+		switch (beac.m_typePDF)
+		{
+			case CBeacon::pdfMonteCarlo:
+				nModes = beac.m_locationMC.m_particles.size();
+				break;
+			case CBeacon::pdfGauss:
+				nModes = 1;
+				break;
+			case CBeacon::pdfSOG:
+				nModes = beac.m_locationSOG.size();
+				break;
+			default:
+				THROW_EXCEPTION("Invalid beac->m_typePDF!!!");
+		};
+		if (!nModes) continue;
+		for (auto* v : {&mx, &my, &mz, &mlogw, &logLiks, &c00, &c11, &c22,
+						&c01, &c02, &c12})
+			v->resize(nModes);
+
+		if (beac.m_typePDF == CBeacon::pdfMonteCarlo)
+		{
+			size_t k = 0;
+			for (const auto& p : beac.m_locationMC.m_particles)
+			{
+				mx[k] = p.d->x;
+				my[k] = p.d->y;
+				mz[k] = p.d->z;
+				mlogw[k++] = p.log_w;
+			}
+		}
+		else
+		{
+			auto packGaussian = [&](const CPointPDFGaussian& g, size_t k) {
+				mx[k] = g.mean.x();
+				my[k] = g.mean.y();
+				mz[k] = g.mean.z();
+				c00[k] = g.cov(0, 0);
+				c11[k] = g.cov(1, 1);
+				c22[k] = g.cov(2, 2);
+				c01[k] = g.cov(0, 1);
+				c02[k] = g.cov(0, 2);
+				c12[k] = g.cov(1, 2);
+			};
+			if (beac.m_typePDF == CBeacon::pdfGauss)
+			{
+				packGaussian(beac.m_locationGauss, 0);
+				mlogw[0] = 0;
+			}
+			else
+			{
+				size_t k = 0;
+				for (const auto& g : beac.m_locationSOG)
+				{
+					mlogw[k] = g.log_w;
+					packGaussian(g.val, k++);
+				}
+			}
+		}
+
+		// H = [Ax Ay Az]/range, varZ = H*C*H' + varR
+		auto gaussLogLik = [&](size_t k, double px, double py, double pz) {
+			const double Ax = mx[k] - px, Ay = my[k] - py, Az = mz[k] - pz;
+			const double r2 = Ax * Ax + Ay * Ay + Az * Az;
+			const double varZ =
+				(Ax * Ax * c00[k] + Ay * Ay * c11[k] + Az * Az * c22[k] +
+				 2 * (Ax * Ay * c01[k] + Ax * Az * c02[k] + Ay * Az * c12[k])) /
+					r2 +
+				varR;
+			return -0.5 * square(sensedRange - std::sqrt(r2)) / varZ;
+		};
+
+		if (beac.m_typePDF == CBeacon::pdfGauss)
+		{
+			for (size_t i = 0; i < nPoses; i++)
+				out_log_liks[i] += gaussLogLik(0, sx[i], sy[i], sz[i]);
+			continue;
+		}
+
+		// Part of math::averageLogLikelihood() which does not depend on the
+		// pose:
+		const double lw_max = *std::max_element(mlogw.begin(), mlogw.end());
+		double SUM1 = 0;
+		for (size_t k = 0; k < nModes; k++)
+			SUM1 += std::exp(mlogw[k] - lw_max);
+		const double K = -0.5 / varR;
+
+		for (size_t i = 0; i < nPoses; i++)
+		{
+			const double px = sx[i], py = sy[i], pz = sz[i];
+			if (beac.m_typePDF == CBeacon::pdfMonteCarlo)
+			{
+				for (size_t k = 0; k < nModes; k++)
+				{
+					const double expectedRange = std::sqrt(
+						square(mx[k] - px) + square(my[k] - py) +
+						square(mz[k] - pz));
+					logLiks[k] = K * square(sensedRange - expectedRange);
+				}
+			}
+			else
+			{
+				for (size_t k = 0; k < nModes; k++)
+					logLiks[k] = gaussLogLik(k, px, py, pz);
+			}
+
+			const double ll_max =
+				*std::max_element(logLiks.begin(), logLiks.end());
+			double SUM2 = 0;
+			for (size_t k = 0; k < nModes; k++)
+				SUM2 += std::exp(mlogw[k] - lw_max + logLiks[k] - ll_max);
+			out_log_liks[i] += -std::log(SUM1) + std::log(SUM2) + ll_max;
+		}
+	}  // for each sensed beacon "m"
+
+	for (size_t i = 0; i < nPoses; i++)
+		MRPT_CHECK_NORMAL_NUMBER(out_log_liks[i]);
+
+	MRPT_END
+}
+
 /*---------------------------------------------------------------
 						insertObservation
   ---------------------------------------------------------------*/
@@ -0,0 +1,112 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include <mrpt/maps/CBeaconMap.h>
+#include <mrpt/obs/CObservationBeaconRanges.h>
+#include <mrpt/random.h>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace mrpt;
+using namespace mrpt::maps;
+using namespace mrpt::math;
+using namespace mrpt::obs;
+using namespace mrpt::poses;
+using namespace std;
+
+// Beacons with all kinds of PDFs:
+static void buildMap(CBeaconMap& map)
+{
+	auto& rng = mrpt::random::getRandomGenerator();
+	map.clear();
+	for (int id = 0; id < 12; id++)
+	{
+		CBeacon b;
+		b.m_ID = id;
+		const TPoint3D pt(
+			rng.drawUniform(-10, 10), rng.drawUniform(-10, 10),
+			rng.drawUniform(0, 3));
+		CPointPDFGaussian g;
+		g.mean = CPoint3D(pt);
+		g.cov.setZero();
+		g.cov(0, 0) = 0.3;
+		g.cov(1, 1) = 0.2;
+		g.cov(2, 2) = 0.1;
+		g.cov(0, 1) = g.cov(1, 0) = 0.05;
+
+		switch (id % 3)
+		{
+			case 0:
+				b.m_typePDF = CBeacon::pdfGauss;
+				b.m_locationGauss = g;
+				break;
+			case 1:
+				b.m_typePDF = CBeacon::pdfMonteCarlo;
+				b.m_locationMC.setSize(100);
+				for (auto& p : b.m_locationMC.m_particles)
+				{
+					p.d->x = pt.x + rng.drawGaussian1D(0, 0.5);
+					p.d->y = pt.y + rng.drawGaussian1D(0, 0.5);
+					p.d->z = pt.z + rng.drawGaussian1D(0, 0.5);
+					p.log_w = rng.drawUniform(-2, 0);
+				}
+				break;
+			case 2:
+				b.m_typePDF = CBeacon::pdfSOG;
+				for (int k = 0; k < 5; k++)
+				{
+					CPointPDFSOG::TGaussianMode m;
+					m.val = g;
+					m.val.mean.x_incr(rng.drawGaussian1D(0, 1));
+					m.val.mean.y_incr(rng.drawGaussian1D(0, 1));
+					m.log_w = rng.drawUniform(-3, 0);
+					b.m_locationSOG.push_back(m);
+				}
+				break;
+		};
+		map.push_back(b);
+	}
+}
+
+TEST(CBeaconMap, computeObservationLikelihoods)
+{
+	auto& rng = mrpt::random::getRandomGenerator();
+	rng.randomize(1234);
+
+	CBeaconMap map;
+	buildMap(map);
+
+	CObservationBeaconRanges obs;
+	obs.minSensorDistance = 0;
+	obs.maxSensorDistance = 30;
+	for (int id : {0, 1, 2, 4, 5, 42 /* Not in the map */, 9, 10, 11})
+	{
+		CObservationBeaconRanges::TMeasurement m;
+		m.beaconID = id;
+		m.sensedDistance = rng.drawUniform(1, 15);
+		m.sensorLocationOnRobot = CPoint3D(0.1, -0.2, 0.5);
+		obs.sensedData.push_back(m);
+	}
+	obs.sensedData.back().sensedDistance = std::nan("");
+
+	std::vector<CPose3D> poses;
+	for (size_t i = 0; i < 50; i++)
+		poses.emplace_back(
+			rng.drawUniform(-5, 5), rng.drawUniform(-5, 5), 0,
+			rng.drawUniform(-M_PI, M_PI), 0, 0);
+
+	std::vector<double> logLiks;
+	map.computeObservationLikelihoods(&obs, poses, logLiks);
+	ASSERT_EQ(logLiks.size(), poses.size());
+	for (size_t i = 0; i < poses.size(); i++)
+	{
+		const double l = map.computeObservationLikelihood(&obs, poses[i]);
+		EXPECT_NEAR(logLiks[i], l, 1e-4 * std::abs(l) + 1e-6);
+	}
+}
@@ -23,6 +23,7 @@
 
 #include <mrpt/system/filesystem.h>
 #include <sstream>
+#include <unordered_map>
 #include <mrpt/io/CFileOutputStream.h>
 
 #include "COctoMapBase_impl.h"
@@ -196,9 +197,7 @@ bool CColouredOctoMap::internal_insertObservation(
 		}
 
 		// Insert rays:
-		m_impl->m_octomap.insertPointCloud(
-				scan, sensorPt, insertionOptions.maxrange,
-				insertionOptions.pruning);
+		internal_insertPointCloudBatch(sensorPt, scan);
 		return true;
 	}
 	else if (IS_CLASS(obs, CObservation3DRangeScan))
@@ -241,39 +240,67 @@ bool CColouredOctoMap::internal_insertObservation(
 		}
 
 		// Insert rays:
-		octomap::KeySet free_cells, occupied_cells;
-		m_impl->m_octomap
-			.computeUpdate(
-				scan, sensorPt, free_cells, occupied_cells,
-				insertionOptions.maxrange);
-
-		// insert data into tree  -----------------------
-		for (const auto & free_cell : free_cells)
-		{
-			m_impl->m_octomap.updateNode(free_cell, false, false);
-		}
-		for (const auto & occupied_cell : occupied_cells)
+		internal_insertPointCloudBatch(sensorPt, scan);
+
+		// Update color: dense clouds have many points per voxel, so
+		// accumulate them and update each voxel only once, with the last
+		// colour (SET) or the mean colour (AVERAGE, INTEGRATE):
+		struct TVoxelColour
 		{
-			m_impl->m_octomap.updateNode(occupied_cell, true, false);
-		}
+			float r{0}, g{0}, b{0};
+			size_t count{0};
+			uint8_t last_r{0}, last_g{0}, last_b{0};
+		};
+		std::unordered_map<
+			octomap::OcTreeKey, TVoxelColour, octomap::OcTreeKey::KeyHash>
+			voxel_colours;
+		voxel_colours.reserve(scan.size());
 
-		// Update color -----------------------
 		const float colF2B = 255.0f;
+		octomap::OcTreeKey key;
 		for (size_t i = 0; i < sizeRangeScan; i++)
 		{
 			const mrpt::opengl::CPointCloudColoured::TPointColour& pt =
 				pts->getPoint(i);
-
-			// Add to this map:
-			if (pt.x != 0 || pt.y != 0 || pt.z != 0)
-				this->updateVoxelColour(
-					pt.x, pt.y, pt.z, uint8_t(pt.R * colF2B),
-					uint8_t(pt.G * colF2B), uint8_t(pt.B * colF2B));
+			if (pt.x == 0 && pt.y == 0 && pt.z == 0) continue;
+			if (!m_impl->m_octomap.coordToKeyChecked(
+					octomap::point3d(pt.x, pt.y, pt.z), key))
+				continue;
+
+			TVoxelColour& vc = voxel_colours[key];
+			vc.last_r = uint8_t(pt.R * colF2B);
+			vc.last_g = uint8_t(pt.G * colF2B);
+			vc.last_b = uint8_t(pt.B * colF2B);
+			vc.r += vc.last_r;
+			vc.g += vc.last_g;
+			vc.b += vc.last_b;
+			vc.count++;
 		}
 
-		// TODO: does pruning make sense if we used "lazy_eval"?
-		if (insertionOptions.pruning)
-			m_impl->m_octomap.prune();
+		auto& tree = m_impl->m_octomap;
+		for (const auto& kv : voxel_colours)
+		{
+			const TVoxelColour& vc = kv.second;
+			const float inv_n = 1.0f / vc.count;
+			const uint8_t r = uint8_t(vc.r * inv_n), g = uint8_t(vc.g * inv_n),
+						  b = uint8_t(vc.b * inv_n);
+			switch (m_colour_method)
+			{
+				case INTEGRATE:
+					tree.integrateNodeColor(kv.first, r, g, b);
+					break;
+				case SET:
+					tree.setNodeColor(
+						kv.first, vc.last_r, vc.last_g, vc.last_b);
+					break;
+				case AVERAGE:
+					tree.averageNodeColor(kv.first, r, g, b);
+					break;
+				default:
+					THROW_EXCEPTION(
+						"Invalid value found for 'm_colour_method'");
+			}
+		}
 
 		return true;
 	}
@@ -682,6 +682,25 @@ void CColouredPointsMap::addFrom_classSpecific(
 	}
 }
 
+void CColouredPointsMap::getBinaryFileChannels(
+	CPointsMapBinaryFile::TChannels& ch) const
+{
+	CPointsMap::getBinaryFileChannels(ch);
+	ch.R = m_color_R.data();
+	ch.G = m_color_G.data();
+	ch.B = m_color_B.data();
+}
+
+void CColouredPointsMap::loadFromBinaryFile(const CPointsMapBinaryFile& f)
+{
+	CPointsMap::loadFromBinaryFile(f);
+	if (!f.hasColor()) return;
+	const size_t N = f.size();
+	m_color_R.assign(f.getPointsBuffer_R(), f.getPointsBuffer_R() + N);
+	m_color_G.assign(f.getPointsBuffer_G(), f.getPointsBuffer_G() + N);
+	m_color_B.assign(f.getPointsBuffer_B(), f.getPointsBuffer_B() + N);
+}
+
 /** Save the point cloud as a PCL PCD file, in either ASCII or binary format
  * \return false on any error */
 bool CColouredPointsMap::savePCDFile(
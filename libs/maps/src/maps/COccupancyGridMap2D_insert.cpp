@@ -255,74 +255,240 @@ bool COccupancyGridMap2D::internal_insertObservation(
 					x2idx(px);  // Remember: This must be after the resizeGrid!!
 				int cy0 = y2idx(py);
 
-				// Insert rays:
-				for (idx = 0; idx < nRanges; idx += K)
+				if (insertionOptions.rasterizeFreeSpace)
 				{
-					if (!o->validRange[idx] && !invalidAsFree) continue;
+					// Method: Rasterize the free space polygon of the scan:
+					// -------------------------------------
+					// The free space is the fan of triangles (sensor, end
+					// point #j, end point #j+1). Its outline is filled row by
+					// row (scanline fill), sampling cells at their centers
+					// within half-open intervals, so each cell gets at most
+					// one "free" update per scan.
+					const size_t nPts = (nRanges + K - 1) / K;
+					const float inv_res = 1.0f / resolution;
+					const float su = (px - x_min) * inv_res,
+								sv = (py - y_min) * inv_res;
+
+					// Fan triangles: #j stands for (sensor, #j, #j+1). Close
+					// the fan for 360deg scans:
+					const bool closed =
+						nPts > 2 && std::abs(o->aperture) >= 2 * M_PI - 1e-3;
+					const size_t nTris =
+						closed ? nPts : (nPts > 0 ? nPts - 1 : 0);
+
+					// Kind of free space of each triangle: 0=valid rays,
+					// 1=invalid (no echo) rays, -1=not free at all.
+					std::vector<int8_t> tri_kind(nTris);
+					for (size_t t = 0; t < nTris; t++)
+					{
+						const size_t t2 = (t + 1) % nPts;
+						const bool v1 = o->validRange[t * K] != 0;
+						const bool v2 = o->validRange[t2 * K] != 0;
+						tri_kind[t] = (v1 && v2) ? 0 : (invalidAsFree ? 1 : -1);
+					}
 
-					// Starting position: Laser position
-					cx = cx0;
-					cy = cy0;
+					// An edge of the outline, in continuous cell coordinates,
+					// sorted so va<vb. This way, all the cells in an edge
+					// shared by two polygons go to only one of them:
+					struct TEdge
+					{
+						float ua, va, dudv;
+						int row0, row1;  // Rows whose centers are in [va,vb)
+					};
+					auto makeEdge = [&](float ua, float va, float ub, float vb,
+										std::vector<TEdge>& edges) {
+						if (va == vb) return;  // Horizontal: ignore
+						if (vb < va)
+						{
+							std::swap(ua, ub);
+							std::swap(va, vb);
+						}
+						TEdge e;
+						e.ua = ua;
+						e.va = va;
+						e.dudv = (ub - ua) / (vb - va);
+						e.row0 = std::max(0, (int)std::ceil(va - 0.5f));
+						e.row1 = std::min<int>(
+							size_y - 1, (int)std::ceil(vb - 0.5f) - 1);
+						if (e.row1 >= e.row0) edges.push_back(e);
+					};
+					auto pt_u = [&](const size_t j) {
+						return (scanPoints_x[j % nPts] - x_min) * inv_res;
+					};
+					auto pt_v = [&](const size_t j) {
+						return (scanPoints_y[j % nPts] - y_min) * inv_res;
+					};
+
+					std::vector<TEdge> edges;
+					std::vector<float> crossings;
+					for (int8_t kind = 0; kind <= 1; kind++)
+					{
+						// The outline of all triangles of this kind: their
+						// outer edges, plus radial edges where the kind
+						// changes:
+						edges.clear();
+						for (size_t j = 0; j < nPts; j++)
+						{
+							const bool prev_in =
+								(j > 0 || closed) &&
+								tri_kind[j > 0 ? j - 1 : nTris - 1] == kind;
+							const bool next_in =
+								j < nTris && tri_kind[j] == kind;
+							if (next_in)
+								makeEdge(
+									pt_u(j), pt_v(j), pt_u(j + 1), pt_v(j + 1),
+									edges);
+							if (prev_in != next_in)
+								makeEdge(su, sv, pt_u(j), pt_v(j), edges);
+						}
+						if (edges.empty()) continue;
+
+						const cellType logodd_free =
+							kind == 0 ? logodd_observation_free
+									  : logodd_noecho_free;
+
+						// Scanline fill, with an active edge table:
+						std::sort(
+							edges.begin(), edges.end(),
+							[](const TEdge& a, const TEdge& b) {
+								return a.row0 < b.row0;
+							});
+						std::vector<const TEdge*> active;
+						size_t next_edge = 0;
+						for (int r = edges[0].row0;
+							 r < static_cast<int>(size_y) &&
+							 (next_edge < edges.size() || !active.empty());
+							 r++)
+						{
+							while (next_edge < edges.size() &&
+								   edges[next_edge].row0 == r)
+								active.push_back(&edges[next_edge++]);
 
-					// Target, in cell indexes:
-					int trg_cx = x2idx(scanPoints_x[idx]);
-					int trg_cy = y2idx(scanPoints_y[idx]);
+							const float vc = r + 0.5f;
+							crossings.clear();
+							for (size_t a = 0; a < active.size();)
+							{
+								const TEdge& e = *active[a];
+								crossings.push_back(
+									e.ua + (vc - e.va) * e.dudv);
+								if (e.row1 == r)
+								{
+									active[a] = active.back();
+									active.pop_back();
+								}
+								else
+									a++;
+							}
+							std::sort(crossings.begin(), crossings.end());
 
-					// The x> comparison implicitly holds if x<0
-					ASSERT_(
-						static_cast<unsigned int>(trg_cx) < size_x &&
-						static_cast<unsigned int>(trg_cy) < size_y);
+							// Cells whose centers are in each [u_in,u_out):
+							cellType* row = theMapArray + r * theMapSize_x;
+							for (size_t c = 0; c + 1 < crossings.size(); c += 2)
+							{
+								const int c0 = std::max(
+									0, (int)std::ceil(crossings[c] - 0.5f));
+								const int c1 = std::min<int>(
+									size_x,
+									(int)std::ceil(crossings[c + 1] - 0.5f));
+								for (int cx_ = c0; cx_ < c1; cx_++)
+									updateCell_fast_free(
+										row + cx_, logodd_free,
+										logodd_thres_free);
+							}
+						}
+					}
 
-					// Use "fractional integers" to approximate float operations
-					//  during the ray tracing:
-					int Acx = trg_cx - cx;
-					int Acy = trg_cy - cy;
+					// And the occupied cells at the end of valid, not
+					// truncated, rays:
+					for (size_t j = 0; j < nPts; j++)
+					{
+						idx = j * K;
+						if (!o->validRange[idx] ||
+							o->scan[idx] >= maxDistanceInsertion)
+							continue;
+						const int trg_cx = x2idx(scanPoints_x[j]);
+						const int trg_cy = y2idx(scanPoints_y[j]);
+						if (static_cast<unsigned int>(trg_cx) < size_x &&
+							static_cast<unsigned int>(trg_cy) < size_y)
+							updateCell_fast_occupied(
+								trg_cx, trg_cy, logodd_observation_occupied,
+								logodd_thres_occupied, theMapArray,
+								theMapSize_x);
+					}
+				}
+				else
+				{
+					// Insert rays:
+					for (idx = 0; idx < nRanges; idx += K)
+					{
+						if (!o->validRange[idx] && !invalidAsFree) continue;
 
-					int Acx_ = abs(Acx);
-					int Acy_ = abs(Acy);
+						// Starting position: Laser position
+						cx = cx0;
+						cy = cy0;
 
-					int nStepsRay = max(Acx_, Acy_);
-					if (!nStepsRay) continue;  // May be...
+						// Target, in cell indexes:
+						int trg_cx = x2idx(scanPoints_x[idx]);
+						int trg_cy = y2idx(scanPoints_y[idx]);
 
-					// Integers store "float values * 128"
-					float N_1 = 1.0f / nStepsRay;  // Avoid division twice.
+						// The x> comparison implicitly holds if x<0
+						ASSERT_(
+							static_cast<unsigned int>(trg_cx) < size_x &&
+							static_cast<unsigned int>(trg_cy) < size_y);
 
-					// Increments at each raytracing step:
-					int frAcx =
-						(Acx < 0 ? -1 : +1) * round((Acx_ << FRBITS) * N_1);
-					int frAcy =
-						(Acy < 0 ? -1 : +1) * round((Acy_ << FRBITS) * N_1);
-
-					int frCX = cx << FRBITS;
-					int frCY = cy << FRBITS;
-					const auto logodd_free = o->validRange[idx]
-												 ? logodd_observation_free
-												 : logodd_noecho_free;
-
-					for (int nStep = 0; nStep < nStepsRay; nStep++)
-					{
-						updateCell_fast_free(
-							cx, cy, logodd_free, logodd_thres_free, theMapArray,
-							theMapSize_x);
+						// Use "fractional integers" to approximate float
+						// operations during the ray tracing:
+						int Acx = trg_cx - cx;
+						int Acy = trg_cy - cy;
 
-						frCX += frAcx;
-						frCY += frAcy;
+						int Acx_ = abs(Acx);
+						int Acy_ = abs(Acy);
 
-						cx = frCX >> FRBITS;
-						cy = frCY >> FRBITS;
-					}
+						int nStepsRay = max(Acx_, Acy_);
+						if (!nStepsRay) continue;  // May be...
 
-					// And finally, the occupied cell at the end:
-					// Only if:
-					//  - It was a valid ray, and
-					//  - The ray was not truncated
-					if (o->validRange[idx] &&
-						o->scan[idx] < maxDistanceInsertion)
-						updateCell_fast_occupied(
-							trg_cx, trg_cy, logodd_observation_occupied,
-							logodd_thres_occupied, theMapArray, theMapSize_x);
+						// Integers store "float values * 128"
+						float N_1 = 1.0f / nStepsRay;  // Avoid division twice.
 
-				}  // End of each range
+						// Increments at each raytracing step:
+						int frAcx =
+							(Acx < 0 ? -1 : +1) * round((Acx_ << FRBITS) * N_1);
+						int frAcy =
+							(Acy < 0 ? -1 : +1) * round((Acy_ << FRBITS) * N_1);
+
+						int frCX = cx << FRBITS;
+						int frCY = cy << FRBITS;
+						const auto logodd_free = o->validRange[idx]
+													 ? logodd_observation_free
+													 : logodd_noecho_free;
+
+						for (int nStep = 0; nStep < nStepsRay; nStep++)
+						{
+							updateCell_fast_free(
+								cx, cy, logodd_free, logodd_thres_free,
+								theMapArray, theMapSize_x);
+
+							frCX += frAcx;
+							frCY += frAcy;
+
+							cx = frCX >> FRBITS;
+							cy = frCY >> FRBITS;
+						}
+
+						// And finally, the occupied cell at the end:
+						// Only if:
+						//  - It was a valid ray, and
+						//  - The ray was not truncated
+						if (o->validRange[idx] &&
+							o->scan[idx] < maxDistanceInsertion)
+							updateCell_fast_occupied(
+								trg_cx, trg_cy, logodd_observation_occupied,
+								logodd_thres_occupied, theMapArray,
+								theMapSize_x);
+
+					}  // End of each range
+
+				}
 
 				mrpt_alloca_free(scanPoints_x);
 				mrpt_alloca_free(scanPoints_y);
@@ -1327,7 +1493,8 @@ COccupancyGridMap2D::TInsertionOptions::TInsertionOptions()
 	  CFD_features_gaussian_size(1),
 	  CFD_features_median_size(3),
 
-	  wideningBeamsWithDistance(false)
+	  wideningBeamsWithDistance(false),
+	  rasterizeFreeSpace(false)
 {
 }
 
@@ -1351,6 +1518,7 @@ void COccupancyGridMap2D::TInsertionOptions::loadFromConfigFile(
 	MRPT_LOAD_CONFIG_VAR(CFD_features_gaussian_size, float, iniFile, section);
 	MRPT_LOAD_CONFIG_VAR(CFD_features_median_size, float, iniFile, section);
 	MRPT_LOAD_CONFIG_VAR(wideningBeamsWithDistance, bool, iniFile, section);
+	MRPT_LOAD_CONFIG_VAR(rasterizeFreeSpace, bool, iniFile, section);
 }
 
 /*---------------------------------------------------------------
@@ -1375,6 +1543,7 @@ void COccupancyGridMap2D::TInsertionOptions::dumpToTextStream(
 	LOADABLEOPTS_DUMP_VAR(CFD_features_gaussian_size, float)
 	LOADABLEOPTS_DUMP_VAR(CFD_features_median_size, float)
 	LOADABLEOPTS_DUMP_VAR(wideningBeamsWithDistance, bool)
+	LOADABLEOPTS_DUMP_VAR(rasterizeFreeSpace, bool)
 
 	out << mrpt::format("\n");
 }
@@ -42,7 +42,7 @@ bool COccupancyGridMap2D::saveAsBitmapFile(const std::string& file) const
 	MRPT_END
 }
 
-uint8_t COccupancyGridMap2D::serializeGetVersion() const { return 6; }
+uint8_t COccupancyGridMap2D::serializeGetVersion() const { return 7; }
 void COccupancyGridMap2D::serializeTo(mrpt::serialization::CArchive& out) const
 {
 // Version 3: Change to log-odds. The only change is in the loader, when
@@ -97,6 +97,9 @@ void COccupancyGridMap2D::serializeTo(mrpt::serialization::CArchive& out) const
 
 	// Version: 5;
 	out << insertionOptions.wideningBeamsWithDistance;
+
+	// Version: 7;
+	out << insertionOptions.rasterizeFreeSpace;
 }
 
 void COccupancyGridMap2D::serializeFrom(
@@ -113,6 +116,7 @@ void COccupancyGridMap2D::serializeFrom(
 		case 4:
 		case 5:
 		case 6:
+		case 7:
 		{
 #ifdef OCCUPANCY_GRIDMAP_CELL_SIZE_8BITS
 			const uint8_t MyBitsPerCell = 8;
@@ -252,6 +256,11 @@ void COccupancyGridMap2D::serializeFrom(
 			{
 				in >> insertionOptions.wideningBeamsWithDistance;
 			}
+
+			if (version >= 7)
+				in >> insertionOptions.rasterizeFreeSpace;
+			else
+				insertionOptions.rasterizeFreeSpace = false;
 		}
 		break;
 		default:
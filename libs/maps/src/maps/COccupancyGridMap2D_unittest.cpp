@@ -104,3 +104,58 @@ TEST(COccupancyGridMap2DTests, insert2DScan)
 		// should have a high "freeness"
 	}
 }
+
+TEST(COccupancyGridMap2DTests, insert2DScanRasterizedFreeSpace)
+{
+	// A dense 270deg scan inside a 8x6m rectangular room, with a few
+	// invalid ranges:
+	CObservation2DRangeScan scan;
+	const size_t N = 1081;
+	scan.aperture = DEG2RAD(270.0f);
+	scan.rightToLeft = true;
+	scan.resizeScan(N);
+	for (size_t i = 0; i < N; i++)
+	{
+		const double a = -0.5 * scan.aperture + i * scan.aperture / (N - 1);
+		const double c = std::cos(a), s = std::sin(a);
+		double r = 1e6;
+		if (c > 0) r = std::min(r, 4.0 / c);
+		if (c < 0) r = std::min(r, -4.0 / c);
+		if (s > 0) r = std::min(r, 3.0 / s);
+		if (s < 0) r = std::min(r, -3.0 / s);
+		scan.setScanRange(i, r);
+		scan.setScanRangeValidity(i, i < 500 || i > 520);
+	}
+
+	COccupancyGridMap2D grid_rays(-10.0f, 10.0f, -10.0f, 10.0f, 0.05f);
+	COccupancyGridMap2D grid_poly(-10.0f, 10.0f, -10.0f, 10.0f, 0.05f);
+	grid_poly.insertionOptions.rasterizeFreeSpace = true;
+	grid_rays.insertObservation(&scan);
+	grid_poly.insertObservation(&scan);
+
+	ASSERT_EQ(grid_rays.getSizeX(), grid_poly.getSizeX());
+	ASSERT_EQ(grid_rays.getSizeY(), grid_poly.getSizeY());
+
+	// Free space in front of the sensor, and walls:
+	EXPECT_GT(grid_poly.getPos(2.0, 1.0), 0.51f);
+	EXPECT_GT(grid_poly.getPos(-1.0, 2.5), 0.51f);
+	EXPECT_LT(grid_poly.getPos(4.01, 1.0), 0.49f);
+	// Behind the sensor (out of the field of view) remains unknown:
+	EXPECT_NEAR(grid_poly.getPos(-2.0, 0.0), 0.5f, 0.01f);
+
+	// Both methods must agree in the classification of (almost) all cells
+	// observed by both:
+	size_t nBoth = 0, nAgree = 0;
+	for (unsigned cy = 0; cy < grid_rays.getSizeY(); cy++)
+		for (unsigned cx = 0; cx < grid_rays.getSizeX(); cx++)
+		{
+			const float p1 = grid_rays.getCell(cx, cy),
+						p2 = grid_poly.getCell(cx, cy);
+			if (std::abs(p1 - 0.5f) < 0.01f || std::abs(p2 - 0.5f) < 0.01f)
+				continue;
+			nBoth++;
+			if ((p1 > 0.5f) == (p2 > 0.5f)) nAgree++;
+		}
+	EXPECT_GT(nBoth, 10000U);
+	EXPECT_GT(nAgree, 0.98 * nBoth);
+}
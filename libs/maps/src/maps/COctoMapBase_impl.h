@@ -13,6 +13,9 @@
 #include <mrpt/obs/CObservation3DRangeScan.h>
 #include <mrpt/maps/CPointsMap.h>
 #include <mrpt/serialization/CArchive.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
 
 namespace mrpt::maps
 {
@@ -237,14 +240,86 @@ void COctoMapBase<OCTREE, OCTREE_NODE>::insertPointCloud(
 	size_t N;
 	const float *xs, *ys, *zs;
 	ptMap.getPointsBuffer(N, xs, ys, zs);
-	for (size_t i = 0; i < N; i++)
-		m_impl->m_octomap
-			.insertRay(
-				sensorPt, octomap::point3d(xs[i], ys[i], zs[i]),
-				insertionOptions.maxrange, insertionOptions.pruning);
+	octomap::Pointcloud scan;
+	scan.reserve(N);
+	for (size_t i = 0; i < N; i++) scan.push_back(xs[i], ys[i], zs[i]);
+	internal_insertPointCloudBatch(sensorPt, scan);
 	MRPT_END
 }
 
+template <class OCTREE, class OCTREE_NODE>
+template <class octomap_point3d, class octomap_pointcloud>
+void COctoMapBase<OCTREE, OCTREE_NODE>::internal_insertPointCloudBatch(
+	const octomap_point3d& sensorPt, const octomap_pointcloud& scan)
+{
+	auto& tree = m_impl->m_octomap;
+	const double maxrange = insertionOptions.maxrange;
+	const size_t N = scan.size();
+
+	// 1) Discretize end points: dense clouds hit the same voxel many times,
+	// so cast only one ray per distinct end voxel (to its center).
+	// Points beyond maxrange only clear free space up to that distance.
+	octomap::KeySet occupied_cells, ray_end_cells;
+	std::vector<octomap::point3d> ray_ends;
+	ray_ends.reserve(N);
+	for (size_t i = 0; i < N; i++)
+	{
+		const octomap::point3d& pt = scan[i];
+		octomap::point3d end = pt;
+		bool is_hit = true;
+		if (maxrange > 0 && (pt - sensorPt).norm() > maxrange)
+		{
+			end = sensorPt + (pt - sensorPt).normalized() * maxrange;
+			is_hit = false;
+		}
+		octomap::OcTreeKey key;
+		if (!tree.coordToKeyChecked(end, key)) continue;
+		if (is_hit) occupied_cells.insert(key);
+		if (ray_end_cells.insert(key).second)
+			ray_ends.push_back(tree.keyToCoord(key));
+	}
+
+	// 2) Ray traversal, in parallel for large clouds. Each thread collects
+	// the free cells of a contiguous chunk of rays in its own set:
+	const size_t nRays = ray_ends.size();
+	const size_t MIN_RAYS_PER_THREAD = 4096;
+	const size_t nThreads = std::max<size_t>(
+		1, std::min<size_t>(
+			   std::thread::hardware_concurrency(),
+			   nRays / MIN_RAYS_PER_THREAD));
+
+	std::vector<octomap::KeySet> free_cells(nThreads);
+	auto traceRays = [&](const size_t t) {
+		octomap::KeyRay keyray;
+		const size_t i0 = t * nRays / nThreads, i1 = (t + 1) * nRays / nThreads;
+		for (size_t i = i0; i < i1; i++)
+			if (tree.computeRayKeys(sensorPt, ray_ends[i], keyray))
+				free_cells[t].insert(keyray.begin(), keyray.end());
+	};
+	if (nThreads == 1)
+		traceRays(0);
+	else
+	{
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < nThreads; t++)
+			threads.emplace_back(traceRays, t);
+		for (auto& th : threads) th.join();
+		for (size_t t = 1; t < nThreads; t++)
+			free_cells[0].insert(free_cells[t].begin(), free_cells[t].end());
+	}
+
+	// 3) One log-odds update per distinct voxel ("occupied" wins), with
+	// lazy evaluation of inner nodes which are updated only once at the end:
+	for (const auto& key : free_cells[0])
+		if (occupied_cells.find(key) == occupied_cells.end())
+			tree.updateNode(key, false, true /*lazy*/);
+	for (const auto& key : occupied_cells)
+		tree.updateNode(key, true, true /*lazy*/);
+	tree.updateInnerOccupancy();
+
+	if (insertionOptions.pruning) tree.prune();
+}
+
 template <class OCTREE, class OCTREE_NODE>
 bool COctoMapBase<OCTREE, OCTREE_NODE>::castRay(
 	const mrpt::math::TPoint3D& origin, const mrpt::math::TPoint3D& direction,
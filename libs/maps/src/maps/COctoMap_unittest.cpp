@@ -8,6 +8,7 @@
    +------------------------------------------------------------------------+ */
 
 #include <mrpt/maps/COctoMap.h>
+#include <mrpt/maps/CSimplePointsMap.h>
 #include <mrpt/obs/CObservation2DRangeScan.h>
 #include <gtest/gtest.h>
 
@@ -130,3 +131,29 @@ TEST(COctoMapTests, insert2DScan)
 		map.insertObservation(&scan1);
 	}
 }
+
+TEST(COctoMapTests, insertDensePointCloud)
+{
+	// A dense wall at x=2, with many points per voxel:
+	CSimplePointsMap pts;
+	for (float y = -1.0f; y <= 1.0f; y += 0.01f)
+		for (float z = -0.5f; z <= 0.5f; z += 0.01f) pts.insertPoint(2, y, z);
+
+	COctoMap map(0.1);
+	map.insertPointCloud(pts, 0, 0, 0);
+
+	double occup;
+	EXPECT_TRUE(map.getPointOccupancy(2, 0.5f, 0.2f, occup));
+	EXPECT_GT(occup, 0.5);
+	EXPECT_TRUE(map.getPointOccupancy(1, 0.2f, 0.1f, occup));
+	EXPECT_LT(occup, 0.5);
+	EXPECT_FALSE(map.getPointOccupancy(3, 0, 0, occup));
+
+	// With a max. range, points beyond it only clear free space:
+	COctoMap map2(0.1);
+	map2.insertionOptions.maxrange = 1.5;
+	map2.insertPointCloud(pts, 0, 0, 0);
+	EXPECT_TRUE(map2.getPointOccupancy(1, 0.2f, 0.1f, occup));
+	EXPECT_LT(occup, 0.5);
+	EXPECT_FALSE(map2.getPointOccupancy(2, 0.5f, 0.2f, occup));
+}
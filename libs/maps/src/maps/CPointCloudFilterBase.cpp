@@ -10,6 +10,10 @@
 #include "maps-precomp.h"  // Precomp header
 
 #include <mrpt/maps/CPointCloudFilterBase.h>
+#include <mrpt/maps/CPointsMap.h>
+
+#include <algorithm>
+#include <thread>
 
 using namespace mrpt::maps;
 
@@ -19,3 +23,38 @@ mrpt::maps::CPointCloudFilterBase::TExtraFilterParams::TExtraFilterParams()
 	: out_deletion_mask(nullptr), do_not_delete(false)
 {
 }
+
+size_t CPointCloudFilterBase::suggestedThreadCount(
+	size_t N, unsigned int num_threads)
+{
+	// Not worth a thread for less points than this:
+	const size_t MIN_POINTS_PER_THREAD = 1024;
+	return std::max<size_t>(
+		1, std::min<size_t>(
+			   num_threads ? num_threads : std::thread::hardware_concurrency(),
+			   N / MIN_POINTS_PER_THREAD));
+}
+
+void CPointCloudFilterBase::parallel_for_ranges(
+	size_t N, size_t nThreads, const std::function<void(size_t, size_t)>& f)
+{
+	if (nThreads <= 1)
+	{
+		f(0, N);
+		return;
+	}
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < nThreads; t++)
+		threads.emplace_back(f, t * N / nThreads, (t + 1) * N / nThreads);
+	for (auto& th : threads) th.join();
+}
+
+void CPointCloudFilterBase::applyDeletionMask(
+	mrpt::maps::CPointsMap* pc, const std::vector<bool>& deletion_mask,
+	TExtraFilterParams* params)
+{
+	if (params == nullptr || !params->do_not_delete)
+		pc->applyDeletionMask(deletion_mask);
+	if (params != nullptr && params->out_deletion_mask != nullptr)
+		*params->out_deletion_mask = deletion_mask;
+}
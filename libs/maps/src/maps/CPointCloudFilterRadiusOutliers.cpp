@@ -0,0 +1,81 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include "maps-precomp.h"  // Precomp header
+
+#include <mrpt/maps/CPointCloudFilterRadiusOutliers.h>
+#include <mrpt/maps/CPointsMap.h>
+#include <mrpt/config/CConfigFileBase.h>
+
+using namespace mrpt::maps;
+
+void CPointCloudFilterRadiusOutliers::filter(
+	mrpt::maps::CPointsMap* pc, const mrpt::system::TTimeStamp pc_timestamp,
+	const mrpt::poses::CPose3D& pc_reference_pose, TExtraFilterParams* params)
+{
+	MRPT_UNUSED_PARAM(pc_timestamp);
+	MRPT_UNUSED_PARAM(pc_reference_pose);
+
+	MRPT_START
+	ASSERT_(pc != nullptr);
+
+	const size_t N = pc->size();
+	const float radius_sqr = static_cast<float>(mrpt::square(options.radius));
+	std::vector<uint8_t> deleted(N, 0);
+
+	if (N > 0)
+	{
+		// Build the KD-tree before going parallel:
+		std::vector<std::pair<size_t, float>> dummy;
+		pc->kdTreeRadiusSearch3D(0, 0, 0, 0, dummy);
+
+		parallel_for_ranges(
+			N, suggestedThreadCount(N, options.num_threads),
+			[&](size_t i0, size_t i1) {
+				std::vector<std::pair<size_t, float>> neighbors;
+				for (size_t i = i0; i < i1; i++)
+				{
+					float x, y, z;
+					pc->getPointFast(i, x, y, z);
+					// The point itself is found, too:
+					const size_t n = pc->kdTreeRadiusSearch3D(
+						x, y, z, radius_sqr, neighbors);
+					if (n < options.min_neighbors + 1) deleted[i] = 1;
+				}
+			});
+	}
+
+	applyDeletionMask(
+		pc, std::vector<bool>(deleted.begin(), deleted.end()), params);
+
+	MRPT_END
+}
+
+CPointCloudFilterRadiusOutliers::TOptions::TOptions()
+	: radius(0.2), min_neighbors(2), num_threads(0)
+{
+}
+
+void CPointCloudFilterRadiusOutliers::TOptions::loadFromConfigFile(
+	const mrpt::config::CConfigFileBase& c, const std::string& s)
+{
+	MRPT_LOAD_CONFIG_VAR(radius, double, c, s);
+	MRPT_LOAD_CONFIG_VAR(min_neighbors, int, c, s);
+	MRPT_LOAD_CONFIG_VAR(num_threads, int, c, s);
+}
+
+void CPointCloudFilterRadiusOutliers::TOptions::saveToConfigFile(
+	mrpt::config::CConfigFileBase& c, const std::string& s) const
+{
+	MRPT_SAVE_CONFIG_VAR_COMMENT(radius, "Search radius [m]");
+	MRPT_SAVE_CONFIG_VAR_COMMENT(
+		min_neighbors, "Min. number of neighbors to keep a point");
+	MRPT_SAVE_CONFIG_VAR_COMMENT(
+		num_threads, "Number of threads (0: one per CPU core)");
+}
@@ -0,0 +1,103 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include "maps-precomp.h"  // Precomp header
+
+#include <mrpt/maps/CPointCloudFilterStatisticalOutliers.h>
+#include <mrpt/maps/CPointsMap.h>
+#include <mrpt/config/CConfigFileBase.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace mrpt::maps;
+
+void CPointCloudFilterStatisticalOutliers::filter(
+	mrpt::maps::CPointsMap* pc, const mrpt::system::TTimeStamp pc_timestamp,
+	const mrpt::poses::CPose3D& pc_reference_pose, TExtraFilterParams* params)
+{
+	MRPT_UNUSED_PARAM(pc_timestamp);
+	MRPT_UNUSED_PARAM(pc_reference_pose);
+
+	MRPT_START
+	ASSERT_(pc != nullptr);
+	ASSERT_(options.mean_k >= 1);
+
+	const size_t N = pc->size();
+	std::vector<bool> deletion_mask(N, false);
+
+	if (N > 1)
+	{
+		// The point itself is returned as its first neighbor:
+		const size_t knn = std::min<size_t>(options.mean_k + 1, N);
+
+		// Build the KD-tree before going parallel:
+		{
+			std::vector<size_t> idx;
+			std::vector<float> dist_sqr;
+			pc->kdTreeNClosestPoint3DIdx(0, 0, 0, 1, idx, dist_sqr);
+		}
+
+		std::vector<double> mean_dist(N);
+		parallel_for_ranges(
+			N, suggestedThreadCount(N, options.num_threads),
+			[&](size_t i0, size_t i1) {
+				std::vector<size_t> idx;
+				std::vector<float> dist_sqr;
+				for (size_t i = i0; i < i1; i++)
+				{
+					float x, y, z;
+					pc->getPointFast(i, x, y, z);
+					pc->kdTreeNClosestPoint3DIdx(x, y, z, knn, idx, dist_sqr);
+					double sum = 0;
+					for (size_t k = 1; k < knn; k++)
+						sum += std::sqrt(dist_sqr[k]);
+					mean_dist[i] = sum / (knn - 1);
+				}
+			});
+
+		double mean = 0, var = 0;
+		for (const double d : mean_dist) mean += d;
+		mean /= N;
+		for (const double d : mean_dist) var += mrpt::square(d - mean);
+		var /= N - 1;
+
+		const double max_dist = mean + options.std_dev_mul * std::sqrt(var);
+		for (size_t i = 0; i < N; i++)
+			deletion_mask[i] = mean_dist[i] > max_dist;
+	}
+
+	applyDeletionMask(pc, deletion_mask, params);
+
+	MRPT_END
+}
+
+CPointCloudFilterStatisticalOutliers::TOptions::TOptions()
+	: mean_k(8), std_dev_mul(1.0), num_threads(0)
+{
+}
+
+void CPointCloudFilterStatisticalOutliers::TOptions::loadFromConfigFile(
+	const mrpt::config::CConfigFileBase& c, const std::string& s)
+{
+	MRPT_LOAD_CONFIG_VAR(mean_k, int, c, s);
+	MRPT_LOAD_CONFIG_VAR(std_dev_mul, double, c, s);
+	MRPT_LOAD_CONFIG_VAR(num_threads, int, c, s);
+}
+
+void CPointCloudFilterStatisticalOutliers::TOptions::saveToConfigFile(
+	mrpt::config::CConfigFileBase& c, const std::string& s) const
+{
+	MRPT_SAVE_CONFIG_VAR_COMMENT(
+		mean_k, "Number of neighbors of each point to average");
+	MRPT_SAVE_CONFIG_VAR_COMMENT(
+		std_dev_mul, "Threshold, in standard deviations");
+	MRPT_SAVE_CONFIG_VAR_COMMENT(
+		num_threads, "Number of threads (0: one per CPU core)");
+}
@@ -0,0 +1,82 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include "maps-precomp.h"  // Precomp header
+
+#include <mrpt/maps/CPointCloudFilterSubsample.h>
+#include <mrpt/maps/CPointsMap.h>
+#include <mrpt/config/CConfigFileBase.h>
+#include <mrpt/random/RandomGenerators.h>
+
+#include <cmath>
+#include <numeric>
+
+using namespace mrpt::maps;
+
+void CPointCloudFilterSubsample::filter(
+	mrpt::maps::CPointsMap* pc, const mrpt::system::TTimeStamp pc_timestamp,
+	const mrpt::poses::CPose3D& pc_reference_pose, TExtraFilterParams* params)
+{
+	MRPT_UNUSED_PARAM(pc_timestamp);
+	MRPT_UNUSED_PARAM(pc_reference_pose);
+
+	MRPT_START
+	ASSERT_(pc != nullptr);
+	ASSERT_(options.ratio >= 0 && options.ratio <= 1);
+
+	const size_t N = pc->size();
+	const double r = options.ratio;
+	std::vector<bool> deletion_mask(N, true);
+
+	if (!options.random)
+	{
+		// Keep a point each time the accumulated ratio reaches an integer:
+		for (size_t i = 0; i < N; i++)
+			deletion_mask[i] = std::floor((i + 1) * r) == std::floor(i * r);
+	}
+	else
+	{
+		// Partial Fisher-Yates shuffle to pick exactly k points:
+		const size_t k = std::min<size_t>(N, std::lround(N * r));
+		std::vector<size_t> idx(N);
+		std::iota(idx.begin(), idx.end(), 0);
+		mrpt::random::CRandomGenerator rng(options.random_seed);
+		for (size_t j = 0; j < k; j++)
+		{
+			std::swap(idx[j], idx[j + rng.drawUniform32bit() % (N - j)]);
+			deletion_mask[idx[j]] = false;
+		}
+	}
+
+	applyDeletionMask(pc, deletion_mask, params);
+
+	MRPT_END
+}
+
+CPointCloudFilterSubsample::TOptions::TOptions()
+	: ratio(0.1), random(false), random_seed(0)
+{
+}
+
+void CPointCloudFilterSubsample::TOptions::loadFromConfigFile(
+	const mrpt::config::CConfigFileBase& c, const std::string& s)
+{
+	MRPT_LOAD_CONFIG_VAR(ratio, double, c, s);
+	MRPT_LOAD_CONFIG_VAR(random, bool, c, s);
+	MRPT_LOAD_CONFIG_VAR(random_seed, int, c, s);
+}
+
+void CPointCloudFilterSubsample::TOptions::saveToConfigFile(
+	mrpt::config::CConfigFileBase& c, const std::string& s) const
+{
+	MRPT_SAVE_CONFIG_VAR_COMMENT(ratio, "Fraction [0,1] of points to keep");
+	MRPT_SAVE_CONFIG_VAR_COMMENT(
+		random, "Pick points randomly instead of evenly");
+	MRPT_SAVE_CONFIG_VAR_COMMENT(random_seed, "Seed for random subsampling");
+}
@@ -0,0 +1,152 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include "maps-precomp.h"  // Precomp header
+
+#include <mrpt/maps/CPointCloudFilterVoxelGrid.h>
+#include <mrpt/maps/CPointsMap.h>
+#include <mrpt/config/CConfigFileBase.h>
+#include "CPointsMap_voxel_key.h"
+
+#include <unordered_map>
+
+using namespace mrpt::maps;
+
+namespace
+{
+/** Points accumulated into one voxel, first of them at index `first` */
+struct TVoxel
+{
+	size_t first, count;
+	double sx, sy, sz;
+};
+struct TCentroid
+{
+	size_t index;
+	float x, y, z;
+};
+}  // namespace
+
+void CPointCloudFilterVoxelGrid::filter(
+	mrpt::maps::CPointsMap* pc, const mrpt::system::TTimeStamp pc_timestamp,
+	const mrpt::poses::CPose3D& pc_reference_pose, TExtraFilterParams* params)
+{
+	MRPT_UNUSED_PARAM(pc_timestamp);
+	MRPT_UNUSED_PARAM(pc_reference_pose);
+
+	MRPT_START
+	ASSERT_(pc != nullptr);
+	ASSERT_(options.voxel_size > 0);
+
+	const size_t N = pc->size();
+	const size_t nThreads = suggestedThreadCount(N, options.num_threads);
+	const double inv_size = 1.0 / options.voxel_size;
+
+	// 1) Voxel of each point, in parallel. Use bytes instead of vector<bool>
+	// so threads can write the mask at once. Points with no valid voxel
+	// (NaN, inf) are deleted right away:
+	std::vector<detail::TVoxelKey> keys(N);
+	std::vector<size_t> hashes(N, 0);
+	std::vector<uint8_t> deleted(N, 0);
+	parallel_for_ranges(N, nThreads, [&](size_t i0, size_t i1) {
+		const detail::TVoxelKeyHash hasher;
+		for (size_t i = i0; i < i1; i++)
+		{
+			float x, y, z;
+			pc->getPointFast(i, x, y, z);
+			if (detail::voxelOf(x, y, z, inv_size, keys[i]))
+				hashes[i] = hasher(keys[i]);
+			else
+				deleted[i] = 1;
+		}
+	});
+
+	// 2) Each thread accumulates the voxels whose hash belongs to it:
+	std::vector<std::vector<TCentroid>> centroids(nThreads);
+	parallel_for_ranges(nThreads, nThreads, [&](size_t t0, size_t t1) {
+		for (size_t t = t0; t < t1; t++)
+		{
+			std::unordered_map<
+				detail::TVoxelKey, TVoxel, detail::TVoxelKeyHash>
+				voxels;
+			for (size_t i = 0; i < N; i++)
+			{
+				// (only the owner of point i reads or writes deleted[i])
+				if (hashes[i] % nThreads != t || deleted[i]) continue;
+				float x, y, z;
+				pc->getPointFast(i, x, y, z);
+				auto it = voxels.find(keys[i]);
+				if (it == voxels.end())
+				{
+					voxels.emplace(keys[i], TVoxel{i, 1, x, y, z});
+					continue;
+				}
+				TVoxel& v = it->second;
+				v.count++;
+				v.sx += x;
+				v.sy += y;
+				v.sz += z;
+				deleted[i] = 1;
+			}
+			for (const auto& kv : voxels)
+			{
+				const TVoxel& v = kv.second;
+				if (v.count < options.min_points_per_voxel)
+				{
+					// Too sparse: remove all its points.
+					deleted[v.first] = 1;
+					continue;
+				}
+				if (v.count == 1) continue;
+				centroids[t].push_back(TCentroid{
+					v.first, static_cast<float>(v.sx / v.count),
+					static_cast<float>(v.sy / v.count),
+					static_cast<float>(v.sz / v.count)});
+			}
+		}
+	});
+
+	// Points of sparse voxels other than the first one are already marked,
+	// since they were merged into it.
+	std::vector<bool> deletion_mask(deleted.begin(), deleted.end());
+
+	if (params == nullptr || !params->do_not_delete)
+	{
+		for (const auto& tc : centroids)
+			for (const auto& c : tc) pc->setPointFast(c.index, c.x, c.y, c.z);
+		pc->mark_as_modified();
+	}
+	applyDeletionMask(pc, deletion_mask, params);
+
+	MRPT_END
+}
+
+CPointCloudFilterVoxelGrid::TOptions::TOptions()
+	: voxel_size(0.1), min_points_per_voxel(1), num_threads(0)
+{
+}
+
+void CPointCloudFilterVoxelGrid::TOptions::loadFromConfigFile(
+	const mrpt::config::CConfigFileBase& c, const std::string& s)
+{
+	MRPT_LOAD_CONFIG_VAR(voxel_size, double, c, s);
+	MRPT_LOAD_CONFIG_VAR(min_points_per_voxel, int, c, s);
+	MRPT_LOAD_CONFIG_VAR(num_threads, int, c, s);
+}
+
+void CPointCloudFilterVoxelGrid::TOptions::saveToConfigFile(
+	mrpt::config::CConfigFileBase& c, const std::string& s) const
+{
+	MRPT_SAVE_CONFIG_VAR_COMMENT(voxel_size, "Voxel side length [m]");
+	MRPT_SAVE_CONFIG_VAR_COMMENT(
+		min_points_per_voxel,
+		"Voxels with less points than this are removed");
+	MRPT_SAVE_CONFIG_VAR_COMMENT(
+		num_threads, "Number of threads (0: one per CPU core)");
+}
@@ -0,0 +1,261 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include <mrpt/maps/CPointCloudFilterVoxelGrid.h>
+#include <mrpt/maps/CPointCloudFilterRadiusOutliers.h>
+#include <mrpt/maps/CPointCloudFilterStatisticalOutliers.h>
+#include <mrpt/maps/CPointCloudFilterSubsample.h>
+#include <mrpt/maps/CSimplePointsMap.h>
+#include <mrpt/obs/CObservation2DRangeScan.h>
+#include <mrpt/poses/CPose3D.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <tuple>
+
+using namespace mrpt::maps;
+
+const mrpt::poses::CPose3D nullPose;
+
+// A 100x100 grid of points, 0.05 m apart, plus some isolated points:
+static void load_grid_with_outliers(CSimplePointsMap& pts)
+{
+	pts.clear();
+	for (int i = 0; i < 100; i++)
+		for (int j = 0; j < 100; j++)
+			pts.insertPoint(i * 0.05f + 0.025f, j * 0.05f + 0.025f, 0);
+	pts.insertPoint(20, 0, 0);
+	pts.insertPoint(0, -20, 1);
+	pts.insertPoint(-15, -15, 3);
+}
+
+static std::vector<std::tuple<float, float, float>> sorted_points(
+	const CSimplePointsMap& pts)
+{
+	std::vector<std::tuple<float, float, float>> v;
+	for (size_t i = 0; i < pts.size(); i++)
+	{
+		float x, y, z;
+		pts.getPoint(i, x, y, z);
+		v.emplace_back(x, y, z);
+	}
+	std::sort(v.begin(), v.end());
+	return v;
+}
+
+TEST(CPointCloudFilterVoxelGrid, centroids)
+{
+	CSimplePointsMap pts;
+	pts.insertPoint(0.1f, 0.1f, 0.1f);
+	pts.insertPoint(5.5f, 5.5f, 5.5f);
+	pts.insertPoint(0.3f, 0.5f, 0.7f);
+	pts.insertPoint(-0.5f, 0.2f, 0.2f);
+
+	CPointCloudFilterVoxelGrid f;
+	f.options.voxel_size = 1.0;
+	CSimplePointsMap pts1 = pts;
+	f.filter(&pts1, mrpt::system::now(), nullPose);
+	ASSERT_EQ(pts1.size(), 3U);
+	float x, y, z;
+	pts1.getPoint(0, x, y, z);
+	EXPECT_NEAR(x, 0.2f, 1e-5f);
+	EXPECT_NEAR(y, 0.3f, 1e-5f);
+	EXPECT_NEAR(z, 0.4f, 1e-5f);
+	pts1.getPoint(2, x, y, z);
+	EXPECT_NEAR(x, -0.5f, 1e-5f);
+
+	f.options.min_points_per_voxel = 2;
+	f.filter(&pts, mrpt::system::now(), nullPose);
+	EXPECT_EQ(pts.size(), 1U);
+}
+
+TEST(CPointCloudFilterVoxelGrid, multithreaded)
+{
+	CSimplePointsMap pts1, pts4;
+	load_grid_with_outliers(pts1);
+	load_grid_with_outliers(pts4);
+
+	CPointCloudFilterVoxelGrid f;
+	f.options.voxel_size = 0.1;
+	f.options.num_threads = 1;
+	f.filter(&pts1, mrpt::system::now(), nullPose);
+	f.options.num_threads = 4;
+	f.filter(&pts4, mrpt::system::now(), nullPose);
+
+	// 2x2 grid points per voxel:
+	EXPECT_EQ(pts1.size(), 50U * 50U + 3U);
+	EXPECT_EQ(sorted_points(pts1), sorted_points(pts4));
+}
+
+TEST(CPointCloudFilterVoxelGrid, nonFinitePoints)
+{
+	const float nan = std::numeric_limits<float>::quiet_NaN(),
+				inf = std::numeric_limits<float>::infinity();
+	for (unsigned int num_threads : {1, 4})
+	{
+		CSimplePointsMap pts;
+		pts.insertPoint(nan, 1, 2);
+		pts.insertPoint(1, inf, 2);
+		pts.insertPoint(-0.2f, -0.3f, 0.4f);
+		pts.insertPoint(1, 2, -inf);
+		pts.insertPoint(1e30f, 0, 0);  // too far for an int64 voxel index
+		pts.insertPoint(-0.4f, -0.1f, 0.2f);
+
+		CPointCloudFilterVoxelGrid f;
+		f.options.voxel_size = 1.0;
+		f.options.num_threads = num_threads;
+		f.filter(&pts, mrpt::system::now(), nullPose);
+		ASSERT_EQ(pts.size(), 1U);
+		float x, y, z;
+		pts.getPoint(0, x, y, z);
+		EXPECT_NEAR(x, -0.3f, 1e-5f);
+		EXPECT_NEAR(y, -0.2f, 1e-5f);
+		EXPECT_NEAR(z, 0.3f, 1e-5f);
+	}
+}
+
+TEST(CPointCloudFilterVoxelGrid, doNotDelete)
+{
+	CSimplePointsMap pts, pts_orig;
+	load_grid_with_outliers(pts);
+	pts_orig = pts;
+
+	CPointCloudFilterVoxelGrid f;
+	f.options.voxel_size = 0.1;
+	CPointCloudFilterBase::TExtraFilterParams params;
+	std::vector<bool> deletion_mask;
+	params.out_deletion_mask = &deletion_mask;
+	params.do_not_delete = true;
+	f.filter(&pts, mrpt::system::now(), nullPose, &params);
+
+	EXPECT_EQ(sorted_points(pts), sorted_points(pts_orig));
+	ASSERT_EQ(deletion_mask.size(), pts.size());
+	EXPECT_EQ(
+		std::count(deletion_mask.begin(), deletion_mask.end(), false),
+		50 * 50 + 3);
+}
+
+TEST(CPointCloudFilterRadiusOutliers, removeIsolatedPoints)
+{
+	CSimplePointsMap pts;
+	load_grid_with_outliers(pts);
+
+	CPointCloudFilterRadiusOutliers f;
+	f.options.radius = 0.1;
+	f.options.min_neighbors = 2;
+	f.options.num_threads = 3;
+	f.filter(&pts, mrpt::system::now(), nullPose);
+
+	EXPECT_EQ(pts.size(), 100U * 100U);
+	EXPECT_LT(pts.getLargestDistanceFromOrigin(), 10.0f);
+}
+
+TEST(CPointCloudFilterStatisticalOutliers, removeIsolatedPoints)
+{
+	CSimplePointsMap pts;
+	load_grid_with_outliers(pts);
+
+	CPointCloudFilterStatisticalOutliers f;
+	f.options.mean_k = 8;
+	f.options.std_dev_mul = 1.0;
+	f.options.num_threads = 3;
+	f.filter(&pts, mrpt::system::now(), nullPose);
+
+	EXPECT_EQ(pts.size(), 100U * 100U);
+	EXPECT_LT(pts.getLargestDistanceFromOrigin(), 10.0f);
+}
+
+TEST(CPointCloudFilterSubsample, uniformAndRandom)
+{
+	const size_t N = 1000;
+	CSimplePointsMap pts;
+	for (size_t i = 0; i < N; i++) pts.insertPoint(i, 0, 0);
+
+	CPointCloudFilterSubsample f;
+	f.options.ratio = 0.1;
+	CSimplePointsMap pts_uniform = pts;
+	f.filter(&pts_uniform, mrpt::system::now(), nullPose);
+	ASSERT_EQ(pts_uniform.size(), N / 10);
+	for (size_t i = 0; i < pts_uniform.size(); i++)
+	{
+		float x, y;
+		pts_uniform.getPoint(i, x, y);
+		EXPECT_NEAR(x, 10.0f * i + 9, 1.0f);
+	}
+
+	f.options.random = true;
+	CSimplePointsMap pts_rnd1 = pts, pts_rnd2 = pts;
+	f.filter(&pts_rnd1, mrpt::system::now(), nullPose);
+	f.filter(&pts_rnd2, mrpt::system::now(), nullPose);
+	ASSERT_EQ(pts_rnd1.size(), N / 10);
+	float prev_x = -1;
+	for (size_t i = 0; i < pts_rnd1.size(); i++)
+	{
+		float x1, y1, x2, y2;
+		pts_rnd1.getPoint(i, x1, y1);
+		pts_rnd2.getPoint(i, x2, y2);
+		EXPECT_EQ(x1, x2);
+		// The original order is kept:
+		EXPECT_GT(x1, prev_x);
+		prev_x = x1;
+	}
+}
+
+TEST(CPointCloudFilterVoxelGrid, insertionFilter)
+{
+	// A dense 270deg scan inside a 8x6m rectangular room:
+	mrpt::obs::CObservation2DRangeScan scan;
+	const size_t N = 1081;
+	scan.aperture = mrpt::DEG2RAD(270.0f);
+	scan.rightToLeft = true;
+	scan.timestamp = mrpt::system::now();
+	scan.resizeScan(N);
+	for (size_t i = 0; i < N; i++)
+	{
+		const double a = -0.5 * scan.aperture + i * scan.aperture / (N - 1);
+		const double c = std::cos(a), s = std::sin(a);
+		double r = 1e6;
+		if (c > 0) r = std::min(r, 4.0 / c);
+		if (c < 0) r = std::min(r, -4.0 / c);
+		if (s > 0) r = std::min(r, 3.0 / s);
+		if (s < 0) r = std::min(r, -3.0 / s);
+		scan.setScanRange(i, r);
+		scan.setScanRangeValidity(i, true);
+	}
+
+	auto voxels = std::make_shared<CPointCloudFilterVoxelGrid>();
+	voxels->options.voxel_size = 0.5;
+
+	CSimplePointsMap pts;
+	pts.insertionOptions.filters.push_back(voxels);
+	// A previous point, which must be kept untouched:
+	pts.insertPoint(100, 100, 0);
+	const mrpt::poses::CPose3D robotPose(1, 2, 0, 0, 0, 0);
+	pts.insertObservation(&scan, &robotPose);
+
+	ASSERT_GT(pts.size(), 10U);
+	ASSERT_LT(pts.size(), 200U);
+	float x, y, z;
+	pts.getPoint(0, x, y, z);
+	EXPECT_EQ(x, 100.0f);
+	EXPECT_EQ(y, 100.0f);
+
+	// One point per map voxel at most:
+	std::set<std::tuple<int, int>> cells;
+	for (size_t i = 1; i < pts.size(); i++)
+	{
+		pts.getPoint(i, x, y, z);
+		EXPECT_TRUE(
+			cells.emplace(int(std::floor(x / 0.5)), int(std::floor(y / 0.5)))
+				.second);
+		EXPECT_NEAR(x, 1.0, 4.0 + 1e-3);
+	}
+}
@@ -15,9 +15,11 @@
 #include <mrpt/system/os.h>
 #include <mrpt/math/geometry.h>
 #include <mrpt/serialization/CArchive.h>
+#include <mrpt/io/CMemoryMappedFile.h>
 
 #include <mrpt/maps/CPointsMap.h>
 #include <mrpt/maps/CSimplePointsMap.h>
+#include "CPointsMap_voxel_key.h"
 
 #include <mrpt/opengl/CPointCloud.h>
 #include <mrpt/opengl/CPointCloudColoured.h>
@@ -39,6 +41,15 @@
 #include <mrpt/core/SSE_macros.h>
 #endif
 
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <unordered_set>
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+
 #if MRPT_HAS_MATLAB
 #include <mexplus.h>
 #endif
@@ -117,55 +128,202 @@ bool CPointsMap::save3D_to_text_file(const string& file) const
 bool CPointsMap::load2Dor3D_from_text_file(
 	const std::string& file, const bool is_3D)
 {
-	MRPT_START
+	TTextFileLoadOptions opts;
+	opts.is_3D = is_3D;
+	return load_from_text_file_parallel(file, opts);
+}
 
-	mark_as_modified();
+namespace
+{
+inline bool isBlank(const char c) { return c == ' ' || c == '\t' || c == '\r'; }
 
-	FILE* f = os::fopen(file.c_str(), "rt");
-	if (!f) return false;
+/** Parses a number in [p,end), after optional blanks, and moves p past it */
+inline bool parseFloat(const char*& p, const char* end, float& v)
+{
+	while (p < end && isBlank(*p)) p++;
+	if (p < end && *p == '+') p++;
+#if defined(__cpp_lib_to_chars)
+	const auto res = std::from_chars(p, end, v);
+	if (res.ec != std::errc()) return false;
+	p = res.ptr;
+#else
+	// The mapped file is not null-terminated: parse a copy of the token
+	char buf[64];
+	size_t n = 0;
+	for (; p + n < end && n + 1 < sizeof(buf) && !isBlank(p[n]); n++)
+		buf[n] = p[n];
+	buf[n] = '\0';
+	char* tokenEnd;
+	v = std::strtof(buf, &tokenEnd);
+	if (tokenEnd == buf) return false;
+	p += tokenEnd - buf;
+#endif
+	return true;
+}
+}  // namespace
 
-	char str[1024];
-	char *ptr, *ptr1, *ptr2, *ptr3;
+bool CPointsMap::load_from_text_file_parallel(
+	const std::string& file, const TTextFileLoadOptions& opts)
+{
+	MRPT_START
 
-	// Clear current map:
-	this->clear();
+	mrpt::io::CMemoryMappedFile f;
+	if (!f.open(file)) return false;
+	const char* data = reinterpret_cast<const char*>(f.data());
+	const size_t len = f.size();
 
-	while (!feof(f))
+	// Split the file in blocks of whole lines:
+	std::vector<size_t> blockStarts(1, 0);
+	while (blockStarts.back() < len)
 	{
-		// Read one string line:
-		str[0] = 0;
-		if (!fgets(str, sizeof(str), f)) break;
-
-		// Find the first digit:
-		ptr = str;
-		while (ptr[0] && (ptr[0] == ' ' || ptr[0] == '\t' || ptr[0] == '\r' ||
-						  ptr[0] == '\n'))
-			ptr++;
-
-		// And try to parse it:
-		float xx = strtod(ptr, &ptr1);
-		if (ptr1 != str)
+		size_t pos = blockStarts.back() + std::max<size_t>(opts.block_size, 1);
+		if (pos < len)
 		{
-			float yy = strtod(ptr1, &ptr2);
-			if (ptr2 != ptr1)
+			const void* eol = std::memchr(data + pos, '\n', len - pos);
+			pos = eol ? static_cast<const char*>(eol) - data + 1 : len;
+		}
+		blockStarts.push_back(std::min(pos, len));
+	}
+	const size_t nBlocks = blockStarts.size() - 1;
+
+	const size_t nThreads = std::max<size_t>(
+		1, std::min<size_t>(
+			   opts.num_threads ? opts.num_threads
+								: std::thread::hardware_concurrency(),
+			   nBlocks));
+	const auto runThreads = [nThreads](const std::function<void()>& job) {
+		if (nThreads == 1) return job();
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < nThreads; t++) threads.emplace_back(job);
+		for (auto& th : threads) th.join();
+	};
+
+	// 1) Count the lines of each block, an upper bound of its points, so
+	// each block gets a fixed slot in the output arrays:
+	std::vector<size_t> offsets(nBlocks + 1, 0);
+	std::atomic<size_t> nextBlock{0};
+	runThreads([&]() {
+		for (size_t b; (b = nextBlock++) < nBlocks;)
+		{
+			const char* p = data + blockStarts[b];
+			const char* end = data + blockStarts[b + 1];
+			size_t n = 0;
+			for (; p < end; n++)
 			{
-				if (!is_3D)
+				const void* eol = std::memchr(p, '\n', end - p);
+				p = eol ? static_cast<const char*>(eol) + 1 : end;
+			}
+			offsets[b + 1] = n;
+		}
+	});
+	for (size_t b = 0; b < nBlocks; b++) offsets[b + 1] += offsets[b];
+
+	// 2) Parse blocks in parallel, each one straight into its slot:
+	this->clear();
+	m_x.resize(offsets[nBlocks]);
+	m_y.resize(offsets[nBlocks]);
+	m_z.resize(offsets[nBlocks]);
+	std::vector<size_t> counts(nBlocks, 0);
+	nextBlock = 0;
+	runThreads([&]() {
+		for (size_t b; (b = nextBlock++) < nBlocks;)
+		{
+			size_t i = offsets[b];
+			const char* p = data + blockStarts[b];
+			const char* end = data + blockStarts[b + 1];
+			while (p < end)
+			{
+				const char* eol =
+					static_cast<const char*>(std::memchr(p, '\n', end - p));
+				if (!eol) eol = end;
+				float x, y, z = 0;
+				const char* q = p;
+				if (parseFloat(q, eol, x) && parseFloat(q, eol, y) &&
+					(!opts.is_3D || parseFloat(q, eol, z)))
 				{
-					this->insertPoint(xx, yy, 0);
+					m_x[i] = x;
+					m_y[i] = y;
+					m_z[i] = z;
+					i++;
 				}
-				else
+				p = eol + 1;
+			}
+			counts[b] = i - offsets[b];
+		}
+	});
+
+	// Close the gaps left by comments and invalid lines:
+	size_t N = 0;
+	for (size_t b = 0; b < nBlocks; b++)
+	{
+		if (N != offsets[b])
+		{
+			const size_t i0 = offsets[b], i1 = i0 + counts[b];
+			std::copy(m_x.begin() + i0, m_x.begin() + i1, m_x.begin() + N);
+			std::copy(m_y.begin() + i0, m_y.begin() + i1, m_y.begin() + N);
+			std::copy(m_z.begin() + i0, m_z.begin() + i1, m_z.begin() + N);
+		}
+		N += counts[b];
+	}
+
+	// 3) Voxel decimation: keep the first point of each voxel. Voxels are
+	// split among threads by their hash, and each thread scans the points
+	// in order, marking as deleted the later points in its own voxels.
+	// Points with NaN or infinite coordinates have no voxel and are dropped.
+	if (opts.voxel_size > 0 && N > 0)
+	{
+		const double inv_size = 1.0 / opts.voxel_size;
+		const size_t nParts = std::min<size_t>(nThreads, 254);
+		const uint8_t DELETED = 0xFF;
+		std::vector<uint8_t> part(N);
+		std::atomic<size_t> nextChunk{0};
+		const size_t CHUNK = 1 << 16;
+		runThreads([&]() {
+			const detail::TVoxelKeyHash hasher;
+			for (size_t c; (c = nextChunk++) * CHUNK < N;)
+				for (size_t i = c * CHUNK; i < std::min(N, (c + 1) * CHUNK);
+					 i++)
 				{
-					float zz = strtod(ptr2, &ptr3);
-					if (ptr3 != ptr2)
-					{
-						this->insertPoint(xx, yy, zz);
-					}
+					detail::TVoxelKey k;
+					const bool ok =
+						detail::voxelOf(m_x[i], m_y[i], m_z[i], inv_size, k);
+					part[i] = ok ? static_cast<uint8_t>(hasher(k) % nParts)
+								 : DELETED;
+				}
+		});
+		std::atomic<size_t> nextPart{0};
+		runThreads([&]() {
+			for (size_t t; (t = nextPart++) < nParts;)
+			{
+				std::unordered_set<detail::TVoxelKey, detail::TVoxelKeyHash>
+					voxels;
+				for (size_t i = 0; i < N; i++)
+				{
+					if (part[i] != t) continue;
+					detail::TVoxelKey k;
+					detail::voxelOf(m_x[i], m_y[i], m_z[i], inv_size, k);
+					if (!voxels.insert(k).second) part[i] = DELETED;
 				}
 			}
+		});
+		size_t nKept = 0;
+		for (size_t i = 0; i < N; i++)
+		{
+			if (part[i] == DELETED) continue;
+			m_x[nKept] = m_x[i];
+			m_y[nKept] = m_y[i];
+			m_z[nKept] = m_z[i];
+			nKept++;
 		}
+		N = nKept;
 	}
+	m_x.resize(N);
+	m_y.resize(N);
+	m_z.resize(N);
 
-	os::fclose(f);
+	// Other channels get their default values:
+	this->resize(m_x.size());
+	mark_as_modified();
 	return true;
 
 	MRPT_END
@@ -577,11 +735,10 @@ void CPointsMap::changeCoordinatesReference(const CPose2D& newBase)
 
 	const CPose3D newBase3D(newBase);
 
-	for (size_t i = 0; i < N; i++)
-		newBase3D.composePoint(
-			m_x[i], m_y[i], m_z[i],  // In
-			m_x[i], m_y[i], m_z[i]  // Out
-		);
+	newBase3D.composePoints(
+		N, m_x.data(), m_y.data(), m_z.data(),  // In
+		m_x.data(), m_y.data(), m_z.data()  // Out
+	);
 
 	mark_as_modified();
 }
@@ -593,11 +750,10 @@ void CPointsMap::changeCoordinatesReference(const CPose3D& newBase)
 {
 	const size_t N = m_x.size();
 
-	for (size_t i = 0; i < N; i++)
-		newBase.composePoint(
-			m_x[i], m_y[i], m_z[i],  // In
-			m_x[i], m_y[i], m_z[i]  // Out
-		);
+	newBase.composePoints(
+		N, m_x.data(), m_y.data(), m_z.data(),  // In
+		m_x.data(), m_y.data(), m_z.data()  // Out
+	);
 
 	mark_as_modified();
 }
@@ -1740,6 +1896,54 @@ bool CPointsMap::loadPCDFile(const std::string& filename)
 #endif
 }
 
+bool CPointsMap::saveBinaryFile(
+	const std::string& filename, bool spatial_sort) const
+{
+	CPointsMapBinaryFile::TChannels ch;
+	getBinaryFileChannels(ch);
+	return CPointsMapBinaryFile::save(filename, ch, spatial_sort);
+}
+
+void CPointsMap::getBinaryFileChannels(
+	CPointsMapBinaryFile::TChannels& ch) const
+{
+	ch.count = m_x.size();
+	ch.x = m_x.data();
+	ch.y = m_y.data();
+	ch.z = m_z.data();
+}
+
+bool CPointsMap::loadBinaryFile(const std::string& filename)
+{
+	CPointsMapBinaryFile f;
+	if (!f.open(filename)) return false;
+	loadFromBinaryFile(f);
+	return true;
+}
+
+void CPointsMap::loadFromBinaryFile(const CPointsMapBinaryFile& f)
+{
+	const size_t N = f.size();
+	this->clear();
+	m_x.assign(f.getPointsBuffer_x(), f.getPointsBuffer_x() + N);
+	m_y.assign(f.getPointsBuffer_y(), f.getPointsBuffer_y() + N);
+	m_z.assign(f.getPointsBuffer_z(), f.getPointsBuffer_z() + N);
+	// Other channels get their default values:
+	this->resize(N);
+	mark_as_modified();
+
+	// Reuse the bounding box stored in the file:
+	mrpt::math::TPoint3Df bb_min, bb_max;
+	f.boundingBox(bb_min, bb_max);
+	m_bb_min_x = bb_min.x;
+	m_bb_min_y = bb_min.y;
+	m_bb_min_z = bb_min.z;
+	m_bb_max_x = bb_max.x;
+	m_bb_max_y = bb_max.y;
+	m_bb_max_z = bb_max.z;
+	m_boundingBoxIsUpdated = true;
+}
+
 /*---------------------------------------------------------------
 						applyDeletionMask
  ---------------------------------------------------------------*/
@@ -1822,6 +2026,66 @@ void CPointsMap::base_copyFrom(const CPointsMap& obj)
 	MRPT_END
 }
 
+namespace
+{
+/** Runs `map.insertionOptions.filters` on the points [n0, size) of `map`,
+ * just loaded from an observation in the map frame. */
+void filterInsertedPoints(
+	CPointsMap& map, const size_t n0, const TTimeStamp timestamp,
+	const CPose3D& robotPose)
+{
+	const auto& filters = map.insertionOptions.filters;
+	if (filters.empty()) return;
+
+	if (n0 == 0)
+	{
+		for (const auto& f : filters) f->filter(&map, timestamp, robotPose);
+		return;
+	}
+
+	// Filter a copy of the new points only, keeping track of which of them
+	// survive, then move these ones (with all their fields) into place:
+	const size_t N = map.size() - n0;
+	CSimplePointsMap aux;
+	aux.resize(N);
+	for (size_t i = 0; i < N; i++)
+	{
+		float x, y, z;
+		map.getPointFast(n0 + i, x, y, z);
+		aux.setPointFast(i, x, y, z);
+	}
+	aux.mark_as_modified();
+
+	std::vector<size_t> kept(N);
+	for (size_t i = 0; i < N; i++) kept[i] = i;
+	std::vector<bool> mask;
+	CPointCloudFilterBase::TExtraFilterParams params;
+	params.out_deletion_mask = &mask;
+	for (const auto& f : filters)
+	{
+		mask.clear();
+		f->filter(&aux, timestamp, robotPose, &params);
+		if (aux.size() == kept.size()) continue;
+		ASSERT_EQUAL_(mask.size(), kept.size());
+		size_t k = 0;
+		for (size_t i = 0; i < kept.size(); i++)
+			if (!mask[i]) kept[k++] = kept[i];
+		kept.resize(k);
+		ASSERT_EQUAL_(aux.size(), kept.size());
+	}
+
+	std::vector<float> fields;
+	for (size_t i = 0; i < kept.size(); i++)
+	{
+		map.getPointAllFieldsFast(n0 + kept[i], fields);
+		aux.getPointFast(i, fields[0], fields[1], fields[2]);
+		map.setPointAllFieldsFast(n0 + i, fields);
+	}
+	map.resize(n0 + kept.size());
+	map.mark_as_modified();
+}
+}  // namespace
+
 /*---------------------------------------------------------------
 					internal_insertObservation
 
@@ -1880,6 +2144,7 @@ bool CPointsMap::internal_insertObservation(
 					*o,  // The laser range scan observation
 					&robotPose3D  // The robot pose
 				);
+				filterInsertedPoints(auxMap, 0, o->timestamp, robotPose3D);
 
 				fuseWith(
 					&auxMap,  // Fuse with this map
@@ -1925,10 +2190,12 @@ bool CPointsMap::internal_insertObservation(
 			{
 				// Don't fuse: Simply add
 				insertionOptions.addToExistingPointsMap = true;
+				const size_t n0 = size();
 				loadFromRangeScan(
 					*o,  // The laser range scan observation
 					&robotPose3D  // The robot pose
 				);
+				filterInsertedPoints(*this, n0, o->timestamp, robotPose3D);
 			}
 
 			return true;
@@ -1970,6 +2237,7 @@ bool CPointsMap::internal_insertObservation(
 					*o,  // The laser range scan observation
 					&robotPose3D  // The robot pose
 				);
+				filterInsertedPoints(auxMap, 0, o->timestamp, robotPose3D);
 
 				fuseWith(
 					&auxMap,  // Fuse with this map
@@ -1982,10 +2250,12 @@ bool CPointsMap::internal_insertObservation(
 			{
 				// Don't fuse: Simply add
 				insertionOptions.addToExistingPointsMap = true;
+				const size_t n0 = size();
 				loadFromRangeScan(
 					*o,  // The laser range scan observation
 					&robotPose3D  // The robot pose
 				);
+				filterInsertedPoints(*this, n0, o->timestamp, robotPose3D);
 			}
 
 			// This could be implemented to check whether existing points fall
@@ -2069,6 +2339,7 @@ bool CPointsMap::internal_insertObservation(
 			auxMap.insertionOptions = insertionOptions;
 			auxMap.insertionOptions.addToExistingPointsMap = false;
 			auxMap.loadFromVelodyneScan(*o, &robotPose3D);
+			filterInsertedPoints(auxMap, 0, o->timestamp, robotPose3D);
 			fuseWith(
 				&auxMap, insertionOptions.minDistBetweenLaserPoints, nullptr /* rather than &checkForDeletion which we don't need for 3D observations */);
 		}
@@ -2076,7 +2347,9 @@ bool CPointsMap::internal_insertObservation(
 		{
 			// Don't fuse: Simply add
 			insertionOptions.addToExistingPointsMap = true;
+			const size_t n0 = size();
 			loadFromVelodyneScan(*o, &robotPose3D);
+			filterInsertedPoints(*this, n0, o->timestamp, robotPose3D);
 		}
 		return true;
 	}
@@ -0,0 +1,340 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include "maps-precomp.h"  // Precomp header
+
+#include <mrpt/maps/CPointsMapBinaryFile.h>
+#include <mrpt/io/CFileOutputStream.h>
+#include <mrpt/core/exceptions.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+using namespace mrpt::maps;
+using mrpt::math::TPoint3Df;
+
+namespace
+{
+/** "MRPTPTS" + '\0' */
+const char FILE_MAGIC[8] = {'M', 'R', 'P', 'T', 'P', 'T', 'S', 0};
+constexpr uint32_t FILE_VERSION = 1;
+/** Written as is: a different value means a different byte order */
+constexpr uint32_t ENDIANNESS_CHECK = 0x01020304;
+/** Alignment of each array in the file */
+constexpr uint64_t ARRAY_ALIGN = 64;
+
+/** At the beginning of the file */
+struct FileHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t endianness;
+	uint64_t num_points;
+	uint64_t num_chunks;
+	float bb_min[3], bb_max[3];
+	/** Byte offsets of each array, or 0 if missing */
+	uint64_t off_x, off_y, off_z, off_R, off_G, off_B, off_weight, off_chunks;
+};
+
+inline uint64_t alignArray(uint64_t n)
+{
+	return (n + ARRAY_ALIGN - 1) / ARRAY_ALIGN * ARRAY_ALIGN;
+}
+
+/** Spreads the lower 21 bits of v, leaving two zero bits between each */
+inline uint64_t spreadBits3(uint64_t v)
+{
+	v &= 0x1fffff;
+	v = (v | v << 32) & 0x1f00000000ffffULL;
+	v = (v | v << 16) & 0x1f0000ff0000ffULL;
+	v = (v | v << 8) & 0x100f00f00f00f00fULL;
+	v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+	v = (v | v << 2) & 0x1249249249249249ULL;
+	return v;
+}
+
+/** Writes `n` elements of `src` in the order given by `order` (or as is if
+ * it is empty), followed by zeros up to the array alignment */
+template <typename T>
+void writeArray(
+	mrpt::io::CFileOutputStream& f, const T* src, size_t n,
+	const std::vector<size_t>& order)
+{
+	if (order.empty())
+		f.Write(src, n * sizeof(T));
+	else
+	{
+		const size_t BLOCK = 1 << 16;
+		std::vector<T> buf(std::min(n, BLOCK));
+		for (size_t i = 0; i < n; i += BLOCK)
+		{
+			const size_t len = std::min(BLOCK, n - i);
+			for (size_t k = 0; k < len; k++) buf[k] = src[order[i + k]];
+			f.Write(buf.data(), len * sizeof(T));
+		}
+	}
+	const uint8_t zeros[ARRAY_ALIGN] = {0};
+	const size_t len = n * sizeof(T);
+	f.Write(zeros, alignArray(len) - len);
+}
+}  // namespace
+
+bool CPointsMapBinaryFile::save(
+	const std::string& filename, const TChannels& data, bool spatial_sort,
+	size_t chunk_size)
+{
+	MRPT_START
+	ASSERT_(chunk_size > 0);
+	const size_t N = data.count;
+	ASSERT_(N == 0 || (data.x && data.y && data.z));
+	const bool hasColor = data.R && data.G && data.B;
+
+	FileHeader h;
+	std::memset(&h, 0, sizeof(h));
+	std::memcpy(h.magic, FILE_MAGIC, sizeof(h.magic));
+	h.version = FILE_VERSION;
+	h.endianness = ENDIANNESS_CHECK;
+	h.num_points = N;
+	h.num_chunks = (N + chunk_size - 1) / chunk_size;
+
+	// Bounding box:
+	if (N)
+	{
+		for (int k = 0; k < 3; k++)
+		{
+			h.bb_min[k] = std::numeric_limits<float>::max();
+			h.bb_max[k] = -std::numeric_limits<float>::max();
+		}
+		for (size_t i = 0; i < N; i++)
+		{
+			const float p[3] = {data.x[i], data.y[i], data.z[i]};
+			for (int k = 0; k < 3; k++)
+			{
+				h.bb_min[k] = std::min(h.bb_min[k], p[k]);
+				h.bb_max[k] = std::max(h.bb_max[k], p[k]);
+			}
+		}
+	}
+
+	// Sort along a Z-order curve, so consecutive points are spatially close:
+	std::vector<size_t> order;
+	if (spatial_sort && N > 1)
+	{
+		float scale[3];
+		for (int k = 0; k < 3; k++)
+		{
+			const float range = h.bb_max[k] - h.bb_min[k];
+			scale[k] = range > 0 ? float(0x1fffff) / range : 0;
+		}
+		std::vector<std::pair<uint64_t, size_t>> codes(N);
+		for (size_t i = 0; i < N; i++)
+		{
+			const float p[3] = {data.x[i], data.y[i], data.z[i]};
+			uint64_t code = 0;
+			for (int k = 0; k < 3; k++)
+			{
+				const float v = (p[k] - h.bb_min[k]) * scale[k];
+				const uint64_t q =
+					v > 0 ? static_cast<uint64_t>(std::min(v, float(0x1fffff)))
+						  : 0;
+				code |= spreadBits3(q) << k;
+			}
+			codes[i] = {code, i};
+		}
+		std::sort(codes.begin(), codes.end());
+		order.resize(N);
+		for (size_t i = 0; i < N; i++) order[i] = codes[i].second;
+	}
+
+	// Spatial index:
+	std::vector<TChunk> chunks(h.num_chunks);
+	for (size_t c = 0; c < chunks.size(); c++)
+	{
+		TChunk& ch = chunks[c];
+		ch.first = c * chunk_size;
+		ch.count = static_cast<uint32_t>(std::min(chunk_size, N - ch.first));
+		for (int k = 0; k < 3; k++)
+		{
+			ch.bb_min[k] = std::numeric_limits<float>::max();
+			ch.bb_max[k] = -std::numeric_limits<float>::max();
+		}
+		for (size_t i = ch.first; i < ch.first + ch.count; i++)
+		{
+			const size_t idx = order.empty() ? i : order[i];
+			const float p[3] = {data.x[idx], data.y[idx], data.z[idx]};
+			for (int k = 0; k < 3; k++)
+			{
+				ch.bb_min[k] = std::min(ch.bb_min[k], p[k]);
+				ch.bb_max[k] = std::max(ch.bb_max[k], p[k]);
+			}
+		}
+	}
+
+	// Layout:
+	const uint64_t arrayLen = alignArray(N * sizeof(float));
+	uint64_t pos = alignArray(sizeof(FileHeader));
+	for (uint64_t* off : {&h.off_x, &h.off_y, &h.off_z})
+	{
+		*off = pos;
+		pos += arrayLen;
+	}
+	if (hasColor)
+	{
+		for (uint64_t* off : {&h.off_R, &h.off_G, &h.off_B})
+		{
+			*off = pos;
+			pos += arrayLen;
+		}
+	}
+	if (data.weight)
+	{
+		h.off_weight = pos;
+		pos += alignArray(N * sizeof(uint32_t));
+	}
+	h.off_chunks = pos;
+
+	try
+	{
+		mrpt::io::CFileOutputStream f;
+		if (!f.open(filename)) return false;
+		writeArray(f, reinterpret_cast<const uint8_t*>(&h), sizeof(h), {});
+		writeArray(f, data.x, N, order);
+		writeArray(f, data.y, N, order);
+		writeArray(f, data.z, N, order);
+		if (hasColor)
+		{
+			writeArray(f, data.R, N, order);
+			writeArray(f, data.G, N, order);
+			writeArray(f, data.B, N, order);
+		}
+		if (data.weight) writeArray(f, data.weight, N, order);
+		writeArray(f, chunks.data(), chunks.size(), {});
+	}
+	catch (const std::exception&)
+	{
+		return false;
+	}
+	return true;
+	MRPT_END
+}
+
+CPointsMapBinaryFile::CPointsMapBinaryFile(const std::string& filename)
+{
+	MRPT_START
+	if (!open(filename))
+		THROW_EXCEPTION_FMT(
+			"Error opening binary point cloud file: '%s'", filename.c_str());
+	MRPT_END
+}
+
+bool CPointsMapBinaryFile::open(const std::string& filename)
+{
+	close();
+	if (!m_file.open(filename)) return false;
+
+	const uint8_t* base = m_file.data();
+	const uint64_t fileSize = m_file.size();
+	FileHeader h;
+	if (fileSize < sizeof(h))
+	{
+		close();
+		return false;
+	}
+	std::memcpy(&h, base, sizeof(h));
+	bool ok = std::memcmp(h.magic, FILE_MAGIC, sizeof(h.magic)) == 0 &&
+			  h.version == FILE_VERSION && h.endianness == ENDIANNESS_CHECK;
+
+	// Checks that an array is within the file:
+	const auto array = [&](uint64_t off, uint64_t len) -> const uint8_t* {
+		if (!off) return nullptr;
+		if (off % ARRAY_ALIGN || off > fileSize || len > fileSize - off)
+			ok = false;
+		return ok ? base + off : nullptr;
+	};
+	const uint64_t N = h.num_points;
+	const uint64_t len = ok && N < fileSize ? N * sizeof(float) : fileSize + 1;
+	m_x = reinterpret_cast<const float*>(array(h.off_x, len));
+	m_y = reinterpret_cast<const float*>(array(h.off_y, len));
+	m_z = reinterpret_cast<const float*>(array(h.off_z, len));
+	m_R = reinterpret_cast<const float*>(array(h.off_R, len));
+	m_G = reinterpret_cast<const float*>(array(h.off_G, len));
+	m_B = reinterpret_cast<const float*>(array(h.off_B, len));
+	m_weight = reinterpret_cast<const uint32_t*>(array(h.off_weight, len));
+	const uint64_t chunksLen = h.num_chunks < fileSize
+								   ? h.num_chunks * sizeof(TChunk)
+								   : fileSize + 1;
+	m_chunks = reinterpret_cast<const TChunk*>(array(h.off_chunks, chunksLen));
+	// Coordinates are mandatory, colours come all or none:
+	ok = ok && m_x && m_y && m_z && m_chunks && (!m_R == !m_G) &&
+		 (!m_R == !m_B);
+	for (uint64_t c = 0; ok && c < h.num_chunks; c++)
+	{
+		const TChunk& ch = m_chunks[c];
+		ok = ch.first <= N && ch.count <= N - ch.first;
+	}
+	if (!ok)
+	{
+		close();
+		return false;
+	}
+	m_count = N;
+	m_chunk_count = h.num_chunks;
+	m_bb_min = TPoint3Df(h.bb_min[0], h.bb_min[1], h.bb_min[2]);
+	m_bb_max = TPoint3Df(h.bb_max[0], h.bb_max[1], h.bb_max[2]);
+	return true;
+}
+
+void CPointsMapBinaryFile::close()
+{
+	m_file.close();
+	m_count = m_chunk_count = 0;
+	m_x = m_y = m_z = m_R = m_G = m_B = nullptr;
+	m_weight = nullptr;
+	m_chunks = nullptr;
+	m_bb_min = m_bb_max = TPoint3Df(0, 0, 0);
+}
+
+void CPointsMapBinaryFile::boundingBox(
+	TPoint3Df& bb_min, TPoint3Df& bb_max) const
+{
+	bb_min = m_bb_min;
+	bb_max = m_bb_max;
+}
+
+void CPointsMapBinaryFile::getPointsInBox(
+	const TPoint3Df& bb_min, const TPoint3Df& bb_max,
+	std::vector<size_t>& out_indices) const
+{
+	out_indices.clear();
+	const float q_min[3] = {bb_min.x, bb_min.y, bb_min.z};
+	const float q_max[3] = {bb_max.x, bb_max.y, bb_max.z};
+	for (size_t c = 0; c < m_chunk_count; c++)
+	{
+		const TChunk& ch = m_chunks[c];
+		bool overlaps = true, inside = true;
+		for (int k = 0; k < 3; k++)
+		{
+			overlaps = overlaps && ch.bb_max[k] >= q_min[k] &&
+					   ch.bb_min[k] <= q_max[k];
+			inside = inside && ch.bb_min[k] >= q_min[k] &&
+					 ch.bb_max[k] <= q_max[k];
+		}
+		if (!overlaps) continue;
+		const size_t end = ch.first + ch.count;
+		for (size_t i = ch.first; i < end; i++)
+		{
+			if (inside ||
+				(m_x[i] >= q_min[0] && m_x[i] <= q_max[0] &&
+				 m_y[i] >= q_min[1] && m_y[i] <= q_max[1] &&
+				 m_z[i] >= q_min[2] && m_z[i] <= q_max[2]))
+				out_indices.push_back(i);
+		}
+	}
+}
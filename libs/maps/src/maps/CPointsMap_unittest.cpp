@@ -11,7 +11,10 @@
 #include <mrpt/maps/CWeightedPointsMap.h>
 #include <mrpt/maps/CColouredPointsMap.h>
 #include <mrpt/poses/CPoint2D.h>
+#include <mrpt/system/filesystem.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <tuple>
 
 using namespace mrpt;
 using namespace mrpt::maps;
@@ -140,6 +143,186 @@ void do_test_clipOutOfRange()
 	}
 }
 
+// Points as sortable tuples: x y z R G B weight
+using point_tuple_t = std::tuple<float, float, float, float, float, float, int>;
+
+template <class MAP>
+std::vector<point_tuple_t> getAllPointFields(const MAP& pts)
+{
+	std::vector<point_tuple_t> ret(pts.size());
+	for (size_t i = 0; i < pts.size(); i++)
+	{
+		float x, y, z, R, G, B;
+		pts.getPoint(i, x, y, z, R, G, B);
+		ret[i] = point_tuple_t(x, y, z, R, G, B, pts.getPointWeight(i));
+	}
+	return ret;
+}
+
+template <class MAP>
+void do_test_binaryFile()
+{
+	MAP pts0;
+	for (int i = 0; i < 10000; i++)
+	{
+		const float x = (i * 37) % 101, y = (i * 11) % 53, z = i % 7;
+		pts0.insertPoint(x, y, z);
+		pts0.setPoint(i, x, y, z, x / 101, y / 53, z / 7);
+		pts0.setPointWeight(i, i % 5);
+	}
+	const auto fields0 = getAllPointFields(pts0);
+	const std::string fil = mrpt::system::getTempFileName();
+
+	// Keeping the point order:
+	{
+		EXPECT_TRUE(pts0.saveBinaryFile(fil, false));
+		MAP pts;
+		load_demo_9pts_map(pts);
+		EXPECT_TRUE(pts.loadBinaryFile(fil));
+		EXPECT_TRUE(getAllPointFields(pts) == fields0);
+
+		float bb[6], bb0[6];
+		pts.boundingBox(bb[0], bb[1], bb[2], bb[3], bb[4], bb[5]);
+		pts0.boundingBox(bb0[0], bb0[1], bb0[2], bb0[3], bb0[4], bb0[5]);
+		EXPECT_TRUE(std::equal(bb, bb + 6, bb0));
+	}
+	// Spatially sorted:
+	{
+		EXPECT_TRUE(pts0.saveBinaryFile(fil, true));
+		MAP pts;
+		EXPECT_TRUE(pts.loadBinaryFile(fil));
+		auto fields = getAllPointFields(pts), fields_sorted = fields0;
+		std::sort(fields.begin(), fields.end());
+		std::sort(fields_sorted.begin(), fields_sorted.end());
+		EXPECT_TRUE(fields == fields_sorted);
+
+		// Spatial index vs. brute force:
+		CPointsMapBinaryFile f(fil);
+		EXPECT_GT(f.getChunkCount(), 1U);
+		const TPoint3Df q_min(10, 20, 2), q_max(30, 25, 4);
+		std::vector<size_t> idxs;
+		f.getPointsInBox(q_min, q_max, idxs);
+		size_t n = 0;
+		for (size_t i = 0; i < pts.size(); i++)
+		{
+			float x, y, z;
+			pts.getPoint(i, x, y, z);
+			if (x >= q_min.x && x <= q_max.x && y >= q_min.y &&
+				y <= q_max.y && z >= q_min.z && z <= q_max.z)
+			{
+				ASSERT_LT(n, idxs.size());
+				EXPECT_EQ(idxs[n++], i);
+			}
+		}
+		EXPECT_EQ(n, idxs.size());
+		EXPECT_GT(n, 0U);
+	}
+	// Other map classes load the XYZ channels:
+	{
+		CSimplePointsMap pts;
+		EXPECT_TRUE(pts.loadBinaryFile(fil));
+		EXPECT_EQ(pts.size(), pts0.size());
+	}
+	// Empty maps and invalid files:
+	{
+		MAP pts;
+		EXPECT_TRUE(pts.saveBinaryFile(fil));
+		load_demo_9pts_map(pts);
+		EXPECT_TRUE(pts.loadBinaryFile(fil));
+		EXPECT_EQ(pts.size(), 0U);
+
+		pts0.save3D_to_text_file(fil);
+		EXPECT_FALSE(pts.loadBinaryFile(fil));
+	}
+	mrpt::system::deleteFile(fil);
+}
+
+TEST(CSimplePointsMapTests, loadTextFileParallel)
+{
+	const std::string fil = mrpt::system::getTempFileName();
+	{
+		FILE* f = fopen(fil.c_str(), "wt");
+		ASSERT_TRUE(f != nullptr);
+		fprintf(f, "# A comment\n\n");
+		for (int i = 0; i < 5000; i++)
+		{
+			if (i % 2)
+				fprintf(f, "%i.5 %i %i extra\r\n", i % 100, i % 10, i % 3);
+			else
+				fprintf(f, "  %i.5\t%i +%ie0\n", i % 100, i % 10, i % 3);
+		}
+		fprintf(f, "1 2\nnot a point\n7 8 9");  // No final EOL
+		fclose(f);
+	}
+	CSimplePointsMap ref;
+	for (int i = 0; i < 5000; i++)
+		ref.insertPoint(i % 100 + .5f, i % 10, i % 3);
+	ref.insertPoint(7, 8, 9);
+
+	// Any number of threads and block sizes:
+	for (const size_t block_size : {10, 1000, 1 << 20})
+	{
+		CSimplePointsMap::TTextFileLoadOptions opts;
+		opts.num_threads = 4;
+		opts.block_size = block_size;
+		CSimplePointsMap pts;
+		load_demo_9pts_map(pts);
+		EXPECT_TRUE(pts.load_from_text_file_parallel(fil, opts));
+		EXPECT_TRUE(
+			pts.getPointsBufferRef_x() == ref.getPointsBufferRef_x() &&
+			pts.getPointsBufferRef_y() == ref.getPointsBufferRef_y() &&
+			pts.getPointsBufferRef_z() == ref.getPointsBufferRef_z());
+	}
+	// 2D:
+	{
+		CSimplePointsMap pts;
+		EXPECT_TRUE(pts.load2D_from_text_file(fil));
+		EXPECT_EQ(pts.size(), ref.size() + 1);
+	}
+	// Voxel decimation: the first point of each voxel, whatever the blocks
+	// and threads:
+	for (const unsigned int num_threads : {1, 4})
+	{
+		CSimplePointsMap::TTextFileLoadOptions opts;
+		opts.voxel_size = 10;
+		opts.block_size = 100;
+		opts.num_threads = num_threads;
+		CSimplePointsMap pts;
+		EXPECT_TRUE(pts.load_from_text_file_parallel(fil, opts));
+		EXPECT_EQ(pts.size(), 10U);
+		float x, y, z;
+		pts.getPoint(0, x, y, z);
+		EXPECT_EQ(x, 0.5f);
+		pts.getPoint(1, x, y, z);
+		EXPECT_EQ(x, 10.5f);
+		EXPECT_EQ(z, 1.0f);
+	}
+
+	// Non-finite or huge coordinates have no voxel:
+	{
+		FILE* f = fopen(fil.c_str(), "wt");
+		ASSERT_TRUE(f != nullptr);
+		fprintf(f, "nan 1 2\n1 inf 2\n1 2 -inf\n1e30 0 0\n1 2 3\n");
+		fclose(f);
+	}
+	{
+		CSimplePointsMap::TTextFileLoadOptions opts;
+		CSimplePointsMap pts;
+		EXPECT_TRUE(pts.load_from_text_file_parallel(fil, opts));
+		EXPECT_EQ(pts.size(), 5U);
+		opts.voxel_size = 1e-3f;
+		EXPECT_TRUE(pts.load_from_text_file_parallel(fil, opts));
+		ASSERT_EQ(pts.size(), 1U);
+		float x, y, z;
+		pts.getPoint(0, x, y, z);
+		EXPECT_EQ(z, 3.0f);
+	}
+	mrpt::system::deleteFile(fil);
+
+	CSimplePointsMap pts;
+	EXPECT_FALSE(pts.load3D_from_text_file(fil));
+}
+
 TEST(CSimplePointsMapTests, insertPoints)
 {
 	do_test_insertPoints<CSimplePointsMap>();
@@ -184,3 +367,18 @@ TEST(CColouredPointsMapTests, clipOutOfRange)
 {
 	do_test_clipOutOfRange<CColouredPointsMap>();
 }
+
+TEST(CSimplePointsMapTests, binaryFile)
+{
+	do_test_binaryFile<CSimplePointsMap>();
+}
+
+TEST(CWeightedPointsMapTests, binaryFile)
+{
+	do_test_binaryFile<CWeightedPointsMap>();
+}
+
+TEST(CColouredPointsMapTests, binaryFile)
+{
+	do_test_binaryFile<CColouredPointsMap>();
+}
@@ -0,0 +1,59 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace mrpt::maps::detail
+{
+/** Integer coordinates of a cubic voxel, for voxel decimation/filtering of
+ * point clouds */
+struct TVoxelKey
+{
+	int64_t x, y, z;
+	bool operator==(const TVoxelKey& o) const
+	{
+		return x == o.x && y == o.y && z == o.z;
+	}
+};
+
+struct TVoxelKeyHash
+{
+	size_t operator()(const TVoxelKey& k) const
+	{
+		// (Unsigned arithmetic, so overflows wrap around)
+		return static_cast<size_t>(
+			(static_cast<uint64_t>(k.x) * 73856093ULL) ^
+			(static_cast<uint64_t>(k.y) * 19349663ULL) ^
+			(static_cast<uint64_t>(k.z) * 83492791ULL));
+	}
+};
+
+/** Computes the voxel of a point, for voxels of size `1/inv_size`.
+ * \return false (and leaves `k` untouched) if any coordinate is NaN or
+ * infinite, or too far away for its voxel index to fit in an int64_t. */
+inline bool voxelOf(
+	const double x, const double y, const double z, const double inv_size,
+	TVoxelKey& k)
+{
+	// Any limit below 2^63 works; this one is exactly representable.
+	constexpr double MAX_IDX = 4611686018427387904.0;  // 2^62
+	const double fx = std::floor(x * inv_size), fy = std::floor(y * inv_size),
+				 fz = std::floor(z * inv_size);
+	// (Comparisons with NaN are false)
+	if (!(std::abs(fx) < MAX_IDX && std::abs(fy) < MAX_IDX &&
+		  std::abs(fz) < MAX_IDX))
+		return false;
+	k = TVoxelKey{static_cast<int64_t>(fx), static_cast<int64_t>(fy),
+				  static_cast<int64_t>(fz)};
+	return true;
+}
+}  // namespace mrpt::maps::detail
@@ -765,6 +765,9 @@ void CRandomFieldGridMap2D::TInsertionOptionsCommon::
 	out << mrpt::format(
 		"GMRF_gridmap_image_cy                   = %u\n",
 		static_cast<unsigned int>(GMRF_gridmap_image_cy));
+	out << mrpt::format(
+		"GMRF_use_sparse_cholesky                = %s\n",
+		GMRF_use_sparse_cholesky ? "YES" : "NO");
 }
 
 /*---------------------------------------------------------------
@@ -811,6 +814,7 @@ void CRandomFieldGridMap2D::TInsertionOptionsCommon::
 		iniFile.read_int(section.c_str(), "gridmap_image_cx", 0, false);
 	GMRF_gridmap_image_cy =
 		iniFile.read_int(section.c_str(), "gridmap_image_cy", 0, false);
+	MRPT_LOAD_CONFIG_VAR(GMRF_use_sparse_cholesky, bool, iniFile, section);
 }
 
 /*---------------------------------------------------------------
@@ -2572,6 +2576,10 @@ void CRandomFieldGridMap2D::insertObservation_GMRF(
 void CRandomFieldGridMap2D::updateMapEstimation_GMRF()
 {
 	Eigen::VectorXd x_incr, x_var;
+	m_gmrf.setSolver(
+		m_insertOptions_common->GMRF_use_sparse_cholesky
+			? mrpt::graphs::ScalarFactorGraph::solverSparseCholesky
+			: mrpt::graphs::ScalarFactorGraph::solverSparseQR);
 	m_gmrf.updateEstimation(
 		x_incr, m_insertOptions_common->GMRF_skip_variance ? NULL : &x_var);
 
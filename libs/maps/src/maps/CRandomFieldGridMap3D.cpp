@@ -207,6 +207,9 @@ void CRandomFieldGridMap3D::TInsertionOptions::dumpToTextStream(
 	out << mrpt::format(
 		"GMRF_skip_variance                   = %s\n",
 		GMRF_skip_variance ? "true" : "false");
+	out << mrpt::format(
+		"GMRF_use_sparse_cholesky             = %s\n",
+		GMRF_use_sparse_cholesky ? "true" : "false");
 }
 
 void CRandomFieldGridMap3D::TInsertionOptions::loadFromConfigFile(
@@ -216,6 +219,8 @@ void CRandomFieldGridMap3D::TInsertionOptions::loadFromConfigFile(
 		section.c_str(), "GMRF_lambdaPrior", GMRF_lambdaPrior);
 	GMRF_skip_variance = iniFile.read_bool(
 		section.c_str(), "GMRF_skip_variance", GMRF_skip_variance);
+	GMRF_use_sparse_cholesky = iniFile.read_bool(
+		section.c_str(), "GMRF_use_sparse_cholesky", GMRF_use_sparse_cholesky);
 }
 
 /** Save the current estimated grid to a VTK file (.vts) as a "structured grid".
@@ -314,6 +319,10 @@ void CRandomFieldGridMap3D::updateMapEstimation()
 		"Cannot update a map with no observations!");
 
 	Eigen::VectorXd x_incr, x_var;
+	m_gmrf.setSolver(
+		insertionOptions.GMRF_use_sparse_cholesky
+			? mrpt::graphs::ScalarFactorGraph::solverSparseCholesky
+			: mrpt::graphs::ScalarFactorGraph::solverSparseQR);
 	m_gmrf.updateEstimation(
 		x_incr, insertionOptions.GMRF_skip_variance ? NULL : &x_var);
 
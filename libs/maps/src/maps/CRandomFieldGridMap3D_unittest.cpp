@@ -92,3 +92,37 @@ TEST(CRandomFieldGridMap3D, insertPointsAndRead)
 		EXPECT_NEAR(map_value, val, 1e-6);
 	}
 }
+
+TEST(CRandomFieldGridMap3D, sparseCholeskySameAsQR)
+{
+	using mrpt::math::TPoint3D;
+
+	const auto im = mrpt::maps::CRandomFieldGridMap3D::gimNearest;
+	mrpt::maps::CRandomFieldGridMap3D grid_qr, grid_chol;
+	grid_chol.insertionOptions.GMRF_use_sparse_cholesky = true;
+	for (auto* g : {&grid_qr, &grid_chol})
+	{
+		g->setSize(-4.0, 4.0, 0.0, 4.0, 0.0, 4.0, 1.0 /*voxel size*/);
+		g->insertionOptions.GMRF_skip_variance = true;
+	}
+
+	const TPoint3D pts[] = {TPoint3D(2.0, 3.0, 1.0), TPoint3D(-3.0, 0.4, 1.0),
+							TPoint3D(3.0, 3.8, 3.0), TPoint3D(0.5, 1.5, 2.5)};
+	double val = 10.0;
+	for (const auto& pt : pts)
+	{
+		for (auto* g : {&grid_qr, &grid_chol})
+		{
+			EXPECT_TRUE(g->insertIndividualReading(val, 1.0, pt, im, false));
+			g->updateMapEstimation();
+		}
+		val += 7.0;
+
+		for (double z = 0.5; z < 4.0; z += 1.0)
+			for (double y = 0.5; y < 4.0; y += 1.0)
+				for (double x = -3.5; x < 4.0; x += 1.0)
+					EXPECT_NEAR(
+						grid_qr.cellByPos(x, y, z)->mean_value,
+						grid_chol.cellByPos(x, y, z)->mean_value, 1e-6);
+	}
+}
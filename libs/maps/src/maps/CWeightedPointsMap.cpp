@@ -152,6 +152,21 @@ void CWeightedPointsMap::addFrom_classSpecific(
 	}
 }
 
+void CWeightedPointsMap::getBinaryFileChannels(
+	CPointsMapBinaryFile::TChannels& ch) const
+{
+	CPointsMap::getBinaryFileChannels(ch);
+	ch.weight = pointWeight.data();
+}
+
+void CWeightedPointsMap::loadFromBinaryFile(const CPointsMapBinaryFile& f)
+{
+	CPointsMap::loadFromBinaryFile(f);
+	if (!f.hasWeights()) return;
+	const uint32_t* w = f.getPointsBuffer_weight();
+	pointWeight.assign(w, w + f.size());
+}
+
 uint8_t CWeightedPointsMap::serializeGetVersion() const { return 2; }
 void CWeightedPointsMap::serializeTo(mrpt::serialization::CArchive& out) const
 {
@@ -689,6 +689,9 @@ class KDTreeCapable
 	 * \param out_dist_sqr The square distance between the query and the
 	 *returned point.
 	 *
+	 * This method (like kdTreeRadiusSearch3D()) may be called from several
+	 * threads at once if the KD-tree is already up to date.
+	 *
 	 *  \sa kdTreeClosestPoint2D,  kdTreeRadiusSearch3D
 	 */
 	inline void kdTreeNClosestPoint3DIdx(
@@ -705,12 +708,11 @@ class KDTreeCapable
 		nanoflann::KNNResultSet<num_t> resultSet(knn);
 		resultSet.init(&out_idx[0], &out_dist_sqr[0]);
 
-		m_kdtree3d_data.query_point[0] = x0;
-		m_kdtree3d_data.query_point[1] = y0;
-		m_kdtree3d_data.query_point[2] = z0;
+		// A local query point, so concurrent calls are safe once the tree is
+		// built:
+		const num_t query[3] = {x0, y0, z0};
 		m_kdtree3d_data.index->findNeighbors(
-			resultSet, &m_kdtree3d_data.query_point[0],
-			nanoflann::SearchParams());
+			resultSet, &query[0], nanoflann::SearchParams());
 		MRPT_END
 	}
 
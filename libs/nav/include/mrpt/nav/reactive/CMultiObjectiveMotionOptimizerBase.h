@@ -105,6 +105,9 @@ class CMultiObjectiveMotionOptimizerBase : public mrpt::rtti::CObject
 	std::map<std::string, mrpt::expr::CRuntimeCompiledExpression> m_score_exprs;
 	std::vector<mrpt::expr::CRuntimeCompiledExpression> m_movement_assert_exprs;
 	std::map<std::string, double> m_expr_vars;
+
+	/** Compiles the score and assert expressions, upon first use */
+	void internal_compile_exprs();
 };
 }
 
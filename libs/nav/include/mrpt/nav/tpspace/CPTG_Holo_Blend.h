@@ -94,6 +94,15 @@ class CPTG_Holo_Blend : public CPTG_RobotShape_Circular
 	double internal_get_w(const double dir) const;
 	/** Evals expr_T_ramp */
 	double internal_get_T_ramp(const double dir) const;
+	/** Values of the expressions for the direction of each path index "k",
+	 * batch-evaluated in internal_initialize() */
+	std::vector<double> m_v_by_k, m_w_by_k, m_T_ramp_by_k;
+	/** Like internal_get_v() for the direction of path index "k" */
+	double internal_get_v_by_k(uint16_t k) const;
+	/** Like internal_get_w() for the direction of path index "k" */
+	double internal_get_w_by_k(uint16_t k) const;
+	/** Like internal_get_T_ramp() for the direction of path index "k" */
+	double internal_get_T_ramp_by_k(uint16_t k) const;
 
 	void internal_construct_exprs();
 
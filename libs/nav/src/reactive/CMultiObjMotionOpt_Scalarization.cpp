@@ -89,14 +89,18 @@ int CMultiObjMotionOpt_Scalarization::impl_decide(
 	// Evaluate the formula for all candidates:
 	const size_t N = extra_info.score_values.size();
 	final_evaluation.assign(N, .0);
-	int best_idx = -1;
-	double best_val = .0;
+
+	// Values of the variables for each eligible candidate, as arrays for a
+	// batch evaluation. Scores missing in a candidate keep their last value.
+	std::vector<size_t> eligible;
+	std::map<std::string, std::vector<double>> var_values;
 	for (size_t i = 0; i < N; i++)
 	{
 		if (extra_info.score_values[i].empty())
 			continue;  // this candidate is non-eligible.
+		eligible.push_back(i);
 
-		// Update variables & evaluate formula:
+		// Update variables:
 		for (const auto& score : extra_info.score_values[i])
 		{
 			const auto& it = m_expr_scalar_vars.find(
@@ -110,7 +114,21 @@ int CMultiObjMotionOpt_Scalarization::impl_decide(
 			double& var = it->second;
 			var = score.second;
 		}
-		const double val = m_expr_scalar_formula.eval();
+		for (const auto& v : m_expr_scalar_vars)
+			var_values[v.first].push_back(v.second);
+	}
+	std::map<std::string, const double*> batch_vars;
+	for (const auto& v : var_values) batch_vars[v.first] = v.second.data();
+
+	std::vector<double> vals;
+	m_expr_scalar_formula.eval_batch(batch_vars, eligible.size(), vals);
+
+	int best_idx = -1;
+	double best_val = .0;
+	for (size_t k = 0; k < eligible.size(); k++)
+	{
+		const size_t i = eligible[k];
+		const double val = vals[k];
 		extra_info.final_evaluation[i] = val;
 
 		if (val > 0 && (best_idx == -1 || val > best_val))
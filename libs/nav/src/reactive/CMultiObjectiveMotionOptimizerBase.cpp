@@ -30,99 +30,45 @@ int CMultiObjectiveMotionOptimizerBase::decide(
 {
 	auto& score_values = extra_info.score_values;
 	score_values.resize(movs.size());
-
-	// For each movement:
-	for (unsigned int mov_idx = 0; mov_idx < movs.size(); ++mov_idx)
+	const size_t nMovs = movs.size();
+
+	// Values of all variables for all movements, as arrays for batch
+	// evaluation. Mark all values as NaN so we detect uninitialized values:
+	std::map<std::string, std::vector<double>> var_values;
+	for (const auto& p : m_expr_vars)
+		var_values[p.first].assign(
+			nMovs, std::numeric_limits<double>::quiet_NaN());
+	for (unsigned int mov_idx = 0; mov_idx < nMovs; ++mov_idx)
 	{
-		const auto& m = movs[mov_idx];
-
-		// Mark all vars as NaN so we detect uninitialized values:
-		for (auto& p : m_expr_vars)
-		{
-			p.second = std::numeric_limits<double>::quiet_NaN();
-		}
-
-		for (const auto& prop : m.props)
+		for (const auto& prop : movs[mov_idx].props)
 		{
-			double& var = m_expr_vars[prop.first];
-			var = prop.second;
-		}
-
-		// Upon first iteration: compile expressions
-		if (m_score_exprs.size() != m_params_base.formula_score.size())
-		{
-			m_score_exprs.clear();
-
-			for (const auto& f : m_params_base.formula_score)
+			auto& vals = var_values[prop.first];
+			if (vals.empty())
 			{
-				auto& se = m_score_exprs[f.first];
-				try
-				{
-					se.compile(
-						f.second, m_expr_vars,
-						std::string("score: ") + f.first);
-				}
-				catch (std::exception&)
-				{
-					m_score_exprs.clear();
-					throw;  // rethrow
-				}
-
-				// Register formulas also as variables, usable by the assert()
-				// expressions:
-				{
-					auto it = m_expr_vars.find(f.first);
-					if (it != m_expr_vars.end())
-					{
-						THROW_EXCEPTION_FMT(
-							"Error: Expression name `%s` already exists as an "
-							"input variable.",
-							f.first.c_str());
-					}
-					// Add it:
-					m_expr_vars[f.first] =
-						std::numeric_limits<double>::quiet_NaN();
-				}
+				vals.assign(nMovs, std::numeric_limits<double>::quiet_NaN());
+				m_expr_vars[prop.first] = vals[0];  // Register new variable
 			}
-		}  // end for each score expr
+			vals[mov_idx] = prop.second;
+		}
 
-		// Upon first iteration: compile expressions
-		if (m_movement_assert_exprs.size() !=
-			m_params_base.movement_assert.size())
-		{
-			const size_t N = m_params_base.movement_assert.size();
-			m_movement_assert_exprs.clear();
-			m_movement_assert_exprs.resize(N);
-			for (size_t i = 0; i < N; i++)
-			{
-				const auto& str = m_params_base.movement_assert[i];
-				auto& ce = m_movement_assert_exprs[i];
+		// Upon first iteration: compile expressions, after registering all
+		// the variables of this movement:
+		if (mov_idx == 0) internal_compile_exprs();
+	}
+	std::map<std::string, const double*> batch_vars;
+	for (const auto& v : var_values) batch_vars[v.first] = v.second.data();
 
-				try
-				{
-					ce.compile(str, m_expr_vars, "assert");
-				}
-				catch (std::exception&)
-				{
-					m_movement_assert_exprs.clear();
-					throw;  // rethrow
-				}
-			}
-		}
+	// For each score: evaluate it for all movements
+	std::vector<double> vals;
+	for (auto& sc : m_score_exprs)
+	{
+		sc.second.eval_batch(batch_vars, nMovs, vals);
 
-		// For each score: evaluate it
-		for (auto& sc : m_score_exprs)
+		for (unsigned int mov_idx = 0; mov_idx < nMovs; ++mov_idx)
 		{
-			// Evaluate:
-			double val;
-			if (m.speed <= 0)  // Invalid candidate
-			{
-				val = .0;
-			}
-			else
-			{
-				val = sc.second.eval();
-			}
+			const double val = (movs[mov_idx].speed <= 0)  // Invalid candidate
+								   ? .0
+								   : vals[mov_idx];
 
 			if (val != val /* NaN */)
 			{
@@ -134,7 +80,7 @@ int CMultiObjectiveMotionOptimizerBase::decide(
 			// Store:
 			score_values[mov_idx][sc.first] = val;
 		}
-	}  // end for mov_idx
+	}
 
 	// Optional score post-processing: normalize highest value to 1.0
 	for (const auto& sScoreName : m_params_base.scores_to_normalize)
@@ -175,34 +121,28 @@ int CMultiObjectiveMotionOptimizerBase::decide(
 	}
 
 	// For each assert, evaluate it (*after* score normalization)
-	for (unsigned int mov_idx = 0; mov_idx < movs.size(); ++mov_idx)
-	{
-		const auto& m = movs[mov_idx];
-		// Mark all vars as NaN so we detect uninitialized values:
-		for (auto& p : m_expr_vars)
-		{
-			p.second = std::numeric_limits<double>::quiet_NaN();
-		}
-		for (const auto& prop : m.props)
-		{
-			double& var = m_expr_vars[prop.first];
-			var = prop.second;
-		}
+	std::vector<std::vector<double>> assert_values(
+		m_movement_assert_exprs.size());
+	for (size_t i = 0; i < m_movement_assert_exprs.size(); i++)
+		m_movement_assert_exprs[i].eval_batch(
+			batch_vars, nMovs, assert_values[i]);
 
+	for (unsigned int mov_idx = 0; mov_idx < nMovs; ++mov_idx)
+	{
 		bool assert_failed = false;
+		for (size_t i = 0; i < m_movement_assert_exprs.size(); i++)
 		{
-			for (auto& ma : m_movement_assert_exprs)
+			if (assert_values[i][mov_idx] == 0)
 			{
-				const double val = ma.eval();
-				if (val == 0)
-				{
-					assert_failed = true;
-					extra_info.log_entries.emplace_back(mrpt::format(
-						"[CMultiObjectiveMotionOptimizerBase] "
-						"mov_idx=%u ASSERT failed: `%s`",
-						mov_idx, ma.get_original_expression().c_str()));
-					break;
-				}
+				assert_failed = true;
+				extra_info.log_entries.emplace_back(mrpt::format(
+					"[CMultiObjectiveMotionOptimizerBase] "
+					"mov_idx=%u ASSERT failed: `%s`",
+					mov_idx,
+					m_movement_assert_exprs[i]
+						.get_original_expression()
+						.c_str()));
+				break;
 			}
 		}
 		if (assert_failed)
@@ -218,6 +158,66 @@ int CMultiObjectiveMotionOptimizerBase::decide(
 	return impl_decide(movs, extra_info);
 }
 
+void CMultiObjectiveMotionOptimizerBase::internal_compile_exprs()
+{
+	if (m_score_exprs.size() != m_params_base.formula_score.size())
+	{
+		m_score_exprs.clear();
+
+		for (const auto& f : m_params_base.formula_score)
+		{
+			auto& se = m_score_exprs[f.first];
+			try
+			{
+				se.compile(
+					f.second, m_expr_vars, std::string("score: ") + f.first);
+			}
+			catch (std::exception&)
+			{
+				m_score_exprs.clear();
+				throw;  // rethrow
+			}
+
+			// Register formulas also as variables, usable by the assert()
+			// expressions:
+			{
+				auto it = m_expr_vars.find(f.first);
+				if (it != m_expr_vars.end())
+				{
+					THROW_EXCEPTION_FMT(
+						"Error: Expression name `%s` already exists as an "
+						"input variable.",
+						f.first.c_str());
+				}
+				// Add it:
+				m_expr_vars[f.first] = std::numeric_limits<double>::quiet_NaN();
+			}
+		}
+	}  // end for each score expr
+
+	if (m_movement_assert_exprs.size() != m_params_base.movement_assert.size())
+	{
+		const size_t N = m_params_base.movement_assert.size();
+		m_movement_assert_exprs.clear();
+		m_movement_assert_exprs.resize(N);
+		for (size_t i = 0; i < N; i++)
+		{
+			const auto& str = m_params_base.movement_assert[i];
+			auto& ce = m_movement_assert_exprs[i];
+
+			try
+			{
+				ce.compile(str, m_expr_vars, "assert");
+			}
+			catch (std::exception&)
+			{
+				m_movement_assert_exprs.clear();
+				throw;  // rethrow
+			}
+		}
+	}
+}
+
 void CMultiObjectiveMotionOptimizerBase::clear() { m_score_exprs.clear(); }
 CMultiObjectiveMotionOptimizerBase::Ptr
 	CMultiObjectiveMotionOptimizerBase::Factory(
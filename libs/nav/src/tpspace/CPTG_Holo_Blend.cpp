@@ -55,9 +55,9 @@ double CPTG_Holo_Blend::eps = 1e-4;  // epsilon for detecting 1/0 situation
 #define COMMON_PTG_DESIGN_PARAMS                                   \
 	const double vxi = m_nav_dyn_state.curVelLocal.vx,             \
 				 vyi = m_nav_dyn_state.curVelLocal.vy;             \
-	const double vf_mod = internal_get_v(dir);                     \
+	const double vf_mod = internal_get_v_by_k(k);                  \
 	const double vxf = vf_mod * cos(dir), vyf = vf_mod * sin(dir); \
-	const double T_ramp = internal_get_T_ramp(dir);
+	const double T_ramp = internal_get_T_ramp_by_k(k);
 
 #if 0
 static double calc_trans_distance_t_below_Tramp_abc_analytic(double t, double a, double b, double c)
@@ -414,7 +414,9 @@ bool CPTG_Holo_Blend::PTG_IsIntoDomain(double x, double y) const
 
 void CPTG_Holo_Blend::internal_deinitialize()
 {
-	// Nothing to do in a closed-form PTG.
+	m_v_by_k.clear();
+	m_w_by_k.clear();
+	m_T_ramp_by_k.clear();
 }
 
 mrpt::kinematics::CVehicleVelCmd::Ptr CPTG_Holo_Blend::directionToMotionCommand(
@@ -424,10 +426,10 @@ mrpt::kinematics::CVehicleVelCmd::Ptr CPTG_Holo_Blend::directionToMotionCommand(
 
 	mrpt::kinematics::CVehicleVelCmd_Holo* cmd =
 		new mrpt::kinematics::CVehicleVelCmd_Holo();
-	cmd->vel = internal_get_v(dir_local);
+	cmd->vel = internal_get_v_by_k(k);
 	cmd->dir_local = dir_local;
-	cmd->ramp_time = internal_get_T_ramp(dir_local);
-	cmd->rot_speed = mrpt::signWithZero(dir_local) * internal_get_w(dir_local);
+	cmd->ramp_time = internal_get_T_ramp_by_k(k);
+	cmd->rot_speed = mrpt::signWithZero(dir_local) * internal_get_w_by_k(k);
 
 	return mrpt::kinematics::CVehicleVelCmd::Ptr(cmd);
 }
@@ -459,7 +461,7 @@ void CPTG_Holo_Blend::getPathPose(
 	const double t = PATH_TIME_STEP * step;
 	const double dir = CParameterizedTrajectoryGenerator::index2alpha(k);
 	COMMON_PTG_DESIGN_PARAMS;
-	const double wf = mrpt::signWithZero(dir) * this->internal_get_w(dir);
+	const double wf = mrpt::signWithZero(dir) * this->internal_get_w_by_k(k);
 	const double TR2_ = 1.0 / (2 * T_ramp);
 
 	// Translational part:
@@ -839,6 +841,20 @@ double CPTG_Holo_Blend::internal_get_T_ramp(const double dir) const
 	return m_expr_T_ramp.eval();
 }
 
+double CPTG_Holo_Blend::internal_get_v_by_k(uint16_t k) const
+{
+	return k < m_v_by_k.size() ? m_v_by_k[k] : internal_get_v(index2alpha(k));
+}
+double CPTG_Holo_Blend::internal_get_w_by_k(uint16_t k) const
+{
+	return k < m_w_by_k.size() ? m_w_by_k[k] : internal_get_w(index2alpha(k));
+}
+double CPTG_Holo_Blend::internal_get_T_ramp_by_k(uint16_t k) const
+{
+	return k < m_T_ramp_by_k.size() ? m_T_ramp_by_k[k]
+									 : internal_get_T_ramp(index2alpha(k));
+}
+
 void CPTG_Holo_Blend::internal_initialize(
 	const std::string& cacheFilename, const bool verbose)
 {
@@ -855,6 +871,17 @@ void CPTG_Holo_Blend::internal_initialize(
 	m_expr_T_ramp.compile(
 		expr_T_ramp, std::map<std::string, double>(), "expr_T_ramp");
 
+	// Evaluate them for the directions of all paths at once:
+	std::vector<double> dirs(m_alphaValuesCount);
+	for (uint16_t k = 0; k < m_alphaValuesCount; k++)
+		dirs[k] = CParameterizedTrajectoryGenerator::index2alpha(k);
+	const std::map<std::string, const double*> dir_values{{"dir", &dirs[0]}};
+	m_expr_v.eval_batch(dir_values, dirs.size(), m_v_by_k);
+	m_expr_w.eval_batch(dir_values, dirs.size(), m_w_by_k);
+	m_expr_T_ramp.eval_batch(dir_values, dirs.size(), m_T_ramp_by_k);
+	for (auto& v : m_v_by_k) v = std::abs(v);
+	for (auto& w : m_w_by_k) w = std::abs(w);
+
 #ifdef DO_PERFORMANCE_BENCHMARK
 	tl.dumpAllStats();
 #endif
@@ -20,6 +20,7 @@
 #include <mrpt/maps/metric_map_types.h>
 #include <mrpt/obs/obs_frwds.h>
 #include <deque>
+#include <vector>
 
 namespace mrpt::maps
 {
@@ -68,6 +69,19 @@ class CMetricMap : public mrpt::serialization::CSerializable,
 	virtual double internal_computeObservationLikelihood(
 		const mrpt::obs::CObservation* obs,
 		const mrpt::poses::CPose3D& takenFrom) = 0;
+
+   protected:
+	/** Internal method called by computeObservationLikelihoods(). The
+	 * default implementation calls internal_computeObservationLikelihood()
+	 * for each pose. Maps may override it to share among all the poses the
+	 * work which does not depend on them.
+	 * \param[out] out_log_liks An array of takenFrom.size() elements. */
+	virtual void internal_computeObservationLikelihoods(
+		const mrpt::obs::CObservation* obs,
+		const std::vector<mrpt::poses::CPose3D>& takenFrom,
+		double* out_log_liks);
+
+   private:
 	/** Internal method called by canComputeObservationLikelihood() */
 	virtual bool internal_canComputeObservationLikelihood(
 		const mrpt::obs::CObservation* obs) const
@@ -147,6 +161,21 @@ class CMetricMap : public mrpt::serialization::CSerializable,
 		const mrpt::obs::CObservation* obs,
 		const mrpt::poses::CPose2D& takenFrom);
 
+	/** Computes the log-likelihood of a given observation for each robot pose
+	 * in a set (e.g. all the particles of a particle filter). The result is
+	 * the same than calling computeObservationLikelihood() for each pose, but
+	 * some maps evaluate all the poses at once much faster.
+	 *
+	 * \param obs The observation.
+	 * \param takenFrom The robot poses the observation may be taken from.
+	 * \param out_log_liks Output log-likelihoods, one per pose.
+	 * \sa computeObservationLikelihood
+	 */
+	void computeObservationLikelihoods(
+		const mrpt::obs::CObservation* obs,
+		const std::vector<mrpt::poses::CPose3D>& takenFrom,
+		std::vector<double>& out_log_liks);
+
 	/** Returns true if this map is able to compute a sensible likelihood
 	 * function for this observation (i.e. an occupancy grid map cannot with an
 	 * image).  See: \ref maps_observations
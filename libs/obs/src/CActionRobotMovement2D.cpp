@@ -499,36 +499,39 @@ void CActionRobotMovement2D::computeFromOdometry_modelThrun(
 	float Atrans = odometryIncrement.norm();
 	float Arot2 = math::wrapToPi(odometryIncrement.phi() - Arot1);
 
+	// Draw all the required normalized samples at once, 6 per particle:
+	const size_t N = o.thrunModel.nParticlesCount;
+	std::vector<float> rnds(6 * N);
+	if (N) getRandomGenerator().drawGaussian1DBatch(&rnds[0], rnds.size());
+
 	// Draw samples:
-	for (size_t i = 0; i < o.thrunModel.nParticlesCount; i++)
+	for (size_t i = 0; i < N; i++)
 	{
+		const float* rnd = &rnds[6 * i];
 		float Arot1_draw = Arot1 -
 						   (o.thrunModel.alfa1_rot_rot * fabs(Arot1) +
 							o.thrunModel.alfa2_rot_trans * Atrans) *
-							   getRandomGenerator().drawGaussian1D_normalized();
+							   rnd[0];
 		float Atrans_draw =
 			Atrans -
 			(o.thrunModel.alfa3_trans_trans * Atrans +
 			 o.thrunModel.alfa4_trans_rot * (fabs(Arot1) + fabs(Arot2))) *
-				getRandomGenerator().drawGaussian1D_normalized();
+				rnd[1];
 		float Arot2_draw = Arot2 -
 						   (o.thrunModel.alfa1_rot_rot * fabs(Arot2) +
 							o.thrunModel.alfa2_rot_trans * Atrans) *
-							   getRandomGenerator().drawGaussian1D_normalized();
+							   rnd[2];
 
 		// Output:
 		aux->m_particles[i].d.x =
 			Atrans_draw * cos(Arot1_draw) +
-			motionModelConfiguration.thrunModel.additional_std_XY *
-				getRandomGenerator().drawGaussian1D_normalized();
+			motionModelConfiguration.thrunModel.additional_std_XY * rnd[3];
 		aux->m_particles[i].d.y =
 			Atrans_draw * sin(Arot1_draw) +
-			motionModelConfiguration.thrunModel.additional_std_XY *
-				getRandomGenerator().drawGaussian1D_normalized();
-		aux->m_particles[i].d.phi = 
+			motionModelConfiguration.thrunModel.additional_std_XY * rnd[4];
+		aux->m_particles[i].d.phi =
 			Arot1_draw + Arot2_draw +
-			motionModelConfiguration.thrunModel.additional_std_phi *
-				getRandomGenerator().drawGaussian1D_normalized();
+			motionModelConfiguration.thrunModel.additional_std_phi * rnd[5];
 		aux->m_particles[i].d.normalizePhi();
 	}
 }
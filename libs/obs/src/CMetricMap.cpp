@@ -177,6 +177,26 @@ float CMetricMap::squareDistanceToClosestCorrespondence(
 	MRPT_END
 }
 
+void CMetricMap::computeObservationLikelihoods(
+	const mrpt::obs::CObservation* obs,
+	const std::vector<mrpt::poses::CPose3D>& takenFrom,
+	std::vector<double>& out_log_liks)
+{
+	out_log_liks.assign(takenFrom.size(), 0.0);
+	if (genericMapParams.enableObservationLikelihood && !takenFrom.empty())
+		internal_computeObservationLikelihoods(
+			obs, takenFrom, &out_log_liks[0]);
+}
+
+void CMetricMap::internal_computeObservationLikelihoods(
+	const mrpt::obs::CObservation* obs,
+	const std::vector<mrpt::poses::CPose3D>& takenFrom, double* out_log_liks)
+{
+	for (size_t i = 0; i < takenFrom.size(); i++)
+		out_log_liks[i] =
+			internal_computeObservationLikelihood(obs, takenFrom[i]);
+}
+
 bool CMetricMap::canComputeObservationLikelihood(
 	const mrpt::obs::CObservation* obs) const
 {
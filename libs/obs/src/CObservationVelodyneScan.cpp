@@ -502,59 +502,56 @@ void CObservationVelodyneScan::generatePointCloudAlongSE3Trajectory(
 		out_points.size() +
 		scan_packets.size() * BLOCKS_PER_PACKET * SCANS_PER_BLOCK + 16);
 
+	// Points are first collected in local coordinates, then the vehicle
+	// poses are interpolated in one batch for all their timestamps:
 	struct PointCloudStorageWrapper_SE3_Interp : public PointCloudStorageWrapper
 	{
-		CObservationVelodyneScan& me_;
-		const mrpt::poses::CPose3DInterpolator& vehicle_path_;
-		std::vector<mrpt::math::TPointXYZIu8>& out_points_;
-		TGeneratePointCloudSE3Results& results_stats_;
-		mrpt::system::TTimeStamp last_query_tim_;
-		mrpt::poses::CPose3D last_query_;
-		bool last_query_valid_;
-
-		PointCloudStorageWrapper_SE3_Interp(
-			CObservationVelodyneScan& me,
-			const mrpt::poses::CPose3DInterpolator& vehicle_path,
-			std::vector<mrpt::math::TPointXYZIu8>& out_points,
-			TGeneratePointCloudSE3Results& results_stats)
-			: me_(me),
-			  vehicle_path_(vehicle_path),
-			  out_points_(out_points),
-			  results_stats_(results_stats),
-			  last_query_tim_(INVALID_TIMESTAMP),
-			  last_query_valid_(false)
-		{
-		}
+		std::vector<mrpt::math::TPointXYZIu8> local_points_;
+		// Distinct consecutive timestamps, and index of each point's one:
+		std::vector<mrpt::system::TTimeStamp> query_tims_;
+		std::vector<size_t> point_tim_idx_;
+
 		void add_point(
 			double pt_x, double pt_y, double pt_z, uint8_t pt_intensity,
 			const mrpt::system::TTimeStamp& tim, const float azimuth) override
 		{
-			// Use a cache since it's expected that the same timestamp is
-			// queried several times in a row:
-			if (last_query_tim_ != tim)
-			{
-				last_query_tim_ = tim;
-				vehicle_path_.interpolate(tim, last_query_, last_query_valid_);
-			}
-
-			if (last_query_valid_)
-			{
-				mrpt::poses::CPose3D global_sensor_pose(
-					mrpt::poses::UNINITIALIZED_POSE);
-				global_sensor_pose.composeFrom(last_query_, me_.sensorPose);
-				double gx, gy, gz;
-				global_sensor_pose.composePoint(pt_x, pt_y, pt_z, gx, gy, gz);
-				out_points_.push_back(
-					mrpt::math::TPointXYZIu8(gx, gy, gz, pt_intensity));
-				++results_stats_.num_correctly_inserted_points;
-			}
-			++results_stats_.num_points;
+			// It's expected that the same timestamp comes several times in
+			// a row:
+			if (query_tims_.empty() || query_tims_.back() != tim)
+				query_tims_.push_back(tim);
+			local_points_.emplace_back(pt_x, pt_y, pt_z, pt_intensity);
+			point_tim_idx_.push_back(query_tims_.size() - 1);
 		}
 	};
 
-	PointCloudStorageWrapper_SE3_Interp my_pc_wrap(
-		*this, vehicle_path, out_points, results_stats);
+	PointCloudStorageWrapper_SE3_Interp my_pc_wrap;
 	velodyne_scan_to_pointcloud(*this, params, my_pc_wrap);
+
+	std::vector<mrpt::math::TPose3D> vehicle_poses;
+	std::vector<bool> vehicle_poses_valid;
+	vehicle_path.interpolate(
+		my_pc_wrap.query_tims_, vehicle_poses, vehicle_poses_valid);
+
+	mrpt::poses::CPose3D global_sensor_pose(mrpt::poses::UNINITIALIZED_POSE);
+	size_t last_tim_idx = std::numeric_limits<size_t>::max();
+	for (size_t i = 0; i < my_pc_wrap.local_points_.size(); i++)
+	{
+		++results_stats.num_points;
+		const size_t tim_idx = my_pc_wrap.point_tim_idx_[i];
+		if (!vehicle_poses_valid[tim_idx]) continue;
+		if (tim_idx != last_tim_idx)
+		{
+			last_tim_idx = tim_idx;
+			global_sensor_pose.composeFrom(
+				mrpt::poses::CPose3D(vehicle_poses[tim_idx]), sensorPose);
+		}
+		const auto& pt = my_pc_wrap.local_points_[i];
+		double gx, gy, gz;
+		global_sensor_pose.composePoint(pt.pt.x, pt.pt.y, pt.pt.z, gx, gy, gz);
+		out_points.push_back(
+			mrpt::math::TPointXYZIu8(gx, gy, gz, pt.intensity));
+		++results_stats.num_correctly_inserted_points;
+	}
 }
 
 void CObservationVelodyneScan::TPointCloud::clear()
@@ -0,0 +1,196 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+#pragma once
+
+#include <mrpt/math/lightweight_geom_data.h>
+#include <mrpt/poses/CPose3D.h>
+#include <cstdint>
+#include <vector>
+
+namespace mrpt::opengl
+{
+/** A bounding volume hierarchy (BVH) of axis-aligned boxes, used to
+ * accelerate ray tracing against large sets of primitives (e.g. the
+ * triangles of a CMesh or a CSetOfTriangles): each ray only visits the
+ * primitives whose boxes it actually crosses, i.e. O(log N) instead of O(N)
+ * on average.
+ *
+ * The hierarchy is built by recursively splitting the primitives by the
+ * median of their centers along the longest axis. Nodes are stored in one
+ * contiguous vector in depth-first order.
+ *
+ * \sa CSetOfTriangles::traceRay(), CMesh::traceRay(),
+ * COpenGLScene::traceRays()
+ * \ingroup mrpt_opengl_grp
+ */
+class CBoundingVolumeHierarchy
+{
+   public:
+	struct TNode
+	{
+		float bb_min[3], bb_max[3];
+		/** For leaves: index of its first primitive in primitiveIndices();
+		 * for inner nodes: index of the second child (the first one is
+		 * always the next node). */
+		uint32_t offset{0};
+		/** Number of primitives for leaves, 0 for inner nodes. */
+		uint32_t count{0};
+	};
+
+	/** Builds the hierarchy for N primitives, given their bounding boxes.
+	 * \param max_leaf_size Max number of primitives in a leaf. */
+	void build(
+		const std::vector<mrpt::math::TPoint3Df>& bb_mins,
+		const std::vector<mrpt::math::TPoint3Df>& bb_maxs,
+		const size_t max_leaf_size = 4);
+
+	/** Builds the hierarchy for N triangles, with `tri(i)` returning an
+	 * object with `x[3], y[3], z[3]` vertex coordinates, like
+	 * CSetOfTriangles::TTriangle. */
+	template <class TRIANGLE_GETTER>
+	void buildForTriangles(const size_t N, TRIANGLE_GETTER&& tri)
+	{
+		std::vector<mrpt::math::TPoint3Df> bb_mins(N), bb_maxs(N);
+		for (size_t i = 0; i < N; i++)
+		{
+			const auto& t = tri(i);
+			for (int k = 0; k < 3; k++)
+			{
+				bb_mins[i][0] = k ? std::min(bb_mins[i][0], t.x[k]) : t.x[0];
+				bb_mins[i][1] = k ? std::min(bb_mins[i][1], t.y[k]) : t.y[0];
+				bb_mins[i][2] = k ? std::min(bb_mins[i][2], t.z[k]) : t.z[0];
+				bb_maxs[i][0] = k ? std::max(bb_maxs[i][0], t.x[k]) : t.x[0];
+				bb_maxs[i][1] = k ? std::max(bb_maxs[i][1], t.y[k]) : t.y[0];
+				bb_maxs[i][2] = k ? std::max(bb_maxs[i][2], t.z[k]) : t.z[0];
+			}
+		}
+		build(bb_mins, bb_maxs);
+	}
+
+	void clear()
+	{
+		m_nodes.clear();
+		m_indices.clear();
+	}
+	bool empty() const { return m_nodes.empty(); }
+	const std::vector<TNode>& nodes() const { return m_nodes; }
+	const std::vector<uint32_t>& primitiveIndices() const { return m_indices; }
+
+	/** Finds the closest intersection of a ray with the primitives.
+	 * \param origin,dir The ray, with `dir` a unit vector.
+	 * \param[in,out] dist On input, the max distance to look for hits; on
+	 * output, the distance to the closest hit, if any.
+	 * \param hit A functor `bool(size_t idx, double& dist)` to test the
+	 * intersection of the ray with the primitive `idx`, which must only
+	 * return true (and update dist) if it is closer than `dist`.
+	 * \return true if any primitive was hit.
+	 */
+	template <class HIT_TEST>
+	bool traceRay(
+		const mrpt::math::TPoint3D& origin, const mrpt::math::TPoint3D& dir,
+		double& dist, HIT_TEST&& hit) const
+	{
+		if (m_nodes.empty()) return false;
+		const double inv_dir[3] = {1.0 / dir.x, 1.0 / dir.y, 1.0 / dir.z};
+
+		bool found = false;
+		double t_near;
+		uint32_t stack[64];
+		int stack_size = 0;
+		if (!rayBoxIntersection(origin, inv_dir, m_nodes[0], dist, t_near))
+			return false;
+		stack[stack_size++] = 0;
+		while (stack_size)
+		{
+			const uint32_t n = stack[--stack_size];
+			const TNode& node = m_nodes[n];
+			if (node.count)
+			{
+				for (uint32_t i = 0; i < node.count; i++)
+					if (hit(m_indices[node.offset + i], dist)) found = true;
+				continue;
+			}
+			// Visit the closest child first:
+			uint32_t c1 = n + 1, c2 = node.offset;
+			double t1, t2;
+			bool hit1 =
+				rayBoxIntersection(origin, inv_dir, m_nodes[c1], dist, t1);
+			bool hit2 =
+				rayBoxIntersection(origin, inv_dir, m_nodes[c2], dist, t2);
+			if (hit1 && hit2 && t2 < t1) std::swap(c1, c2);
+			if (hit1 && hit2)
+			{
+				stack[stack_size++] = c2;
+				stack[stack_size++] = c1;
+			}
+			else if (hit1)
+				stack[stack_size++] = c1;
+			else if (hit2)
+				stack[stack_size++] = c2;
+		}
+		return found;
+	}
+
+	/** Like traceRay(), for a hierarchy built with buildForTriangles(), and
+	 * the ray given as the X axis of a pose (the convention of
+	 * CRenderizable::traceRay()), in the frame of the triangles.
+	 * \return true if any triangle is hit, with its distance in `dist`. */
+	template <class TRIANGLE_GETTER>
+	bool traceRayTriangles(
+		const mrpt::poses::CPose3D& ray, double& dist,
+		TRIANGLE_GETTER&& tri) const
+	{
+		const auto& R = ray.getRotationMatrix();
+		const mrpt::math::TPoint3D origin(ray.x(), ray.y(), ray.z());
+		const mrpt::math::TPoint3D dir(R(0, 0), R(1, 0), R(2, 0));
+		dist = HUGE_VAL;
+		return traceRay(origin, dir, dist, [&](size_t i, double& d) {
+			const auto& t = tri(i);
+			double t_hit;
+			if (!rayTriangleIntersection(origin, dir, t.x, t.y, t.z, t_hit) ||
+				t_hit > d)
+				return false;
+			d = t_hit;
+			return true;
+		});
+	}
+
+	/** Ray-box intersection (slab method), for hits in [0,max_dist].
+	 * \param[out] t_near The distance at which the ray enters the box. */
+	static bool rayBoxIntersection(
+		const mrpt::math::TPoint3D& origin, const double inv_dir[3],
+		const TNode& box, const double max_dist, double& t_near)
+	{
+		double t0 = 0, t1 = max_dist;
+		for (int k = 0; k < 3; k++)
+		{
+			double ta = (box.bb_min[k] - origin[k]) * inv_dir[k];
+			double tb = (box.bb_max[k] - origin[k]) * inv_dir[k];
+			if (ta > tb) std::swap(ta, tb);
+			// (Written so NaNs, from 0*inf, do not discard the box)
+			if (!(ta <= t0)) t0 = ta;
+			if (!(tb >= t1)) t1 = tb;
+			if (t0 > t1) return false;
+		}
+		t_near = t0;
+		return true;
+	}
+
+	/** Ray-triangle intersection (Moller-Trumbore), for hits at a distance
+	 * t>=0 along the unit vector `dir`. */
+	static bool rayTriangleIntersection(
+		const mrpt::math::TPoint3D& origin, const mrpt::math::TPoint3D& dir,
+		const float xs[3], const float ys[3], const float zs[3], double& t);
+
+   private:
+	std::vector<TNode> m_nodes;
+	std::vector<uint32_t> m_indices;
+};
+
+}  // namespace mrpt::opengl
@@ -149,6 +149,7 @@ class CGeneralizedCylinder : public CRenderizableDisplayList
 	 * \sa mrpt::opengl::CRenderizable.
 	 */
 	bool traceRay(const mrpt::poses::CPose3D& o, double& dist) const override;
+	void prepareForRayTracing() const override;
 	/**
 	 * Get axis's spatial coordinates.
 	 */
@@ -97,6 +97,9 @@ class CMesh : public CRenderizableDisplayList
 	// structure for ray tracing) needs to be
 	// recalculated
 	mutable std::vector<mrpt::math::TPolygonWithPlane> tmpPolys;
+	/** Bounding volume hierarchy of the triangles, for fast ray tracing.
+	 * Updated together with tmpPolys. */
+	mutable CBoundingVolumeHierarchy m_bvh;
 
    public:
 	void setGridLimits(float xmin, float xmax, float ymin, float ymax)
@@ -249,6 +252,7 @@ class CMesh : public CRenderizableDisplayList
 	/** Trace ray
 	  */
 	bool traceRay(const mrpt::poses::CPose3D& o, double& dist) const override;
+	void prepareForRayTracing() const override;
 
 	/** Constructor  */
 	CMesh(
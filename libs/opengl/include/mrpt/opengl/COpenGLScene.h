@@ -207,6 +207,19 @@ class COpenGLScene : public mrpt::serialization::CSerializable
 	 */
 	bool traceRay(const mrpt::poses::CPose3D& o, double& dist) const;
 
+	/** Traces a batch of rays, e.g. all the rays of a simulated range
+	 * sensor, in parallel. Each ray is the X axis of a pose, as in
+	 * traceRay().
+	 * \param[out] dists The distance of each ray to the closest object, or
+	 * HUGE_VAL for rays which do not hit anything.
+	 * \return The number of rays which hit some object.
+	 * \note CRenderizable::prepareForRayTracing() is called for all the
+	 * objects before tracing the rays, in several threads.
+	 */
+	size_t traceRays(
+		const std::vector<mrpt::poses::CPose3D>& rays,
+		std::vector<double>& dists) const;
+
 	/** Evaluates the bounding box of the scene in the given viewport (default:
 	 * "main"). */
 	void getBoundingBox(
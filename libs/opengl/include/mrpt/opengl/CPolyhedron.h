@@ -656,6 +656,7 @@ class CPolyhedron : public CRenderizableDisplayList
 	 * \sa CRenderizable
 	 */
 	bool traceRay(const mrpt::poses::CPose3D& o, double& dist) const override;
+	void prepareForRayTracing() const override;
 	/**
 	 * Gets a list with the polyhedron's vertices.
 	 */
@@ -274,9 +274,18 @@ class CRenderizable : public mrpt::serialization::CSerializable
 	 * effectively collisions with the object (returning the distance to the
 	 * origin of the ray in "dist"), or false in other case. "dist" variable
 	 * yields undefined behaviour when false is returned
+	 *
+	 * Once prepareForRayTracing() has been called, and until the object is
+	 * modified, this method must not modify the object, so it can be called
+	 * from several threads at once (see COpenGLScene::traceRays()).
 	 */
 	virtual bool traceRay(const mrpt::poses::CPose3D& o, double& dist) const;
 
+	/** Updates the auxiliary data used by traceRay() (polygons, bounding
+	 * volume hierarchies...), if outdated. Derived classes with such data
+	 * must override it. \sa traceRay */
+	virtual void prepareForRayTracing() const;
+
 	/** This method is safe for calling from within ::render() methods \sa
 	 * renderTextBitmap, mrpt::opengl::gl_utils */
 	static void renderTextBitmap(const char* str, void* fontStyle);
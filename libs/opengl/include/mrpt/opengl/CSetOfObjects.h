@@ -104,6 +104,7 @@ class CSetOfObjects : public CRenderizable
 
 	bool traceRay(
 		const mrpt::poses::CPose3D& o, double& dist) const override;
+	void prepareForRayTracing() const override;
 
 	CRenderizable& setColor_u8(const mrpt::img::TColor& c) override;
 	CRenderizable& setColorR_u8(const uint8_t r) override;
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <mrpt/opengl/CRenderizableDisplayList.h>
+#include <mrpt/opengl/CBoundingVolumeHierarchy.h>
 #include <mrpt/math/geometry.h>
 
 namespace mrpt::opengl
@@ -72,6 +73,11 @@ class CSetOfTriangles : public CRenderizableDisplayList
 	 * Polygon cache.
 	 */
 	mutable std::vector<mrpt::math::TPolygonWithPlane> tmpPolygons;
+	/**
+	 * Bounding volume hierarchy of the triangles, for fast ray tracing.
+	 * Updated together with the polygon cache.
+	 */
+	mutable CBoundingVolumeHierarchy m_bvh;
 
    public:
 	/**
@@ -154,6 +160,7 @@ class CSetOfTriangles : public CRenderizableDisplayList
 	/** Ray tracing
 	 */
 	bool traceRay(const mrpt::poses::CPose3D& o, double& dist) const override;
+	void prepareForRayTracing() const override;
 
 	/**
 	 * Gets the polygon cache.
@@ -75,6 +75,7 @@ class CTexturedPlane : public CTexturedObject
 
 	bool traceRay(
 		const mrpt::poses::CPose3D& o, double& dist) const override;
+	void prepareForRayTracing() const override;
 	void getBoundingBox(
 		mrpt::math::TPoint3D& bb_min,
 		mrpt::math::TPoint3D& bb_max) const override;
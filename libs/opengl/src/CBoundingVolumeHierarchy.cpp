@@ -0,0 +1,134 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include "opengl-precomp.h"  // Precompiled header
+
+#include <mrpt/opengl/CBoundingVolumeHierarchy.h>
+#include <algorithm>
+
+using namespace mrpt;
+using namespace mrpt::opengl;
+using namespace mrpt::math;
+
+void CBoundingVolumeHierarchy::build(
+	const std::vector<TPoint3Df>& bb_mins,
+	const std::vector<TPoint3Df>& bb_maxs, const size_t max_leaf_size)
+{
+	ASSERT_EQUAL_(bb_mins.size(), bb_maxs.size());
+	ASSERT_ABOVE_(max_leaf_size, 0U);
+	clear();
+	const size_t N = bb_mins.size();
+	if (!N) return;
+
+	m_indices.resize(N);
+	std::vector<TPoint3Df> centers(N);
+	for (size_t i = 0; i < N; i++)
+	{
+		m_indices[i] = static_cast<uint32_t>(i);
+		for (int k = 0; k < 3; k++)
+			centers[i][k] = 0.5f * (bb_mins[i][k] + bb_maxs[i][k]);
+	}
+	m_nodes.reserve(2 * N / max_leaf_size + 1);
+
+	// Recursively split [first,last) by the median of the centers along the
+	// longest axis of their bounding box:
+	struct TTask
+	{
+		uint32_t first, last;
+		// Index of the parent node, whose "offset" must point to this one if
+		// it's its second child (or -1):
+		int64_t parent_of_second;
+	};
+	std::vector<TTask> tasks;
+	tasks.push_back({0, static_cast<uint32_t>(N), -1});
+	while (!tasks.empty())
+	{
+		const TTask task = tasks.back();
+		tasks.pop_back();
+
+		const uint32_t node_idx = static_cast<uint32_t>(m_nodes.size());
+		if (task.parent_of_second >= 0)
+			m_nodes[task.parent_of_second].offset = node_idx;
+		m_nodes.emplace_back();
+
+		float c_min[3], c_max[3];
+		{
+			TNode& node = m_nodes.back();
+			for (int k = 0; k < 3; k++)
+			{
+				node.bb_min[k] = c_min[k] = std::numeric_limits<float>::max();
+				node.bb_max[k] = c_max[k] = -std::numeric_limits<float>::max();
+			}
+			for (uint32_t i = task.first; i < task.last; i++)
+			{
+				const uint32_t p = m_indices[i];
+				for (int k = 0; k < 3; k++)
+				{
+					node.bb_min[k] = std::min(node.bb_min[k], bb_mins[p][k]);
+					node.bb_max[k] = std::max(node.bb_max[k], bb_maxs[p][k]);
+					c_min[k] = std::min(c_min[k], centers[p][k]);
+					c_max[k] = std::max(c_max[k], centers[p][k]);
+				}
+			}
+		}
+
+		const uint32_t count = task.last - task.first;
+		int axis = 0;
+		for (int k = 1; k < 3; k++)
+			if (c_max[k] - c_min[k] > c_max[axis] - c_min[axis]) axis = k;
+
+		if (count <= max_leaf_size || c_max[axis] == c_min[axis])
+		{
+			m_nodes.back().offset = task.first;
+			m_nodes.back().count = count;
+			continue;
+		}
+
+		const uint32_t mid = task.first + count / 2;
+		std::nth_element(
+			m_indices.begin() + task.first, m_indices.begin() + mid,
+			m_indices.begin() + task.last, [&](uint32_t a, uint32_t b) {
+				return centers[a][axis] < centers[b][axis];
+			});
+
+		// Depth-first order: the first child goes right after this node, so
+		// it's popped first:
+		tasks.push_back({mid, task.last, node_idx});
+		tasks.push_back({task.first, mid, -1});
+	}
+}
+
+bool CBoundingVolumeHierarchy::rayTriangleIntersection(
+	const TPoint3D& origin, const TPoint3D& dir, const float xs[3],
+	const float ys[3], const float zs[3], double& t)
+{
+	const double e1[3] = {xs[1] - xs[0], ys[1] - ys[0], zs[1] - zs[0]};
+	const double e2[3] = {xs[2] - xs[0], ys[2] - ys[0], zs[2] - zs[0]};
+	// p = dir x e2
+	const double p[3] = {dir.y * e2[2] - dir.z * e2[1],
+						 dir.z * e2[0] - dir.x * e2[2],
+						 dir.x * e2[1] - dir.y * e2[0]};
+	const double det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+	if (std::abs(det) < 1e-12) return false;  // Parallel to the triangle
+	const double inv_det = 1.0 / det;
+
+	const double s[3] = {origin.x - xs[0], origin.y - ys[0], origin.z - zs[0]};
+	const double u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inv_det;
+	if (u < 0 || u > 1) return false;
+
+	// q = s x e1
+	const double q[3] = {s[1] * e1[2] - s[2] * e1[1],
+						 s[2] * e1[0] - s[0] * e1[2],
+						 s[0] * e1[1] - s[1] * e1[0]};
+	const double v = (dir.x * q[0] + dir.y * q[1] + dir.z * q[2]) * inv_det;
+	if (v < 0 || u + v > 1) return false;
+
+	t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inv_det;
+	return t >= 0;
+}
@@ -127,10 +127,15 @@ inline void createMesh(
 
 bool CGeneralizedCylinder::traceRay(const CPose3D& o, double& dist) const
 {
-	if (!meshUpToDate || !polysUpToDate) updatePolys();
+	prepareForRayTracing();
 	return math::traceRay(polys, (o - this->m_pose).asTPose(), dist);
 }
 
+void CGeneralizedCylinder::prepareForRayTracing() const
+{
+	if (!meshUpToDate || !polysUpToDate) updatePolys();
+}
+
 void CGeneralizedCylinder::updateMesh() const
 {
 	CRenderizableDisplayList::notifyChange();
@@ -551,9 +551,18 @@ void CMesh::setUV(
 }
 
 bool CMesh::traceRay(const mrpt::poses::CPose3D& o, double& dist) const
+{
+	prepareForRayTracing();
+	return m_bvh.traceRayTriangles(
+		o - this->m_pose, dist,
+		[this](size_t i) -> const CSetOfTriangles::TTriangle& {
+			return actualMesh[i].first;
+		});
+}
+
+void CMesh::prepareForRayTracing() const
 {
 	if (!trianglesUpToDate || !polygonsUpToDate) updatePolygons();
-	return mrpt::math::traceRay(tmpPolys, (o - this->m_pose).asTPose(), dist);
 }
 
 static math::TPolygon3D tmpPoly(3);
@@ -579,6 +588,10 @@ void CMesh::updatePolygons() const
 	transform(
 		actualMesh.begin(), actualMesh.end(), tmpPolys.begin(),
 		createPolygonFromTriangle);
+	m_bvh.buildForTriangles(
+		N, [this](size_t i) -> const CSetOfTriangles::TTriangle& {
+			return actualMesh[i].first;
+		});
 	polygonsUpToDate = true;
 	CRenderizableDisplayList::notifyChange();
 }
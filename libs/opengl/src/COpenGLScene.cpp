@@ -19,6 +19,9 @@
 
 #include "opengl_internals.h"
 
+#include <algorithm>
+#include <thread>
+
 using namespace mrpt;
 using namespace mrpt::opengl;
 using namespace mrpt::serialization::metaprogramming;
@@ -295,6 +298,50 @@ bool COpenGLScene::traceRay(const mrpt::poses::CPose3D& o, double& dist) const
 	return found;
 }
 
+size_t COpenGLScene::traceRays(
+	const std::vector<mrpt::poses::CPose3D>& rays,
+	std::vector<double>& dists) const
+{
+	const size_t N = rays.size();
+	dists.assign(N, HUGE_VAL);
+	if (!N) return 0;
+
+	// Objects build their ray-tracing caches (e.g. BVHs) lazily: build them
+	// all now, so traceRay() does not modify any object from the threads.
+	for (const auto& vp : m_viewports)
+		for (const auto& o : vp->m_objects) o->prepareForRayTracing();
+
+	std::vector<uint8_t> hits(N, 0);
+
+	auto traceChunk = [&](const size_t i0, const size_t i1) {
+		for (size_t i = i0; i < i1; i++)
+		{
+			double d;
+			if (traceRay(rays[i], d))
+			{
+				hits[i] = 1;
+				dists[i] = d;
+			}
+		}
+	};
+
+	const size_t MIN_RAYS_PER_THREAD = 64;
+	const size_t nThreads = std::max<size_t>(
+		1, std::min<size_t>(
+			   std::thread::hardware_concurrency(), N / MIN_RAYS_PER_THREAD));
+	if (nThreads == 1)
+		traceChunk(0, N);
+	else
+	{
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < nThreads; t++)
+			threads.emplace_back(
+				traceChunk, t * N / nThreads, (t + 1) * N / nThreads);
+		for (auto& th : threads) th.join();
+	}
+	return std::count(hits.begin(), hits.end(), 1);
+}
+
 bool COpenGLScene::saveToFile(const std::string& fil) const
 {
 	try
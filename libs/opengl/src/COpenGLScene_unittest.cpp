@@ -0,0 +1,121 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include <mrpt/opengl/COpenGLScene.h>
+#include <mrpt/opengl/CSetOfObjects.h>
+#include <mrpt/opengl/CSetOfTriangles.h>
+#include <mrpt/opengl/CSphere.h>
+#include <mrpt/random.h>
+#include <gtest/gtest.h>
+
+using namespace mrpt;
+using namespace mrpt::opengl;
+using namespace mrpt::math;
+using namespace mrpt::poses;
+using namespace std;
+
+// A set of random triangles, with a random pose:
+static CSetOfTriangles::Ptr randomTriangles(const size_t N)
+{
+	auto& rng = mrpt::random::getRandomGenerator();
+	auto obj = mrpt::make_aligned_shared<CSetOfTriangles>();
+	for (size_t i = 0; i < N; i++)
+	{
+		CSetOfTriangles::TTriangle t;
+		const double cx = rng.drawUniform(-5.0, 5.0),
+					 cy = rng.drawUniform(-5.0, 5.0),
+					 cz = rng.drawUniform(-5.0, 5.0);
+		for (int k = 0; k < 3; k++)
+		{
+			t.x[k] = cx + rng.drawUniform(-0.5, 0.5);
+			t.y[k] = cy + rng.drawUniform(-0.5, 0.5);
+			t.z[k] = cz + rng.drawUniform(-0.5, 0.5);
+		}
+		obj->insertTriangle(t);
+	}
+	obj->setPose(CPose3D(1.0, -2.0, 0.5, 0.3, -0.2, 0.1));
+	return obj;
+}
+
+static CPose3D randomRay()
+{
+	auto& rng = mrpt::random::getRandomGenerator();
+	return CPose3D(
+		rng.drawUniform(-8.0, 8.0), rng.drawUniform(-8.0, 8.0),
+		rng.drawUniform(-8.0, 8.0), rng.drawUniform(-M_PI, M_PI),
+		rng.drawUniform(-M_PI / 2, M_PI / 2), 0);
+}
+
+TEST(COpenGLScene, traceRayTrianglesBVH)
+{
+	mrpt::random::getRandomGenerator().randomize(123);
+	auto obj = randomTriangles(2000);
+
+	std::vector<TPolygon3D> polys(obj->getTrianglesCount());
+	obj->getPolygons(polys);
+	const std::vector<TPolygonWithPlane> polys_wp(polys.begin(), polys.end());
+
+	size_t nHits = 0;
+	for (int i = 0; i < 500; i++)
+	{
+		const CPose3D ray = randomRay();
+		double d_bvh, d_ref;
+		const bool hit_bvh = obj->traceRay(ray, d_bvh);
+		const bool hit_ref = mrpt::math::traceRay(
+			polys_wp, (ray - obj->getPoseRef()).asTPose(), d_ref);
+		ASSERT_EQ(hit_ref, hit_bvh);
+		if (hit_ref)
+		{
+			EXPECT_NEAR(d_ref, d_bvh, 1e-4);
+			nHits++;
+		}
+	}
+	EXPECT_GT(nHits, 50U);
+}
+
+TEST(COpenGLScene, traceRays)
+{
+	mrpt::random::getRandomGenerator().randomize(456);
+
+	COpenGLScene scene;
+	scene.insert(randomTriangles(500));
+
+	// (nested, so its ray-tracing cache is built through CSetOfObjects)
+	auto tris2 = randomTriangles(1000);
+	tris2->setPose(CPose3D(-1.0, 0.5, 2.0, -0.7, 0.4, 0.2));
+	auto group = mrpt::make_aligned_shared<CSetOfObjects>();
+	group->insert(tris2);
+	scene.insert(group);
+
+	auto sphere = mrpt::make_aligned_shared<CSphere>(1.5f);
+	sphere->setLocation(3, 3, 3);
+	scene.insert(sphere);
+
+	std::vector<CPose3D> rays;
+	for (int i = 0; i < 2000; i++) rays.push_back(randomRay());
+
+	std::vector<double> dists;
+	const size_t nHits = scene.traceRays(rays, dists);
+	ASSERT_EQ(dists.size(), rays.size());
+	EXPECT_GT(nHits, 100U);
+
+	size_t nHitsRef = 0;
+	for (size_t i = 0; i < rays.size(); i++)
+	{
+		double d;
+		if (scene.traceRay(rays[i], d))
+		{
+			nHitsRef++;
+			EXPECT_DOUBLE_EQ(d, dists[i]);
+		}
+		else
+			EXPECT_EQ(dists[i], HUGE_VAL);
+	}
+	EXPECT_EQ(nHitsRef, nHits);
+}
@@ -1093,10 +1093,15 @@ void CPolyhedron::render_dl() const
 
 bool CPolyhedron::traceRay(const mrpt::poses::CPose3D& o, double& dist) const
 {
-	if (!polygonsUpToDate) updatePolygons();
+	prepareForRayTracing();
 	return math::traceRay(tempPolygons, (o - this->m_pose).asTPose(), dist);
 }
 
+void CPolyhedron::prepareForRayTracing() const
+{
+	if (!polygonsUpToDate) updatePolygons();
+}
+
 void CPolyhedron::getEdgesLength(std::vector<double>& lengths) const
 {
 	lengths.resize(mEdges.size());
@@ -346,6 +346,8 @@ bool CRenderizable::traceRay(const mrpt::poses::CPose3D&, double&) const
 	return false;
 }
 
+void CRenderizable::prepareForRayTracing() const {}
+
 CRenderizable::Ptr& mrpt::opengl::operator<<(
 	CRenderizable::Ptr& r, const mrpt::poses::CPose3D& p)
 {
@@ -174,6 +174,11 @@ bool CSetOfObjects::traceRay(const mrpt::poses::CPose3D& o, double& dist) const
 	return found;
 }
 
+void CSetOfObjects::prepareForRayTracing() const
+{
+	for (const auto& o : m_objects) o->prepareForRayTracing();
+}
+
 class FSetColor
 {
    public:
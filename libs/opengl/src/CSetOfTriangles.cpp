@@ -144,10 +144,16 @@ void CSetOfTriangles::serializeFrom(
 
 bool CSetOfTriangles::traceRay(
 	const mrpt::poses::CPose3D& o, double& dist) const
+{
+	prepareForRayTracing();
+	return m_bvh.traceRayTriangles(
+		o - this->m_pose, dist,
+		[this](size_t i) -> const TTriangle& { return m_triangles[i]; });
+}
+
+void CSetOfTriangles::prepareForRayTracing() const
 {
 	if (!polygonsUpToDate) updatePolygons();
-	return mrpt::math::traceRay(
-		tmpPolygons, (o - this->m_pose).asTPose(), dist);
 }
 
 // Helper function. Given two 2D points (y1,z1) and (y2,z2), returns three
@@ -358,6 +364,8 @@ void CSetOfTriangles::updatePolygons() const
 			tmp[j].z = t.z[j];
 			tmpPolygons[i] = tmp;
 		}
+	m_bvh.buildForTriangles(
+		N, [this](size_t i) -> const TTriangle& { return m_triangles[i]; });
 	polygonsUpToDate = true;
 	CRenderizableDisplayList::notifyChange();
 }
@@ -145,10 +145,15 @@ void CTexturedPlane::serializeFrom(
 
 bool CTexturedPlane::traceRay(const mrpt::poses::CPose3D& o, double& dist) const
 {
-	if (!polygonUpToDate) updatePoly();
+	prepareForRayTracing();
 	return math::traceRay(tmpPoly, (o - this->m_pose).asTPose(), dist);
 }
 
+void CTexturedPlane::prepareForRayTracing() const
+{
+	if (!polygonUpToDate) updatePoly();
+}
+
 void CTexturedPlane::updatePoly() const
 {
 	TPolygon3D poly(4);
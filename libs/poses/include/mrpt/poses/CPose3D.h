@@ -366,6 +366,51 @@ class CPose3D : public CPose<CPose3D>, public mrpt::serialization::CSerializable
 		ASSERT_BELOW_(std::abs(lz), eps);
 	}
 
+	/** @name Batch (structure-of-arrays) versions of point/pose composition
+	 * These methods transform N points (or poses) at once, which is much
+	 * faster than N calls to composePoint(): the rotation matrix is loaded
+	 * only once, and the loops use AVX2 kernels if MRPT was built with
+	 * `-mavx2` (e.g. with `-march=native`), or plain (auto-vectorizable)
+	 * loops otherwise.
+	 * Input and output arrays can be the same, for in-place transformations.
+	 * @{ */
+
+	/** Computes \f$ G_i = P \oplus L_i \f$ for N points, given as separate
+	 * arrays of coordinates.
+	 * \param out_jacobians_df_dse3 If not null, it must point to an array of
+	 * N matrices, which will be filled with the Jacobians with respect to the
+	 * 6D locally Euclidean vector in the tangent space of SE(3), as in
+	 * composePoint().
+	 */
+	void composePoints(
+		const size_t N, const double* lx, const double* ly, const double* lz,
+		double* gx, double* gy, double* gz,
+		mrpt::math::CMatrixFixedNumeric<double, 3, 6>* out_jacobians_df_dse3 =
+			nullptr) const;
+	/** \overload For single-precision points (e.g. point maps). Computations
+	 * are done in single precision too. */
+	void composePoints(
+		const size_t N, const float* lx, const float* ly, const float* lz,
+		float* gx, float* gy, float* gz) const;
+
+	/** Computes \f$ L_i = G_i \ominus P \f$ for N points, given as separate
+	 * arrays of coordinates. \sa composePoints */
+	void inverseComposePoints(
+		const size_t N, const double* gx, const double* gy, const double* gz,
+		double* lx, double* ly, double* lz) const;
+	/** \overload */
+	void inverseComposePoints(
+		const size_t N, const float* gx, const float* gy, const float* gz,
+		float* lx, float* ly, float* lz) const;
+
+	/** Computes \f$ O_i = P \oplus I_i \f$ for N poses, like N calls to
+	 * composeFrom() but without building any temporary CPose3D object
+	 * (e.g. for the particles of a CPose3DPDFParticles). */
+	void composePoses(
+		const size_t N, const mrpt::math::TPose3D* in,
+		mrpt::math::TPose3D* out) const;
+	/** @} */
+
 	/**  Makes "this = A (+) B"; this method is slightly more efficient than
 	 * "this= A + B;" since it avoids the temporary object.
 	 *  \note A or B can be "this" without problems.
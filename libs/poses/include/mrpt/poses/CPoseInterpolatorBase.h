@@ -13,6 +13,8 @@
 #include <mrpt/poses/SE_traits.h>
 #include <mrpt/math/lightweight_geom_data.h>
 #include <mrpt/poses/poses_frwds.h>
+#include <algorithm>
+#include <vector>
 
 namespace mrpt::poses
 {
@@ -64,7 +66,10 @@ class CPoseInterpolatorBase
 	using point_t = typename mrpt::poses::SE_traits<DIM>::point_t;
 
 	using TTimePosePair = std::pair<mrpt::Clock::time_point, pose_t>;
-	using TPath = std::map<mrpt::Clock::time_point, pose_t>;
+	/** The path, as a vector of (time, pose) pairs sorted by time, with
+	 * unique timestamps. A sorted vector is more compact and cache-friendly
+	 * than a std::map, and all lookups are binary searches anyway. */
+	using TPath = std::vector<TTimePosePair>;
 	using iterator = typename TPath::iterator;
 	using const_iterator = typename TPath::const_iterator;
 	using reverse_iterator = typename TPath::reverse_iterator;
@@ -82,34 +87,42 @@ class CPoseInterpolatorBase
 	inline const_reverse_iterator rend() const { return m_path.rend(); }
 	iterator lower_bound(const mrpt::Clock::time_point& t)
 	{
-		return m_path.lower_bound(t);
+		return std::lower_bound(
+			m_path.begin(), m_path.end(), t, cmp_pair_time);
 	}
 	const_iterator lower_bound(const mrpt::Clock::time_point& t) const
 	{
-		return m_path.lower_bound(t);
+		return std::lower_bound(
+			m_path.begin(), m_path.end(), t, cmp_pair_time);
 	}
 
 	iterator upper_bound(const mrpt::Clock::time_point& t)
 	{
-		return m_path.upper_bound(t);
+		return std::upper_bound(
+			m_path.begin(), m_path.end(), t, cmp_time_pair);
 	}
 	const_iterator upper_bound(const mrpt::Clock::time_point& t) const
 	{
-		return m_path.upper_bound(t);
+		return std::upper_bound(
+			m_path.begin(), m_path.end(), t, cmp_time_pair);
 	}
 
 	iterator erase(iterator element_to_erase)
 	{
-		m_path.erase(element_to_erase++);
-		return element_to_erase;
+		return m_path.erase(element_to_erase);
 	}
 
 	size_t size() const { return m_path.size(); }
 	bool empty() const { return m_path.empty(); }
-	iterator find(const mrpt::Clock::time_point& t) { return m_path.find(t); }
+	iterator find(const mrpt::Clock::time_point& t)
+	{
+		auto it = lower_bound(t);
+		return (it != m_path.end() && it->first == t) ? it : m_path.end();
+	}
 	const_iterator find(const mrpt::Clock::time_point& t) const
 	{
-		return m_path.find(t);
+		auto it = lower_bound(t);
+		return (it != m_path.end() && it->first == t) ? it : m_path.end();
 	}
 	/** @} */
 
@@ -136,6 +149,22 @@ class CPoseInterpolatorBase
 		const mrpt::Clock::time_point &t, cpose_t& out_interp,
 		bool& out_valid_interp) const;
 
+	/** Batch version of interpolate(), for N query times at once.
+	 * It is much faster than N calls to interpolate() when the query times
+	 * are sorted (e.g. the per-point timestamps of a LiDAR sweep): the path
+	 * knots are found by scanning forward from those of the previous query,
+	 * and the setup of the interpolation (e.g. SLERP quaternions) is done
+	 * only once for all consecutive queries between the same two knots.
+	 * Unsorted query times are also supported, with a binary search each.
+	 * \param t The N times of the points to interpolate.
+	 * \param out_interp The N output interpolated poses.
+	 * \param out_valid_interp Whether each interpolation was valid.
+	 */
+	void interpolate(
+		const std::vector<mrpt::Clock::time_point>& t,
+		std::vector<pose_t>& out_interp,
+		std::vector<bool>& out_valid_interp) const;
+
 	/** Clears the current sequence of poses */
 	void clear();
 
@@ -205,10 +234,30 @@ class CPoseInterpolatorBase
 	mrpt::Clock::duration maxTimeInterpolation;
 	TInterpolatorMethod m_method;
 
+	/** Interpolates at the N times `t[i]`, all of them between the knots p2
+	 * and p3 (p1 and p4 are their previous and next knots). */
 	void impl_interpolation(const TTimePosePair &p1, const TTimePosePair &p2,
 		const TTimePosePair &p3, const TTimePosePair &p4,
-		const TInterpolatorMethod method, const mrpt::Clock::time_point &td,
-		pose_t& out_interp) const;
+		const TInterpolatorMethod method, const mrpt::Clock::time_point* t,
+		pose_t* out_interp, const size_t N) const;
+
+	/** Gets the 4 knots to interpolate at a time between those of the knots
+	 * `idx-1` and `idx`, checking the max time between knots.
+	 * \return false if there is not information enough to interpolate. */
+	bool impl_get_knots(
+		const size_t idx, TTimePosePair& p1, TTimePosePair& p2,
+		TTimePosePair& p3, TTimePosePair& p4) const;
+
+	static bool cmp_pair_time(
+		const TTimePosePair& p, const mrpt::Clock::time_point& t)
+	{
+		return p.first < t;
+	}
+	static bool cmp_time_pair(
+		const mrpt::Clock::time_point& t, const TTimePosePair& p)
+	{
+		return t < p.first;
+	}
 
 };  // End of class def.
 }
@@ -20,7 +20,10 @@ IMPLEMENTS_SERIALIZABLE(CPose2DInterpolator, CSerializable, mrpt::poses)
 uint8_t CPose2DInterpolator::serializeGetVersion() const { return 0; }
 void CPose2DInterpolator::serializeTo(mrpt::serialization::CArchive& out) const
 {
-	out << m_path;
+	// (Same format than the former std::map container)
+	const std::map<mrpt::Clock::time_point, mrpt::math::TPose2D> path(
+		m_path.begin(), m_path.end());
+	out << path;
 }
 void CPose2DInterpolator::serializeFrom(
 	mrpt::serialization::CArchive& in, uint8_t version)
@@ -29,7 +32,9 @@ void CPose2DInterpolator::serializeFrom(
 	{
 		case 0:
 		{
-			in >> m_path;
+			std::map<mrpt::Clock::time_point, mrpt::math::TPose2D> path;
+			in >> path;
+			m_path.assign(path.begin(), path.end());
 		}
 		break;
 		default:
@@ -44,12 +49,11 @@ template <>
 void CPoseInterpolatorBase<2>::impl_interpolation(
 	const TTimePosePair &p1, const TTimePosePair &p2,
 	const TTimePosePair &p3, const TTimePosePair &p4,
-	const TInterpolatorMethod method, const mrpt::Clock::time_point &t, pose_t& out_interp) const
+	const TInterpolatorMethod method, const mrpt::Clock::time_point* t,
+	pose_t* out_interps, const size_t N) const
 {
 	using mrpt::math::TPose2D;
 	using doubleDuration = std::chrono::duration<double>;
-	doubleDuration durationT(t.time_since_epoch());
-	double td = durationT.count();
 	mrpt::math::CArrayDouble<4> ts;
 	ts[0] = std::chrono::duration_cast<doubleDuration>(p1.first.time_since_epoch()).count();
 	ts[1] = std::chrono::duration_cast<doubleDuration>(p2.first.time_since_epoch()).count();
@@ -72,82 +76,100 @@ void CPoseInterpolatorBase<2>::impl_interpolation(
 
 	unwrap2PiSequence(yaw);
 
-	// Target interpolated values:
+	// The spline and line fit coefficients are computed once and shared by
+	// all the queries:
+	using detail::TSpline4;
+	using detail::TLinearFit4;
+	const auto timeOf = [t](size_t i) {
+		return std::chrono::duration_cast<doubleDuration>(
+				   t[i].time_since_epoch())
+			.count();
+	};
+
 	switch (method)
 	{
 		case imSpline:
+		case imSSLSLL:
 		{
 			// ---------------------------------------
 			//    SPLINE INTERPOLATION
 			// ---------------------------------------
-			out_interp.x = math::spline(td, ts, X);
-			out_interp.y = math::spline(td, ts, Y);
-			out_interp.phi = math::spline(td, ts, yaw, true);  // Wrap 2pi
+			const TSpline4 sx(ts, X), sy(ts, Y);
+			const TSpline4 syaw(ts, yaw, true);  // Wrap 2pi
+			for (size_t i = 0; i < N; i++)
+			{
+				const double td = timeOf(i);
+				out_interps[i] = TPose2D(sx(td), sy(td), syaw(td));
+			}
 		}
 		break;
 
 		case imLinear2Neig:
 		{
-			out_interp.x =
-				math::interpolate2points(td, ts[1], X[1], ts[2], X[2]);
-			out_interp.y =
-				math::interpolate2points(td, ts[1], Y[1], ts[2], Y[2]);
-			out_interp.phi = math::interpolate2points(
-				td, ts[1], yaw[1], ts[2], yaw[2], true);  // Wrap 2pi
+			for (size_t i = 0; i < N; i++)
+			{
+				const double td = timeOf(i);
+				pose_t& out_interp = out_interps[i];
+				out_interp.x =
+					math::interpolate2points(td, ts[1], X[1], ts[2], X[2]);
+				out_interp.y =
+					math::interpolate2points(td, ts[1], Y[1], ts[2], Y[2]);
+				out_interp.phi = math::interpolate2points(
+					td, ts[1], yaw[1], ts[2], yaw[2], true);  // Wrap 2pi
+			}
 		}
 		break;
 
 		case imLinear4Neig:
 		{
-			out_interp.x =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(td, ts, X);
-			out_interp.y =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(td, ts, Y);
-			out_interp.phi =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(
-					td, ts, yaw, true);  // Wrap 2pi
+			const TLinearFit4 lx(ts, X), ly(ts, Y);
+			const TLinearFit4 lyaw(ts, yaw, true);  // Wrap 2pi
+			for (size_t i = 0; i < N; i++)
+			{
+				const double td = timeOf(i);
+				out_interps[i] = TPose2D(lx(td), ly(td), lyaw(td));
+			}
 		}
 		break;
 
 		case imSSLLLL:
 		{
-			out_interp.x = math::spline(td, ts, X);
-			out_interp.y = math::spline(td, ts, Y);
-			out_interp.phi =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(
-					td, ts, yaw, true);  // Wrap 2pi
-		}
-		break;
-
-		case imSSLSLL:
-		{
-			out_interp.x = math::spline(td, ts, X);
-			out_interp.y = math::spline(td, ts, Y);
-			out_interp.phi = math::spline(td, ts, yaw, true);  // Wrap 2pi
+			const TSpline4 sx(ts, X), sy(ts, Y);
+			const TLinearFit4 lyaw(ts, yaw, true);  // Wrap 2pi
+			for (size_t i = 0; i < N; i++)
+			{
+				const double td = timeOf(i);
+				out_interps[i] = TPose2D(sx(td), sy(td), lyaw(td));
+			}
 		}
 		break;
 
 		case imLinearSlerp:
 		{
-			const double ratio = (td - ts[1]) / (ts[2] - ts[1]);
 			const double Aang = mrpt::math::angDistance(yaw[1], yaw[2]);
-			out_interp.phi = yaw[1] + ratio * Aang;
-
-			out_interp.x =
-				math::interpolate2points(td, ts[1], X[1], ts[2], X[2]);
-			out_interp.y =
-				math::interpolate2points(td, ts[1], Y[1], ts[2], Y[2]);
+			for (size_t i = 0; i < N; i++)
+			{
+				const double td = timeOf(i);
+				const double ratio = (td - ts[1]) / (ts[2] - ts[1]);
+				out_interps[i] = TPose2D(
+					math::interpolate2points(td, ts[1], X[1], ts[2], X[2]),
+					math::interpolate2points(td, ts[1], Y[1], ts[2], Y[2]),
+					yaw[1] + ratio * Aang);
+			}
 		}
 		break;
 
 		case imSplineSlerp:
 		{
-			const double ratio = (td - ts[1]) / (ts[2] - ts[1]);
 			const double Aang = mrpt::math::angDistance(yaw[1], yaw[2]);
-			out_interp.phi = yaw[1] + ratio * Aang;
-
-			out_interp.x = math::spline(td, ts, X);
-			out_interp.y = math::spline(td, ts, Y);
+			const TSpline4 sx(ts, X), sy(ts, Y);
+			for (size_t i = 0; i < N; i++)
+			{
+				const double td = timeOf(i);
+				const double ratio = (td - ts[1]) / (ts[2] - ts[1]);
+				out_interps[i] =
+					TPose2D(sx(td), sy(td), yaw[1] + ratio * Aang);
+			}
 		}
 		break;
 
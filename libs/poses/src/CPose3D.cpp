@@ -28,6 +28,9 @@
 #include <limits>  // for numeric_...
 #include <ostream>  // for operator<<
 #include <string>  // for allocator
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 #include <mrpt/math/CArrayNumeric.h>  // for CArrayDo...
 #include <mrpt/math/CMatrixFixedNumeric.h>  // for CMatrixF...
 #include <mrpt/math/CMatrixTemplateNumeric.h>  // for CMatrixD...
@@ -790,6 +793,207 @@ void CPose3D::inverseComposePoint(
 	}
 }
 
+namespace
+{
+#if defined(__AVX2__)
+#if defined(__FMA__)
+inline __m256 madd(__m256 a, __m256 b, __m256 c)
+{
+	return _mm256_fmadd_ps(a, b, c);
+}
+inline __m256d madd(__m256d a, __m256d b, __m256d c)
+{
+	return _mm256_fmadd_pd(a, b, c);
+}
+#else
+inline __m256 madd(__m256 a, __m256 b, __m256 c)
+{
+	return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+}
+inline __m256d madd(__m256d a, __m256d b, __m256d c)
+{
+	return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+}
+#endif
+
+// AVX2 kernels for transformPoints(). They return the number of points
+// processed (a multiple of the vector width); the caller handles the rest.
+size_t transformPointsAVX2(
+	const float R[9], const float t[3], const size_t N, const float* xs,
+	const float* ys, const float* zs, float* oxs, float* oys, float* ozs)
+{
+	__m256 r[9];
+	for (int k = 0; k < 9; k++) r[k] = _mm256_set1_ps(R[k]);
+	const __m256 tx = _mm256_set1_ps(t[0]), ty = _mm256_set1_ps(t[1]),
+				 tz = _mm256_set1_ps(t[2]);
+	size_t i = 0;
+	for (; i + 8 <= N; i += 8)
+	{
+		// Load all inputs before storing, so in-place works:
+		const __m256 x = _mm256_loadu_ps(xs + i), y = _mm256_loadu_ps(ys + i),
+					 z = _mm256_loadu_ps(zs + i);
+		_mm256_storeu_ps(
+			oxs + i, madd(r[0], x, madd(r[1], y, madd(r[2], z, tx))));
+		_mm256_storeu_ps(
+			oys + i, madd(r[3], x, madd(r[4], y, madd(r[5], z, ty))));
+		_mm256_storeu_ps(
+			ozs + i, madd(r[6], x, madd(r[7], y, madd(r[8], z, tz))));
+	}
+	return i;
+}
+size_t transformPointsAVX2(
+	const double R[9], const double t[3], const size_t N, const double* xs,
+	const double* ys, const double* zs, double* oxs, double* oys, double* ozs)
+{
+	__m256d r[9];
+	for (int k = 0; k < 9; k++) r[k] = _mm256_set1_pd(R[k]);
+	const __m256d tx = _mm256_set1_pd(t[0]), ty = _mm256_set1_pd(t[1]),
+				  tz = _mm256_set1_pd(t[2]);
+	size_t i = 0;
+	for (; i + 4 <= N; i += 4)
+	{
+		const __m256d x = _mm256_loadu_pd(xs + i),
+					  y = _mm256_loadu_pd(ys + i),
+					  z = _mm256_loadu_pd(zs + i);
+		_mm256_storeu_pd(
+			oxs + i, madd(r[0], x, madd(r[1], y, madd(r[2], z, tx))));
+		_mm256_storeu_pd(
+			oys + i, madd(r[3], x, madd(r[4], y, madd(r[5], z, ty))));
+		_mm256_storeu_pd(
+			ozs + i, madd(r[6], x, madd(r[7], y, madd(r[8], z, tz))));
+	}
+	return i;
+}
+#endif  // __AVX2__
+
+// o_i = R * p_i + t, with R in row-major order:
+template <typename T>
+void transformPoints(
+	const T R[9], const T t[3], const size_t N, const T* xs, const T* ys,
+	const T* zs, T* oxs, T* oys, T* ozs)
+{
+	size_t i = 0;
+#if defined(__AVX2__)
+	i = transformPointsAVX2(R, t, N, xs, ys, zs, oxs, oys, ozs);
+#endif
+	for (; i < N; i++)
+	{
+		const T x = xs[i], y = ys[i], z = zs[i];
+		oxs[i] = R[0] * x + R[1] * y + R[2] * z + t[0];
+		oys[i] = R[3] * x + R[4] * y + R[5] * z + t[1];
+		ozs[i] = R[6] * x + R[7] * y + R[8] * z + t[2];
+	}
+}
+
+// Gets the rotation and translation of P (or of its inverse) as plain arrays:
+template <typename T>
+void getRt(const CPose3D& P, const bool inverse, T R[9], T t[3])
+{
+	const auto& ROT = P.getRotationMatrix();
+	for (int r = 0; r < 3; r++)
+		for (int c = 0; c < 3; c++)
+			R[3 * r + c] = static_cast<T>(inverse ? ROT(c, r) : ROT(r, c));
+	for (int r = 0; r < 3; r++)
+		t[r] = static_cast<T>(
+			inverse ? -(ROT(0, r) * P.x() + ROT(1, r) * P.y() +
+						ROT(2, r) * P.z())
+					: P.m_coords[r]);
+}
+}  // namespace
+
+void CPose3D::composePoints(
+	const size_t N, const double* lx, const double* ly, const double* lz,
+	double* gx, double* gy, double* gz,
+	mrpt::math::CMatrixFixedNumeric<double, 3, 6>* out_jacobians_df_dse3) const
+{
+	double R[9], t[3];
+	getRt(*this, false, R, t);
+	transformPoints(R, t, N, lx, ly, lz, gx, gy, gz);
+
+	if (out_jacobians_df_dse3)
+	{
+		for (size_t i = 0; i < N; i++)
+		{
+			alignas(MRPT_MAX_ALIGN_BYTES) const double nums[3 * 6] = {
+				1, 0, 0, 0, gz[i], -gy[i], 0, 1, 0, -gz[i], 0, gx[i],
+				0, 0, 1, gy[i], -gx[i], 0};
+			out_jacobians_df_dse3[i].loadFromArray(nums);
+		}
+	}
+}
+
+void CPose3D::composePoints(
+	const size_t N, const float* lx, const float* ly, const float* lz,
+	float* gx, float* gy, float* gz) const
+{
+	float R[9], t[3];
+	getRt(*this, false, R, t);
+	transformPoints(R, t, N, lx, ly, lz, gx, gy, gz);
+}
+
+void CPose3D::inverseComposePoints(
+	const size_t N, const double* gx, const double* gy, const double* gz,
+	double* lx, double* ly, double* lz) const
+{
+	double R[9], t[3];
+	getRt(*this, true, R, t);
+	transformPoints(R, t, N, gx, gy, gz, lx, ly, lz);
+}
+
+void CPose3D::inverseComposePoints(
+	const size_t N, const float* gx, const float* gy, const float* gz,
+	float* lx, float* ly, float* lz) const
+{
+	float R[9], t[3];
+	getRt(*this, true, R, t);
+	transformPoints(R, t, N, gx, gy, gz, lx, ly, lz);
+}
+
+void CPose3D::composePoses(
+	const size_t N, const mrpt::math::TPose3D* in,
+	mrpt::math::TPose3D* out) const
+{
+	const CMatrixDouble33& Ra = m_ROT;
+	CMatrixDouble33 Rb(UNINITIALIZED_MATRIX), R(UNINITIALIZED_MATRIX);
+	for (size_t i = 0; i < N; i++)
+	{
+		const TPose3D& b = in[i];
+#ifdef HAVE_SINCOS
+		double cy, sy;
+		::sincos(b.yaw, &sy, &cy);
+		double cp, sp;
+		::sincos(b.pitch, &sp, &cp);
+		double cr, sr;
+		::sincos(b.roll, &sr, &cr);
+#else
+		const double cy = cos(b.yaw);
+		const double sy = sin(b.yaw);
+		const double cp = cos(b.pitch);
+		const double sp = sin(b.pitch);
+		const double cr = cos(b.roll);
+		const double sr = sin(b.roll);
+#endif
+		Rb(0, 0) = cy * cp;
+		Rb(0, 1) = cy * sp * sr - sy * cr;
+		Rb(0, 2) = cy * sp * cr + sy * sr;
+		Rb(1, 0) = sy * cp;
+		Rb(1, 1) = sy * sp * sr + cy * cr;
+		Rb(1, 2) = sy * sp * cr - cy * sr;
+		Rb(2, 0) = -sp;
+		Rb(2, 1) = cp * sr;
+		Rb(2, 2) = cp * cr;
+		R.multiply_AB(Ra, Rb);
+
+		// (Read the whole input before writing, since in==out is allowed)
+		const double bx = b.x, by = b.y, bz = b.z;
+		TPose3D& o = out[i];
+		o.x = m_coords[0] + Ra(0, 0) * bx + Ra(0, 1) * by + Ra(0, 2) * bz;
+		o.y = m_coords[1] + Ra(1, 0) * bx + Ra(1, 1) * by + Ra(1, 2) * bz;
+		o.z = m_coords[2] + Ra(2, 0) * bx + Ra(2, 1) * by + Ra(2, 2) * bz;
+		TPose3D::SO3_to_yaw_pitch_roll(R, o.yaw, o.pitch, o.roll);
+	}
+}
+
 CPose3D CPose3D::exp(
 	const mrpt::math::CArrayNumeric<double, 6>& mu, bool pseudo_exponential)
 {
@@ -20,7 +20,10 @@ IMPLEMENTS_SERIALIZABLE(CPose3DInterpolator, CSerializable, mrpt::poses)
 uint8_t CPose3DInterpolator::serializeGetVersion() const { return 1; }
 void CPose3DInterpolator::serializeTo(mrpt::serialization::CArchive& out) const
 {
-	out << m_path;  // v1: change container element CPose3D->TPose3D
+	// (Same format than the former std::map container)
+	const std::map<mrpt::Clock::time_point, mrpt::math::TPose3D> path(
+		m_path.begin(), m_path.end());
+	out << path;  // v1: change container element CPose3D->TPose3D
 }
 void CPose3DInterpolator::serializeFrom(
 	mrpt::serialization::CArchive& in, uint8_t version)
@@ -34,13 +37,15 @@ void CPose3DInterpolator::serializeFrom(
 			m_path.clear();
 			for (const auto& p : old_path)
 			{
-				m_path[p.first] = p.second.asTPose();
+				m_path.emplace_back(p.first, p.second.asTPose());
 			}
 		}
 		break;
 		case 1:
 		{
-			in >> m_path;
+			std::map<mrpt::Clock::time_point, mrpt::math::TPose3D> path;
+			in >> path;
+			m_path.assign(path.begin(), path.end());
 		}
 		break;
 		default:
@@ -55,14 +60,13 @@ template <>
 void CPoseInterpolatorBase<3>::impl_interpolation(
 	const TTimePosePair &p1, const TTimePosePair &p2, 
 	const TTimePosePair &p3, const TTimePosePair &p4,
-	const TInterpolatorMethod method, const mrpt::Clock::time_point &t, pose_t& out_interp) const
+	const TInterpolatorMethod method, const mrpt::Clock::time_point* t,
+	pose_t* out_interps, const size_t N) const
 {
 	using mrpt::math::TPose3D;
 	mrpt::math::CArrayDouble<4> X, Y, Z, yaw, pitch, roll;
 	mrpt::math::CArrayDouble<4> ts;
 	using doubleDuration = std::chrono::duration<double>;
-	doubleDuration durationT = t.time_since_epoch();
-	double td = durationT.count();
 	ts[0] = std::chrono::duration_cast<doubleDuration>(p1.first.time_since_epoch()).count();
 	ts[1] = std::chrono::duration_cast<doubleDuration>(p2.first.time_since_epoch()).count();
 	ts[2] = std::chrono::duration_cast<doubleDuration>(p3.first.time_since_epoch()).count();
@@ -99,7 +103,22 @@ void CPoseInterpolatorBase<3>::impl_interpolation(
 	unwrap2PiSequence(pitch);
 	unwrap2PiSequence(roll);
 
-	// Target interpolated values:
+	// The spline and line fit coefficients, the SLERP quaternions, etc.
+	// are computed once and shared by all the queries:
+	using detail::TSpline4;
+	using detail::TLinearFit4;
+	const auto timeOf = [t](size_t i) {
+		return std::chrono::duration_cast<doubleDuration>(
+				   t[i].time_since_epoch())
+			.count();
+	};
+	mrpt::math::CQuaternionDouble q2, q3, q;
+	if (method == imLinearSlerp || method == imSplineSlerp)
+	{
+		TPose3D(0, 0, 0, yaw[1], pitch[1], roll[1]).getAsQuaternion(q2);
+		TPose3D(0, 0, 0, yaw[2], pitch[2], roll[2]).getAsQuaternion(q3);
+	}
+
 	switch (method)
 	{
 		case imSpline:
@@ -107,112 +126,119 @@ void CPoseInterpolatorBase<3>::impl_interpolation(
 			// ---------------------------------------
 			//    SPLINE INTERPOLATION
 			// ---------------------------------------
-			out_interp.x = math::spline(td, ts, X);
-			out_interp.y = math::spline(td, ts, Y);
-			out_interp.z = math::spline(td, ts, Z);
-			out_interp.yaw = math::spline(td, ts, yaw, true);  // Wrap 2pi
-			out_interp.pitch = math::spline(td, ts, pitch, true);
-			out_interp.roll = math::spline(td, ts, roll, true);
+			const TSpline4 sx(ts, X), sy(ts, Y), sz(ts, Z);
+			const TSpline4 syaw(ts, yaw, true);  // Wrap 2pi
+			const TSpline4 spitch(ts, pitch, true), sroll(ts, roll, true);
+			for (size_t i = 0; i < N; i++)
+			{
+				const double td = timeOf(i);
+				out_interps[i] = TPose3D(
+					sx(td), sy(td), sz(td), syaw(td), spitch(td), sroll(td));
+			}
 		}
 		break;
 
 		case imLinear2Neig:
 		{
-			out_interp.x =
-				math::interpolate2points(td, ts[1], X[1], ts[2], X[2]);
-			out_interp.y =
-				math::interpolate2points(td, ts[1], Y[1], ts[2], Y[2]);
-			out_interp.z =
-				math::interpolate2points(td, ts[1], Z[1], ts[2], Z[2]);
-			out_interp.yaw = math::interpolate2points(
-				td, ts[1], yaw[1], ts[2], yaw[2], true);  // Wrap 2pi
-			out_interp.pitch = math::interpolate2points(
-				td, ts[1], pitch[1], ts[2], pitch[2], true);
-			out_interp.roll = math::interpolate2points(
-				td, ts[1], roll[1], ts[2], roll[2], true);
+			for (size_t i = 0; i < N; i++)
+			{
+				const double td = timeOf(i);
+				pose_t& out_interp = out_interps[i];
+				out_interp.x =
+					math::interpolate2points(td, ts[1], X[1], ts[2], X[2]);
+				out_interp.y =
+					math::interpolate2points(td, ts[1], Y[1], ts[2], Y[2]);
+				out_interp.z =
+					math::interpolate2points(td, ts[1], Z[1], ts[2], Z[2]);
+				out_interp.yaw = math::interpolate2points(
+					td, ts[1], yaw[1], ts[2], yaw[2], true);  // Wrap 2pi
+				out_interp.pitch = math::interpolate2points(
+					td, ts[1], pitch[1], ts[2], pitch[2], true);
+				out_interp.roll = math::interpolate2points(
+					td, ts[1], roll[1], ts[2], roll[2], true);
+			}
 		}
 		break;
 
 		case imLinear4Neig:
 		{
-			out_interp.x =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(td, ts, X);
-			out_interp.y =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(td, ts, Y);
-			out_interp.z =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(td, ts, Z);
-			out_interp.yaw =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(
-					td, ts, yaw, true);  // Wrap 2pi
-			out_interp.pitch =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(
-					td, ts, pitch, true);
-			out_interp.roll =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(
-					td, ts, roll, true);
+			const TLinearFit4 lx(ts, X), ly(ts, Y), lz(ts, Z);
+			const TLinearFit4 lyaw(ts, yaw, true);  // Wrap 2pi
+			const TLinearFit4 lpitch(ts, pitch, true), lroll(ts, roll, true);
+			for (size_t i = 0; i < N; i++)
+			{
+				const double td = timeOf(i);
+				out_interps[i] = TPose3D(
+					lx(td), ly(td), lz(td), lyaw(td), lpitch(td), lroll(td));
+			}
 		}
 		break;
 
 		case imSSLLLL:
 		{
-			out_interp.x = math::spline(td, ts, X);
-			out_interp.y = math::spline(td, ts, Y);
-			out_interp.z =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(td, ts, Z);
-			out_interp.yaw =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(
-					td, ts, yaw, true);  // Wrap 2pi
-			out_interp.pitch =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(
-					td, ts, pitch, true);
-			out_interp.roll =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(
-					td, ts, roll, true);
+			const TSpline4 sx(ts, X), sy(ts, Y);
+			const TLinearFit4 lz(ts, Z);
+			const TLinearFit4 lyaw(ts, yaw, true);  // Wrap 2pi
+			const TLinearFit4 lpitch(ts, pitch, true), lroll(ts, roll, true);
+			for (size_t i = 0; i < N; i++)
+			{
+				const double td = timeOf(i);
+				out_interps[i] = TPose3D(
+					sx(td), sy(td), lz(td), lyaw(td), lpitch(td), lroll(td));
+			}
 		}
 		break;
 
 		case imSSLSLL:
 		{
-			out_interp.x = math::spline(td, ts, X);
-			out_interp.y = math::spline(td, ts, Y);
-			out_interp.z =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(td, ts, Z);
-			out_interp.yaw = math::spline(td, ts, yaw, true);  // Wrap 2pi
-			out_interp.pitch =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(
-					td, ts, pitch, true);
-			out_interp.roll =
-				math::leastSquareLinearFit<double, decltype(ts), 4>(
-					td, ts, roll, true);
+			const TSpline4 sx(ts, X), sy(ts, Y);
+			const TLinearFit4 lz(ts, Z);
+			const TSpline4 syaw(ts, yaw, true);  // Wrap 2pi
+			const TLinearFit4 lpitch(ts, pitch, true), lroll(ts, roll, true);
+			for (size_t i = 0; i < N; i++)
+			{
+				const double td = timeOf(i);
+				out_interps[i] = TPose3D(
+					sx(td), sy(td), lz(td), syaw(td), lpitch(td), lroll(td));
+			}
 		}
 		break;
 
 		case imLinearSlerp:
 		{
-			const double ratio = (td - ts[1]) / (ts[2] - ts[1]);
-			mrpt::math::slerp_ypr(
-				TPose3D(0, 0, 0, yaw[1], pitch[1], roll[1]),
-				TPose3D(0, 0, 0, yaw[2], pitch[2], roll[2]), ratio, out_interp);
-
-			out_interp.x =
-				math::interpolate2points(td, ts[1], X[1], ts[2], X[2]);
-			out_interp.y =
-				math::interpolate2points(td, ts[1], Y[1], ts[2], Y[2]);
-			out_interp.z =
-				math::interpolate2points(td, ts[1], Z[1], ts[2], Z[2]);
+			for (size_t i = 0; i < N; i++)
+			{
+				const double td = timeOf(i);
+				pose_t& out_interp = out_interps[i];
+				const double ratio = (td - ts[1]) / (ts[2] - ts[1]);
+				mrpt::math::slerp(q2, q3, ratio, q);
+				q.rpy(out_interp.roll, out_interp.pitch, out_interp.yaw);
+
+				out_interp.x =
+					math::interpolate2points(td, ts[1], X[1], ts[2], X[2]);
+				out_interp.y =
+					math::interpolate2points(td, ts[1], Y[1], ts[2], Y[2]);
+				out_interp.z =
+					math::interpolate2points(td, ts[1], Z[1], ts[2], Z[2]);
+			}
 		}
 		break;
 
 		case imSplineSlerp:
 		{
-			const double ratio = (td - ts[1]) / (ts[2] - ts[1]);
-			mrpt::math::slerp_ypr(
-				TPose3D(0, 0, 0, yaw[1], pitch[1], roll[1]),
-				TPose3D(0, 0, 0, yaw[2], pitch[2], roll[2]), ratio, out_interp);
-
-			out_interp.x = math::spline(td, ts, X);
-			out_interp.y = math::spline(td, ts, Y);
-			out_interp.z = math::spline(td, ts, Z);
+			const TSpline4 sx(ts, X), sy(ts, Y), sz(ts, Z);
+			for (size_t i = 0; i < N; i++)
+			{
+				const double td = timeOf(i);
+				pose_t& out_interp = out_interps[i];
+				const double ratio = (td - ts[1]) / (ts[2] - ts[1]);
+				mrpt::math::slerp(q2, q3, ratio, q);
+				q.rpy(out_interp.roll, out_interp.pitch, out_interp.yaw);
+
+				out_interp.x = sx(td);
+				out_interp.y = sy(td);
+				out_interp.z = sz(td);
+			}
 		}
 		break;
 
@@ -10,6 +10,8 @@
 #include <mrpt/poses/CPose3D.h>
 #include <mrpt/poses/CPose3DInterpolator.h>
 #include <mrpt/system/datetime.h>
+#include <mrpt/math/interp_fit.hpp>
+#include <mrpt/math/wrap2pi.h>
 #include <CTraitsTest.h>
 #include <gtest/gtest.h>
 
@@ -49,3 +51,113 @@ TEST(CPose3DInterpolator, interp)
 				.sum(),
 		1e-4);
 }
+
+TEST(CPose3DInterpolator, interpBatch)
+{
+	using namespace mrpt::poses;
+	using mrpt::math::TPose3D;
+
+	const auto t0 = mrpt::Clock::now();
+	const mrpt::Clock::duration dt(std::chrono::milliseconds(100));
+
+	CPose3DInterpolator pose_path;
+	for (int i = 0; i < 20; i++)
+		pose_path.insert(
+			t0 + i * dt, TPose3D(
+							 0.3 * i, std::sin(0.2 * i), 0.01 * i * i,
+							 0.4 * i, 0.05 * std::cos(0.3 * i), -0.02 * i));
+
+	// Sorted queries, with exact matches and out-of-range ones, followed by
+	// a few unsorted ones:
+	std::vector<mrpt::Clock::time_point> ts;
+	for (int i = -10; i < 210; i++)
+		ts.push_back(t0 + i * std::chrono::milliseconds(10) - dt / 7);
+	for (int i = 0; i < 20; i++)
+		ts.push_back(t0 + ((i * 7) % 20) * dt + dt / 3);
+
+	// (imSplineSlerp is not tested since it cannot interpolate in the first
+	// and last intervals)
+	for (const auto method : {imSpline, imLinear2Neig, imLinear4Neig,
+							  imSSLLLL, imSSLSLL, imLinearSlerp})
+	{
+		pose_path.setInterpolationMethod(method);
+
+		std::vector<TPose3D> poses;
+		std::vector<bool> valids;
+		pose_path.interpolate(ts, poses, valids);
+		ASSERT_EQ(poses.size(), ts.size());
+		ASSERT_EQ(valids.size(), ts.size());
+
+		size_t nValid = 0;
+		for (size_t i = 0; i < ts.size(); i++)
+		{
+			TPose3D p;
+			bool valid;
+			pose_path.interpolate(ts[i], p, valid);
+			EXPECT_EQ(valid, valids[i]) << "method: " << method << " i=" << i;
+			if (!valid) continue;
+			nValid++;
+			for (int k = 0; k < 6; k++)
+				EXPECT_NEAR(p[k], poses[i][k], 1e-9)
+					<< "method: " << method << " i=" << i;
+		}
+		EXPECT_GT(nValid, ts.size() / 2);
+	}
+}
+
+TEST(CPose3DInterpolator, interpMatchesMathFunctions)
+{
+	using namespace mrpt::poses;
+	using mrpt::math::TPose3D;
+
+	// (Times close to the epoch, so they lose no precision as doubles)
+	const mrpt::Clock::time_point t0;
+	const mrpt::Clock::duration dt(std::chrono::milliseconds(100));
+	const double dt_sec = 0.1;
+
+	CPose3DInterpolator pose_path;
+	mrpt::math::CArrayDouble<4> ts, xs, yaws;
+	const double knots_x[4] = {0.0, 0.5, 0.7, 1.6};
+	const double knots_yaw[4] = {3.0, -3.1, -2.9, 2.8};  // Wraps around pi
+	for (int i = 0; i < 4; i++)
+	{
+		pose_path.insert(
+			t0 + i * dt, TPose3D(knots_x[i], 0, 0, knots_yaw[i], 0, 0));
+		ts[i] = i * dt_sec;
+		xs[i] = knots_x[i];
+		yaws[i] = knots_yaw[i];
+	}
+	mrpt::math::unwrap2PiSequence(yaws);
+
+	for (int k = 1; k < 10; k++)
+	{
+		const mrpt::Clock::time_point t = t0 + dt + k * dt / 10;
+		const double td = dt_sec + k * dt_sec / 10;
+		TPose3D p;
+		bool valid;
+
+		pose_path.setInterpolationMethod(imSpline);
+		pose_path.interpolate(t, p, valid);
+		ASSERT_TRUE(valid);
+		EXPECT_NEAR(p.x, mrpt::math::spline(td, ts, xs), 1e-9);
+		EXPECT_NEAR(
+			mrpt::math::angDistance(
+				p.yaw, mrpt::math::spline(td, ts, yaws, true)),
+			0, 1e-9);
+
+		pose_path.setInterpolationMethod(imLinear4Neig);
+		pose_path.interpolate(t, p, valid);
+		ASSERT_TRUE(valid);
+		EXPECT_NEAR(
+			p.x,
+			(mrpt::math::leastSquareLinearFit<double, decltype(ts), 4>(
+				td, ts, xs)),
+			1e-9);
+		EXPECT_NEAR(
+			mrpt::math::angDistance(
+				p.yaw,
+				mrpt::math::leastSquareLinearFit<double, decltype(ts), 4>(
+					td, ts, yaws, true)),
+			0, 1e-9);
+	}
+}
@@ -239,8 +239,11 @@ mrpt::math::TPose3D CPose3DPDFParticles::getParticlePose(int i) const
 void CPose3DPDFParticles::changeCoordinatesReference(
 	const CPose3D& newReferenceBase)
 {
-	for (auto& p : m_particles)
-		p.d = (newReferenceBase + CPose3D(p.d)).asTPose();
+	const size_t N = m_particles.size();
+	std::vector<TPose3D> poses(N);
+	for (size_t i = 0; i < N; i++) poses[i] = m_particles[i].d;
+	newReferenceBase.composePoses(N, poses.data(), poses.data());
+	for (size_t i = 0; i < N; i++) m_particles[i].d = poses[i];
 }
 
 void CPose3DPDFParticles::drawSingleSample(CPose3D& outPart) const
@@ -1009,3 +1009,85 @@ TEST_F(Pose3DTests, Jacob_dAexpeD_de)
 				j[2], DEG2RAD(j[3]), DEG2RAD(j[4]),
 				DEG2RAD(j[5]));
 }
+
+TEST_F(Pose3DTests, BatchComposePoints)
+{
+	// An odd number of points, to also test the non-vectorized tail:
+	const size_t N = 13;
+	std::vector<double> xs(N), ys(N), zs(N), gxs(N), gys(N), gzs(N);
+	std::vector<float> xsf(N), ysf(N), zsf(N);
+	for (size_t k = 0; k < N; k++)
+	{
+		xs[k] = -5.0 + k;
+		ys[k] = 3.0 - 0.5 * k;
+		zs[k] = 0.1 * k * k;
+		xsf[k] = xs[k];
+		ysf[k] = ys[k];
+		zsf[k] = zs[k];
+	}
+	std::vector<CMatrixFixedNumeric<double, 3, 6>> jacobs(N);
+
+	for (const auto& i : ptc)
+	{
+		const CPose3D p(
+			i[0], i[1], i[2], DEG2RAD(i[3]), DEG2RAD(i[4]), DEG2RAD(i[5]));
+		p.composePoints(
+			N, &xs[0], &ys[0], &zs[0], &gxs[0], &gys[0], &gzs[0],
+			&jacobs[0]);
+
+		std::vector<double> lxs(N), lys(N), lzs(N);
+		p.inverseComposePoints(
+			N, &gxs[0], &gys[0], &gzs[0], &lxs[0], &lys[0], &lzs[0]);
+
+		// In-place, single precision:
+		std::vector<float> fx = xsf, fy = ysf, fz = zsf;
+		p.composePoints(N, &fx[0], &fy[0], &fz[0], &fx[0], &fy[0], &fz[0]);
+
+		for (size_t k = 0; k < N; k++)
+		{
+			double gx, gy, gz;
+			CMatrixFixedNumeric<double, 3, 6> df_dse3;
+			p.composePoint(
+				xs[k], ys[k], zs[k], gx, gy, gz, nullptr, nullptr, &df_dse3);
+			EXPECT_NEAR(gx, gxs[k], 1e-9);
+			EXPECT_NEAR(gy, gys[k], 1e-9);
+			EXPECT_NEAR(gz, gzs[k], 1e-9);
+			EXPECT_NEAR(
+				0, (df_dse3 - jacobs[k]).array().abs().maxCoeff(), 1e-9);
+
+			EXPECT_NEAR(xs[k], lxs[k], 1e-9);
+			EXPECT_NEAR(ys[k], lys[k], 1e-9);
+			EXPECT_NEAR(zs[k], lzs[k], 1e-9);
+
+			EXPECT_NEAR(gx, fx[k], 1e-4);
+			EXPECT_NEAR(gy, fy[k], 1e-4);
+			EXPECT_NEAR(gz, fz[k], 1e-4);
+		}
+	}
+}
+
+TEST_F(Pose3DTests, BatchComposePoses)
+{
+	std::vector<TPose3D> in;
+	for (const auto& i : ptc)
+		in.emplace_back(
+			i[0], i[1], i[2], DEG2RAD(i[3]), DEG2RAD(i[4]), DEG2RAD(i[5]));
+
+	for (const auto& i : ptc)
+	{
+		const CPose3D p(
+			i[0], i[1], i[2], DEG2RAD(i[3]), DEG2RAD(i[4]), DEG2RAD(i[5]));
+		std::vector<TPose3D> out = in;
+		p.composePoses(in.size(), &out[0], &out[0]);  // In-place
+		for (size_t k = 0; k < in.size(); k++)
+		{
+			const CPose3D ref = p + CPose3D(in[k]);
+			const CMatrixDouble44 HM_ref =
+				ref.getHomogeneousMatrixVal<CMatrixDouble44>();
+			const CMatrixDouble44 HM =
+				CPose3D(out[k]).getHomogeneousMatrixVal<CMatrixDouble44>();
+			EXPECT_NEAR(0, (HM_ref - HM).array().abs().maxCoeff(), 1e-9)
+				<< "p: " << p << "\nin: " << in[k] << "\n";
+		}
+	}
+}
@@ -14,12 +14,110 @@
 #include <mrpt/math/wrap2pi.h>
 #include <mrpt/math/interp_fit.hpp>
 #include <mrpt/math/CMatrixD.h>
+#include <mrpt/core/bits_math.h>  // keep_min()
 #include <mrpt/poses/CPose3DPDFParticles.h>
 #include <mrpt/system/datetime.h>
 #include <fstream>
 
 namespace mrpt::poses
 {
+namespace detail
+{
+/** The cubic spline of mrpt::math::spline() through 4 knots, with its
+ * coefficients computed once so it can be evaluated at many query times */
+struct TSpline4
+{
+	double x[4];
+	/** For each interval [x_j,x_j+1]: the cubic and linear terms in
+	 * (t-x_j) and (x_j+1-t) */
+	double c[3][4];
+	bool wrap2pi;
+
+	template <class VECTORLIKE>
+	TSpline4(const VECTORLIKE& xs, const VECTORLIKE& ys, bool wrap = false)
+		: wrap2pi(wrap)
+	{
+		ASSERT_(xs[0] <= xs[1] && xs[1] <= xs[2] && xs[2] <= xs[3]);
+		double y[4], h[3];
+		for (int i = 0; i < 4; i++)
+		{
+			x[i] = xs[i];
+			y[i] = wrap2pi ? mrpt::math::wrapToPi(ys[i]) : ys[i];
+		}
+		if (wrap2pi)
+		{
+			// Assure the function is linear without jumps in the interval:
+			for (int i = 1; i < 4; i++)
+			{
+				const double Ay = y[i] - y[i - 1];
+				if (Ay > M_PI)
+					y[i] -= M_2PI;
+				else if (Ay < -M_PI)
+					y[i] += M_2PI;
+			}
+		}
+		for (int i = 0; i < 3; i++) h[i] = x[i + 1] - x[i];
+
+		const double k = 1 / (4 * h[0] * h[1] + 4 * h[0] * h[2] +
+							  3 * h[1] * h[1] + 4 * h[1] * h[2]);
+		const double a11 = 2 * (h[1] + h[2]) * k, a12 = -h[1] * k,
+					 a22 = 2 * (h[0] + h[1]) * k;
+		const double b1 = (y[2] - y[1]) / h[1] - (y[1] - y[0]) / h[0];
+		const double b2 = (y[3] - y[2]) / h[2] - (y[2] - y[1]) / h[1];
+		// Second derivatives at the knots (natural spline):
+		const double z[4] = {0, 6 * (a11 * b1 + a12 * b2),
+							 6 * (a12 * b1 + a22 * b2), 0};
+		for (int j = 0; j < 3; j++)
+		{
+			c[j][0] = z[j + 1] / (6 * h[j]);
+			c[j][1] = z[j] / (6 * h[j]);
+			c[j][2] = y[j + 1] / h[j] - h[j] / 6 * z[j + 1];
+			c[j][3] = y[j] / h[j] - h[j] / 6 * z[j];
+		}
+	}
+
+	double operator()(const double t) const
+	{
+		const int j = t < x[1] ? 0 : (t < x[2] ? 1 : 2);
+		const double d1 = t - x[j], d2 = x[j + 1] - t;
+		const double res = c[j][0] * d1 * d1 * d1 + c[j][1] * d2 * d2 * d2 +
+						   c[j][2] * d1 + c[j][3] * d2;
+		return wrap2pi ? mrpt::math::wrapToPi(res) : res;
+	}
+};
+
+/** The least-squares line of mrpt::math::leastSquareLinearFit() through 4
+ * knots, computed once so it can be evaluated at many query times */
+struct TLinearFit4
+{
+	double x_min, b0, b1;
+	bool wrap2pi;
+
+	template <class VECTORLIKE>
+	TLinearFit4(const VECTORLIKE& xs, const VECTORLIKE& ys, bool wrap = false)
+		: x_min(xs[0]), wrap2pi(wrap)
+	{
+		for (int i = 1; i < 4; i++) mrpt::keep_min(x_min, xs[i]);
+		double Su = 0, Suu = 0, Sy = 0, Suy = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			const double u = xs[i] - x_min;
+			Su += u;
+			Suu += u * u;
+			Sy += ys[i];
+			Suy += u * ys[i];
+		}
+		b1 = (4 * Suy - Su * Sy) / (4 * Suu - Su * Su);
+		b0 = (Sy - b1 * Su) / 4;
+	}
+
+	double operator()(const double t) const
+	{
+		const double res = b0 + b1 * (t - x_min);
+		return wrap2pi ? mrpt::math::wrapToPi(res) : res;
+	}
+};
+}  // namespace detail
 
 template <int DIM>
 CPoseInterpolatorBase<DIM>::CPoseInterpolatorBase() :
@@ -37,12 +135,22 @@ void CPoseInterpolatorBase<DIM>::clear()
 template <int DIM>
 void CPoseInterpolatorBase<DIM>::insert(const mrpt::Clock::time_point &t, const cpose_t &p)
 {
-	m_path[t] = p.asTPose();
+	insert(t, p.asTPose());
 }
 template <int DIM>
 void CPoseInterpolatorBase<DIM>::insert(const mrpt::Clock::time_point &t, const pose_t &p)
 {
-	m_path[t] = p;
+	// Most common case: poses are inserted in chronological order
+	if (m_path.empty() || m_path.back().first < t)
+	{
+		m_path.emplace_back(t, p);
+		return;
+	}
+	iterator it = lower_bound(t);
+	if (it->first == t)
+		it->second = p;
+	else
+		m_path.emplace(it, t, p);
 }
 
 /*---------------------------------------------------------------
@@ -64,9 +172,95 @@ typename CPoseInterpolatorBase<DIM>::pose_t & CPoseInterpolatorBase<DIM>::interp
 	for (size_t k=0;k<pose_t::static_size;k++) {
 		out_interp[k]=0;
 	}
+
+	// Out of range?
+	const_iterator it_ge1 = lower_bound( t );
+
+	// Exact match?
+	if( it_ge1 != m_path.end() && it_ge1->first == t )
+	{
+		out_interp = it_ge1->second;
+		out_valid_interp = true;
+		return out_interp;
+	}
+
+	TTimePosePair p1, p2, p3, p4;
+	if (!impl_get_knots(it_ge1 - m_path.begin(), p1, p2, p3, p4))
+	{
+		out_valid_interp = false;
+		return out_interp;
+	}
+
+	// Do interpolation:
+	// ------------------------------------------
+	// First Previous point:  p1
+	// Second Previous point: p2
+	// First Next point:	  p3
+	// Second Next point:     p4
+	// Time where to interpolate:  t
+
+	impl_interpolation(p1,p2,p3,p4, m_method,&t,&out_interp,1);
+
+	out_valid_interp = true;
+	return out_interp;
+
+} // end interpolate
+
+template <int DIM>
+void CPoseInterpolatorBase<DIM>::interpolate(
+	const std::vector<mrpt::Clock::time_point>& t,
+	std::vector<pose_t>& out_interp, std::vector<bool>& out_valid_interp) const
+{
+	const size_t N = t.size(), nKnots = m_path.size();
+	out_interp.resize(N);
+	out_valid_interp.assign(N, false);
+
+	// Index of the first knot with time >= t[i]:
+	size_t idx = 0;
 	TTimePosePair p1, p2, p3, p4;
-	p1.second = p2.second = p3.second = p4.second = out_interp;
+	for (size_t i = 0; i < N;)
+	{
+		if (i > 0 && t[i] >= t[i - 1])
+		{
+			// Sorted queries: scan forward from the previous knot
+			while (idx < nKnots && m_path[idx].first < t[i]) idx++;
+		}
+		else
+			idx = lower_bound(t[i]) - m_path.begin();
+
+		// Exact match?
+		if (idx < nKnots && m_path[idx].first == t[i])
+		{
+			out_interp[i] = m_path[idx].second;
+			out_valid_interp[i] = true;
+			i++;
+			continue;
+		}
+
+		if (!impl_get_knots(idx, p1, p2, p3, p4))
+		{
+			for (size_t k = 0; k < pose_t::static_size; k++)
+				out_interp[i][k] = 0;
+			i++;
+			continue;
+		}
+
+		// All the next queries between the same two knots share the setup:
+		size_t j = i + 1;
+		while (j < N && t[j] > p2.first && t[j] < p3.first) j++;
+
+		impl_interpolation(
+			p1, p2, p3, p4, m_method, &t[i], &out_interp[i], j - i);
+		for (size_t k = i; k < j; k++) out_valid_interp[k] = true;
+		i = j;
+	}
+}
 
+template <int DIM>
+bool CPoseInterpolatorBase<DIM>::impl_get_knots(
+	const size_t idx, TTimePosePair& p1, TTimePosePair& p2,
+	TTimePosePair& p3, TTimePosePair& p4) const
+{
 	// We'll look for 4 consecutive time points.
 	// Check if the selected method needs all 4 points or just the central 2 of them:
 	bool interp_method_requires_4pts;
@@ -82,50 +276,32 @@ typename CPoseInterpolatorBase<DIM>::pose_t & CPoseInterpolatorBase<DIM>::interp
 		break;
 	};
 
-
-	// Out of range?
-	const_iterator it_ge1 = m_path.lower_bound( t );
-
-	// Exact match?
-	if( it_ge1 != m_path.end() && it_ge1->first == t )
-	{
-		out_interp = it_ge1->second;
-		out_valid_interp = true;
-		return out_interp;
-	}
-
 	// Are we in the beginning or the end of the path?
-	if( it_ge1 == m_path.end() || it_ge1 == m_path.begin() )
-	{
-		out_valid_interp = false;
-		return out_interp;
-	} // end
+	const size_t nKnots = m_path.size();
+	if (idx >= nKnots || idx == 0) return false;
 
-	p3 = *it_ge1;		// Third pair
-	const_iterator it_ge2 = it_ge1; ++it_ge2;
-	if(it_ge2 == m_path.end() )
+	p3 = m_path[idx];  // Third pair
+	if (idx + 1 >= nKnots)
 	{
-		if (interp_method_requires_4pts) {
-			out_valid_interp = false;
-			return out_interp;
-		}
-	}
-	else {
-		p4 = *(it_ge2);		// Fourth pair
+		if (interp_method_requires_4pts) return false;
+		// Unused by the method, but leave it with well-defined values:
+		p4.first = mrpt::Clock::time_point();
+		for (size_t k = 0; k < pose_t::static_size; k++) p4.second[k] = 0;
 	}
+	else
+		p4 = m_path[idx + 1];  // Fourth pair
 
-	p2 = *(--it_ge1);	// Second pair
+	p2 = m_path[idx - 1];  // Second pair
 
-	if( it_ge1 == m_path.begin() )
+	if (idx == 1)
 	{
-		if (interp_method_requires_4pts) {
-			out_valid_interp = false;
-			return out_interp;
-		}
-	}
-	else {
-		p1 = *(--it_ge1);	// First pair
+		if (interp_method_requires_4pts) return false;
+		// Unused by the method, but leave it with well-defined values:
+		p1.first = mrpt::Clock::time_point();
+		for (size_t k = 0; k < pose_t::static_size; k++) p1.second[k] = 0;
 	}
+	else
+		p1 = m_path[idx - 2];  // First pair
 
 	// Test if the difference between the desired timestamp and the next timestamp is lower than a certain (configurable) value
 	const mrpt::Clock::duration dt12 = interp_method_requires_4pts ? (p2.first - p1.first) : mrpt::Clock::duration(0);
@@ -136,25 +312,10 @@ typename CPoseInterpolatorBase<DIM>::pose_t & CPoseInterpolatorBase<DIM>::interp
 	  (dt12 > maxTimeInterpolation ||
 	   dt23 > maxTimeInterpolation ||
 	   dt34 > maxTimeInterpolation ))
-	{
-		out_valid_interp = false;
-		return out_interp;
-	}
-
-	// Do interpolation:
-	// ------------------------------------------
-	// First Previous point:  p1
-	// Second Previous point: p2
-	// First Next point:	  p3
-	// Second Next point:     p4
-	// Time where to interpolate:  t
-
-	impl_interpolation(p1,p2,p3,p4, m_method,t,out_interp);
-
-	out_valid_interp = true;
-	return out_interp;
+		return false;
 
-} // end interpolate
+	return true;
+}
 
 template <int DIM>
 bool CPoseInterpolatorBase<DIM>::getPreviousPoseWithMinDistance(const mrpt::Clock::time_point &t, double distance, cpose_t &out_pose)
@@ -174,7 +335,7 @@ bool CPoseInterpolatorBase<DIM>::getPreviousPoseWithMinDistance(const mrpt::Cloc
 	pose_t myPose;
 
 	// Search for the desired timestamp
-	iterator  it = m_path.find(t);
+	iterator  it = find(t);
 	if( it != m_path.end() && it != m_path.begin() )
 		myPose = it->second;
 	else
@@ -397,7 +558,7 @@ void CPoseInterpolatorBase<DIM>::filter( unsigned int component, unsigned int sa
 
 		mrpt::poses::CPose3D auxPose;
 		particles.getMean( auxPose );
-		aux[it1->first] = pose_t(auxPose.asTPose());
+		aux.emplace_back(it1->first, pose_t(auxPose.asTPose()));
 	} // end for it1
 	m_path = aux;
 }
@@ -9,4 +9,5 @@
 #pragma once
 
 #include "random/RandomGenerators.h"
+#include "random/CCounterBasedRandomGenerator.h"
 #include "random/random_shuffle.h"
@@ -0,0 +1,163 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mrpt
+{
+namespace random
+{
+/** A counter-based pseudo random number generator (Philox4x32-10), intended
+ * for drawing large batches of samples and for parallel programs.
+ *
+ * The n-th 128-bit output block is a pure function of (seed, substream, n),
+ * so:
+ *  - Different threads can use independent, reproducible substreams by
+ *    creating their generators with substream() (e.g. one per thread index).
+ *  - Several threads can cooperatively fill one long sequence by seek()'ing
+ *    each generator to the first block of their chunk: the result does not
+ *    depend on the number of threads.
+ *  - The inner loop has no sequential state, so the batch methods
+ *    (drawUniformBatch(), drawGaussian1DBatch()) generate several blocks per
+ *    iteration in a SIMD-friendly way.
+ *
+ * As with CRandomGenerator, one object must not be shared among threads
+ * without external synchronization.
+ *
+ * Reference: J. K. Salmon, M. A. Moraes, R. O. Dror, D. E. Shaw, "Parallel
+ * random numbers: as easy as 1, 2, 3", SC'11.
+ *
+ * \sa CRandomGenerator
+ * \ingroup mrpt_random_grp
+ */
+class CCounterBasedRandomGenerator
+{
+   public:
+	/** Number of 32bit words generated per counter value */
+	static constexpr std::size_t BLOCK_WORDS = 4;
+
+	/** Constructor from a seed and an optional substream index */
+	CCounterBasedRandomGenerator(
+		const uint64_t seed = 0, const uint64_t substream = 0)
+	{
+		randomize(seed, substream);
+	}
+
+	/** @name Initialization
+	 @{ */
+
+	/** Resets the generator to the first block of the given substream */
+	void randomize(const uint64_t seed, const uint64_t substream = 0);
+
+	/** Returns a new generator for the same seed but a different, independent
+	 * substream, positioned at its beginning. Typical usage is one substream
+	 * per worker thread or per particle chunk. */
+	CCounterBasedRandomGenerator substream(const uint64_t id) const
+	{
+		return CCounterBasedRandomGenerator(m_seed, id);
+	}
+
+	/** Moves to the beginning of the given 128-bit block within the current
+	 * substream, discarding any partially consumed block. Each block holds
+	 * BLOCK_WORDS uniform 32bit values, i.e. BLOCK_WORDS uniform samples or
+	 * BLOCK_WORDS gaussian samples when using the batch methods. */
+	void seek(const uint64_t block_index);
+
+	uint64_t getSeed() const { return m_seed; }
+	uint64_t getSubstream() const { return m_substream; }
+	/** Index of the next block to be generated */
+	uint64_t getBlockCounter() const { return m_counter; }
+	/** @} */
+
+	/** @name Scalar draws
+	 @{ */
+
+	/** Returns the next 32bit word of the stream */
+	uint32_t drawUniform32bit()
+	{
+		if (m_buf_idx >= BLOCK_WORDS) refillBuffer();
+		return m_buf[m_buf_idx++];
+	}
+
+	/** Returns a sample uniformly distributed in [Min,Max] */
+	double drawUniform(const double Min, const double Max)
+	{
+		return Min +
+			   (Max - Min) * drawUniform32bit() *
+				   2.3283064370807973754314699618685e-10;  // 0xFFFFFFFF ^ -1
+	}
+	/** @} */
+
+	/** @name Batch draws
+	 * These methods always start at a block boundary (any partially consumed
+	 * block is discarded) and leave the generator positioned at the block
+	 * following the last one used, so that the same sequence is obtained
+	 * regardless of how a long batch is split into shorter calls whose
+	 * lengths are multiples of BLOCK_WORDS.
+	 @{ */
+
+	/** Fills `out[0:N-1]` with raw uniform 32bit words */
+	void drawUniform32bitBatch(uint32_t* out, const std::size_t N);
+
+	/** Fills `out[0:N-1]` with independent samples, uniformly distributed in
+	 * [Min,Max], like drawUniform() */
+	void drawUniformBatch(
+		double* out, const std::size_t N, const double Min = 0,
+		const double Max = 1);
+	/** \overload */
+	void drawUniformBatch(
+		float* out, const std::size_t N, const double Min = 0,
+		const double Max = 1);
+
+	/** Fills `out[0:N-1]` with independent samples of a normal distribution
+	 * (Box-Muller transform over pairs of uniform samples). */
+	void drawGaussian1DBatch(
+		double* out, const std::size_t N, const double mean = 0,
+		const double std = 1);
+	/** \overload */
+	void drawGaussian1DBatch(
+		float* out, const std::size_t N, const double mean = 0,
+		const double std = 1);
+
+	/** Resizes and fills a std::vector<> with normally distributed samples
+	 * \sa drawGaussian1DBatch */
+	template <typename T>
+	void drawGaussian1DVector(
+		std::vector<T>& v, const std::size_t N, const double mean = 0,
+		const double std = 1)
+	{
+		v.resize(N);
+		if (N) drawGaussian1DBatch(&v[0], N, mean, std);
+	}
+	/** @} */
+
+	/** Computes `nBlocks` consecutive output blocks of the Philox4x32-10
+	 * function, starting at block index `first_block`, and stores them in
+	 * `out[0:4*nBlocks-1]`. This is the stateless kernel used by all other
+	 * methods. */
+	static void generateBlocks(
+		const uint64_t seed, const uint64_t substream,
+		const uint64_t first_block, const std::size_t nBlocks, uint32_t* out);
+
+   private:
+	uint64_t m_seed{0}, m_substream{0};
+	/** Index of the next block to generate */
+	uint64_t m_counter{0};
+	std::array<uint32_t, BLOCK_WORDS> m_buf;
+	std::size_t m_buf_idx{BLOCK_WORDS};
+
+	void refillBuffer();
+};
+
+}  // namespace random
+}  // namespace mrpt
@@ -143,6 +143,19 @@ class CRandomGenerator
 				drawUniform(unif_min, unif_max));
 	}
 
+	/** Fills `out[0:N-1]` with independent samples uniformly distributed in
+	 * [Min,Max]. Faster than repeated calls to drawUniform(), since each 64bit
+	 * output of the MT19937_64 engine provides two samples.
+	 * \sa CCounterBasedRandomGenerator for parallel, reproducible substreams.
+	 */
+	void drawUniformBatch(
+		double* out, const size_t N, const double Min = 0,
+		const double Max = 1);
+	/** \overload */
+	void drawUniformBatch(
+		float* out, const size_t N, const double Min = 0,
+		const double Max = 1);
+
 	/** @} */
 
 	/** @name Normal/Gaussian pdf
@@ -164,6 +177,22 @@ class CRandomGenerator
 		return mean + std * drawGaussian1D_normalized();
 	}
 
+	/** Fills `out[0:N-1]` with independent, normally distributed samples.
+	 * Faster than repeated calls to drawGaussian1D(), since each 64bit output
+	 * of the MT19937_64 engine provides the two uniform samples of one
+	 * Box-Muller transform, which yields two normal samples.
+	 * Note that, for the same seed, the generated sequence differs from that of
+	 * drawGaussian1D_normalized().
+	 * \sa CCounterBasedRandomGenerator for parallel, reproducible substreams.
+	 */
+	void drawGaussian1DBatch(
+		double* out, const size_t N, const double mean = 0,
+		const double std = 1);
+	/** \overload */
+	void drawGaussian1DBatch(
+		float* out, const size_t N, const double mean = 0,
+		const double std = 1);
+
 	/** Fills the given matrix with independent, 1D-normally distributed
 	 * samples.
 	  * Matrix classes can be mrpt::math::CMatrixTemplateNumeric or
@@ -0,0 +1,195 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include "random-precomp.h"  // Precompiled headers
+
+#include <mrpt/random/CCounterBasedRandomGenerator.h>
+#include <algorithm>
+#include "box_muller.h"
+
+using namespace mrpt::random;
+
+// Philox4x32 constants (Salmon et al., SC'11)
+static constexpr uint32_t PHILOX_M0 = 0xD2511F53;
+static constexpr uint32_t PHILOX_M1 = 0xCD9E8D57;
+static constexpr uint32_t PHILOX_W0 = 0x9E3779B9;
+static constexpr uint32_t PHILOX_W1 = 0xBB67AE85;
+static constexpr unsigned int PHILOX_ROUNDS = 10;
+
+// Number of blocks computed together in the inner loop. The body has no
+// cross-lane dependencies, so compilers can map it onto SIMD registers.
+static constexpr std::size_t PHILOX_LANES = 8;
+
+// Number of blocks generated in each stack-allocated chunk of batch methods:
+static constexpr std::size_t CHUNK_BLOCKS = 64;
+
+void CCounterBasedRandomGenerator::generateBlocks(
+	const uint64_t seed, const uint64_t substream, const uint64_t first_block,
+	const std::size_t nBlocks, uint32_t* out)
+{
+	const uint32_t key0 = static_cast<uint32_t>(seed);
+	const uint32_t key1 = static_cast<uint32_t>(seed >> 32);
+	const uint32_t s0 = static_cast<uint32_t>(substream);
+	const uint32_t s1 = static_cast<uint32_t>(substream >> 32);
+
+	std::size_t b = 0;
+	while (b < nBlocks)
+	{
+		const std::size_t nLanes = std::min(PHILOX_LANES, nBlocks - b);
+
+		uint32_t c0[PHILOX_LANES], c1[PHILOX_LANES], c2[PHILOX_LANES],
+			c3[PHILOX_LANES];
+		for (std::size_t l = 0; l < PHILOX_LANES; l++)
+		{
+			const uint64_t ctr = first_block + b + l;
+			c0[l] = static_cast<uint32_t>(ctr);
+			c1[l] = static_cast<uint32_t>(ctr >> 32);
+			c2[l] = s0;
+			c3[l] = s1;
+		}
+
+		uint32_t k0 = key0, k1 = key1;
+		for (unsigned int r = 0; r < PHILOX_ROUNDS; r++)
+		{
+			for (std::size_t l = 0; l < PHILOX_LANES; l++)
+			{
+				const uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c0[l];
+				const uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c2[l];
+				const uint32_t n0 =
+					static_cast<uint32_t>(p1 >> 32) ^ c1[l] ^ k0;
+				const uint32_t n2 =
+					static_cast<uint32_t>(p0 >> 32) ^ c3[l] ^ k1;
+				c1[l] = static_cast<uint32_t>(p1);
+				c3[l] = static_cast<uint32_t>(p0);
+				c0[l] = n0;
+				c2[l] = n2;
+			}
+			k0 += PHILOX_W0;
+			k1 += PHILOX_W1;
+		}
+
+		for (std::size_t l = 0; l < nLanes; l++)
+		{
+			uint32_t* o = out + BLOCK_WORDS * (b + l);
+			o[0] = c0[l];
+			o[1] = c1[l];
+			o[2] = c2[l];
+			o[3] = c3[l];
+		}
+		b += nLanes;
+	}
+}
+
+void CCounterBasedRandomGenerator::randomize(
+	const uint64_t seed, const uint64_t substream)
+{
+	m_seed = seed;
+	m_substream = substream;
+	seek(0);
+}
+
+void CCounterBasedRandomGenerator::seek(const uint64_t block_index)
+{
+	m_counter = block_index;
+	m_buf_idx = BLOCK_WORDS;
+}
+
+void CCounterBasedRandomGenerator::refillBuffer()
+{
+	generateBlocks(m_seed, m_substream, m_counter++, 1, &m_buf[0]);
+	m_buf_idx = 0;
+}
+
+void CCounterBasedRandomGenerator::drawUniform32bitBatch(
+	uint32_t* out, const std::size_t N)
+{
+	m_buf_idx = BLOCK_WORDS;  // Always start at a block boundary
+	const std::size_t nFull = N / BLOCK_WORDS;
+	generateBlocks(m_seed, m_substream, m_counter, nFull, out);
+	m_counter += nFull;
+
+	const std::size_t nRem = N - nFull * BLOCK_WORDS;
+	if (nRem)
+	{
+		refillBuffer();
+		std::copy(&m_buf[0], &m_buf[0] + nRem, out + nFull * BLOCK_WORDS);
+		m_buf_idx = BLOCK_WORDS;
+	}
+}
+
+namespace
+{
+/** Common implementation of the batch methods: generates the blocks in
+ * chunks and converts them with the functor `conv(words, nWords, out)` */
+template <typename T, typename CONVERTER>
+void batchConvert(
+	CCounterBasedRandomGenerator& gen, T* out, const std::size_t N,
+	CONVERTER conv)
+{
+	constexpr std::size_t BW = CCounterBasedRandomGenerator::BLOCK_WORDS;
+	uint32_t words[CHUNK_BLOCKS * BW];
+	std::size_t i = 0;
+	while (i < N)
+	{
+		const std::size_t n = std::min(N - i, CHUNK_BLOCKS * BW);
+		// Round up to whole blocks, so partial blocks are consumed entirely:
+		const std::size_t nWords = ((n + BW - 1) / BW) * BW;
+		gen.drawUniform32bitBatch(words, nWords);
+		conv(words, n, out + i);
+		i += n;
+	}
+}
+
+template <typename T>
+void uniformImpl(
+	CCounterBasedRandomGenerator& gen, T* out, const std::size_t N,
+	const double Min, const double Max)
+{
+	// Same scaling than drawUniform(), so both sample [Min,Max]:
+	const double scale =
+		(Max - Min) * 2.3283064370807973754314699618685e-10;  // 0xFFFFFFFF^-1
+	batchConvert(
+		gen, out, N, [=](const uint32_t* w, const std::size_t n, T* o) {
+			for (std::size_t k = 0; k < n; k++)
+				o[k] = static_cast<T>(Min + scale * w[k]);
+		});
+}
+
+template <typename T>
+void gaussianImpl(
+	CCounterBasedRandomGenerator& gen, T* out, const std::size_t N,
+	const double mean, const double std)
+{
+	batchConvert(
+		gen, out, N, [=](const uint32_t* w, const std::size_t n, T* o) {
+			mrpt::random::internal::boxMuller(w, n, o, mean, std);
+		});
+}
+}  // namespace
+
+void CCounterBasedRandomGenerator::drawUniformBatch(
+	double* out, const std::size_t N, const double Min, const double Max)
+{
+	uniformImpl(*this, out, N, Min, Max);
+}
+void CCounterBasedRandomGenerator::drawUniformBatch(
+	float* out, const std::size_t N, const double Min, const double Max)
+{
+	uniformImpl(*this, out, N, Min, Max);
+}
+void CCounterBasedRandomGenerator::drawGaussian1DBatch(
+	double* out, const std::size_t N, const double mean, const double std)
+{
+	gaussianImpl(*this, out, N, mean, std);
+}
+void CCounterBasedRandomGenerator::drawGaussian1DBatch(
+	float* out, const std::size_t N, const double mean, const double std)
+{
+	gaussianImpl(*this, out, N, mean, std);
+}
@@ -10,6 +10,7 @@
 #include "random-precomp.h"  // Precompiled headers
 
 #include <mrpt/random/RandomGenerators.h>
+#include "box_muller.h"
 
 using namespace mrpt::random;
 
@@ -43,3 +44,69 @@ double CRandomGenerator::drawGaussian1D_normalized()
 {
 	return m_normdistribution(m_MT19937);
 }
+
+namespace
+{
+// Each 64bit output of the engine provides two uniform 32bit words:
+template <typename T, typename CONVERTER>
+void mtBatchConvert(std::mt19937_64& mt, T* out, const size_t N, CONVERTER conv)
+{
+	constexpr size_t CHUNK = 256;
+	uint32_t words[CHUNK];
+	for (size_t i = 0; i < N; i += CHUNK)
+	{
+		const size_t n = std::min(CHUNK, N - i);
+		for (size_t k = 0; k < n; k += 2)
+		{
+			const uint64_t r = mt();
+			words[k] = static_cast<uint32_t>(r);
+			words[k + 1] = static_cast<uint32_t>(r >> 32);
+		}
+		conv(words, n, out + i);
+	}
+}
+
+template <typename T>
+void mtUniformBatch(
+	std::mt19937_64& mt, T* out, const size_t N, const double Min,
+	const double Max)
+{
+	const double scale =
+		(Max - Min) * 2.3283064370807973754314699618685e-10;  // 0xFFFFFFFF^-1
+	mtBatchConvert(mt, out, N, [=](const uint32_t* w, const size_t n, T* o) {
+		for (size_t k = 0; k < n; k++)
+			o[k] = static_cast<T>(Min + scale * w[k]);
+	});
+}
+
+template <typename T>
+void mtGaussianBatch(
+	std::mt19937_64& mt, T* out, const size_t N, const double mean,
+	const double std)
+{
+	mtBatchConvert(mt, out, N, [=](const uint32_t* w, const size_t n, T* o) {
+		mrpt::random::internal::boxMuller(w, n, o, mean, std);
+	});
+}
+}  // namespace
+
+void CRandomGenerator::drawUniformBatch(
+	double* out, const size_t N, const double Min, const double Max)
+{
+	mtUniformBatch(m_MT19937, out, N, Min, Max);
+}
+void CRandomGenerator::drawUniformBatch(
+	float* out, const size_t N, const double Min, const double Max)
+{
+	mtUniformBatch(m_MT19937, out, N, Min, Max);
+}
+void CRandomGenerator::drawGaussian1DBatch(
+	double* out, const size_t N, const double mean, const double std)
+{
+	mtGaussianBatch(m_MT19937, out, N, mean, std);
+}
+void CRandomGenerator::drawGaussian1DBatch(
+	float* out, const size_t N, const double mean, const double std)
+{
+	mtGaussianBatch(m_MT19937, out, N, mean, std);
+}
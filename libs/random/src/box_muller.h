@@ -0,0 +1,42 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace mrpt
+{
+namespace random
+{
+namespace internal
+{
+/** Box-Muller transform of `n` uniform 32bit words into `n` normal samples.
+ * Each pair of words yields two independent samples; u1 is mapped into (0,1]
+ * to keep log() finite. If `n` is odd, the last sine sample is dropped. */
+template <typename T>
+inline void boxMuller(
+	const uint32_t* w, const std::size_t n, T* out, const double mean,
+	const double std)
+{
+	constexpr double k2Pow32 = 2.3283064365386963e-10;  // 2^-32
+	for (std::size_t k = 0; k < n; k += 2)
+	{
+		const double u1 = (w[k] + 1.0) * k2Pow32;
+		const double u2 = w[k + 1] * k2Pow32;
+		const double r = std * std::sqrt(-2.0 * std::log(u1));
+		const double th = 6.283185307179586476925286766559 * u2;
+		out[k] = static_cast<T>(mean + r * std::cos(th));
+		if (k + 1 < n) out[k + 1] = static_cast<T>(mean + r * std::sin(th));
+	}
+}
+}  // namespace internal
+}  // namespace random
+}  // namespace mrpt
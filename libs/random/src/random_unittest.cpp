@@ -8,7 +8,9 @@
    +------------------------------------------------------------------------+ */
 
 #include <mrpt/random/RandomGenerators.h>
+#include <mrpt/random/CCounterBasedRandomGenerator.h>
 #include <gtest/gtest.h>
+#include <cmath>
 
 TEST(Random, Randomize)
 {
@@ -26,3 +28,82 @@ TEST(Random, Randomize)
 	auto r1abis = rnd.drawUniform32bit();
 	EXPECT_EQ(r1a, r1abis);
 }
+
+TEST(Random, CounterBasedKnownAnswer)
+{
+	// Philox4x32-10 known-answer vector from the Random123 distribution:
+	uint32_t blk[4];
+	mrpt::random::CCounterBasedRandomGenerator::generateBlocks(0, 0, 0, 1, blk);
+	EXPECT_EQ(blk[0], 0x6627e8d5u);
+	EXPECT_EQ(blk[1], 0xe169c58du);
+	EXPECT_EQ(blk[2], 0xbc57ac4cu);
+	EXPECT_EQ(blk[3], 0x9b00dbd8u);
+}
+
+TEST(Random, CounterBasedBatchAndSeek)
+{
+	using namespace mrpt::random;
+
+	const size_t N = 1000;
+	CCounterBasedRandomGenerator gen(123);
+	std::vector<uint32_t> batch(N);
+	gen.drawUniform32bitBatch(&batch[0], N);
+
+	// Same sequence with scalar draws:
+	CCounterBasedRandomGenerator gen2(123);
+	for (size_t i = 0; i < N; i++) EXPECT_EQ(batch[i], gen2.drawUniform32bit());
+
+	// Same sequence filled in two chunks, as two threads would do:
+	CCounterBasedRandomGenerator ga(123), gb(123);
+	std::vector<uint32_t> split(N);
+	gb.seek(100);
+	gb.drawUniform32bitBatch(&split[400], N - 400);
+	ga.drawUniform32bitBatch(&split[0], 400);
+	EXPECT_EQ(batch, split);
+
+	// Different substreams are different:
+	auto gs = gen.substream(1);
+	std::vector<uint32_t> other(N);
+	gs.drawUniform32bitBatch(&other[0], N);
+	EXPECT_NE(batch, other);
+}
+
+TEST(Random, UniformBatchMatchesScalar)
+{
+	using namespace mrpt::random;
+
+	const size_t N = 1000;
+	std::vector<double> batch(N);
+	CCounterBasedRandomGenerator cb1(7), cb2(7);
+	cb1.drawUniformBatch(&batch[0], N, -2.0, 3.0);
+	for (size_t i = 0; i < N; i++)
+		EXPECT_DOUBLE_EQ(batch[i], cb2.drawUniform(-2.0, 3.0));
+}
+
+TEST(Random, GaussianBatchStatistics)
+{
+	using namespace mrpt::random;
+
+	const size_t N = 100000;
+	std::vector<double> v(N);
+	auto checkStats = [&]() {
+		double m = 0, m2 = 0;
+		for (const double x : v)
+		{
+			m += x;
+			m2 += x * x;
+		}
+		m /= N;
+		const double std = std::sqrt(m2 / N - m * m);
+		EXPECT_NEAR(m, 2.0, 0.02);
+		EXPECT_NEAR(std, 3.0, 0.03);
+	};
+
+	CCounterBasedRandomGenerator cbrng(1);
+	cbrng.drawGaussian1DBatch(&v[0], N, 2.0, 3.0);
+	checkStats();
+
+	CRandomGenerator rng(1);
+	rng.drawGaussian1DBatch(&v[0], N, 2.0, 3.0);
+	checkStats();
+}
@@ -159,6 +159,11 @@ class CMultiMetricMap : public mrpt::maps::CMetricMap
 	double internal_computeObservationLikelihood(
 		const mrpt::obs::CObservation* obs,
 		const mrpt::poses::CPose3D& takenFrom) override;
+	// See docs in base class
+	void internal_computeObservationLikelihoods(
+		const mrpt::obs::CObservation* obs,
+		const std::vector<mrpt::poses::CPose3D>& takenFrom,
+		double* out_log_liks) override;
 
    public:
 	/** @name Access to internal list of maps: direct list, iterators, utility
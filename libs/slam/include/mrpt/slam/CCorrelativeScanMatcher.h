@@ -0,0 +1,131 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+#pragma once
+
+#include <mrpt/slam/CMetricMapsAlignmentAlgorithm.h>
+#include <mrpt/config/CLoadableOptions.h>
+#include <mrpt/core/bits_math.h>
+#include <mrpt/poses/CPose2D.h>
+
+namespace mrpt::slam
+{
+/** A global 2D scan matcher: an exhaustive search of the (x,y,phi) pose of a
+ * points map (m2) over a reference map (m1) within a search window, made
+ * fast by branch-and-bound over a multi-resolution grid.
+ *
+ * The reference map is converted into a likelihood field (a grid whose cells
+ * hold exp(-d^2/(2*sigma^2)), with "d" the distance to the closest obstacle),
+ * from which a pyramid of grids is built, where each cell of level "h" holds
+ * the maximum of the 2^h x 2^h cells of the finest grid starting at that
+ * cell. The score of a candidate pose is the average likelihood of the
+ * points of m2, thus the score of a coarse candidate bounds from above all
+ * its finer children, so whole branches of the search tree can be discarded
+ * without missing the global optimum (up to the grid discretization).
+ * Rotations are searched in discrete steps, and distributed among threads.
+ *
+ * This implements the method in: W. Hess, D. Kohler, H. Rapp, D. Andor,
+ * "Real-Time Loop Closure in 2D LIDAR SLAM", ICRA 2016.
+ *
+ * Unlike CICP, the result does not depend on a good initial guess as long as
+ * the true pose is within the search window, so it is well suited to check
+ * loop closures. Its output may then be refined with CICP.
+ *
+ * \sa CMetricMapsAlignmentAlgorithm, CICP
+ * \ingroup mrpt_slam_grp
+ */
+class CCorrelativeScanMatcher : public mrpt::slam::CMetricMapsAlignmentAlgorithm
+{
+   public:
+	/** The algorithm configuration data */
+	class TConfigParams : public mrpt::config::CLoadableOptions
+	{
+	   public:
+		void loadFromConfigFile(
+			const mrpt::config::CConfigFileBase& source,
+			const std::string& section) override;  // See base docs
+		void saveToConfigFile(
+			mrpt::config::CConfigFileBase& c,
+			const std::string& s) const override;  // See base docs
+
+		/** Half size of the search window in x and y [m], around the initial
+		 * estimation (Default: 1 m) */
+		double linear_window{1.0};
+		/** Half size of the search window in orientation [rad], around the
+		 * initial estimation (Default: 30 deg) */
+		double angular_window{mrpt::DEG2RAD(30.0)};
+		/** Orientation step [rad]. If 0 (default), it is computed such as the
+		 * farthest point in m2 moves about one cell per step. */
+		double angular_step{0};
+		/** Cell size [m] of the likelihood grid if m1 is a points map. If it
+		 * is a grid map, its own resolution is used. (Default: 0.05 m) */
+		double resolution{0.05};
+		/** Std. deviation [m] of the likelihood field around obstacles
+		 * (Default: 0.10 m) */
+		double sigma{0.10};
+		/** Number of levels of the grid pyramid (Default: 7) */
+		unsigned int pyramid_levels{7};
+		/** Minimum score in [0,1] for a solution to be accepted (Default:
+		 * 0.5). Higher values make the search faster. */
+		double min_score{0.5};
+		/** Only use at most this number of points from m2 (0: all). Points
+		 * are uniformly decimated (Default: 500) */
+		unsigned int max_points{500};
+		/** Number of threads for the search over rotations (0: as many as
+		 * hardware threads) */
+		unsigned int num_threads{0};
+	};
+
+	/** The algorithm options */
+	TConfigParams options;
+
+	/** The algorithm return information */
+	struct TReturnInfo
+	{
+		/** The score of the solution, in [0,1]: the average likelihood of the
+		 * points of m2. It is 0 if no pose was found with a score above
+		 * TConfigParams::min_score */
+		float goodness{0};
+		/** Number of grid poses whose score was evaluated, at any level */
+		size_t nEvaluatedCandidates{0};
+		/** Number of orientations in the search */
+		size_t nRotations{0};
+	};
+
+	/** Finds the pose of m2 relative to m1 within the search window defined
+	 * in "options", centered at the mean of initialEstimationPDF.
+	 *
+	 * \param m1			[IN] The reference map: a
+	 * mrpt::maps::COccupancyGridMap2D, a mrpt::maps::CMultiMetricMap with a
+	 * grid map, or any map which can be converted into a points map.
+	 * \param m2			[IN] The map to be aligned: any map which can be
+	 * converted into a points map.
+	 * \param initialEstimationPDF	[IN] Center of the search window (its
+	 * covariance is ignored).
+	 * \param runningTime	[OUT] A pointer to a container for obtaining the
+	 * algorithm running time in seconds, or nullptr if you don't need it.
+	 * \param info	[OUT] A pointer to a TReturnInfo struct, or nullptr.
+	 *
+	 * \return A mrpt::poses::CPosePDFGaussian, with a covariance given by the
+	 * grid discretization. If no pose had a score above
+	 * TConfigParams::min_score, the initial estimation is returned and
+	 * TReturnInfo::goodness is 0.
+	 */
+	mrpt::poses::CPosePDF::Ptr AlignPDF(
+		const mrpt::maps::CMetricMap* m1, const mrpt::maps::CMetricMap* m2,
+		const mrpt::poses::CPosePDFGaussian& initialEstimationPDF,
+		float* runningTime = nullptr, void* info = nullptr) override;
+
+	/** Not applicable in this class, will launch an exception. */
+	mrpt::poses::CPose3DPDF::Ptr Align3DPDF(
+		const mrpt::maps::CMetricMap* m1, const mrpt::maps::CMetricMap* m2,
+		const mrpt::poses::CPose3DPDFGaussian& initialEstimationPDF,
+		float* runningTime = nullptr, void* info = nullptr) override;
+};
+
+}
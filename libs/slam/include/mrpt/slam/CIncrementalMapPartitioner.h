@@ -11,6 +11,7 @@
 
 #include <mrpt/system/COutputLogger.h>
 #include <mrpt/config/CLoadableOptions.h>
+#include <mrpt/graphs/CGraphPartitioner.h>
 #include <mrpt/maps/CMultiMetricMap.h>
 #include <mrpt/maps/CSimplePointsMap.h>
 #include <mrpt/maps/CSimpleMap.h>
@@ -181,15 +182,23 @@ class CIncrementalMapPartitioner : public mrpt::system::COutputLogger,
 		mrpt::opengl::CSetOfObjects::Ptr& objs,
 		const std::map<uint32_t, int64_t>* renameIndexes = NULL) const;
 
-	/** Return a copy of the adjacency matrix.  */
+	/** Return a dense copy of the adjacency matrix. Note that this takes
+	 * O(N^2) memory: prefer getSparseAdjacency() for large maps. */
 	template <class MATRIX>
 	void getAdjacencyMatrix(MATRIX& outMatrix) const
 	{
-		outMatrix = m_A;
+		const auto n = m_A.size();
+		outMatrix.setZero(n, n);
+		for (size_t i = 0; i < n; i++)
+			for (const auto& e : m_A[i]) outMatrix(i, e.first) = e.second;
 	}
 
-	/** Return a const ref to the internal adjacency matrix.  */
-	const mrpt::math::CMatrixDouble& getAdjacencyMatrix() const { return m_A; }
+	/** Return a const ref to the internal (sparse) adjacency matrix, which
+	 * only holds the pairs of keyframes with a nonzero similarity. */
+	const mrpt::graphs::sparse_adjacency_t<double>& getSparseAdjacency() const
+	{
+		return m_A;
+	}
 
 	/** Read-only access to the sequence of Sensory Frames */
 	const mrpt::maps::CSimpleMap* getSequenceOfFrames() const
@@ -208,8 +217,11 @@ class CIncrementalMapPartitioner : public mrpt::system::COutputLogger,
 	mrpt::maps::CSimpleMap m_individualFrames;
 	std::deque<mrpt::maps::CMultiMetricMap::Ptr> m_individualMaps;
 
-	/** Adjacency matrix */
-	mrpt::math::CMatrixD m_A{ 0,0 };
+	/** Adjacency matrix, only with nonzero similarities */
+	mrpt::graphs::sparse_adjacency_t<double> m_A;
+	/** Fiedler vector of the last bisection, used as initial guess for the
+	 * next updatePartitions() */
+	std::vector<double> m_fiedler;
 
 	/** The last partition */
 	std::vector<std::vector<uint32_t>> m_last_partition;
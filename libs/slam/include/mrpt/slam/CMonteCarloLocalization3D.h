@@ -117,6 +117,12 @@ class CMonteCarloLocalization3D
 		const size_t particleIndexForMap,
 		const mrpt::obs::CSensoryFrame& observation,
 		const mrpt::poses::CPose3D& x) const override;
+	/** Evaluates all the particles at once if there is one map for all */
+	void PF_SLAM_computeObservationLikelihoodForParticles(
+		const mrpt::bayes::CParticleFilter::TParticleFilterOptions& PF_options,
+		const mrpt::obs::CSensoryFrame& observation,
+		const std::vector<mrpt::poses::CPose3D>& x,
+		std::vector<double>& out_log_liks) const override;
 	/** @} */
 
 };  // End of class def.
@@ -86,7 +86,8 @@ class CRangeBearingKFSLAM
 	 * out_landmarksPositions) gives the corresponding landmark ID.
 	  *  \param out_fullState The complete state vector (7+3M).
 	  *  \param out_fullCovariance The full (7+3M)x(7+3M) covariance matrix of
-	 * the filter.
+	 * the filter. With the mrpt::bayes::kfEIF method, it is recovered on
+	 * demand from the information matrix.
 	  * \sa getCurrentRobotPose
 	  */
 	void getCurrentState(
@@ -76,7 +76,8 @@ class CRangeBearingKFSLAM2D
 	 * out_landmarksPositions) gives the corresponding landmark ID.
 	  *  \param out_fullState The complete state vector (3+2M).
 	  *  \param out_fullCovariance The full (3+2M)x(3+2M) covariance matrix of
-	 * the filter.
+	 * the filter. With the mrpt::bayes::kfEIF method, it is recovered on
+	 * demand from the information matrix.
 	  * \sa getCurrentRobotPose
 	  */
 	void getCurrentState(
@@ -358,18 +358,19 @@ void PF_implementation<PARTICLE_TYPE, MYSELF, STORAGE>::
 		//	UPDATE STAGE
 		// ----------------------------------------------------------------------
 		// Compute all the likelihood values & update particles weight:
+		std::vector<mrpt::poses::CPose3D> partPoses(M);
 		for (size_t i = 0; i < M; i++)
 		{
 			bool pose_is_valid;
-			const mrpt::math::TPose3D partPose =
-				getLastPose(i, pose_is_valid);  // Take the particle data:
-			mrpt::poses::CPose3D partPose2 = mrpt::poses::CPose3D(partPose);
-			const double obs_log_likelihood =
-				PF_SLAM_computeObservationLikelihoodForParticle(
-					PF_options, i, *sf, partPose2);
+			partPoses[i] = mrpt::poses::CPose3D(
+				getLastPose(i, pose_is_valid));  // Take the particle data:
+		}
+		std::vector<double> obs_log_likelihoods;
+		PF_SLAM_computeObservationLikelihoodForParticles(
+			PF_options, *sf, partPoses, obs_log_likelihoods);
+		for (size_t i = 0; i < M; i++)
 			me->m_particles[i].log_w +=
-				obs_log_likelihood * PF_options.powFactor;
-		}  // for each particle "i"
+				obs_log_likelihoods[i] * PF_options.powFactor;
 
 		// Normalization of weights is done outside of this method
 		// automatically.
@@ -287,6 +287,24 @@ class PF_implementation : public mrpt::system::COutputLogger
 		const mrpt::obs::CSensoryFrame& observation,
 		const mrpt::poses::CPose3D& x) const = 0;
 
+	/** Evaluate the observation likelihood for all the particles at once, at
+	 * the given locations (one per particle). By default, it calls
+	 * PF_SLAM_computeObservationLikelihoodForParticle() for each one, but
+	 * implementations may evaluate all of them at once, e.g. with
+	 * mrpt::maps::CMetricMap::computeObservationLikelihoods().
+	 */
+	virtual void PF_SLAM_computeObservationLikelihoodForParticles(
+		const mrpt::bayes::CParticleFilter::TParticleFilterOptions& PF_options,
+		const mrpt::obs::CSensoryFrame& observation,
+		const std::vector<mrpt::poses::CPose3D>& x,
+		std::vector<double>& out_log_liks) const
+	{
+		out_log_liks.resize(x.size());
+		for (size_t i = 0; i < x.size(); i++)
+			out_log_liks[i] = PF_SLAM_computeObservationLikelihoodForParticle(
+				PF_options, i, observation, x[i]);
+	}
+
 	/** @} */
 
 	/** Auxiliary method called by PF implementations: return true if we have
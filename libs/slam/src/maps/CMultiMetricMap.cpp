@@ -89,6 +89,31 @@ struct MapComputeLikelihood
 
 };  // end of MapComputeLikelihood
 
+struct MapComputeLikelihoods
+{
+	const CObservation* obs;
+	const std::vector<CPose3D>& takenFrom;
+	double* total_log_liks;
+	std::vector<double> log_liks;
+
+	MapComputeLikelihoods(
+		const CMultiMetricMap& m, const CObservation* _obs,
+		const std::vector<CPose3D>& _takenFrom, double* _total_log_liks)
+		: obs(_obs), takenFrom(_takenFrom), total_log_liks(_total_log_liks)
+	{
+		std::fill(total_log_liks, total_log_liks + takenFrom.size(), 0.0);
+	}
+
+	template <typename PTR>
+	inline void operator()(PTR& ptr)
+	{
+		ptr->computeObservationLikelihoods(obs, takenFrom, log_liks);
+		for (size_t i = 0; i < takenFrom.size(); i++)
+			total_log_liks[i] += log_liks[i];
+	}
+
+};  // end of MapComputeLikelihoods
+
 struct MapCanComputeLikelihood
 {
 	const CObservation* obs;
@@ -310,6 +335,15 @@ double CMultiMetricMap::internal_computeObservationLikelihood(
 	return ret_log_lik;
 }
 
+// Read docs in base class
+void CMultiMetricMap::internal_computeObservationLikelihoods(
+	const CObservation* obs, const std::vector<CPose3D>& takenFrom,
+	double* out_log_liks)
+{
+	MapComputeLikelihoods op_likelihoods(*this, obs, takenFrom, out_log_liks);
+	MapExecutor::run(*this, op_likelihoods);
+}
+
 // Read docs in base class
 bool CMultiMetricMap::internal_canComputeObservationLikelihood(
 	const CObservation* obs) const
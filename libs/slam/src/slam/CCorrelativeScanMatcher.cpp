@@ -0,0 +1,435 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include "slam-precomp.h"  // Precompiled headers
+
+#include <mrpt/slam/CCorrelativeScanMatcher.h>
+#include <mrpt/maps/CMultiMetricMap.h>
+#include <mrpt/maps/COccupancyGridMap2D.h>
+#include <mrpt/maps/CSimplePointsMap.h>
+#include <mrpt/system/CTicTac.h>
+#include <mrpt/config/CConfigFileBase.h>  // MRPT_LOAD_*()
+#include <mrpt/poses/CPosePDFGaussian.h>
+#include <mrpt/poses/CPose3DPDF.h>
+#include <mrpt/poses/CPose3DPDFGaussian.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+using namespace mrpt::slam;
+using namespace mrpt::maps;
+using namespace mrpt::system;
+using namespace mrpt::poses;
+using namespace std;
+
+void CCorrelativeScanMatcher::TConfigParams::loadFromConfigFile(
+	const mrpt::config::CConfigFileBase& iniFile, const std::string& section)
+{
+	MRPT_LOAD_CONFIG_VAR(linear_window, double, iniFile, section);
+	angular_window = DEG2RAD(iniFile.read_double(
+		section, "angular_window_DEG", RAD2DEG(angular_window)));
+	angular_step = DEG2RAD(iniFile.read_double(
+		section, "angular_step_DEG", RAD2DEG(angular_step)));
+	MRPT_LOAD_CONFIG_VAR(resolution, double, iniFile, section);
+	MRPT_LOAD_CONFIG_VAR(sigma, double, iniFile, section);
+	MRPT_LOAD_CONFIG_VAR(pyramid_levels, int, iniFile, section);
+	MRPT_LOAD_CONFIG_VAR(min_score, double, iniFile, section);
+	MRPT_LOAD_CONFIG_VAR(max_points, int, iniFile, section);
+	MRPT_LOAD_CONFIG_VAR(num_threads, int, iniFile, section);
+}
+
+void CCorrelativeScanMatcher::TConfigParams::saveToConfigFile(
+	mrpt::config::CConfigFileBase& c, const std::string& s) const
+{
+	MRPT_SAVE_CONFIG_VAR_COMMENT(
+		linear_window, "Half size of the search window in x,y [m]");
+	c.write(
+		s, "angular_window_DEG", RAD2DEG(angular_window),
+		mrpt::config::MRPT_SAVE_NAME_PADDING(),
+		mrpt::config::MRPT_SAVE_VALUE_PADDING(),
+		"Half size of the search window in phi [deg]");
+	c.write(
+		s, "angular_step_DEG", RAD2DEG(angular_step),
+		mrpt::config::MRPT_SAVE_NAME_PADDING(),
+		mrpt::config::MRPT_SAVE_VALUE_PADDING(),
+		"Orientation step [deg] (0=automatic)");
+	MRPT_SAVE_CONFIG_VAR_COMMENT(
+		resolution, "Cell size of the likelihood grid for points maps [m]");
+	MRPT_SAVE_CONFIG_VAR_COMMENT(
+		sigma, "Std. deviation of the likelihood field [m]");
+	MRPT_SAVE_CONFIG_VAR_COMMENT(pyramid_levels, "Levels of the grid pyramid");
+	MRPT_SAVE_CONFIG_VAR_COMMENT(
+		min_score, "Minimum score [0,1] of an acceptable solution");
+	MRPT_SAVE_CONFIG_VAR_COMMENT(
+		max_points, "Maximum number of points to use from m2 (0=all)");
+	MRPT_SAVE_CONFIG_VAR_COMMENT(
+		num_threads, "Number of threads (0=hardware concurrency)");
+}
+
+namespace
+{
+/** The likelihood field of the reference map, plus coarser levels where each
+ * cell (cx,cy) of level "h" holds the maximum of the cells
+ * [cx,cx+2^h)x[cy,cy+2^h) of level 0. All levels have "pad" extra cells
+ * before the first row/column, so the coarse cells overlapping the grid from
+ * outside are also defined. */
+struct TGridPyramid
+{
+	double x_min, y_min, resolution;
+	int size_x, size_y, pad;
+	std::vector<std::vector<float>> levels;
+
+	inline float at(size_t h, int cx, int cy) const
+	{
+		cx += pad;
+		cy += pad;
+		const int stride = size_x + pad;
+		if (cx < 0 || cy < 0 || cx >= stride || cy >= size_y + pad) return 0;
+		return levels[h][cx + cy * stride];
+	}
+
+	/** Builds all levels from a list of obstacles (in meters). */
+	void build(
+		const std::vector<std::pair<float, float>>& obstacles, double sigma,
+		unsigned int nLevels)
+	{
+		ASSERT_(nLevels >= 1 && nLevels <= 16);
+		pad = (1 << (nLevels - 1)) - 1;
+		const int stride = size_x + pad;
+		const size_t nCells = size_t(stride) * (size_y + pad);
+		levels.assign(nLevels, std::vector<float>(nCells, 0.0f));
+
+		// Level 0: likelihood field, up to 3 sigmas away from obstacles:
+		std::vector<uint8_t> done(size_t(size_x) * size_y, 0);
+		const int r = std::max(0, int(std::ceil(3 * sigma / resolution)));
+		std::vector<float> kernel((2 * r + 1) * (2 * r + 1));
+		for (int dy = -r; dy <= r; dy++)
+			for (int dx = -r; dx <= r; dx++)
+				kernel[(dx + r) + (dy + r) * (2 * r + 1)] = std::exp(
+					-0.5 * (dx * dx + dy * dy) * resolution * resolution /
+					(sigma * sigma));
+		auto& L0 = levels[0];
+		for (const auto& o : obstacles)
+		{
+			const int ox = int(std::floor((o.first - x_min) / resolution));
+			const int oy = int(std::floor((o.second - y_min) / resolution));
+			if (ox < 0 || oy < 0 || ox >= size_x || oy >= size_y) continue;
+			if (done[ox + oy * size_x]) continue;
+			done[ox + oy * size_x] = 1;
+			for (int cy = std::max(0, oy - r);
+				 cy <= std::min(size_y - 1, oy + r); cy++)
+				for (int cx = std::max(0, ox - r);
+					 cx <= std::min(size_x - 1, ox + r); cx++)
+				{
+					const float k =
+						kernel[(cx - ox + r) + (cy - oy + r) * (2 * r + 1)];
+					float& c = L0[(cx + pad) + (cy + pad) * stride];
+					if (k > c) c = k;
+				}
+		}
+
+		// Coarser levels: the window of 2^h cells is the union of two
+		// windows of 2^(h-1) cells, in each direction:
+		for (size_t h = 1; h < nLevels; h++)
+		{
+			const int s = 1 << (h - 1);
+			auto& L = levels[h];
+			for (int cy = -pad; cy < size_y; cy++)
+				for (int cx = -pad; cx < size_x; cx++)
+					L[(cx + pad) + (cy + pad) * stride] = std::max(
+						std::max(at(h - 1, cx, cy), at(h - 1, cx + s, cy)),
+						std::max(
+							at(h - 1, cx, cy + s), at(h - 1, cx + s, cy + s)));
+		}
+	}
+};
+
+struct TCandidate
+{
+	int ox, oy;
+	float score;
+	bool operator<(const TCandidate& o) const { return score > o.score; }
+};
+
+const CPointsMap* asPointsMap(const CMetricMap* m)
+{
+	if (IS_DERIVED(m, CPointsMap)) return static_cast<const CPointsMap*>(m);
+	return m->getAsSimplePointsMap();
+}
+}  // namespace
+
+CPosePDF::Ptr CCorrelativeScanMatcher::AlignPDF(
+	const mrpt::maps::CMetricMap* m1, const mrpt::maps::CMetricMap* m2,
+	const CPosePDFGaussian& initialEstimationPDF, float* runningTime,
+	void* info)
+{
+	MRPT_START
+
+	CTicTac tictac;
+	if (runningTime) tictac.Tic();
+	ASSERT_(m1 != nullptr && m2 != nullptr);
+	ASSERT_(options.sigma > 0);
+
+	// Reference map: grid map or points:
+	const COccupancyGridMap2D* grid = nullptr;
+	if (IS_CLASS(m1, COccupancyGridMap2D))
+		grid = static_cast<const COccupancyGridMap2D*>(m1);
+	else if (IS_CLASS(m1, CMultiMetricMap))
+	{
+		const auto* mm = static_cast<const CMultiMetricMap*>(m1);
+		if (mm->m_gridMaps.size()) grid = mm->m_gridMaps[0].get();
+	}
+
+	TGridPyramid pyr;
+	std::vector<std::pair<float, float>> obstacles;
+	if (grid)
+	{
+		pyr.x_min = grid->getXMin();
+		pyr.y_min = grid->getYMin();
+		pyr.resolution = grid->getResolution();
+		pyr.size_x = grid->getSizeX();
+		pyr.size_y = grid->getSizeY();
+		for (int cy = 0; cy < pyr.size_y; cy++)
+			for (int cx = 0; cx < pyr.size_x; cx++)
+				if (grid->getCell(cx, cy) < 0.5f)
+					obstacles.emplace_back(
+						grid->idx2x(cx), grid->idx2y(cy));
+	}
+	else
+	{
+		const CPointsMap* pts1 = asPointsMap(m1);
+		ASSERTMSG_(pts1, "m1 must be a grid map or convertible to points");
+		ASSERT_(options.resolution > 0);
+		const auto& xs = pts1->getPointsBufferRef_x();
+		const auto& ys = pts1->getPointsBufferRef_y();
+		if (xs.empty())
+		{
+			pyr.x_min = pyr.y_min = 0;
+			pyr.size_x = pyr.size_y = 1;
+		}
+		else
+		{
+			const double margin = 3 * options.sigma + options.resolution;
+			const auto mx = std::minmax_element(xs.begin(), xs.end());
+			const auto my = std::minmax_element(ys.begin(), ys.end());
+			pyr.x_min = *mx.first - margin;
+			pyr.y_min = *my.first - margin;
+			pyr.size_x = 1 + int((*mx.second + margin - pyr.x_min) /
+								 options.resolution);
+			pyr.size_y = 1 + int((*my.second + margin - pyr.y_min) /
+								 options.resolution);
+		}
+		pyr.resolution = options.resolution;
+		obstacles.reserve(xs.size());
+		for (size_t i = 0; i < xs.size(); i++)
+			obstacles.emplace_back(xs[i], ys[i]);
+	}
+	pyr.build(obstacles, options.sigma, options.pyramid_levels);
+	const double res = pyr.resolution;
+
+	// Points to be aligned (decimated):
+	const CPointsMap* pts2 = asPointsMap(m2);
+	ASSERTMSG_(pts2, "m2 must be convertible to a points map");
+	std::vector<float> px, py;
+	{
+		const auto& xs = pts2->getPointsBufferRef_x();
+		const auto& ys = pts2->getPointsBufferRef_y();
+		const size_t decim =
+			(options.max_points && xs.size() > options.max_points)
+				? (xs.size() + options.max_points - 1) / options.max_points
+				: 1;
+		for (size_t i = 0; i < xs.size(); i += decim)
+		{
+			px.push_back(xs[i]);
+			py.push_back(ys[i]);
+		}
+	}
+	const size_t nPts = px.size();
+
+	// Search window:
+	const CPose2D init = initialEstimationPDF.mean;
+	double max_range = res;
+	for (size_t i = 0; i < nPts; i++)
+		mrpt::keep_max(max_range, std::sqrt(px[i] * px[i] + py[i] * py[i]));
+	const double ang_step = options.angular_step > 0
+								? options.angular_step
+								: std::acos(
+									  1.0 - 0.5 * (res * res) /
+												(max_range * max_range));
+	const int nRotHalf = int(std::ceil(options.angular_window / ang_step));
+	const int wxy = int(std::ceil(options.linear_window / res));
+
+	// Rotations sorted by distance to the initial estimation, so good
+	// solutions are found soon, making pruning more effective:
+	std::vector<int> rotations;
+	rotations.push_back(0);
+	for (int k = 1; k <= nRotHalf; k++)
+	{
+		rotations.push_back(k);
+		rotations.push_back(-k);
+	}
+
+	// Best solution so far. Equal scores are broken by the lowest
+	// (rotation, x, y) index, so the result does not depend on which thread
+	// finds them first:
+	std::mutex best_mtx;
+	std::atomic<float> best_score{static_cast<float>(options.min_score)};
+	int best_k = 0, best_ox = 0, best_oy = 0;
+	bool found = false;
+	std::atomic<size_t> nEvaluated{0};
+	// Whether a candidate scoring "s" (a leaf score, or the upper bound of
+	// a whole subtree, whose lowest index is (k,ox,oy)) may beat the best:
+	auto beats = [&](float s, int k, int ox, int oy) {
+		if (s > best_score) return true;
+		if (s < best_score) return false;
+		std::lock_guard<std::mutex> lock(best_mtx);
+		return (s > best_score) ||
+			   (s == best_score && found &&
+				std::tie(k, ox, oy) < std::tie(best_k, best_ox, best_oy));
+	};
+
+	const size_t top = options.pyramid_levels - 1;
+	std::atomic<size_t> next_rot{0};
+	auto worker = [&]() {
+		std::vector<int> cx(nPts), cy(nPts);
+		size_t nEval = 0;
+		for (size_t r; (r = next_rot++) < rotations.size();)
+		{
+			// Discretize the rotated points:
+			const int k = rotations[r];
+			const double phi = init.phi() + k * ang_step;
+			const double cc = std::cos(phi), ss = std::sin(phi);
+			for (size_t i = 0; i < nPts; i++)
+			{
+				const double gx = init.x() + cc * px[i] - ss * py[i];
+				const double gy = init.y() + ss * px[i] + cc * py[i];
+				cx[i] = int(std::floor((gx - pyr.x_min) / res));
+				cy[i] = int(std::floor((gy - pyr.y_min) / res));
+			}
+			auto score = [&](size_t h, int ox, int oy) {
+				nEval++;
+				float s = 0;
+				for (size_t i = 0; i < nPts; i++)
+					s += pyr.at(h, cx[i] + ox, cy[i] + oy);
+				return nPts ? s / nPts : 0.0f;
+			};
+
+			// Depth-first branch and bound, best children first:
+			std::function<void(size_t, const TCandidate&)> branch;
+			branch = [&](size_t h, const TCandidate& c) {
+				if (h == 0)
+				{
+					std::lock_guard<std::mutex> lock(best_mtx);
+					if (c.score > best_score ||
+						(c.score == best_score && found &&
+						 std::tie(k, c.ox, c.oy) <
+							 std::tie(best_k, best_ox, best_oy)))
+					{
+						best_score = c.score;
+						best_k = k;
+						best_ox = c.ox;
+						best_oy = c.oy;
+						found = true;
+					}
+					return;
+				}
+				const int s = 1 << (h - 1);
+				TCandidate children[4];
+				int nChildren = 0;
+				for (int dy : {0, s})
+					for (int dx : {0, s})
+					{
+						if (c.ox + dx > wxy || c.oy + dy > wxy) continue;
+						children[nChildren++] = TCandidate{
+							c.ox + dx, c.oy + dy,
+							score(h - 1, c.ox + dx, c.oy + dy)};
+					}
+				// (insertion sort: at most 4 children)
+				for (int i = 1; i < nChildren; i++)
+					for (int j = i; j > 0 && children[j] < children[j - 1]; j--)
+						std::swap(children[j], children[j - 1]);
+				for (int i = 0; i < nChildren; i++)
+				{
+					const auto& ch = children[i];
+					if (ch.score < best_score) break;
+					if (beats(ch.score, k, ch.ox, ch.oy)) branch(h - 1, ch);
+				}
+			};
+
+			std::vector<TCandidate> cands;
+			const int S = 1 << top;
+			for (int oy = -wxy; oy <= wxy; oy += S)
+				for (int ox = -wxy; ox <= wxy; ox += S)
+					cands.push_back(TCandidate{ox, oy, score(top, ox, oy)});
+			std::sort(cands.begin(), cands.end());
+			for (const auto& c : cands)
+			{
+				if (c.score < best_score) break;
+				if (beats(c.score, k, c.ox, c.oy)) branch(top, c);
+			}
+		}
+		nEvaluated += nEval;
+	};
+
+	const size_t nThreads = std::min<size_t>(
+		rotations.size(),
+		options.num_threads
+			? options.num_threads
+			: std::max(1U, std::thread::hardware_concurrency()));
+	if (nThreads <= 1)
+		worker();
+	else
+	{
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < nThreads; t++) threads.emplace_back(worker);
+		for (auto& t : threads) t.join();
+	}
+
+	// Output PDF, with the uncertainty of the discretization:
+	auto resultPDF = mrpt::make_aligned_shared<CPosePDFGaussian>();
+	if (found)
+		resultPDF->mean = CPose2D(
+			init.x() + best_ox * res, init.y() + best_oy * res,
+			init.phi() + best_k * ang_step);
+	else
+		resultPDF->mean = init;
+	resultPDF->cov.setZero();
+	resultPDF->cov(0, 0) = resultPDF->cov(1, 1) = res * res;
+	resultPDF->cov(2, 2) = ang_step * ang_step;
+
+	if (info)
+	{
+		auto& outInfo = *static_cast<TReturnInfo*>(info);
+		outInfo.goodness = found ? best_score.load() : 0.0f;
+		outInfo.nEvaluatedCandidates = nEvaluated;
+		outInfo.nRotations = rotations.size();
+	}
+	if (runningTime) *runningTime = tictac.Tac();
+
+	return resultPDF;
+
+	MRPT_END
+}
+
+CPose3DPDF::Ptr CCorrelativeScanMatcher::Align3DPDF(
+	const mrpt::maps::CMetricMap* m1, const mrpt::maps::CMetricMap* m2,
+	const CPose3DPDFGaussian& initialEstimationPDF, float* runningTime,
+	void* info)
+{
+	MRPT_UNUSED_PARAM(m1);
+	MRPT_UNUSED_PARAM(m2);
+	MRPT_UNUSED_PARAM(initialEstimationPDF);
+	MRPT_UNUSED_PARAM(runningTime);
+	MRPT_UNUSED_PARAM(info);
+	THROW_EXCEPTION("Align3D method not applicable to CCorrelativeScanMatcher");
+}
@@ -0,0 +1,164 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include <mrpt/slam/CCorrelativeScanMatcher.h>
+#include <mrpt/maps/COccupancyGridMap2D.h>
+#include <mrpt/maps/CSimplePointsMap.h>
+#include <mrpt/poses/CPosePDFGaussian.h>
+#include <mrpt/math/wrap2pi.h>
+#include <mrpt/random.h>
+#include <gtest/gtest.h>
+
+using namespace mrpt;
+using namespace mrpt::slam;
+using namespace mrpt::maps;
+using namespace mrpt::poses;
+using namespace std;
+
+// An asymmetric "room": walls of a 8x5 m rectangle, plus a pillar and an
+// inner wall.
+static void buildRoom(CSimplePointsMap& m)
+{
+	m.clear();
+	const double d = 0.02;
+	for (double t = 0; t <= 8; t += d)
+	{
+		m.insertPoint(t, 0);
+		m.insertPoint(t, 5);
+	}
+	for (double t = 0; t <= 5; t += d)
+	{
+		m.insertPoint(0, t);
+		m.insertPoint(8, t);
+	}
+	for (double t = 0; t <= 2; t += d) m.insertPoint(5, t);
+	for (double a = 0; a < 2 * M_PI; a += 0.05)
+		m.insertPoint(2 + 0.3 * cos(a), 3 + 0.3 * sin(a));
+}
+
+// The points of "ref" seen from "pose" (a random subset, with noise):
+static void observeFrom(
+	const CSimplePointsMap& ref, const CPose2D& pose, CSimplePointsMap& obs)
+{
+	auto& rng = mrpt::random::getRandomGenerator();
+	obs.clear();
+	for (size_t i = 0; i < ref.size(); i++)
+	{
+		if (rng.drawUniform(0, 1) < 0.5) continue;
+		float x, y;
+		ref.getPoint(i, x, y);
+		double lx, ly;
+		pose.inverseComposePoint(x, y, lx, ly);
+		obs.insertPoint(
+			lx + rng.drawGaussian1D(0, 0.01), ly + rng.drawGaussian1D(0, 0.01));
+	}
+}
+
+TEST(CCorrelativeScanMatcher, alignPointsMaps)
+{
+	mrpt::random::getRandomGenerator().randomize(1234);
+	CSimplePointsMap ref, obs;
+	buildRoom(ref);
+
+	CCorrelativeScanMatcher matcher;
+	matcher.options.linear_window = 1.0;
+	matcher.options.angular_window = DEG2RAD(20.0);
+	matcher.options.num_threads = 2;
+
+	for (const auto& gt :
+		 {CPose2D(3.0, 2.0, DEG2RAD(10.0)), CPose2D(6.5, 3.5, DEG2RAD(-90.0)),
+		  CPose2D(1.0, 1.0, DEG2RAD(179.0))})
+	{
+		observeFrom(ref, gt, obs);
+
+		// A bad initial guess, still within the search window:
+		CPosePDFGaussian init;
+		init.mean = gt + CPose2D(0.7, -0.6, DEG2RAD(-15.0));
+
+		CCorrelativeScanMatcher::TReturnInfo info;
+		const auto pdf = matcher.AlignPDF(&ref, &obs, init, nullptr, &info);
+		const CPose2D est = pdf->getMeanVal();
+		EXPECT_NEAR(est.x(), gt.x(), 0.1) << "gt: " << gt;
+		EXPECT_NEAR(est.y(), gt.y(), 0.1) << "gt: " << gt;
+		EXPECT_NEAR(
+			mrpt::math::wrapToPi(est.phi() - gt.phi()), 0, DEG2RAD(2.0))
+			<< "gt: " << gt;
+		EXPECT_GT(info.goodness, 0.8f);
+		EXPECT_GT(info.nRotations, 1u);
+		EXPECT_GT(info.nEvaluatedCandidates, 0u);
+	}
+}
+
+TEST(CCorrelativeScanMatcher, alignToGridMap)
+{
+	mrpt::random::getRandomGenerator().randomize(4321);
+	CSimplePointsMap ref, obs;
+	buildRoom(ref);
+
+	COccupancyGridMap2D grid(-1, 9, -1, 6, 0.05f);
+	for (size_t i = 0; i < ref.size(); i++)
+	{
+		float x, y;
+		ref.getPoint(i, x, y);
+		grid.setPos(x, y, 0.0f);
+	}
+
+	const CPose2D gt(4.0, 2.5, DEG2RAD(45.0));
+	observeFrom(ref, gt, obs);
+
+	CCorrelativeScanMatcher matcher;
+	CPosePDFGaussian init;
+	init.mean = gt + CPose2D(-0.5, 0.4, DEG2RAD(8.0));
+	CCorrelativeScanMatcher::TReturnInfo info;
+	const CPose2D est =
+		matcher.AlignPDF(&grid, &obs, init, nullptr, &info)->getMeanVal();
+	EXPECT_NEAR(est.x(), gt.x(), 0.1);
+	EXPECT_NEAR(est.y(), gt.y(), 0.1);
+	EXPECT_NEAR(mrpt::math::wrapToPi(est.phi() - gt.phi()), 0, DEG2RAD(2.0));
+
+	// Out of the search window: no solution is accepted.
+	matcher.options.linear_window = 0.2;
+	matcher.options.angular_window = DEG2RAD(2.0);
+	init.mean = gt + CPose2D(2.0, 0, 0);
+	const CPose2D est2 =
+		matcher.AlignPDF(&grid, &obs, init, nullptr, &info)->getMeanVal();
+	EXPECT_EQ(info.goodness, 0.0f);
+	EXPECT_EQ(est2, init.mean);
+}
+
+// A straight wall seen from any point along it: many poses get the very same
+// score, and the solution must not depend on the number of threads.
+TEST(CCorrelativeScanMatcher, equalScoresAreDeterministic)
+{
+	CSimplePointsMap ref, obs;
+	for (double t = -10; t <= 10; t += 0.02) ref.insertPoint(t, 0.01);
+	for (double t = -1; t <= 1; t += 0.02) obs.insertPoint(t, 0.01);
+
+	CCorrelativeScanMatcher matcher;
+	matcher.options.linear_window = 0.5;
+	matcher.options.angular_window = DEG2RAD(5.0);
+	CPosePDFGaussian init;
+	init.mean = CPose2D(0.3, 0, 0);
+
+	matcher.options.num_threads = 1;
+	CCorrelativeScanMatcher::TReturnInfo info;
+	const CPose2D est1 =
+		matcher.AlignPDF(&ref, &obs, init, nullptr, &info)->getMeanVal();
+	EXPECT_EQ(info.goodness, 1.0f);
+	EXPECT_NEAR(est1.y(), 0, 0.05);
+
+	matcher.options.num_threads = 4;
+	for (int rep = 0; rep < 10; rep++)
+	{
+		const CPose2D est =
+			matcher.AlignPDF(&ref, &obs, init, nullptr, &info)->getMeanVal();
+		EXPECT_EQ(info.goodness, 1.0f);
+		EXPECT_EQ(est, est1);
+	}
+}
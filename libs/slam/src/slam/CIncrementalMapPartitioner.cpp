@@ -102,7 +102,8 @@ void CIncrementalMapPartitioner::TOptions::saveToConfigFile(
 void CIncrementalMapPartitioner::clear()
 {
 	m_last_last_partition_are_new_ones = false;
-	m_A.setSize(0, 0);
+	m_A.clear();
+	m_fiedler.clear();
 	m_individualFrames.clear();  // Free the map...
 	m_individualMaps.clear();
 	m_last_partition.clear();  // Delete last partitions
@@ -129,7 +130,9 @@ uint32_t CIncrementalMapPartitioner::addMapFrame(
 	m_individualFrames.insert(&robotPose, frame);
 
 	// Expand the adjacency matrix (pads with 0)
-	m_A.setSize(n, n);
+	m_A.resize(n);
+	// Initial guess for the new node in the next Fiedler vector:
+	if (!m_fiedler.empty()) m_fiedler.resize(n, 0.0);
 
 	ASSERT_(m_individualMaps.size() == n);
 	ASSERT_(m_individualFrames.size() == n);
@@ -169,35 +172,33 @@ uint32_t CIncrementalMapPartitioner::addMapFrame(
 		for (uint32_t j = 0; j < new_id; j++)
 		{
 			const auto id_diff = new_id - j;
-			double s_sym;
-			if (id_diff > options.maxKeyFrameDistanceToEval)
-			{
-				// skip evaluation
-				s_sym = .0;
-			}
-			else
-			{
-				// KF "j":
-				map_keyframe_t map_j;
-				CPose3DPDF::Ptr posePDF_j;
-				map_j.kf_id = j;
-				m_individualFrames.get(j, posePDF_j, map_j.raw_observations);
-				auto pose_j = posePDF_j->getMeanVal();
-				map_j.metric_map = m_individualMaps[j];
-
-				auto relPose = pose_j - pose_i;
-
-				// Evaluate similarity metric & make it symetric:
-				const auto s_ij = sim_func(map_i, map_j, relPose);
-				const auto s_ji = sim_func(map_j, map_i, relPose);
-				s_sym = 0.5*(s_ij + s_ji);
-			}
-			m_A(i, j) = m_A(j, i) = s_sym;
+			// skip evaluation (leave a zero similarity)
+			if (id_diff > options.maxKeyFrameDistanceToEval) continue;
+
+			// KF "j":
+			map_keyframe_t map_j;
+			CPose3DPDF::Ptr posePDF_j;
+			map_j.kf_id = j;
+			m_individualFrames.get(j, posePDF_j, map_j.raw_observations);
+			auto pose_j = posePDF_j->getMeanVal();
+			map_j.metric_map = m_individualMaps[j];
+
+			auto relPose = pose_j - pose_i;
+
+			// Evaluate similarity metric & make it symetric:
+			const auto s_ij = sim_func(map_i, map_j, relPose);
+			const auto s_ji = sim_func(map_j, map_i, relPose);
+			const double s_sym = 0.5*(s_ij + s_ji);
+
+			// Only store overlapping pairs. Since j<i, all rows remain
+			// sorted by pushing back:
+			if (s_sym == 0) continue;
+			m_A[i].emplace_back(j, s_sym);
+			m_A[j].emplace_back(i, s_sym);
 		}  // for j
 	}  // i=n-1=new_id
 
-	// Self-similatity: Not used
-	m_A(new_id, new_id) = 0;
+	// Self-similatity: Not used (not stored)
 
 	// If a partition has been already computed, add these new keyframes
 	// into a new partition on its own. When the user calls updatePartitions()
@@ -230,11 +231,12 @@ void CIncrementalMapPartitioner::updatePartitions(
 	MRPT_START
 
 	partitions.clear();
-	CGraphPartitioner<CMatrixD>::RecursiveSpectralPartition(
-		m_A, partitions, options.partitionThreshold, true, true,
+	// Sparse partitioning, starting from the last Fiedler vector:
+	CGraphPartitioner<CMatrixD, double>::RecursiveSpectralPartition(
+		m_A, partitions, options.partitionThreshold,
 		!options.forceBisectionOnly,
-		options.minimumNumberElementsEachCluster, false /* verbose */
-		);
+		options.minimumNumberElementsEachCluster, false /* verbose */,
+		&m_fiedler);
 
 	m_last_partition = partitions;
 	m_last_last_partition_are_new_ones = false;
@@ -252,7 +254,7 @@ void CIncrementalMapPartitioner::removeSetOfNodes(
 {
 	MRPT_START
 
-	size_t nOld = m_A.cols();
+	size_t nOld = m_A.size();
 	size_t nNew = nOld - indexesToRemove.size();
 	size_t i, j;
 
@@ -277,15 +279,28 @@ void CIncrementalMapPartitioner::removeSetOfNodes(
 
 	ASSERT_(indexesToStay.size() == nNew);
 
-	// Update the A matrix:
+	// Update the A matrix (and the Fiedler vector guess):
 	// ---------------------------------------------------
-	CMatrixDouble newA(nNew, nNew);
+	std::vector<int64_t> newIndex(nOld, -1);
+	for (i = 0; i < nNew; i++) newIndex[indexesToStay[i]] = i;
+
+	sparse_adjacency_t<double> newA(nNew);
 	for (i = 0; i < nNew; i++)
-		for (j = 0; j < nNew; j++)
-			newA(i, j) = m_A(indexesToStay[i], indexesToStay[j]);
+		for (const auto& e : m_A[indexesToStay[i]])
+			if (newIndex[e.first] >= 0)
+				newA[i].emplace_back(newIndex[e.first], e.second);
 
 	// Substitute "A":
-	m_A = newA;
+	m_A = std::move(newA);
+
+	if (m_fiedler.size() == nOld)
+	{
+		std::vector<double> newFiedler(nNew);
+		for (i = 0; i < nNew; i++) newFiedler[i] = m_fiedler[indexesToStay[i]];
+		m_fiedler = std::move(newFiedler);
+	}
+	else
+		m_fiedler.clear();
 
 	// The last partitioning is all the nodes together:
 	// --------------------------------------------------
@@ -353,21 +368,25 @@ void CIncrementalMapPartitioner::getAs3DScene(
 	const std::map<uint32_t, int64_t>* renameIndexes) const
 {
 	objs->clear();
-	ASSERT_((int)m_individualFrames.size() == m_A.cols());
+	ASSERT_(m_individualFrames.size() == m_A.size());
 
 	auto gl_grid = opengl::CGridPlaneXY::Create();
 	objs->insert(gl_grid);
 	int bbminx = std::numeric_limits<int>::max(), bbminy = std::numeric_limits<int>::max();
 	int bbmaxx = -bbminx, bbmaxy = -bbminy;
 
+	std::vector<CPose3D> means(m_individualFrames.size());
 	for (size_t i = 0; i < m_individualFrames.size(); i++)
 	{
 		CPose3DPDF::Ptr i_pdf;
 		CSensoryFrame::Ptr i_sf;
 		m_individualFrames.get(i, i_pdf, i_sf);
+		i_pdf->getMean(means[i]);
+	}
 
-		CPose3D i_mean;
-		i_pdf->getMean(i_mean);
+	for (size_t i = 0; i < m_individualFrames.size(); i++)
+	{
+		const CPose3D& i_mean = means[i];
 
 		mrpt::keep_min(bbminx, (int)floor(i_mean.x()));
 		mrpt::keep_min(bbminy, (int)floor(i_mean.y()));
@@ -396,16 +415,13 @@ void CIncrementalMapPartitioner::getAs3DScene(
 		objs->insert(i_sph);
 
 		// Arcs:
-		for (size_t j = i + 1; j < m_individualFrames.size(); j++)
+		for (const auto& e : m_A[i])
 		{
-			CPose3DPDF::Ptr j_pdf;
-			CSensoryFrame::Ptr j_sf;
-			m_individualFrames.get(j, j_pdf, j_sf);
-
-			CPose3D j_mean;
-			j_pdf->getMean(j_mean);
+			const size_t j = e.first;
+			if (j <= i) continue;
+			const CPose3D& j_mean = means[j];
 
-			float SSO_ij = m_A(i, j);
+			float SSO_ij = e.second;
 
 			if (SSO_ij > 0.01)
 			{
@@ -434,7 +450,8 @@ void CIncrementalMapPartitioner::serializeFrom(
 		case 0:
 		case 1:
 		{
-			in >> m_individualFrames >> m_individualMaps >> m_A >>
+			CMatrixD A;
+			in >> m_individualFrames >> m_individualMaps >> A >>
 				m_last_partition >> m_last_last_partition_are_new_ones;
 			if (version == 0)
 			{
@@ -442,6 +459,20 @@ void CIncrementalMapPartitioner::serializeFrom(
 				std::vector<uint8_t> old_modified_nodes;
 				in >> old_modified_nodes;
 			}
+			// Dense matrix up to v1:
+			m_A.assign(A.rows(), {});
+			for (size_t i = 0; i < m_A.size(); i++)
+				for (size_t j = 0; j < m_A.size(); j++)
+					if (i != j && A(i, j) != 0)
+						m_A[i].emplace_back(j, A(i, j));
+			m_fiedler.clear();
+		}
+		break;
+		case 2:
+		{
+			in >> m_individualFrames >> m_individualMaps >> m_A >>
+				m_last_partition >> m_last_last_partition_are_new_ones;
+			m_fiedler.clear();
 		}
 		break;
 		default:
@@ -449,7 +480,7 @@ void CIncrementalMapPartitioner::serializeFrom(
 	};
 }
 
-uint8_t CIncrementalMapPartitioner::serializeGetVersion() const { return 1; }
+uint8_t CIncrementalMapPartitioner::serializeGetVersion() const { return 2; }
 void CIncrementalMapPartitioner::serializeTo(
 	mrpt::serialization::CArchive& out) const
 {
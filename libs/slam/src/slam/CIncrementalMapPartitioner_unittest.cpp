@@ -8,6 +8,8 @@
    +------------------------------------------------------------------------+ */
 
 #include <mrpt/slam/CIncrementalMapPartitioner.h>
+#include <mrpt/obs/CSensoryFrame.h>
+#include <mrpt/poses/CPose3DPDFGaussian.h>
 #include <gtest/gtest.h>
 
 using namespace mrpt;
@@ -25,3 +27,50 @@ TEST(CIncrementalMapPartitioner, test_dataset)
 {
 	MRPT_TODO("Write me");
 }
+
+TEST(CIncrementalMapPartitioner, sparse_custom_similarity)
+{
+	// Two groups of keyframes, far apart, with similarity only for nearby
+	// keyframes:
+	CIncrementalMapPartitioner imp;
+	imp.setSimilarityMethod(
+		[](const map_keyframe_t&, const map_keyframe_t&,
+		   const mrpt::poses::CPose3D& relPose) {
+			return relPose.norm() < 2.0 ? 1.0 : 0.0;
+		});
+	imp.options.partitionThreshold = 0.5;
+
+	const size_t N = 30;
+	std::vector<std::vector<uint32_t>> parts;
+	for (size_t i = 0; i < N; i++)
+	{
+		const double x = (i < N / 2) ? 0.1 * i : 20.0 + 0.1 * i;
+		mrpt::poses::CPose3DPDFGaussian p;
+		p.mean = mrpt::poses::CPose3D(x, 0, 0, 0, 0, 0);
+		EXPECT_EQ(imp.addMapFrame(mrpt::obs::CSensoryFrame(), p), i);
+		// Update partitions as keyframes arrive:
+		if (i % 5 == 4) imp.updatePartitions(parts);
+	}
+	EXPECT_EQ(imp.getNodesCount(), N);
+
+	// Only overlapping pairs are stored:
+	const auto& A = imp.getSparseAdjacency();
+	ASSERT_EQ(A.size(), N);
+	for (size_t i = 0; i < N; i++) EXPECT_EQ(A[i].size(), N / 2 - 1);
+
+	ASSERT_EQ(parts.size(), 2u);
+	for (auto& p : parts) std::sort(p.begin(), p.end());
+	std::sort(parts.begin(), parts.end());
+	for (size_t i = 0; i < N / 2; i++)
+	{
+		EXPECT_EQ(parts[0][i], i);
+		EXPECT_EQ(parts[1][i], i + N / 2);
+	}
+
+	// Removing nodes keeps the adjacency consistent:
+	imp.removeSetOfNodes({0, 1, 2, 20});
+	mrpt::math::CMatrixDouble D;
+	imp.getAdjacencyMatrix(D);
+	ASSERT_EQ(D.rows(), static_cast<int>(N - 4));
+	EXPECT_EQ(D.sum(), (12 * 11) + (14 * 13));
+}
@@ -189,6 +189,33 @@ double
 	return ret;
 }
 
+void CMonteCarloLocalization3D::
+	PF_SLAM_computeObservationLikelihoodForParticles(
+		const CParticleFilter::TParticleFilterOptions& PF_options,
+		const CSensoryFrame& observation, const std::vector<CPose3D>& x,
+		std::vector<double>& out_log_liks) const
+{
+	if (!options.metricMap)
+	{
+		// One map per particle:
+		PF_implementation::PF_SLAM_computeObservationLikelihoodForParticles(
+			PF_options, observation, x, out_log_liks);
+		return;
+	}
+
+	// Same than PF_SLAM_computeObservationLikelihoodForParticle(), for all
+	// the particles at once:
+	out_log_liks.assign(x.size(), 1.0);
+	std::vector<double> obs_log_liks;
+	for (const auto& obs : observation)
+	{
+		options.metricMap->computeObservationLikelihoods(
+			obs.get(), x, obs_log_liks);
+		for (size_t i = 0; i < x.size(); i++)
+			out_log_liks[i] += obs_log_liks[i];
+	}
+}
+
 // Specialization for my kind of particles:
 void CMonteCarloLocalization3D::
 	PF_SLAM_implementation_custom_update_particle_with_new_pose(
@@ -74,6 +74,7 @@ void CRangeBearingKFSLAM::reset()
 	// Initial cov:  nullptr diagonal -> perfect knowledge.
 	m_pkk.setSize(get_vehicle_size(), get_vehicle_size());
 	m_pkk.zeros();
+	invalidateInformationForm();
 	// -----------------------
 
 	// Use SF-based matching (faster & easier for bearing-range observations
@@ -177,7 +178,7 @@ void CRangeBearingKFSLAM::getCurrentState(
 		out_fullState[i] = m_xkk[i];
 
 	// Full cov:
-	out_fullCovariance = m_pkk;
+	getFullCovariance(out_fullCovariance);
 
 	MRPT_END
 }
@@ -194,9 +195,7 @@ void CRangeBearingKFSLAM::processActionObservation(
 	m_SF = SF;
 
 	// Sanity check:
-	ASSERT_(
-		m_IDs.size() ==
-		(m_pkk.cols() - get_vehicle_size()) / get_feature_size());
+	ASSERT_(m_IDs.size() == this->getNumberOfLandmarksInTheMap());
 
 	// ===================================================================================================================
 	// Here's the meat!: Call the main method for the KF algorithm, which will
@@ -1024,11 +1023,9 @@ void CRangeBearingKFSLAM::getAs3DObject(
 			m_xkk[get_vehicle_size() + get_feature_size() * i + 1]);
 		pointGauss.mean.z(
 			m_xkk[get_vehicle_size() + get_feature_size() * i + 2]);
-		m_pkk.extractMatrix(
-			get_vehicle_size() + get_feature_size() * i,
-			get_vehicle_size() + get_feature_size() * i, get_feature_size(),
-			get_feature_size(), COV);
-		pointGauss.cov = COV;
+		KFMatrix_FxF lm_cov;
+		getLandmarkCov(i, lm_cov);
+		pointGauss.cov = lm_cov;
 
 		opengl::CEllipsoid::Ptr ellip =
 			mrpt::make_aligned_shared<opengl::CEllipsoid>();
@@ -1194,6 +1191,30 @@ double CRangeBearingKFSLAM::computeOffDiagonalBlocksApproximationError(
 {
 	MRPT_START
 
+	unsigned int nLMs = landmarksMembership.size();
+
+	const auto& info_blocks = getInformationBlocks();
+	if (KF_options.method == mrpt::bayes::kfEIF && !info_blocks.empty())
+	{
+		// The information matrix is directly available: add up its blocks
+		// (node k>0 is the (k-1)'th landmark) without inverting anything.
+		ASSERT_EQUAL_(info_blocks.size(), nLMs + 1);
+		double sumOffBlocks = 0, sumLMs = 0;
+		for (size_t j = 1; j < info_blocks.size(); j++)
+			for (const auto& ib : info_blocks[j])
+			{
+				const size_t i = ib.first;
+				if (i == 0) continue;  // Vehicle-landmark block
+				const double s = ib.second.sum();
+				sumLMs += (i == j) ? s : 2 * s;
+				if (i != j && 0 == math::countCommonElements(
+									   landmarksMembership[i - 1],
+									   landmarksMembership[j - 1]))
+					sumOffBlocks += 2 * ib.second.block(0, 0, 2, 2).sum();
+			}
+		return sumOffBlocks / sumLMs;
+	}
+
 	// Compute the information matrix:
 	CMatrixTemplateNumeric<kftype> fullCov(m_pkk);
 	size_t i;
@@ -1204,7 +1225,6 @@ double CRangeBearingKFSLAM::computeOffDiagonalBlocksApproximationError(
 	H.array().abs();  // Replace by absolute values:
 
 	double sumOffBlocks = 0;
-	unsigned int nLMs = landmarksMembership.size();
 
 	ASSERT_(
 		int(get_vehicle_size() + nLMs * get_feature_size()) == fullCov.cols());
@@ -1287,9 +1307,11 @@ void CRangeBearingKFSLAM::saveMapAndPath2DRepresentationAsMATLABFile(
 	{
 		size_t idx = get_vehicle_size() + i * get_feature_size();
 
-		cov(0, 0) = m_pkk(idx + 0, idx + 0);
-		cov(1, 1) = m_pkk(idx + 1, idx + 1);
-		cov(0, 1) = cov(1, 0) = m_pkk(idx + 0, idx + 1);
+		KFMatrix_FxF lm_cov;
+		getLandmarkCov(i, lm_cov);
+		cov(0, 0) = lm_cov(0, 0);
+		cov(1, 1) = lm_cov(1, 1);
+		cov(0, 1) = cov(1, 0) = lm_cov(0, 1);
 
 		mean[0] = m_xkk[idx + 0];
 		mean[1] = m_xkk[idx + 1];
@@ -60,6 +60,7 @@ void CRangeBearingKFSLAM2D::reset()
 	// Initial cov:
 	m_pkk.setSize(3, 3);
 	m_pkk.zeros();
+	invalidateInformationForm();
 }
 
 /*---------------------------------------------------------------
@@ -127,7 +128,7 @@ void CRangeBearingKFSLAM2D::getCurrentState(
 		out_fullState[i] = m_xkk[i];
 
 	// Full cov:
-	out_fullCovariance = m_pkk;
+	getFullCovariance(out_fullCovariance);
 
 	MRPT_END
 }
@@ -985,8 +986,9 @@ void CRangeBearingKFSLAM2D::getAs3DObject(
 	{
 		pointGauss.mean.x(m_xkk[3 + 2 * i + 0]);
 		pointGauss.mean.y(m_xkk[3 + 2 * i + 1]);
-		m_pkk.extractMatrix(3 + 2 * i, 3 + 2 * i, 2, 2, COV);
-		pointGauss.cov = COV;
+		KFMatrix_FxF lm_cov;
+		getLandmarkCov(i, lm_cov);
+		pointGauss.cov = lm_cov;
 
 		opengl::CEllipsoid::Ptr ellip =
 			mrpt::make_aligned_shared<opengl::CEllipsoid>();
@@ -1048,9 +1050,11 @@ void CRangeBearingKFSLAM2D::saveMapAndPath2DRepresentationAsMATLABFile(
 	{
 		size_t idx = get_vehicle_size() + i * get_feature_size();
 
-		cov(0, 0) = m_pkk(idx + 0, idx + 0);
-		cov(1, 1) = m_pkk(idx + 1, idx + 1);
-		cov(0, 1) = cov(1, 0) = m_pkk(idx + 0, idx + 1);
+		KFMatrix_FxF lm_cov;
+		getLandmarkCov(i, lm_cov);
+		cov(0, 0) = lm_cov(0, 0);
+		cov(1, 1) = lm_cov(1, 1);
+		cov(0, 1) = cov(1, 0) = lm_cov(0, 1);
 
 		mean[0] = m_xkk[idx + 0];
 		mean[1] = m_xkk[idx + 1];
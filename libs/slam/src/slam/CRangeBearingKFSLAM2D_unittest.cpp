@@ -0,0 +1,114 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include <mrpt/slam/CRangeBearingKFSLAM2D.h>
+#include <mrpt/obs/CActionRobotMovement2D.h>
+#include <mrpt/obs/CObservationBearingRange.h>
+#include <mrpt/random.h>
+#include <gtest/gtest.h>
+
+using namespace mrpt;
+using namespace mrpt::bayes;
+using namespace mrpt::slam;
+using namespace mrpt::math;
+using namespace mrpt::obs;
+using namespace mrpt::poses;
+using namespace mrpt::random;
+using namespace std;
+
+// Runs the same synthetic sequence (robot moving along a circle among
+// landmarks with known IDs) through a 2D range-bearing KF-SLAM with the
+// given method, returning the final full state and covariance.
+static void run_kf_slam_2d(
+	const TKFMethod method, const int max_active, CVectorDouble& state,
+	CMatrixDouble& cov, const bool recover_full_cov = false)
+{
+	CRangeBearingKFSLAM2D slam;
+	slam.KF_options.method = method;
+	slam.KF_options.EIF_max_active_landmarks = max_active;
+	slam.KF_options.EIF_recover_full_covariance = recover_full_cov;
+	slam.options.std_sensor_range = 0.05f;
+	slam.options.std_sensor_yaw = DEG2RAD(1.0f);
+
+	auto& rng = getRandomGenerator();
+	rng.randomize(1234);
+
+	std::vector<TPoint2D> lms;
+	for (int i = 0; i < 12; i++)
+		lms.emplace_back(
+			rng.drawUniform(-6.0, 6.0), rng.drawUniform(-6.0, 6.0));
+
+	CActionRobotMovement2D::TMotionModelOptions odo_opts;
+	odo_opts.modelSelection = CActionRobotMovement2D::mmGaussian;
+
+	const CPose2D Ap(0.25, 0, DEG2RAD(5.0));
+	CPose2D gt_pose;
+	for (int step = 0; step < 40; step++)
+	{
+		gt_pose = gt_pose + Ap;
+
+		auto act = CActionRobotMovement2D::Create();
+		act->computeFromOdometry(
+			CPose2D(
+				Ap.x() + rng.drawGaussian1D(0, 0.01), Ap.y(),
+				Ap.phi() + rng.drawGaussian1D(0, DEG2RAD(0.5))),
+			odo_opts);
+		auto acts = CActionCollection::Create();
+		acts->insert(*act);
+
+		auto obs = CObservationBearingRange::Create();
+		obs->fieldOfView_yaw = 2 * M_PI;
+		for (size_t i = 0; i < lms.size(); i++)
+		{
+			const CPoint2D l = CPoint2D(lms[i]) - gt_pose;
+			CObservationBearingRange::TMeasurement m;
+			m.range = l.norm() + rng.drawGaussian1D(0, 0.01);
+			m.yaw = atan2(l.y(), l.x()) + rng.drawGaussian1D(0, DEG2RAD(0.2));
+			m.pitch = 0;
+			m.landmarkID = i;
+			obs->sensedData.push_back(m);
+		}
+		auto sf = CSensoryFrame::Create();
+		sf->insert(obs);
+
+		slam.processActionObservation(acts, sf);
+	}
+
+	CPosePDFGaussian robotPose;
+	std::vector<TPoint2D> lm_pos;
+	std::map<unsigned int, mrpt::maps::CLandmark::TLandmarkID> lm_IDs;
+	slam.getCurrentState(robotPose, lm_pos, lm_IDs, state, cov);
+	EXPECT_EQ(lms.size(), lm_pos.size());
+}
+
+TEST(CRangeBearingKFSLAM2D, EIF_vs_EKF)
+{
+	CVectorDouble x_ekf, x_eif;
+	CMatrixDouble P_ekf, P_eif;
+	run_kf_slam_2d(kfEKFNaive, 0, x_ekf, P_ekf);
+
+	// Without sparsification the information form is exact:
+	run_kf_slam_2d(kfEIF, 0, x_eif, P_eif);
+	ASSERT_EQ(x_ekf.size(), x_eif.size());
+	ASSERT_EQ(P_ekf.rows(), P_eif.rows());
+	EXPECT_LT((x_ekf - x_eif).array().abs().maxCoeff(), 1e-3);
+	EXPECT_LT((P_ekf - P_eif).array().abs().maxCoeff(), 1e-4);
+
+	// Same result if the covariance is recovered at each step:
+	CVectorDouble x_eif_full;
+	CMatrixDouble P_eif_full;
+	run_kf_slam_2d(kfEIF, 0, x_eif_full, P_eif_full, true);
+	EXPECT_LT((x_eif_full - x_eif).array().abs().maxCoeff(), 1e-9);
+	EXPECT_LT((P_eif_full - P_eif).array().abs().maxCoeff(), 1e-9);
+
+	// With sparsification it is an approximation, but must stay close:
+	run_kf_slam_2d(kfEIF, 4, x_eif, P_eif);
+	ASSERT_EQ(x_ekf.size(), x_eif.size());
+	EXPECT_LT((x_ekf - x_eif).array().abs().maxCoeff(), 0.1);
+}
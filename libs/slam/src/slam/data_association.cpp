@@ -29,10 +29,10 @@
 #include <mrpt/poses/CPointPDFGaussian.h>
 #include <mrpt/poses/CPoint2DPDFGaussian.h>
 
-#include <memory>
-#include <set>
-#include <numeric>  // accumulate
+#include <atomic>
 #include <memory>  // unique_ptr
+#include <set>
+#include <thread>
 
 #include <nanoflann.hpp>  // For kd-tree's
 #include <mrpt/math/KDTreeCapable.h>  // For kd-tree's
@@ -45,92 +45,6 @@ using namespace mrpt::slam;
 
 namespace mrpt::slam
 {
-struct TAuxDataRecursiveJCBB
-{
-	/** Just to avoid recomputing them all the time. */
-	size_t nPredictions, nObservations, length_O;
-	std::map<size_t, size_t> currentAssociation;
-};
-
-/**  Computes the joint distance metric (mahalanobis or matching likelihood)
- * between two  a set of associations
- *
- * On "currentAssociation":  maps "ID_obs" -> "ID_pred"
- *  For each landmark ID in the observations (ID_obs), its association
- *  in the predictions, that is: ID_pred = associations[ID_obs]
- *
- */
-template <typename T, TDataAssociationMetric METRIC>
-double joint_pdf_metric(
-	const CMatrixTemplateNumeric<T>& Z_observations_mean,
-	const CMatrixTemplateNumeric<T>& Y_predictions_mean,
-	const CMatrixTemplateNumeric<T>& Y_predictions_cov,
-	const TAuxDataRecursiveJCBB& info, const TDataAssociationResults& aux_data)
-{
-	MRPT_UNUSED_PARAM(aux_data);
-	// Make a list of the indices of the predictions that appear in
-	// "currentAssociation":
-	const size_t N = info.currentAssociation.size();
-	ASSERT_(N > 0);
-	std::vector<size_t> indices_pred(
-		N);  // Appearance order indices in the std::maps
-	std::vector<size_t> indices_obs(N);
-
-	{
-		size_t i = 0;
-		for (auto it : info.currentAssociation)
-		{
-			indices_obs[i] = it.first;
-			indices_pred[i] = it.second;
-			i++;
-		}
-	}
-
-	// ----------------------------------------------------------------------
-	// Extract submatrix of the covariances involved here:
-	//  COV = PREDICTIONS_COV(INDX,INDX) + OBSERVATIONS_COV(INDX2,INDX2)
-	// ----------------------------------------------------------------------
-	Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> COV;
-	Y_predictions_cov.extractSubmatrixSymmetricalBlocks(
-		info.length_O,  // dims of cov. submatrices
-		indices_pred, COV);
-
-	// ----------------------------------------------------------------------
-	// Mean:
-	// The same for the vector of "errors" or "innovation" between predictions
-	// and observations:
-	// ----------------------------------------------------------------------
-	Eigen::Matrix<T, Eigen::Dynamic, 1> innovations(N * info.length_O);
-	T* dst_ptr = &innovations[0];
-	for (map<size_t, size_t>::const_iterator it =
-			 info.currentAssociation.begin();
-		 it != info.currentAssociation.end(); ++it)
-	{
-		const T* pred_i_mean = Y_predictions_mean.get_unsafe_row(it->second);
-		const T* obs_i_mean = Z_observations_mean.get_unsafe_row(it->first);
-
-		for (unsigned int k = 0; k < info.length_O; k++)
-			*dst_ptr++ = pred_i_mean[k] - obs_i_mean[k];
-	}
-
-	// Compute mahalanobis distance squared:
-	CMatrixTemplateNumeric<T> COV_inv;
-	COV.inv_fast(COV_inv);
-
-	const double d2 = mrpt::math::multiply_HCHt_scalar(innovations, COV_inv);
-
-	if (METRIC == metricMaha) return d2;
-
-	ASSERT_(METRIC == metricML);
-
-	// Matching likelihood: The evaluation at 0 of the PDF of the difference
-	// between the two Gaussians:
-	const T cov_det = COV.det();
-	const double ml = exp(-0.5 * d2) / (std::pow(M_2PI, info.length_O * 0.5) *
-										std::sqrt(cov_det));
-	return ml;
-}
-
 template <TDataAssociationMetric METRIC>
 bool isCloser(const double v1, const double v2);
 
@@ -146,116 +60,283 @@ bool isCloser<metricML>(const double v1, const double v2)
 	return v1 > v2;
 }
 
-/* Based on MATLAB code by:
-  University of Zaragoza
-  Centro Politecnico Superior
-  Robotics and Real Time Group
-  Authors of the original MATLAB code:  J. Neira, J. Tardos
-  C++ version: J.L. Blanco Claraco
-*/
-template <typename T, TDataAssociationMetric METRIC>
-void JCBB_recursive(
-	const mrpt::math::CMatrixTemplateNumeric<T>& Z_observations_mean,
-	const mrpt::math::CMatrixTemplateNumeric<T>& Y_predictions_mean,
-	const mrpt::math::CMatrixTemplateNumeric<T>& Y_predictions_cov,
-	TDataAssociationResults& results, const TAuxDataRecursiveJCBB& info,
-	const observation_index_t curObsIdx)
+/** Read-only data shared by all the threads exploring the JCBB tree */
+struct TJCBBProblem
+{
+	const CMatrixDouble* Z_observations_mean{nullptr};
+	const CMatrixDouble* Y_predictions_mean{nullptr};
+	const CMatrixDouble* Y_predictions_cov{nullptr};
+	const CMatrixBool* indiv_compatibility{nullptr};
+	size_t nPredictions{0}, nObservations{0}, length_O{0};
+	/** potentials[i]: Number of observations among i+1,...,N-1 with at least
+	 * one IC pairing, i.e. an upper bound of how many more pairings can be
+	 * added to a hypothesis after observation i */
+	std::vector<size_t> potentials;
+	/** chi2thres_joint[k]: Threshold of the joint compatibility test for a
+	 * hypothesis with k pairings (only for the Mahalanobis metric) */
+	std::vector<double> chi2thres_joint;
+	/** Largest number of pairings in a complete hypothesis found so far by
+	 * any thread: the shared bound for pruning. */
+	std::atomic<size_t> best_size{0};
+};
+
+/** The state of one JCBB depth-first search: the current hypothesis, the
+ * lower Cholesky factor of its joint innovation covariance and the whitened
+ * innovation vector (so its joint Mahalanobis distance is just the squared
+ * norm of the latter), plus the best complete hypothesis found.
+ *
+ * Based on MATLAB code by:
+ *  University of Zaragoza
+ *  Centro Politecnico Superior
+ *  Robotics and Real Time Group
+ *  Authors of the original MATLAB code:  J. Neira, J. Tardos
+ *  C++ version: J.L. Blanco Claraco
+ */
+template <TDataAssociationMetric METRIC>
+struct TJCBBSearch
 {
-	// End of iteration?
-	if (curObsIdx >= info.nObservations)
+	using pairing_t = std::pair<observation_index_t, prediction_index_t>;
+
+	explicit TJCBBSearch(TJCBBProblem& problem) : pb(problem)
+	{
+		const size_t maxDim = pb.nObservations * pb.length_O;
+		L.setZero(maxDim, maxDim);
+		whitened.setZero(maxDim);
+		pred_used.assign(pb.nPredictions, false);
+		pairings.reserve(pb.nObservations);
+	}
+
+	TJCBBProblem& pb;
+	std::vector<pairing_t> pairings;
+	std::vector<bool> pred_used;
+	Eigen::MatrixXd L;
+	Eigen::VectorXd whitened;
+
+	std::vector<pairing_t> best;
+	double best_distance{0};
+	size_t nNodes{0};
+
+	double metric(const double d2, const double log_det) const
 	{
-		if (info.currentAssociation.size() > results.associations.size())
+		if (METRIC == metricMaha) return d2;
+		// Matching likelihood: The evaluation at 0 of the PDF of the
+		// difference between the two Gaussians:
+		return exp(-0.5 * (d2 + log_det)) /
+			   std::pow(M_2PI, pb.length_O * 0.5);
+	}
+
+	/** Appends the pairing (obsIdx,predIdx) to the current hypothesis with a
+	 * block Cholesky update. With the Mahalanobis metric, the extended
+	 * hypothesis must also pass the joint compatibility (chi2) test; with
+	 * the matching likelihood metric, only individual compatibility is
+	 * required, as in previous versions.
+	 * On input, d2 and log_det are those of the current hypothesis; on
+	 * output, those of the extended one. */
+	bool push(
+		const observation_index_t obsIdx, const prediction_index_t predIdx,
+		double& d2, double& log_det)
+	{
+		const size_t O = pb.length_O, k = pairings.size(), off = k * O;
+		const auto& COV = *pb.Y_predictions_cov;
+
+		// Cross covariances with the predictions already in the hypothesis:
+		Eigen::MatrixXd X(off, O);
+		for (size_t p = 0; p < k; p++)
+			X.block(p * O, 0, O, O) =
+				COV.block(pairings[p].second * O, predIdx * O, O, O);
+		if (k)
+			L.topLeftCorner(off, off)
+				.triangularView<Eigen::Lower>()
+				.solveInPlace(X);
+
+		const Eigen::LLT<Eigen::MatrixXd> llt(
+			COV.block(predIdx * O, predIdx * O, O, O) - X.transpose() * X);
+		if (llt.info() != Eigen::Success) return false;
+
+		Eigen::VectorXd w(O);
+		for (size_t c = 0; c < O; c++)
+			w[c] = pb.Y_predictions_mean->get_unsafe(predIdx, c) -
+				   pb.Z_observations_mean->get_unsafe(obsIdx, c);
+		if (k) w -= X.transpose() * whitened.head(off);
+		llt.matrixL().solveInPlace(w);
+
+		const double new_d2 = d2 + w.squaredNorm();
+		if (METRIC == metricMaha && new_d2 >= pb.chi2thres_joint[k + 1])
+			return false;
+
+		L.block(off, 0, O, off) = X.transpose();
+		L.block(off, off, O, O) = llt.matrixL();
+		whitened.segment(off, O) = w;
+
+		d2 = new_d2;
+		log_det += 2 * llt.matrixLLT().diagonal().array().log().sum();
+		pairings.emplace_back(obsIdx, predIdx);
+		pred_used[predIdx] = true;
+		return true;
+	}
+
+	void pop()
+	{
+		pred_used[pairings.back().second] = false;
+		pairings.pop_back();
+	}
+
+	/** Keeps the hypothesis if it's better than the best one: more pairings
+	 * or the same number with a better joint metric */
+	void leaf(const double d2, const double log_det)
+	{
+		if (pairings.size() > best.size())
 		{
-			// It's a better choice since more features are matched.
-			results.associations = info.currentAssociation;
-			results.distance = joint_pdf_metric<T, METRIC>(
-				Z_observations_mean, Y_predictions_mean, Y_predictions_cov,
-				info, results);
+			best = pairings;
+			best_distance = metric(d2, log_det);
+
+			size_t cur = pb.best_size.load();
+			while (cur < best.size() &&
+				   !pb.best_size.compare_exchange_weak(cur, best.size()))
+			{
+			}
 		}
-		else if (
-			!info.currentAssociation.empty() &&
-			info.currentAssociation.size() == results.associations.size())
+		else if (!pairings.empty() && pairings.size() == best.size())
 		{
-			// The same # of features matched than the previous best one...
-			// decide by better distance:
-			const double d2 = joint_pdf_metric<T, METRIC>(
-				Z_observations_mean, Y_predictions_mean, Y_predictions_cov,
-				info, results);
-
-			if (isCloser<METRIC>(d2, results.distance))
+			const double dist = metric(d2, log_det);
+			if (isCloser<METRIC>(dist, best_distance))
 			{
-				results.associations = info.currentAssociation;
-				results.distance = d2;
+				best = pairings;
+				best_distance = dist;
 			}
 		}
 	}
-	else  // A normal iteration:
+
+	/** Can the current hypothesis, after pairing (or not) the observation
+	 * obsIdx, still get as many pairings as the best one? When it can only
+	 * tie, and the metric is the Mahalanobis distance (which never decreases
+	 * as pairings are added), it must also be able to improve the distance.
+	 */
+	bool promising(
+		const observation_index_t obsIdx, const bool pair_it,
+		const double d2) const
 	{
-		// Iterate for all compatible landmarsk of "curObsIdx"
-		const observation_index_t obsIdx = curObsIdx;
-
-		const size_t nPreds = results.indiv_compatibility.rows();
-
-		// Can we do it better than the current "results.associations"?
-		// This can be checked by counting the potential new pairings+the so-far
-		// established ones.
-		//    Matlab: potentials  = pairings(compatibility.AL(i+1:end))
-		// Moved up by Kasra Khosoussi
-		const size_t potentials = std::accumulate(
-			results.indiv_compatibility_counts.begin() + (obsIdx + 1),
-			results.indiv_compatibility_counts.end(), 0);
-		for (prediction_index_t predIdx = 0; predIdx < nPreds; predIdx++)
+		const size_t max_pairings =
+			pairings.size() + (pair_it ? 1 : 0) + pb.potentials[obsIdx];
+		if (max_pairings < pb.best_size.load()) return false;
+		if (METRIC == metricMaha && !best.empty() &&
+			max_pairings == best.size() && d2 >= best_distance)
+			return false;
+		return true;
+	}
+
+	void recurse(
+		const observation_index_t obsIdx, const double d2,
+		const double log_det)
+	{
+		if (obsIdx >= pb.nObservations)
 		{
-			if ((info.currentAssociation.size() + potentials) >=
-				results.associations.size())
-			{
-				// Only if predIdx is NOT already assigned:
-				if (results.indiv_compatibility(predIdx, obsIdx))
-				{
-					// Only if predIdx is NOT already assigned:
-					bool already_asigned = false;
-					for (auto itS : info.currentAssociation)
-					{
-						if (itS.second == predIdx)
-						{
-							already_asigned = true;
-							break;
-						}
-					}
+			leaf(d2, log_det);
+			return;
+		}
 
-					if (!already_asigned)
-					{
-						// Launch a new recursive line for this hipothesis:
-						TAuxDataRecursiveJCBB new_info = info;
-						new_info.currentAssociation[curObsIdx] = predIdx;
+		// Iterate for all compatible landmarks of "obsIdx":
+		for (prediction_index_t predIdx = 0; predIdx < pb.nPredictions;
+			 predIdx++)
+		{
+			if (!promising(obsIdx, true, d2)) break;
+			if (!pb.indiv_compatibility->get_unsafe(predIdx, obsIdx) ||
+				pred_used[predIdx])
+				continue;
+
+			nNodes++;
+			double new_d2 = d2, new_log_det = log_det;
+			if (!push(obsIdx, predIdx, new_d2, new_log_det)) continue;
+			recurse(obsIdx + 1, new_d2, new_log_det);
+			pop();
+		}
 
-						results.nNodesExploredInJCBB++;
+		// star node: Ei not paired
+		if (promising(obsIdx, false, d2))
+		{
+			nNodes++;
+			recurse(obsIdx + 1, d2, log_det);
+		}
+	}
+};
 
-						JCBB_recursive<T, METRIC>(
-							Z_observations_mean, Y_predictions_mean,
-							Y_predictions_cov, results, new_info,
-							curObsIdx + 1);
-					}
-				}
+/** Branch & bound search for the largest jointly compatible hypothesis.
+ * The top-level branches (the choices for the first observation) are
+ * explored in parallel, sharing the bound on the best hypothesis size.
+ * Results are merged in the sequential order of branches, so they do not
+ * depend on the number of threads. */
+template <TDataAssociationMetric METRIC>
+void JCBB(TJCBBProblem& pb, TDataAssociationResults& results)
+{
+	// Top-level branches: each IC prediction for observation #0, then "star":
+	std::vector<int> branches;
+	for (size_t i = 0; i < pb.nPredictions; i++)
+		if (pb.indiv_compatibility->get_unsafe(i, 0)) branches.push_back(i);
+	branches.push_back(-1);
+
+	struct TBranchResult
+	{
+		std::vector<std::pair<observation_index_t, prediction_index_t>> best;
+		double distance{0};
+		size_t nNodes{0};
+	};
+	std::vector<TBranchResult> branch_results(branches.size());
+
+	std::atomic<size_t> next_branch{0};
+	auto worker = [&]() {
+		for (size_t b; (b = next_branch++) < branches.size();)
+		{
+			TJCBBSearch<METRIC> search(pb);
+			search.nNodes = 1;
+			double d2 = 0, log_det = 0;
+			if (branches[b] < 0)
+			{
+				if (search.promising(0, false, d2))
+					search.recurse(1, d2, log_det);
 			}
+			else if (search.push(0, branches[b], d2, log_det))
+				search.recurse(1, d2, log_det);
+
+			branch_results[b].best = std::move(search.best);
+			branch_results[b].distance = search.best_distance;
+			branch_results[b].nNodes = search.nNodes;
 		}
+	};
 
-		// Can we do it better than the current "results.associations"?
-		if ((info.currentAssociation.size() + potentials) >=
-			results.associations.size())
-		{
-			// Yes we can </obama>
+	// Small problems are not worth the overhead of threads:
+	const size_t nThreads =
+		pb.nObservations < 8
+			? 1
+			: std::min<size_t>(
+				  branches.size(),
+				  std::max(1U, std::thread::hardware_concurrency()));
+	if (nThreads <= 1)
+		worker();
+	else
+	{
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < nThreads; t++) threads.emplace_back(worker);
+		for (auto& t : threads) t.join();
+	}
 
-			// star node: Ei not paired
-			results.nNodesExploredInJCBB++;
-			JCBB_recursive<T, METRIC>(
-				Z_observations_mean, Y_predictions_mean, Y_predictions_cov,
-				results, info, curObsIdx + 1);
+	size_t best_size = 0;
+	for (const auto& br : branch_results)
+	{
+		results.nNodesExploredInJCBB += br.nNodes;
+		if (br.best.empty()) continue;
+		if (br.best.size() > best_size ||
+			(br.best.size() == best_size &&
+			 isCloser<METRIC>(br.distance, results.distance)))
+		{
+			best_size = br.best.size();
+			results.associations.clear();
+			results.associations.insert(br.best.begin(), br.best.end());
+			results.distance = br.distance;
 		}
 	}
 }
 
-}
+}  // namespace mrpt::slam
 
 /* ==================================================================================================
 Computes the data-association between the prediction of a set of landmarks and
@@ -365,9 +446,61 @@ void mrpt::slam::data_association_full_covariance(
 							 : -1000 /*A very small log-likelihoo   */);
 	results.indiv_compatibility.fillAll(false);
 
-	CMatrixDouble pred_i_cov(length_O, length_O);
+	// Precompute the inverse and the log-normalization constant of the
+	// marginal covariance of each prediction, so that each
+	// (prediction,observation) pair below only costs one quadratic form:
+	const size_t O2 = length_O * length_O;
+	std::vector<double> pred_cov_inv(nPredictions * O2);
+	std::vector<double> pred_log_norm(nPredictions);
+	{
+		CMatrixDouble pred_i_cov(length_O, length_O), pred_i_cov_inv;
+		for (size_t i = 0; i < nPredictions; ++i)
+		{
+			const size_t pred_cov_idx = i * length_O;
+			Y_predictions_cov.extractMatrix(
+				pred_cov_idx, pred_cov_idx, length_O, length_O, pred_i_cov);
+			pred_i_cov.inv(pred_i_cov_inv);
+			for (size_t r = 0; r < length_O; r++)
+				for (size_t c = 0; c < length_O; c++)
+					pred_cov_inv[i * O2 + r * length_O + c] =
+						pred_i_cov_inv.get_unsafe(r, c);
+			pred_log_norm[i] =
+				-0.5 * (length_O * ::log(M_2PI) + ::log(pred_i_cov.det()));
+		}
+	}
+
+	std::vector<double> diff_means_i_j(length_O);
+
+	// Sqr. mahalanobis distance and log-pdf of obs_j -> pred_i:
+	auto evalPair = [&](const size_t i, const size_t j, double& d2,
+						double& ml) {
+		const double* C_inv = &pred_cov_inv[i * O2];
+		for (size_t k = 0; k < length_O; k++)
+			diff_means_i_j[k] = Z_observations_mean.get_unsafe(j, k) -
+								Y_predictions_mean.get_unsafe(i, k);
+		d2 = 0;
+		for (size_t r = 0; r < length_O; r++)
+		{
+			double row = 0;
+			for (size_t c = 0; c < length_O; c++)
+				row += C_inv[r * length_O + c] * diff_means_i_j[c];
+			d2 += diff_means_i_j[r] * row;
+		}
+		ml = pred_log_norm[i] - 0.5 * d2;
+	};
 
-	Eigen::VectorXd diff_means_i_j(length_O);
+	auto storePair = [&](const size_t i, const size_t j, const double d2,
+						 const double ml) {
+		// The distance according to the metric
+		results.indiv_distances(i, j) = (metric == metricMaha) ? d2 : ml;
+
+		// Individual compatibility
+		const bool IC = (compatibilityTestMetric == metricML)
+							? (ml > log_ML_compat_test_threshold)
+							: (d2 < chi2thres);
+		results.indiv_compatibility(i, j) = IC;
+		if (IC) results.indiv_compatibility_counts[j]++;
+	};
 
 	for (size_t j = 0; j < nObservations; ++j)
 	{
@@ -376,33 +509,9 @@ void mrpt::slam::data_association_full_covariance(
 			// Compute all the distances w/o a KD-tree
 			for (size_t i = 0; i < nPredictions; ++i)
 			{
-				// Evaluate sqr. mahalanobis distance of obs_j -> pred_i:
-				const size_t pred_cov_idx =
-					i * length_O;  // Extract the submatrix from the diagonal:
-				Y_predictions_cov.extractMatrix(
-					pred_cov_idx, pred_cov_idx, length_O, length_O, pred_i_cov);
-
-				for (size_t k = 0; k < length_O; k++)
-					diff_means_i_j[k] = Z_observations_mean.get_unsafe(j, k) -
-										Y_predictions_mean.get_unsafe(i, k);
-
 				double d2, ml;
-				// mrpt::math::productIntegralAndMahalanobisTwoGaussians(diff_means_i_j,pred_i_cov,obs_j_cov,
-				// d2,ml);
-				mrpt::math::mahalanobisDistance2AndLogPDF(
-					diff_means_i_j, pred_i_cov, d2, ml);
-
-				// The distance according to the metric
-				double val = (metric == metricMaha) ? d2 : ml;
-
-				results.indiv_distances(i, j) = val;
-
-				// Individual compatibility
-				const bool IC = (compatibilityTestMetric == metricML)
-									? (ml > log_ML_compat_test_threshold)
-									: (d2 < chi2thres);
-				results.indiv_compatibility(i, j) = IC;
-				if (IC) results.indiv_compatibility_counts[j]++;
+				evalPair(i, j, d2, ml);
+				storePair(i, j, d2, ml);
 			}
 		}
 		else
@@ -422,37 +531,14 @@ void mrpt::slam::data_association_full_covariance(
 				// the prediction in
 				// "predictions_mean"
 
-				// Build the PDF of the prediction:
-				const size_t pred_cov_idx =
-					i * length_O;  // Extract the submatrix from the diagonal:
-				Y_predictions_cov.extractMatrix(
-					pred_cov_idx, pred_cov_idx, length_O, length_O, pred_i_cov);
-
-				for (size_t k = 0; k < length_O; k++)
-					diff_means_i_j[k] = Z_observations_mean.get_unsafe(j, k) -
-										Y_predictions_mean.get_unsafe(i, k);
-
 				double d2, ml;
-				//				mrpt::math::productIntegralAndMahalanobisTwoGaussians(diff_means_i_j,pred_i_cov,obs_j_cov,
-				// d2,ml);
-				mrpt::math::mahalanobisDistance2AndLogPDF(
-					diff_means_i_j, pred_i_cov, d2, ml);
+				evalPair(i, j, d2, ml);
 
 				if (d2 > 6 * chi2thres)
 					break;  // Since kd-tree returns the landmarks by distance
 				// order, we can skip the rest
 
-				// The distance according to the metric
-				double val = (metric == metricMaha) ? d2 : ml;
-
-				results.indiv_distances(i, j) = val;
-
-				// Individual compatibility
-				const bool IC = (compatibilityTestMetric == metricML)
-									? (ml > log_ML_compat_test_threshold)
-									: (d2 < chi2thres);
-				results.indiv_compatibility(i, j) = IC;
-				if (IC) results.indiv_compatibility_counts[j]++;
+				storePair(i, j, d2, ml);
 			}
 		}  // end use KD-Tree
 	}  // end for
@@ -537,20 +623,31 @@ void mrpt::slam::data_association_full_covariance(
 		// ------------------------------------
 		case assocJCBB:
 		{
-			// Call to the recursive method:
-			TAuxDataRecursiveJCBB info;
-			info.nPredictions = nPredictions;
-			info.nObservations = nObservations;
-			info.length_O = length_O;
+			TJCBBProblem pb;
+			pb.Z_observations_mean = &Z_observations_mean;
+			pb.Y_predictions_mean = &Y_predictions_mean;
+			pb.Y_predictions_cov = &Y_predictions_cov;
+			pb.indiv_compatibility = &results.indiv_compatibility;
+			pb.nPredictions = nPredictions;
+			pb.nObservations = nObservations;
+			pb.length_O = length_O;
+
+			// Matlab: potentials  = pairings(compatibility.AL(i+1:end))
+			pb.potentials.assign(nObservations, 0);
+			for (size_t j = nObservations - 1; j > 0; j--)
+				pb.potentials[j - 1] =
+					pb.potentials[j] +
+					(results.indiv_compatibility_counts[j] ? 1 : 0);
+
+			pb.chi2thres_joint.resize(nObservations + 1);
+			for (size_t k = 1; k <= nObservations; k++)
+				pb.chi2thres_joint[k] =
+					mrpt::math::chi2inv(chi2quantile, k * length_O);
 
 			if (metric == metricMaha)
-				JCBB_recursive<CMatrixDouble::Scalar, metricMaha>(
-					Z_observations_mean, Y_predictions_mean, Y_predictions_cov,
-					results, info, 0);
+				JCBB<metricMaha>(pb, results);
 			else
-				JCBB_recursive<CMatrixDouble::Scalar, metricML>(
-					Z_observations_mean, Y_predictions_mean, Y_predictions_cov,
-					results, info, 0);
+				JCBB<metricML>(pb, results);
 		}
 		break;
 
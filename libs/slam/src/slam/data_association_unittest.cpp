@@ -8,6 +8,7 @@
    +------------------------------------------------------------------------+ */
 
 #include <mrpt/slam/data_association.h>
+#include <mrpt/random.h>
 #include <gtest/gtest.h>
 
 using namespace mrpt;
@@ -55,3 +56,89 @@ TEST(DataAssociation, TestNoICs)
 		}
 	}
 }
+
+TEST(DataAssociation, JCBB_ClutteredScene)
+{
+	// Many landmarks in a small area, all of them observed (shuffled) with
+	// some noise, plus a few spurious observations:
+	auto& rng = mrpt::random::getRandomGenerator();
+	rng.randomize(123);
+
+	const size_t nPreds = 25, nSpurious = 3;
+	CMatrixDouble y(nPreds, 2), y_cov(2 * nPreds, 2 * nPreds),
+		z(nPreds + nSpurious, 2);
+	y_cov.setZero();
+	for (size_t i = 0; i < nPreds; i++)
+	{
+		y(i, 0) = rng.drawUniform(0.0, 4.0);
+		y(i, 1) = rng.drawUniform(0.0, 4.0);
+		y_cov(2 * i, 2 * i) = y_cov(2 * i + 1, 2 * i + 1) = 0.02;
+	}
+	// Correlated predictions, as in a SLAM map:
+	for (size_t i = 0; i < 2 * nPreds; i++)
+		for (size_t j = 0; j < 2 * nPreds; j++)
+			if (i % 2 == j % 2) y_cov(i, j) += 0.005;
+
+	std::vector<size_t> perm(nPreds);
+	for (size_t i = 0; i < nPreds; i++) perm[i] = i;
+	rng.permuteVector(perm, perm);
+	for (size_t j = 0; j < nPreds; j++)
+	{
+		z(j, 0) = y(perm[j], 0) + rng.drawGaussian1D(0, 0.01);
+		z(j, 1) = y(perm[j], 1) + rng.drawGaussian1D(0, 0.01);
+	}
+	for (size_t j = nPreds; j < nPreds + nSpurious; j++)
+	{
+		z(j, 0) = 10 + j;
+		z(j, 1) = -10;
+	}
+
+	for (const bool use_kdtree : {false, true})
+	{
+		TDataAssociationResults res;
+		data_association_full_covariance(
+			z, y, y_cov, res, assocJCBB, metricMaha, 0.99, use_kdtree);
+
+		EXPECT_EQ(nPreds, res.associations.size());
+		for (size_t j = 0; j < nPreds; j++)
+		{
+			const auto it = res.associations.find(j);
+			ASSERT_TRUE(it != res.associations.end());
+			EXPECT_EQ(perm[j], it->second);
+		}
+		EXPECT_GT(res.nNodesExploredInJCBB, 0u);
+	}
+}
+
+TEST(DataAssociation, JCBB_JointGateOnlyForMaha)
+{
+	// Two observations, each individually compatible with one prediction,
+	// but with opposite errors on two strongly correlated predictions, so
+	// the pair of them is not jointly compatible:
+	CMatrixDouble y(2, 2), y_cov(4, 4), z(2, 2);
+	y(0, 0) = 0;
+	y(0, 1) = 0;
+	y(1, 0) = 10;
+	y(1, 1) = 0;
+	z(0, 0) = 1.5;
+	z(0, 1) = 0;
+	z(1, 0) = 8.5;
+	z(1, 1) = 0;
+	y_cov.setZero();
+	for (int i = 0; i < 4; i++) y_cov(i, i) = 1.0;
+	y_cov(0, 2) = y_cov(2, 0) = y_cov(1, 3) = y_cov(3, 1) = 0.99;
+
+	// Mahalanobis: the joint compatibility test keeps only one pairing
+	TDataAssociationResults res_maha;
+	data_association_full_covariance(
+		z, y, y_cov, res_maha, assocJCBB, metricMaha, 0.99, false);
+	EXPECT_EQ(1u, res_maha.associations.size());
+
+	// Matching likelihood: no joint chi2 gate, both pairings are kept
+	TDataAssociationResults res_ml;
+	data_association_full_covariance(
+		z, y, y_cov, res_ml, assocJCBB, metricML, 0.99, false);
+	ASSERT_EQ(2u, res_ml.associations.size());
+	EXPECT_EQ(0u, res_ml.associations[0]);
+	EXPECT_EQ(1u, res_ml.associations[1]);
+}
@@ -123,6 +123,17 @@ class CLandmarksMap : public mrpt::maps::CMetricMap
 		const mrpt::obs::CObservation* obs,
 		const mrpt::poses::CPose3D& takenFrom) override;
 
+	/** Evaluates the same likelihood than
+	 * internal_computeObservationLikelihood() for a set of poses. For
+	 * mrpt::obs::CObservationStereoImages, the SIFT features are extracted
+	 * only once and the map landmarks are packed into a spatial hash only
+	 * once for all the poses. For mrpt::obs::CObservationBeaconRanges,
+	 * beacons are looked up by ID only once. */
+	void internal_computeObservationLikelihoods(
+		const mrpt::obs::CObservation* obs,
+		const std::vector<mrpt::poses::CPose3D>& takenFrom,
+		double* out_log_liks) override;
+
 	/** The color of landmark ellipsoids in CLandmarksMap::getAs3DObject */
 	static mrpt::img::TColorf COLOR_LANDMARKS_IN_3DSCENES;
 
@@ -28,6 +28,8 @@
 #include <mrpt/opengl/CGridPlaneXY.h>
 #include <mrpt/opengl/CEllipsoid.h>
 #include <mrpt/opengl/COpenGLScene.h>
+#include <algorithm>
+#include <unordered_map>
 
 using namespace mrpt;
 using namespace mrpt::math;
@@ -2004,6 +2006,290 @@ float CLandmarksMap::TCustomSequenceLandmarks::getLargestDistanceFromOrigin()
 	return m_largestDistanceFromOrigin;
 }
 
+namespace
+{
+/** The positions and covariances of the SIFT landmarks of a map, packed into
+ * contiguous arrays. Optionally, the arrays are sorted by the cell of a
+ * uniform 3D grid each landmark falls in, and a hash table of the cells
+ * allows visiting only the landmarks around a given point. */
+struct TPackedSIFTLandmarks
+{
+	std::vector<const CLandmark*> lms;
+	std::vector<double> x, y, z, c11, c22, c33, c12, c13, c23;
+	/** The largest trace of the covariances */
+	double maxTrace{0};
+
+	/** Spatial hash: cell key -> [first,last) range of indices */
+	std::unordered_map<uint64_t, std::pair<size_t, size_t>> cells;
+	double cellSize{0};
+
+	size_t size() const { return lms.size(); }
+	void resize(size_t n)
+	{
+		lms.resize(n);
+		for (auto* v : {&x, &y, &z, &c11, &c22, &c33, &c12, &c13, &c23})
+			v->resize(n);
+	}
+
+	/** Loads SIFT landmarks: one every "decimation" landmarks of "seq" (of
+	 * any type), as in CLandmarksMap::computeLikelihood_SIFT_LandmarkMap() */
+	void load(
+		const CLandmarksMap::TCustomSequenceLandmarks& seq,
+		const size_t decimation = 1)
+	{
+		resize(0);
+		cells.clear();
+		maxTrace = 0;
+		for (size_t i = 0; i < seq.size(); i += decimation)
+		{
+			const CLandmark& lm = *seq.get(i);
+			if (lm.getType() != featSIFT) continue;
+			lms.push_back(&lm);
+			x.push_back(lm.pose_mean.x);
+			y.push_back(lm.pose_mean.y);
+			z.push_back(lm.pose_mean.z);
+			c11.push_back(lm.pose_cov_11);
+			c22.push_back(lm.pose_cov_22);
+			c33.push_back(lm.pose_cov_33);
+			c12.push_back(lm.pose_cov_12);
+			c13.push_back(lm.pose_cov_13);
+			c23.push_back(lm.pose_cov_23);
+			maxTrace = std::max(
+				maxTrace, double(lm.pose_cov_11) + lm.pose_cov_22 +
+							  lm.pose_cov_33);
+		}
+	}
+
+	/** Makes "this" the landmarks in "local" seen from "pose", the same way
+	 * than CLandmarksMap::changeCoordinatesReference() */
+	void transformFrom(const TPackedSIFTLandmarks& local, const CPose3D& pose)
+	{
+		const size_t n = local.size();
+		resize(n);
+		lms = local.lms;
+		maxTrace = local.maxTrace;  // Invariant to rotations
+		cells.clear();
+		const CMatrixDouble33& R = pose.getRotationMatrix();
+		const double R11 = R(0, 0), R12 = R(0, 1), R13 = R(0, 2);
+		const double R21 = R(1, 0), R22 = R(1, 1), R23 = R(1, 2);
+		const double R31 = R(2, 0), R32 = R(2, 1), R33 = R(2, 2);
+		const double tx = pose.x(), ty = pose.y(), tz = pose.z();
+		for (size_t i = 0; i < n; i++)
+		{
+			const double lx = local.x[i], ly = local.y[i], lz = local.z[i];
+			x[i] = tx + R11 * lx + R12 * ly + R13 * lz;
+			y[i] = ty + R21 * lx + R22 * ly + R23 * lz;
+			z[i] = tz + R31 * lx + R32 * ly + R33 * lz;
+
+			// cov = R * C * R', stored as float as in CLandmark:
+			const double C11 = local.c11[i], C22 = local.c22[i],
+						 C33 = local.c33[i], C12 = local.c12[i],
+						 C13 = local.c13[i], C23 = local.c23[i];
+			// Rows of R * C:
+			const double A11 = R11 * C11 + R12 * C12 + R13 * C13,
+						 A12 = R11 * C12 + R12 * C22 + R13 * C23,
+						 A13 = R11 * C13 + R12 * C23 + R13 * C33;
+			const double A21 = R21 * C11 + R22 * C12 + R23 * C13,
+						 A22 = R21 * C12 + R22 * C22 + R23 * C23,
+						 A23 = R21 * C13 + R22 * C23 + R23 * C33;
+			const double A31 = R31 * C11 + R32 * C12 + R33 * C13,
+						 A32 = R31 * C12 + R32 * C22 + R33 * C23,
+						 A33 = R31 * C13 + R32 * C23 + R33 * C33;
+			c11[i] = float(A11 * R11 + A12 * R12 + A13 * R13);
+			c12[i] = float(A11 * R21 + A12 * R22 + A13 * R23);
+			c13[i] = float(A11 * R31 + A12 * R32 + A13 * R33);
+			c22[i] = float(A21 * R21 + A22 * R22 + A23 * R23);
+			c23[i] = float(A21 * R31 + A22 * R32 + A23 * R33);
+			c33[i] = float(A31 * R31 + A32 * R32 + A33 * R33);
+		}
+	}
+
+	static uint64_t cellKey(int64_t cx, int64_t cy, int64_t cz)
+	{
+		// Cells far apart may share a key, which only means that a few more
+		// landmarks are visited.
+		const uint64_t m = (1 << 21) - 1;
+		return (uint64_t(cx) & m) | ((uint64_t(cy) & m) << 21) |
+			   ((uint64_t(cz) & m) << 42);
+	}
+	int64_t cellIdx(double v) const
+	{
+		return static_cast<int64_t>(std::floor(v / cellSize));
+	}
+
+	/** Sorts the landmarks by grid cells and builds the spatial hash */
+	void buildGrid(double cell_size)
+	{
+		cellSize = cell_size;
+		cells.clear();
+		const size_t n = size();
+		std::vector<std::pair<uint64_t, size_t>> keys(n);
+		for (size_t i = 0; i < n; i++)
+			keys[i] = {cellKey(cellIdx(x[i]), cellIdx(y[i]), cellIdx(z[i])),
+					   i};
+		std::sort(keys.begin(), keys.end());
+
+		TPackedSIFTLandmarks sorted;
+		sorted.resize(n);
+		for (size_t k = 0; k < n; k++)
+		{
+			const size_t i = keys[k].second;
+			sorted.lms[k] = lms[i];
+			sorted.x[k] = x[i];
+			sorted.y[k] = y[i];
+			sorted.z[k] = z[i];
+			sorted.c11[k] = c11[i];
+			sorted.c22[k] = c22[i];
+			sorted.c33[k] = c33[i];
+			sorted.c12[k] = c12[i];
+			sorted.c13[k] = c13[i];
+			sorted.c23[k] = c23[i];
+
+			if (k == 0 || keys[k].first != keys[k - 1].first)
+				cells[keys[k].first] = {k, k};
+			cells[keys[k].first].second = k + 1;
+		}
+		std::swap(lms, sorted.lms);
+		for (auto p : {std::make_pair(&x, &sorted.x),
+					   std::make_pair(&y, &sorted.y),
+					   std::make_pair(&z, &sorted.z),
+					   std::make_pair(&c11, &sorted.c11),
+					   std::make_pair(&c22, &sorted.c22),
+					   std::make_pair(&c33, &sorted.c33),
+					   std::make_pair(&c12, &sorted.c12),
+					   std::make_pair(&c13, &sorted.c13),
+					   std::make_pair(&c23, &sorted.c23)})
+			std::swap(*p.first, *p.second);
+	}
+
+	/** Calls f(first,last) for the ranges of landmarks which may be within a
+	 * distance "r" of (px,py,pz): all of them if there is no grid, or if the
+	 * search box spans more cells than those with landmarks. */
+	template <class FUNCTOR>
+	void forEachRangeNear(
+		double px, double py, double pz, double r, FUNCTOR f) const
+	{
+		if (cells.empty() || !(r < 1e3 * cellSize))
+		{
+			if (size()) f(0, size());
+			return;
+		}
+		const int64_t x0 = cellIdx(px - r), x1 = cellIdx(px + r);
+		const int64_t y0 = cellIdx(py - r), y1 = cellIdx(py + r);
+		const int64_t z0 = cellIdx(pz - r), z1 = cellIdx(pz + r);
+		if (double(x1 - x0 + 1) * (y1 - y0 + 1) * (z1 - z0 + 1) >
+			cells.size())
+		{
+			f(0, size());
+			return;
+		}
+		for (int64_t cx = x0; cx <= x1; cx++)
+			for (int64_t cy = y0; cy <= y1; cy++)
+				for (int64_t cz = z0; cz <= z1; cz++)
+				{
+					const auto it = cells.find(cellKey(cx, cy, cz));
+					if (it != cells.end())
+						f(it->second.first, it->second.second);
+				}
+	}
+};
+
+/** The cell size of the spatial hash of the map landmarks: the search radius
+ * of an observed landmark as uncertain as the most uncertain map landmark */
+double siftLikelihoodGridCellSize(const double mapMaxTrace, const double K_dist)
+{
+	return std::max(
+		1e-3, std::sqrt(2 * mapMaxTrace * std::log(1e-2) / K_dist));
+}
+
+/** The likelihood of "SIFTLikelihoodMethod=0" (see
+ * CLandmarksMap::computeLikelihood_SIFT_LandmarkMap()) of the observed
+ * landmarks "obs" (in global coordinates) given the map landmarks "map".
+ * Pairs of landmarks whose likelihood by distance is known to be below the
+ * threshold (from their Euclidean distance and the covariance traces) are
+ * not visited, and contribute with the same residual value than in the
+ * exhaustive search. */
+double likelihoodOfPackedSIFTs(
+	const TPackedSIFTLandmarks& map, const TPackedSIFTLandmarks& obs,
+	const double K_dist, const double K_desc)
+{
+	// exp(K_dist * maha2) > 1e-2  <==>  maha2 < maxMaha2
+	const double maxMaha2 = std::log(1e-2) / K_dist;
+	// The residual likelihood of a pair of far landmarks:
+	const double farLik = 1e-10f;
+	std::vector<double> maha2;
+
+	double lik = 1.0;
+	for (size_t i = 0; i < obs.size(); i++)
+	{
+		const CLandmark* lm1 = obs.lms[i];
+		const double x1 = obs.x[i], y1 = obs.y[i], z1 = obs.z[i];
+		const double a1 = obs.c11[i], d1 = obs.c22[i], f1 = obs.c33[i];
+		const double b1 = obs.c12[i], c1 = obs.c13[i], e1 = obs.c23[i];
+
+		// Since maha2 >= dist^2 / trace(C1+C2), pairs farther than this
+		// cannot pass the threshold:
+		const double r = std::sqrt(maxMaha2 * (a1 + d1 + f1 + map.maxTrace));
+
+		double lik_i = 0;
+		size_t nNear = 0;
+		map.forEachRangeNear(x1, y1, z1, r, [&](size_t first, size_t last) {
+			// Mahalanobis distances, with the closed-form inverse of the
+			// symmetric matrix C=[a b c;b d e;c e f]:
+			maha2.resize(last - first);
+			for (size_t j = first; j < last; j++)
+			{
+				const double dx = x1 - map.x[j], dy = y1 - map.y[j],
+							 dz = z1 - map.z[j];
+				const double a = a1 + map.c11[j], b = b1 + map.c12[j],
+							 c = c1 + map.c13[j], d = d1 + map.c22[j],
+							 e = e1 + map.c23[j], f = f1 + map.c33[j];
+				const double A = d * f - e * e, B = c * e - b * f,
+							 C = b * e - c * d, D = a * f - c * c,
+							 E = b * c - a * e, F = a * d - b * b;
+				maha2[j - first] =
+					(A * dx * dx + D * dy * dy + F * dz * dz +
+					 2 * (B * dx * dy + C * dx * dz + E * dy * dz)) /
+					(a * A + b * B + c * C);
+			}
+
+			for (size_t j = first; j < last; j++)
+			{
+				if (maha2[j - first] > 1.001 * maxMaha2) continue;
+				const double likByDist = exp(K_dist * maha2[j - first]);
+				if (!(likByDist > 1e-2)) continue;
+				nNear++;
+
+				// The distance between descriptors, cached in _mEDD:
+				const CLandmark* lm2 = map.lms[j];
+				const std::pair<CLandmark::TLandmarkID, CLandmark::TLandmarkID>
+					mPair(lm2->ID, lm1->ID);
+				auto itEDD = CLandmarksMap::_mEDD.find(mPair);
+				if (itEDD == CLandmarksMap::_mEDD.end() || itEDD->second == 0)
+				{
+					ASSERT_(!lm1->features.empty() && !lm2->features.empty());
+					ASSERT_(lm1->features[0] && lm2->features[0]);
+					const auto& desc1 = lm1->features[0]->descriptors.SIFT;
+					const auto& desc2 = lm2->features[0]->descriptors.SIFT;
+					ASSERT_(desc1.size() == desc2.size());
+					unsigned long distDesc = 0;
+					for (size_t k = 0; k < desc1.size(); k++)
+						distDesc += square(desc1[k] - desc2[k]);
+					itEDD = CLandmarksMap::_mEDD.insert_or_assign(
+						mPair, distDesc).first;
+				}
+				const double likByDesc =
+					exp(K_desc * (unsigned long)itEDD->second);
+				lik_i += likByDist * likByDesc;
+			}
+		});
+		lik_i += (map.size() - nNear) * farLik;
+		lik *= (0.1 + 0.9 * lik_i);
+	}
+	return lik;
+}
+}  // namespace
+
 /*---------------------------------------------------------------
 					computeLikelihood_SIFT_LandmarkMap
   ---------------------------------------------------------------*/
@@ -2012,16 +2298,10 @@ double CLandmarksMap::computeLikelihood_SIFT_LandmarkMap(
 	std::vector<bool>* otherCorrespondences)
 {
 	double lik = 0;  // For 'traditional'
-	double lik_i;
-	unsigned long distDesc;
-	double likByDist, likByDesc;
-
-	std::vector<unsigned char>::iterator it1, it2;
 	double K_dist = -0.5 / square(likelihoodOptions.SIFTs_mahaDist_std);
 	double K_desc =
 		-0.5 / square(likelihoodOptions.SIFTs_sigma_descriptor_dist);
 
-	unsigned int idx1, idx2;
 	CPointPDFGaussian lm1_pose, lm2_pose;
 	CMatrixD dij(1, 3), Cij(3, 3), Cij_1;
 	double distMahaFlik2;
@@ -2032,113 +2312,12 @@ double CLandmarksMap::computeLikelihood_SIFT_LandmarkMap(
 	{
 		case 0:  // Our method
 		{
-			// lik = 1e-9;		// For consensus
-			lik = 1.0;  // For traditional
-
-			TSequenceLandmarks::iterator lm1, lm2;
-			for (idx1 = 0, lm1 = theMap->landmarks.begin();
-				 lm1 < theMap->landmarks.end();
-				 lm1 += decimation, idx1 += decimation)  // Other theMap LM1
-			{
-				if (lm1->getType() == featSIFT)
-				{
-					// Get the pose of lm1 as an object:
-					lm1->getPose(lm1_pose);
-
-					lik_i = 0;  // Counter
-
-					for (idx2 = 0, lm2 = landmarks.begin();
-						 lm2 != landmarks.end();
-						 lm2++, idx2++)  // This theMap LM2
-					{
-						if (lm2->getType() == featSIFT)
-						{
-							// Get the pose of lm2 as an object:
-							lm2->getPose(lm2_pose);
-
-							// Compute the likelihood according to mahalanobis
-							// distance:
-							// Distance between means:
-							dij(0, 0) = lm1->pose_mean.x - lm2->pose_mean.x;
-							dij(0, 1) = lm1->pose_mean.y - lm2->pose_mean.y;
-							dij(0, 2) = lm1->pose_mean.z - lm2->pose_mean.z;
-
-							// std::cout << "ED POSICION: " << sqrt(
-							// dij(0,0)*dij(0,0) + dij(0,1)*dij(0,1) +
-							// dij(0,2)*dij(0,2) ) << std::endl;
-							// Equivalent covariance from "i" to "j":
-							Cij = CMatrixDouble(lm1_pose.cov + lm2_pose.cov);
-							Cij_1 = Cij.inv();
-
-							distMahaFlik2 = dij.multiply_HCHt_scalar(
-								Cij_1);  //( dij * Cij_1 * (~dij) )(0,0);
-
-							likByDist = exp(K_dist * distMahaFlik2);
-
-							if (likByDist > 1e-2)
-							{
-								// If the EUCLIDEAN distance is not too large,
-								// we compute the Descriptor distance
-								// Compute Likelihood by descriptor
-								// Compute distance between descriptors
-
-								// IF the EDD has been already computed, we skip
-								// this step!
-								std::pair<
-									mrpt::maps::CLandmark::TLandmarkID,
-									mrpt::maps::CLandmark::TLandmarkID>
-									mPair(lm2->ID, lm1->ID);
-								// std::cout << "Par: (" << lm2->ID << "," <<
-								// lm1->ID << ") -> ";
-
-								if (CLandmarksMap::_mEDD[mPair] == 0)
-								{
-									distDesc = 0;
-									ASSERT_(
-										!lm1->features.empty() &&
-										!lm2->features.empty());
-									ASSERT_(
-										lm1->features[0] && lm2->features[0]);
-									ASSERT_(
-										lm1->features[0]
-											->descriptors.SIFT.size() ==
-										lm2->features[0]
-											->descriptors.SIFT.size());
-
-									for (it1 = lm1->features[0]
-												   ->descriptors.SIFT.begin(),
-										it2 = lm2->features[0]
-												  ->descriptors.SIFT.begin();
-										 it1 != lm1->features[0]
-													->descriptors.SIFT.end();
-										 it1++, it2++)
-										distDesc += square(*it1 - *it2);
-
-									// Insert into the vector of Euclidean
-									// distances
-									CLandmarksMap::_mEDD[mPair] = distDesc;
-								}  // end if
-								else
-								{
-									distDesc = (unsigned long)
-										CLandmarksMap::_mEDD[mPair];
-								}
-								likByDesc = exp(K_desc * distDesc);
-								lik_i += likByDist *
-										 likByDesc;  // Cumulative Likelihood
-							}
-							else
-							{
-								// If the EUCLIDEAN distance is too large, we
-								// assume that the cumulative likelihood is
-								// (almost) zero.
-								lik_i += 1e-10f;
-							}
-						}  // end if
-					}  // end for "lm2"
-					lik *= (0.1 + 0.9 * lik_i);  // (TRADITIONAL) Total
-				}
-			}  // end for "lm1"
+			TPackedSIFTLandmarks thisLMs, otherLMs;
+			thisLMs.load(landmarks);
+			otherLMs.load(theMap->landmarks, decimation);
+			thisLMs.buildGrid(
+				siftLikelihoodGridCellSize(thisLMs.maxTrace, K_dist));
+			lik = likelihoodOfPackedSIFTs(thisLMs, otherLMs, K_dist, K_desc);
 		}
 		break;
 
@@ -2198,6 +2377,112 @@ double CLandmarksMap::computeLikelihood_SIFT_LandmarkMap(
 	return lik;
 }
 
+/*---------------------------------------------------------------
+					computeObservationLikelihoods
+  ---------------------------------------------------------------*/
+void CLandmarksMap::internal_computeObservationLikelihoods(
+	const CObservation* obs, const std::vector<CPose3D>& takenFrom,
+	double* out_log_liks)
+{
+	MRPT_START
+
+	const size_t nPoses = takenFrom.size();
+	if (CLASS_ID(CObservationStereoImages) == obs->GetRuntimeClass() &&
+		insertionOptions.SIFTLikelihoodMethod == 0)
+	{
+		const CObservationStereoImages* o =
+			static_cast<const CObservationStereoImages*>(obs);
+
+		// The observed landmarks, relative to the robot:
+		CLandmarksMap auxMap;
+		auxMap.insertionOptions = insertionOptions;
+		auxMap.loadSiftFeaturesFromStereoImageObservation(
+			*o, CLandmarksMap::_mapMaxID, likelihoodOptions.SIFT_feat_options);
+		if (!CLandmarksMap::_maxIDUpdated)
+		{
+			CLandmarksMap::_mapMaxID += auxMap.size();
+			CLandmarksMap::_maxIDUpdated = true;
+		}
+
+		const double K_dist =
+			-0.5 / square(likelihoodOptions.SIFTs_mahaDist_std);
+		const double K_desc =
+			-0.5 / square(likelihoodOptions.SIFTs_sigma_descriptor_dist);
+
+		TPackedSIFTLandmarks thisLMs, localLMs, globalLMs;
+		thisLMs.load(landmarks);
+		thisLMs.buildGrid(
+			siftLikelihoodGridCellSize(thisLMs.maxTrace, K_dist));
+		localLMs.load(auxMap.landmarks, likelihoodOptions.SIFTs_decimation);
+
+		for (size_t i = 0; i < nPoses; i++)
+		{
+			globalLMs.transformFrom(localLMs, takenFrom[i]);
+			out_log_liks[i] = log(
+				likelihoodOfPackedSIFTs(thisLMs, globalLMs, K_dist, K_desc));
+			MRPT_CHECK_NORMAL_NUMBER(out_log_liks[i]);
+		}
+	}
+	else if (CLASS_ID(CObservationBeaconRanges) == obs->GetRuntimeClass())
+	{
+		const CObservationBeaconRanges* o =
+			static_cast<const CObservationBeaconRanges*>(obs);
+		std::fill(out_log_liks, out_log_liks + nPoses, 0.0);
+
+		// Beacons by ID (the first one, as in the sequential search):
+		std::unordered_map<CLandmark::TLandmarkID, const CLandmark*> beacons;
+		for (size_t k = 0; k < landmarks.size(); k++)
+		{
+			const CLandmark* lm = landmarks.get(k);
+			if (lm->getType() == featBeacon) beacons.emplace(lm->ID, lm);
+		}
+
+		const float sensorStd = likelihoodOptions.beaconRangesUseObservationStd
+									? o->stdError
+									: likelihoodOptions.beaconRangesStd;
+		const double K = -0.5 / square(sensorStd);
+
+		for (const auto& m : o->sensedData)
+		{
+			const auto itB =
+				beacons.find(static_cast<unsigned int>(m.beaconID));
+			if (itB == beacons.end() || std::isnan(m.sensedDistance))
+			{
+				// If not found, uniform distribution:
+				if (o->maxSensorDistance != o->minSensorDistance)
+				{
+					const double l = log(
+						1.0 / (o->maxSensorDistance - o->minSensorDistance));
+					for (size_t i = 0; i < nPoses; i++) out_log_liks[i] += l;
+				}
+				continue;
+			}
+
+			const TPoint3D& b = itB->second->pose_mean;
+			const double sensedDist = std::max(0.0f, m.sensedDistance);
+			const auto& s = m.sensorLocationOnRobot;
+			for (size_t i = 0; i < nPoses; i++)
+			{
+				double sx, sy, sz;
+				takenFrom[i].composePoint(s.x(), s.y(), s.z(), sx, sy, sz);
+				const double expectedRange = std::sqrt(
+					square(b.x - sx) + square(b.y - sy) + square(b.z - sz));
+				out_log_liks[i] += K * square(expectedRange - sensedDist);
+			}
+		}
+
+		for (size_t i = 0; i < nPoses; i++)
+			MRPT_CHECK_NORMAL_NUMBER(out_log_liks[i]);
+	}
+	else
+	{
+		CMetricMap::internal_computeObservationLikelihoods(
+			obs, takenFrom, out_log_liks);
+	}
+
+	MRPT_END
+}
+
 /*---------------------------------------------------------------
 					TInsertionOptions
   ---------------------------------------------------------------*/
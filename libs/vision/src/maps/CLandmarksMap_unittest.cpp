@@ -0,0 +1,182 @@
+/* +------------------------------------------------------------------------+
+   |                     Mobile Robot Programming Toolkit (MRPT)            |
+   |                          http://www.mrpt.org/                          |
+   |                                                                        |
+   | Copyright (c) 2005-2018, Individual contributors, see AUTHORS file     |
+   | See: http://www.mrpt.org/Authors - All rights reserved.                |
+   | Released under BSD License. See details in http://www.mrpt.org/License |
+   +------------------------------------------------------------------------+ */
+
+#include <mrpt/maps/CLandmarksMap.h>
+#include <mrpt/obs/CObservationBeaconRanges.h>
+#include <mrpt/math/CMatrixFixedNumeric.h>
+#include <mrpt/random.h>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace mrpt;
+using namespace mrpt::maps;
+using namespace mrpt::math;
+using namespace mrpt::obs;
+using namespace mrpt::poses;
+using namespace std;
+
+static CLandmark newLandmark(
+	mrpt::vision::TFeatureType type, CLandmark::TLandmarkID id, double x,
+	double y, double z, float var)
+{
+	CLandmark lm;
+	lm.createOneFeature();
+	lm.features[0]->type = type;
+	lm.ID = id;
+	lm.pose_mean = TPoint3D(x, y, z);
+	lm.pose_cov_11 = var;
+	lm.pose_cov_22 = 2 * var;
+	lm.pose_cov_33 = var;
+	lm.pose_cov_12 = 0.5f * var;
+	lm.pose_cov_13 = 0;
+	lm.pose_cov_23 = -0.3f * var;
+	return lm;
+}
+
+static std::vector<CPose3D> randomPoses(size_t n)
+{
+	auto& rng = mrpt::random::getRandomGenerator();
+	std::vector<CPose3D> poses;
+	for (size_t i = 0; i < n; i++)
+		poses.emplace_back(
+			rng.drawUniform(-5, 5), rng.drawUniform(-5, 5),
+			rng.drawUniform(-0.2, 0.2), rng.drawUniform(-M_PI, M_PI),
+			rng.drawUniform(-0.1, 0.1), rng.drawUniform(-0.1, 0.1));
+	return poses;
+}
+
+TEST(CLandmarksMap, beaconsLikelihoodForManyPoses)
+{
+	auto& rng = mrpt::random::getRandomGenerator();
+	rng.randomize(1234);
+
+	CLandmarksMap map;
+	for (int id = 0; id < 20; id++)
+		map.landmarks.push_back(newLandmark(
+			mrpt::vision::featBeacon, id, rng.drawUniform(-10, 10),
+			rng.drawUniform(-10, 10), rng.drawUniform(0, 3), 0));
+
+	CObservationBeaconRanges obs;
+	obs.minSensorDistance = 0;
+	obs.maxSensorDistance = 30;
+	obs.stdError = 0.1f;
+	for (int id : {3, 7, 11, 99 /* Not in the map */, 19, 0})
+	{
+		CObservationBeaconRanges::TMeasurement m;
+		m.beaconID = id;
+		m.sensedDistance = rng.drawUniform(1, 15);
+		m.sensorLocationOnRobot = CPoint3D(0.1, -0.2, 0.5);
+		obs.sensedData.push_back(m);
+	}
+	obs.sensedData.back().sensedDistance = std::nan("");
+
+	for (bool useObsStd : {false, true})
+	{
+		map.likelihoodOptions.beaconRangesUseObservationStd = useObsStd;
+		const auto poses = randomPoses(50);
+		std::vector<double> logLiks;
+		map.computeObservationLikelihoods(&obs, poses, logLiks);
+		ASSERT_EQ(logLiks.size(), poses.size());
+		for (size_t i = 0; i < poses.size(); i++)
+		{
+			const double l = map.computeObservationLikelihood(&obs, poses[i]);
+			EXPECT_NEAR(logLiks[i], l, 1e-5 * std::abs(l) + 1e-9);
+		}
+	}
+}
+
+// The likelihood in CLandmarksMap::computeLikelihood_SIFT_LandmarkMap(),
+// visiting all pairs of landmarks:
+static double exhaustiveSIFTLikelihood(
+	const CLandmarksMap& map, const CLandmarksMap& obs)
+{
+	const double K_dist =
+		-0.5 / square(map.likelihoodOptions.SIFTs_mahaDist_std);
+	const double K_desc =
+		-0.5 / square(map.likelihoodOptions.SIFTs_sigma_descriptor_dist);
+	double lik = 1.0;
+	for (size_t i = 0; i < obs.landmarks.size(); i++)
+	{
+		const CLandmark& lm1 = *obs.landmarks.get(i);
+		double lik_i = 0;
+		for (size_t j = 0; j < map.landmarks.size(); j++)
+		{
+			const CLandmark& lm2 = *map.landmarks.get(j);
+			CPointPDFGaussian p1, p2;
+			lm1.getPose(p1);
+			lm2.getPose(p2);
+			const CMatrixDouble33 C_inv = (p1.cov + p2.cov).inverse();
+			const Eigen::Vector3d d = p1.mean.m_coords - p2.mean.m_coords;
+			const double maha2 = d.dot(C_inv * d);
+			const double likByDist = exp(K_dist * maha2);
+			if (likByDist > 1e-2)
+			{
+				const auto& d1 = lm1.features[0]->descriptors.SIFT;
+				const auto& d2 = lm2.features[0]->descriptors.SIFT;
+				double distDesc = 0;
+				for (size_t k = 0; k < d1.size(); k++)
+					distDesc += square(d1[k] - d2[k]);
+				lik_i += likByDist * exp(K_desc * distDesc);
+			}
+			else
+				lik_i += 1e-10f;
+		}
+		lik *= (0.1 + 0.9 * lik_i);
+	}
+	return log(lik);
+}
+
+TEST(CLandmarksMap, SIFTLikelihoodSkipsFarLandmarks)
+{
+	auto& rng = mrpt::random::getRandomGenerator();
+	rng.randomize(4321);
+
+	auto randomDescriptor = [&]() {
+		std::vector<uint8_t> desc(16);
+		for (auto& v : desc) v = rng.drawUniform32bit() % 20;
+		return desc;
+	};
+
+	// A map spread over a large area, and observations of some of its
+	// landmarks plus some spurious ones:
+	CLandmarksMap map, obs;
+	for (int id = 0; id < 300; id++)
+	{
+		auto lm = newLandmark(
+			mrpt::vision::featSIFT, id, rng.drawUniform(-20, 20),
+			rng.drawUniform(-20, 20), rng.drawUniform(0, 5),
+			rng.drawUniform(0.01f, 0.2f));
+		lm.features[0]->descriptors.SIFT = randomDescriptor();
+		map.landmarks.push_back(lm);
+
+		if (id % 10 == 0 || id % 37 == 0)
+		{
+			auto lm_obs = lm;
+			lm_obs.createOneFeature();
+			lm_obs.features[0]->type = mrpt::vision::featSIFT;
+			lm_obs.features[0]->descriptors.SIFT =
+				id % 37 == 0 ? randomDescriptor()
+							 : lm.features[0]->descriptors.SIFT;
+			lm_obs.ID = 1000 + id;
+			lm_obs.pose_mean.x += rng.drawGaussian1D(0, 0.05);
+			lm_obs.pose_mean.y += rng.drawGaussian1D(0, 0.05);
+			obs.landmarks.push_back(lm_obs);
+		}
+	}
+
+	map.likelihoodOptions.SIFTs_decimation = 1;
+	for (double mahaStd : {1.0, 10.0})
+	{
+		map.likelihoodOptions.SIFTs_mahaDist_std = mahaStd;
+		CLandmarksMap::_mEDD.clear();
+		const double l = map.computeLikelihood_SIFT_LandmarkMap(&obs);
+		EXPECT_NEAR(l, exhaustiveSIFTLikelihood(map, obs), 1e-6 * std::abs(l))
+			<< "mahaStd=" << mahaStd;
+	}
+}
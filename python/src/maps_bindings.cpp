@@ -535,7 +535,10 @@ void export_maps()
 			.def_readwrite(
 				"wideningBeamsWithDistance",
 				&COccupancyGridMap2D::TInsertionOptions::
-					wideningBeamsWithDistance);
+					wideningBeamsWithDistance)
+			.def_readwrite(
+				"rasterizeFreeSpace",
+				&COccupancyGridMap2D::TInsertionOptions::rasterizeFreeSpace);
 
 		// TLikelihoodOptions
 		class_<